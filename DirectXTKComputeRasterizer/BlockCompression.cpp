@@ -0,0 +1,732 @@
+#include "BlockCompression.h"
+#include "DebugOutput.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // ------------------------------------------------------------------------------
+    // BC7 ̃e[u (D3D11 ̎dl BC7 Format Mode Reference)
+    // ------------------------------------------------------------------------------
+
+    struct BC7Mode {
+        uint8_t subsets;
+        uint8_t partitionBits;
+        uint8_t rotationBits;
+        uint8_t indexSelectionBits;
+        uint8_t colorBits;
+        uint8_t alphaBits;
+        uint8_t endpointPBits;  // [_Ƃ P rbg
+        uint8_t sharedPBits;    // TuZbg2[_ŋL P rbg
+        uint8_t indexBits;
+        uint8_t indexBits2;     // [h 4, 5 ̃At@ (܂̓J[) p2ڂ̃CfbNX
+    };
+
+    const BC7Mode c_BC7Modes[8] = {
+        { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+        { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+        { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+        { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+        { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+        { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+        { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+        { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+    };
+
+    const uint8_t c_Weights2[4] = { 0, 21, 43, 64 };
+    const uint8_t c_Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+    const uint8_t c_Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    const uint8_t* GetWeights(uint32_t indexBits)
+    {
+        return indexBits == 2 ? c_Weights2 : (indexBits == 3 ? c_Weights3 : c_Weights4);
+    }
+
+    // 2TuZbg̃p[eBV (rbg i eNZ i ̃TuZbg)
+    const uint16_t c_Partitions2[64] = {
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+        0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+        0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+        0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+        0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+        0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+        0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+        0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+    };
+
+    // 3TuZbg̃p[eBV
+    const uint8_t c_Partitions3[64][16] = {
+        { 0,0,1,1, 0,0,1,1, 0,2,2,1, 2,2,2,2 }, { 0,0,0,1, 0,0,1,1, 2,2,1,1, 2,2,2,1 },
+        { 0,0,0,0, 2,0,0,1, 2,2,1,1, 2,2,1,1 }, { 0,2,2,2, 0,0,2,2, 0,0,1,1, 0,1,1,1 },
+        { 0,0,0,0, 0,0,0,0, 1,1,2,2, 1,1,2,2 }, { 0,0,1,1, 0,0,1,1, 0,0,2,2, 0,0,2,2 },
+        { 0,0,2,2, 0,0,2,2, 1,1,1,1, 1,1,1,1 }, { 0,0,1,1, 0,0,1,1, 2,2,1,1, 2,2,1,1 },
+        { 0,0,0,0, 0,0,0,0, 1,1,1,1, 2,2,2,2 }, { 0,0,0,0, 1,1,1,1, 1,1,1,1, 2,2,2,2 },
+        { 0,0,0,0, 1,1,1,1, 2,2,2,2, 2,2,2,2 }, { 0,0,1,2, 0,0,1,2, 0,0,1,2, 0,0,1,2 },
+        { 0,1,1,2, 0,1,1,2, 0,1,1,2, 0,1,1,2 }, { 0,1,2,2, 0,1,2,2, 0,1,2,2, 0,1,2,2 },
+        { 0,0,1,1, 0,1,1,2, 1,1,2,2, 1,2,2,2 }, { 0,0,1,1, 2,0,0,1, 2,2,0,0, 2,2,2,0 },
+        { 0,0,0,1, 0,0,1,1, 0,1,1,2, 1,1,2,2 }, { 0,1,1,1, 0,0,1,1, 2,0,0,1, 2,2,0,0 },
+        { 0,0,0,0, 1,1,2,2, 1,1,2,2, 1,1,2,2 }, { 0,0,2,2, 0,0,2,2, 0,0,2,2, 1,1,1,1 },
+        { 0,1,1,1, 0,1,1,1, 0,2,2,2, 0,2,2,2 }, { 0,0,0,1, 0,0,0,1, 2,2,2,1, 2,2,2,1 },
+        { 0,0,0,0, 0,0,1,1, 0,1,2,2, 0,1,2,2 }, { 0,0,0,0, 1,1,0,0, 2,2,1,0, 2,2,1,0 },
+        { 0,1,2,2, 0,1,2,2, 0,0,1,1, 0,0,0,0 }, { 0,0,1,2, 0,0,1,2, 1,1,2,2, 2,2,2,2 },
+        { 0,1,1,0, 1,2,2,1, 1,2,2,1, 0,1,1,0 }, { 0,0,0,0, 0,1,1,0, 1,2,2,1, 1,2,2,1 },
+        { 0,0,2,2, 1,1,0,2, 1,1,0,2, 0,0,2,2 }, { 0,1,1,0, 0,1,1,0, 2,0,0,2, 2,2,2,2 },
+        { 0,0,1,1, 0,1,2,2, 0,1,2,2, 0,0,1,1 }, { 0,0,0,0, 2,0,0,0, 2,2,1,1, 2,2,2,1 },
+        { 0,0,0,0, 0,0,0,2, 1,1,2,2, 1,2,2,2 }, { 0,2,2,2, 0,0,2,2, 0,0,1,2, 0,0,1,1 },
+        { 0,0,1,1, 0,0,1,2, 0,0,2,2, 0,2,2,2 }, { 0,1,2,0, 0,1,2,0, 0,1,2,0, 0,1,2,0 },
+        { 0,0,0,0, 1,1,1,1, 2,2,2,2, 0,0,0,0 }, { 0,1,2,0, 1,2,0,1, 2,0,1,2, 0,1,2,0 },
+        { 0,1,2,0, 2,0,1,2, 1,2,0,1, 0,1,2,0 }, { 0,0,1,1, 2,2,0,0, 1,1,2,2, 0,0,1,1 },
+        { 0,0,1,1, 1,1,2,2, 2,2,0,0, 0,0,1,1 }, { 0,1,0,1, 0,1,0,1, 2,2,2,2, 2,2,2,2 },
+        { 0,0,0,0, 0,0,0,0, 2,1,2,1, 2,1,2,1 }, { 0,0,2,2, 1,1,2,2, 0,0,2,2, 1,1,2,2 },
+        { 0,0,2,2, 0,0,1,1, 0,0,2,2, 0,0,1,1 }, { 0,2,2,0, 1,2,2,1, 0,2,2,0, 1,2,2,1 },
+        { 0,1,0,1, 2,2,2,2, 2,2,2,2, 0,1,0,1 }, { 0,0,0,0, 2,1,2,1, 2,1,2,1, 2,1,2,1 },
+        { 0,1,0,1, 0,1,0,1, 0,1,0,1, 2,2,2,2 }, { 0,2,2,2, 0,1,1,1, 0,2,2,2, 0,1,1,1 },
+        { 0,0,0,2, 1,1,1,2, 0,0,0,2, 1,1,1,2 }, { 0,0,0,0, 2,1,1,2, 2,1,1,2, 2,1,1,2 },
+        { 0,2,2,2, 0,1,1,1, 0,1,1,1, 0,2,2,2 }, { 0,0,0,2, 1,1,1,2, 1,1,1,2, 0,0,0,2 },
+        { 0,1,1,0, 0,1,1,0, 0,1,1,0, 2,2,2,2 }, { 0,0,0,0, 0,0,0,0, 2,1,1,2, 2,1,1,2 },
+        { 0,1,1,0, 0,1,1,0, 2,2,2,2, 2,2,2,2 }, { 0,0,2,2, 0,0,1,1, 0,0,1,1, 0,0,2,2 },
+        { 0,0,2,2, 1,1,2,2, 1,1,2,2, 0,0,2,2 }, { 0,0,0,0, 0,0,0,0, 0,0,0,0, 2,1,1,2 },
+        { 0,0,0,2, 0,0,0,1, 0,0,0,2, 0,0,0,1 }, { 0,2,2,2, 1,2,2,2, 0,2,2,2, 1,2,2,2 },
+        { 0,1,0,1, 2,2,2,2, 2,2,2,2, 2,2,2,2 }, { 0,1,1,1, 2,0,1,1, 2,2,0,1, 2,2,2,0 },
+    };
+
+    // TuZbg 1, 2 ̐擪 (AJ[) ̃eNZBAJ[̃CfbNX͍ŏʃrbgȂ
+    const uint8_t c_Anchors2[64] = {
+        15,15,15,15,15,15,15,15, 15,15,15,15,15,15,15,15,
+        15, 2, 8, 2, 2, 8, 8,15,  2, 8, 2, 2, 8, 8, 2, 2,
+        15,15, 6, 8, 2, 8,15,15,  2, 8, 2, 2, 2,15,15, 6,
+         6, 2, 6, 8,15,15, 2, 2, 15,15,15,15,15, 2, 2,15,
+    };
+
+    const uint8_t c_Anchors3a[64] = {
+         3, 3,15,15, 8, 3,15,15,  8, 8, 6, 6, 6, 5, 3, 3,
+         3, 3, 8,15, 3, 3, 6,10,  5, 8, 8, 6, 8, 5,15,15,
+         8,15, 3, 5, 6,10, 8,15, 15, 3,15, 5,15,15,15,15,
+         3,15, 5, 5, 5, 8, 5,10,  5,10, 8,13,15,12, 3, 3,
+    };
+
+    const uint8_t c_Anchors3b[64] = {
+        15, 8, 8, 3,15,15, 3, 8, 15,15,15,15,15,15,15, 8,
+        15, 8,15, 3,15, 8,15, 8,  3,15, 6,10,15,15,10, 8,
+        15, 3,15,10,10, 8, 9,10,  6,15, 8,15, 3, 6, 6, 8,
+        15, 3,15,15,15,15,15,15, 15,15,15,15, 3,15,15, 8,
+    };
+
+    // 128bit ̃ubNʃrbgǂ
+    class BitReader
+    {
+    public:
+        explicit BitReader(const uint8_t* block)
+        {
+            for (int i = 7; i >= 0; --i)
+            {
+                m_low = (m_low << 8) | block[i];
+                m_high = (m_high << 8) | block[i + 8];
+            }
+        }
+
+        uint32_t Read(uint32_t count)
+        {
+            uint64_t value;
+            if (m_position >= 64)
+            {
+                value = m_high >> (m_position - 64);
+            }
+            else
+            {
+                value = m_low >> m_position;
+                if (m_position + count > 64)
+                {
+                    value |= m_high << (64 - m_position);
+                }
+            }
+            m_position += count;
+            return static_cast<uint32_t>(value & ((1u << count) - 1));
+        }
+
+    private:
+        uint64_t m_low = 0;
+        uint64_t m_high = 0;
+        uint32_t m_position = 0;
+    };
+
+    class BitWriter
+    {
+    public:
+        void Write(uint32_t value, uint32_t count)
+        {
+            const uint64_t bits = value & ((1u << count) - 1);
+            if (m_position >= 64)
+            {
+                m_high |= bits << (m_position - 64);
+            }
+            else
+            {
+                m_low |= bits << m_position;
+                if (m_position + count > 64)
+                {
+                    m_high |= bits >> (64 - m_position);
+                }
+            }
+            m_position += count;
+        }
+
+        void Store(uint8_t* block) const
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                block[i] = static_cast<uint8_t>(m_low >> (i * 8));
+                block[i + 8] = static_cast<uint8_t>(m_high >> (i * 8));
+            }
+        }
+
+    private:
+        uint64_t m_low = 0;
+        uint64_t m_high = 0;
+        uint32_t m_position = 0;
+    };
+
+    // e0  e1 (RGBA, 0-255)  weights (0-64) ŕԂpbg
+    void InterpolatePalette(const int e0[4], const int e1[4], const uint8_t* weights, uint32_t count, uint32_t* palette)
+    {
+#if defined(_XM_SSE_INTRINSICS_)
+        // 16bit x 8 [2Gg RGBA ׁA1̏Z2GgԂ
+        const __m128i endpoint0 = _mm_setr_epi16(static_cast<short>(e0[0]), static_cast<short>(e0[1]),
+                                                 static_cast<short>(e0[2]), static_cast<short>(e0[3]),
+                                                 static_cast<short>(e0[0]), static_cast<short>(e0[1]),
+                                                 static_cast<short>(e0[2]), static_cast<short>(e0[3]));
+        const __m128i endpoint1 = _mm_setr_epi16(static_cast<short>(e1[0]), static_cast<short>(e1[1]),
+                                                 static_cast<short>(e1[2]), static_cast<short>(e1[3]),
+                                                 static_cast<short>(e1[0]), static_cast<short>(e1[1]),
+                                                 static_cast<short>(e1[2]), static_cast<short>(e1[3]));
+        const __m128i sixtyFour = _mm_set1_epi16(64);
+        const __m128i half = _mm_set1_epi16(32);
+        for (uint32_t i = 0; i < count; i += 2)
+        {
+            const short w0 = weights[i];
+            const short w1 = weights[i + 1];
+            const __m128i w = _mm_setr_epi16(w0, w0, w0, w0, w1, w1, w1, w1);
+            __m128i value = _mm_add_epi16(_mm_mullo_epi16(endpoint0, _mm_sub_epi16(sixtyFour, w)),
+                                          _mm_mullo_epi16(endpoint1, w));
+            value = _mm_srli_epi16(_mm_add_epi16(value, half), 6);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(palette + i), _mm_packus_epi16(value, value));
+        }
+#else
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const int w = weights[i];
+            uint32_t entry = 0;
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                entry |= static_cast<uint32_t>(((64 - w) * e0[c] + w * e1[c] + 32) >> 6) << (c * 8);
+            }
+            palette[i] = entry;
+        }
+#endif
+    }
+
+    // ------------------------------------------------------------------------------
+    // BC1 / BC3
+    // ------------------------------------------------------------------------------
+
+    void Unpack565(uint32_t color, int rgb[3])
+    {
+        const int r = (color >> 11) & 31;
+        const int g = (color >> 5) & 63;
+        const int b = color & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    uint32_t Pack565(const int rgb[3])
+    {
+        return static_cast<uint32_t>(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+    }
+
+#if !defined(_XM_SSE_INTRINSICS_)
+    uint32_t MakeRGBA(int r, int g, int b, int a)
+    {
+        return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) | (static_cast<uint32_t>(b) << 16) |
+               (static_cast<uint32_t>(a) << 24);
+    }
+#endif
+
+    // GR[_̒[_: e`l̍ŏlƍőlAωł傫`l
+    // tɕω`lւāAoEfBO{bNX̑ΊpI
+    void ChooseEndpoints(const uint32_t texels[16], uint32_t channelCount, int e0[4], int e1[4])
+    {
+        int mean[4] = {};
+        uint32_t mainChannel = 0;
+        for (uint32_t c = 0; c < channelCount; ++c)
+        {
+            e0[c] = 255;
+            e1[c] = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                const int value = (texels[i] >> (c * 8)) & 0xFF;
+                e0[c] = std::min(e0[c], value);
+                e1[c] = std::max(e1[c], value);
+                mean[c] += value;
+            }
+            if (e1[c] - e0[c] > e1[mainChannel] - e0[mainChannel])
+            {
+                mainChannel = c;
+            }
+        }
+
+        for (uint32_t c = 0; c < channelCount; ++c)
+        {
+            int covariance = 0;
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                const int main = static_cast<int>((texels[i] >> (mainChannel * 8)) & 0xFF) * 16 - mean[mainChannel];
+                covariance += main * (static_cast<int>((texels[i] >> (c * 8)) & 0xFF) * 16 - mean[c]);
+            }
+            if (covariance < 0)
+            {
+                std::swap(e0[c], e1[c]);
+            }
+        }
+    }
+
+    // BC2/BC3 ̃J[ubN͏4F[h (allowTransparent = false)
+    void DecodeColorBlock(const uint8_t* block, uint32_t texels[16], bool allowTransparent)
+    {
+        const uint32_t color0 = block[0] | (block[1] << 8);
+        const uint32_t color1 = block[2] | (block[3] << 8);
+        const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+#if defined(_XM_SSE_INTRINSICS_)
+        // 16bit x 8 [2[_ RGBA ׂB565  8bit ւ̓WJ (r << 3 | r >> 2 Ȃ) 
+        // R  G ̓}XNl̏ 16bit ̐ρAB ͉ʂ̐ςŋ߂
+        const short packed0 = static_cast<short>(color0);
+        const short packed1 = static_cast<short>(color1);
+        const __m128i masked = _mm_and_si128(_mm_setr_epi16(packed0, packed0, packed0, 0, packed1, packed1, packed1, 0),
+                                             _mm_setr_epi16(static_cast<short>(0xF800), 0x07E0, 0x001F, 0, static_cast<short>(0xF800), 0x07E0, 0x001F, 0));
+        const __m128i high = _mm_mulhi_epu16(masked, _mm_setr_epi16(0x0108, 0x2080, 0, 0, 0x0108, 0x2080, 0, 0));
+        const __m128i low = _mm_srli_epi16(_mm_mullo_epi16(masked, _mm_setr_epi16(0, 0, 33, 0, 0, 0, 33, 0)), 2);
+        const __m128i endpoints = _mm_or_si128(_mm_or_si128(high, low), _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255));
+
+        // [_ւ̂ƑƁAʂ c0 Aʂ c1 ̒ԐF (3  21846 / 65536 ̐ςŊ؂͈͂)
+        const __m128i swapped = _mm_shuffle_epi32(endpoints, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128i interpolated;
+        if (color0 > color1 || !allowTransparent)
+        {
+            interpolated = _mm_mulhi_epu16(_mm_add_epi16(_mm_add_epi16(endpoints, endpoints), swapped), _mm_set1_epi16(21846));
+        }
+        else
+        {
+            interpolated = _mm_and_si128(_mm_srli_epi16(_mm_add_epi16(endpoints, swapped), 1), _mm_setr_epi32(-1, -1, 0, 0));
+        }
+
+        alignas(16) uint32_t palette[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(palette), _mm_packus_epi16(endpoints, interpolated));
+#else
+        int c0[3], c1[3];
+        Unpack565(color0, c0);
+        Unpack565(color1, c1);
+
+        uint32_t palette[4];
+        palette[0] = MakeRGBA(c0[0], c0[1], c0[2], 255);
+        palette[1] = MakeRGBA(c1[0], c1[1], c1[2], 255);
+        if (color0 > color1 || !allowTransparent)
+        {
+            palette[2] = MakeRGBA((2 * c0[0] + c1[0]) / 3, (2 * c0[1] + c1[1]) / 3, (2 * c0[2] + c1[2]) / 3, 255);
+            palette[3] = MakeRGBA((c0[0] + 2 * c1[0]) / 3, (c0[1] + 2 * c1[1]) / 3, (c0[2] + 2 * c1[2]) / 3, 255);
+        }
+        else
+        {
+            palette[2] = MakeRGBA((c0[0] + c1[0]) / 2, (c0[1] + c1[1]) / 2, (c0[2] + c1[2]) / 2, 255);
+            palette[3] = 0;
+        }
+#endif
+
+        // CfbNX̎QƂ̓XJ[̂܂ (SSE2 ɂ̓[Ƃ̕\ȂArőIԂ葬)
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            texels[i] = palette[(indices >> (i * 2)) & 3];
+        }
+    }
+
+    void EncodeColorBlock(const uint32_t texels[16], uint8_t* block)
+    {
+        int low[4], high[4];
+        ChooseEndpoints(texels, 3, low, high);
+
+        // 4F[hɂ邽 color0 > color1 ɂȂ悤ׂ (ꍇ͑SeNZ color0)
+        uint32_t color0 = Pack565(high);
+        uint32_t color1 = Pack565(low);
+        if (color0 < color1)
+        {
+            std::swap(color0, color1);
+        }
+        int c0[3], c1[3];
+        Unpack565(color0, c0);
+        Unpack565(color1, c1);
+
+        const int axis[3] = { c1[0] - c0[0], c1[1] - c0[1], c1[2] - c0[2] };
+        const int lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+        uint32_t indices = 0;
+        if (color0 != color1 && lengthSquared > 0)
+        {
+            // ւ̎ˉe t (0 = color0, 1 = color1) pbg̕ (0, 2, 3, 1) Ɋ蓖Ă
+            static const uint32_t c_Order[4] = { 0, 2, 3, 1 };
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                int dot = 0;
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    dot += (static_cast<int>((texels[i] >> (c * 8)) & 0xFF) - c0[c]) * axis[c];
+                }
+                const int step = std::min(std::max((dot * 3 + lengthSquared / 2) / lengthSquared, 0), 3);
+                indices |= c_Order[step] << (i * 2);
+            }
+        }
+
+        block[0] = static_cast<uint8_t>(color0);
+        block[1] = static_cast<uint8_t>(color0 >> 8);
+        block[2] = static_cast<uint8_t>(color1);
+        block[3] = static_cast<uint8_t>(color1 >> 8);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            block[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+        }
+    }
+}
+
+void DecodeBC1Block(const uint8_t* block, uint32_t texels[16])
+{
+    DecodeColorBlock(block, texels, true);
+}
+
+void DecodeBC3Block(const uint8_t* block, uint32_t texels[16])
+{
+#if defined(_XM_SSE_INTRINSICS_)
+    // 8Gg 16bit [ňxɕԂ (7  5  9363 / 65536  13108 / 65536 ̐ςŊ؂͈͂)
+    const __m128i alpha0 = _mm_set1_epi16(block[0]);
+    const __m128i alpha1 = _mm_set1_epi16(block[1]);
+    __m128i alpha;
+    if (block[0] > block[1])
+    {
+        alpha = _mm_add_epi16(_mm_mullo_epi16(alpha0, _mm_setr_epi16(7, 0, 6, 5, 4, 3, 2, 1)),
+                              _mm_mullo_epi16(alpha1, _mm_setr_epi16(0, 7, 1, 2, 3, 4, 5, 6)));
+        alpha = _mm_mulhi_epu16(alpha, _mm_set1_epi16(9363));
+    }
+    else
+    {
+        alpha = _mm_add_epi16(_mm_mullo_epi16(alpha0, _mm_setr_epi16(5, 0, 4, 3, 2, 1, 0, 0)),
+                              _mm_mullo_epi16(alpha1, _mm_setr_epi16(0, 5, 1, 2, 3, 4, 0, 0)));
+        alpha = _mm_or_si128(_mm_mulhi_epu16(alpha, _mm_set1_epi16(13108)), _mm_setr_epi16(0, 0, 0, 0, 0, 0, 0, 255));
+    }
+
+    alignas(16) uint16_t palette[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(palette), alpha);
+#else
+    const int alpha0 = block[0];
+    const int alpha1 = block[1];
+    int palette[8] = { alpha0, alpha1 };
+    if (alpha0 > alpha1)
+    {
+        for (int i = 1; i < 7; ++i)
+        {
+            palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+        }
+    }
+    else
+    {
+        for (int i = 1; i < 5; ++i)
+        {
+            palette[i + 1] = ((5 - i) * alpha0 + i * alpha1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+#endif
+
+    uint64_t indices = 0;
+    for (int i = 7; i >= 2; --i)
+    {
+        indices = (indices << 8) | block[i];
+    }
+
+    DecodeColorBlock(block + 8, texels, false);
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        texels[i] = (texels[i] & 0x00FFFFFF) | (static_cast<uint32_t>(palette[(indices >> (i * 3)) & 7]) << 24);
+    }
+}
+
+void DecodeBC7Block(const uint8_t* block, uint32_t texels[16])
+{
+    uint32_t modeIndex = 0;
+    while (modeIndex < 8 && !(block[0] & (1 << modeIndex)))
+    {
+        ++modeIndex;
+    }
+    if (modeIndex == 8)
+    {
+        // \񂳂ꂽ[h͓ȍ
+        std::fill(texels, texels + 16, 0u);
+        return;
+    }
+
+    const BC7Mode& mode = c_BC7Modes[modeIndex];
+    BitReader reader(block);
+    reader.Read(modeIndex + 1);
+    const uint32_t partition = reader.Read(mode.partitionBits);
+    const uint32_t rotation = reader.Read(mode.rotationBits);
+    const uint32_t indexSelection = reader.Read(mode.indexSelectionBits);
+
+    // [_ [TuZbg][0/1][RGBA]
+    int endpoints[3][2][4];
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        for (uint32_t s = 0; s < mode.subsets; ++s)
+        {
+            endpoints[s][0][c] = static_cast<int>(reader.Read(mode.colorBits));
+            endpoints[s][1][c] = static_cast<int>(reader.Read(mode.colorBits));
+        }
+    }
+    for (uint32_t s = 0; s < mode.subsets; ++s)
+    {
+        endpoints[s][0][3] = static_cast<int>(reader.Read(mode.alphaBits));
+        endpoints[s][1][3] = static_cast<int>(reader.Read(mode.alphaBits));
+    }
+
+    uint32_t colorBits = mode.colorBits;
+    uint32_t alphaBits = mode.alphaBits;
+    if (mode.endpointPBits || mode.sharedPBits)
+    {
+        for (uint32_t s = 0; s < mode.subsets; ++s)
+        {
+            uint32_t pBits[2];
+            pBits[0] = reader.Read(1);
+            pBits[1] = mode.sharedPBits ? pBits[0] : reader.Read(1);
+            for (uint32_t e = 0; e < 2; ++e)
+            {
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    endpoints[s][e][c] = (endpoints[s][e][c] << 1) | static_cast<int>(pBits[e]);
+                }
+            }
+        }
+        colorBits += 1;
+        alphaBits += alphaBits ? 1 : 0;
+    }
+
+    // 8bit ɍL (ʃrbgʂɕ)
+    for (uint32_t s = 0; s < mode.subsets; ++s)
+    {
+        for (uint32_t e = 0; e < 2; ++e)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                const int value = endpoints[s][e][c] << (8 - colorBits);
+                endpoints[s][e][c] = value | (value >> colorBits);
+            }
+            if (alphaBits)
+            {
+                const int value = endpoints[s][e][3] << (8 - alphaBits);
+                endpoints[s][e][3] = value | (value >> alphaBits);
+            }
+            else
+            {
+                endpoints[s][e][3] = 255;
+            }
+        }
+    }
+
+    uint8_t subsetOf[16];
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        subsetOf[i] = mode.subsets == 1 ? 0 :
+                      (mode.subsets == 2 ? static_cast<uint8_t>((c_Partitions2[partition] >> i) & 1) : c_Partitions3[partition][i]);
+    }
+    const uint32_t anchor1 = mode.subsets == 2 ? c_Anchors2[partition] : c_Anchors3a[partition];
+    const uint32_t anchor2 = mode.subsets == 3 ? c_Anchors3b[partition] : 0;
+
+    uint8_t indices[16];
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        const bool isAnchor = i == 0 || (mode.subsets >= 2 && i == anchor1) || (mode.subsets == 3 && i == anchor2);
+        indices[i] = static_cast<uint8_t>(reader.Read(mode.indexBits - (isAnchor ? 1 : 0)));
+    }
+
+    uint32_t palette[3][16];
+    if (!mode.indexBits2)
+    {
+        for (uint32_t s = 0; s < mode.subsets; ++s)
+        {
+            InterpolatePalette(endpoints[s][0], endpoints[s][1], GetWeights(mode.indexBits), 1u << mode.indexBits, palette[s]);
+        }
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            texels[i] = palette[subsetOf[i]][indices[i]];
+        }
+    }
+    else
+    {
+        // [h 4, 5: J[ƃAt@ʂ̃CfbNXŕԂ (indexSelection œւ)
+        uint8_t indices2[16];
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            indices2[i] = static_cast<uint8_t>(reader.Read(mode.indexBits2 - (i == 0 ? 1 : 0)));
+        }
+
+        const uint32_t colorIndexBits = indexSelection ? mode.indexBits2 : mode.indexBits;
+        const uint32_t alphaIndexBits = indexSelection ? mode.indexBits : mode.indexBits2;
+        const uint8_t* colorIndices = indexSelection ? indices2 : indices;
+        const uint8_t* alphaIndices = indexSelection ? indices : indices2;
+
+        InterpolatePalette(endpoints[0][0], endpoints[0][1], GetWeights(colorIndexBits), 1u << colorIndexBits, palette[0]);
+        InterpolatePalette(endpoints[0][0], endpoints[0][1], GetWeights(alphaIndexBits), 1u << alphaIndexBits, palette[1]);
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            texels[i] = (palette[0][colorIndices[i]] & 0x00FFFFFF) | (palette[1][alphaIndices[i]] & 0xFF000000);
+        }
+    }
+
+    // At@ R / G / B ̓ւ
+    if (rotation)
+    {
+        const uint32_t shift = (rotation - 1) * 8;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            const uint32_t alpha = texels[i] >> 24;
+            const uint32_t other = (texels[i] >> shift) & 0xFF;
+            texels[i] = (texels[i] & ~(0xFFu << shift) & 0x00FFFFFF) | (alpha << shift) | (other << 24);
+        }
+    }
+}
+
+void DecodeBlock(TextureFormat format, const uint8_t* block, uint32_t texels[16])
+{
+    switch (format)
+    {
+    case TextureFormat::BC1: DecodeBC1Block(block, texels); break;
+    case TextureFormat::BC3: DecodeBC3Block(block, texels); break;
+    case TextureFormat::BC7: DecodeBC7Block(block, texels); break;
+    default:
+        DebugOutput("Failed to decode block: unsupported format\n");
+        throw std::runtime_error("Failed to decode block: unsupported format");
+    }
+}
+
+void EncodeBC1Block(const uint32_t texels[16], uint8_t* block)
+{
+    EncodeColorBlock(texels, block);
+}
+
+void EncodeBC3Block(const uint32_t texels[16], uint8_t* block)
+{
+    int alpha0 = 0, alpha1 = 255;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        const int alpha = static_cast<int>(texels[i] >> 24);
+        alpha0 = std::max(alpha0, alpha);
+        alpha1 = std::min(alpha1, alpha);
+    }
+
+    // alpha0 > alpha1 8iK[h (0 = alpha0, 1 = alpha1, 2..7 = )
+    uint64_t indices = 0;
+    if (alpha0 > alpha1)
+    {
+        const int range = alpha0 - alpha1;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            const int step = ((alpha0 - static_cast<int>(texels[i] >> 24)) * 7 + range / 2) / range;
+            const uint64_t index = step == 0 ? 0 : (step == 7 ? 1 : step + 1);
+            indices |= index << (i * 3);
+        }
+    }
+
+    block[0] = static_cast<uint8_t>(alpha0);
+    block[1] = static_cast<uint8_t>(alpha1);
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        block[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    }
+    EncodeColorBlock(texels, block + 8);
+}
+
+void EncodeBC7Block(const uint32_t texels[16], uint8_t* block)
+{
+    // [h 6: 1TuZbgARGBA 7bit + [_Ƃ P rbgA4bit CfbNX
+    int low[4], high[4];
+    ChooseEndpoints(texels, 4, low, high);
+
+    // P rbg 0 / 1 ɂƁA8bit ɖ߂[_ low ̐؂̂ / high ̐؂グɂȂ
+    int endpoints[2][4];
+    uint32_t pBits[2] = { 0, 1 };
+    int lengthSquared = 0;
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        endpoints[0][c] = low[c] & ~1;
+        endpoints[1][c] = high[c] | 1;
+        const int axis = endpoints[1][c] - endpoints[0][c];
+        lengthSquared += axis * axis;
+    }
+
+    uint32_t indices[16];
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        int dot = 0;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            dot += (static_cast<int>((texels[i] >> (c * 8)) & 0xFF) - endpoints[0][c]) * (endpoints[1][c] - endpoints[0][c]);
+        }
+        const int weight = lengthSquared > 0 ? std::min(std::max((dot * 64 + lengthSquared / 2) / lengthSquared, 0), 64) : 0;
+
+        uint32_t best = 0;
+        for (uint32_t k = 1; k < 16; ++k)
+        {
+            if (std::abs(c_Weights4[k] - weight) < std::abs(c_Weights4[best] - weight))
+            {
+                best = k;
+            }
+        }
+        indices[i] = best;
+    }
+
+    // AJ[ (eNZ 0) ̃CfbNX̍ŏʃrbg 0 łȂ΂ȂȂ
+    if (indices[0] & 8)
+    {
+        std::swap(endpoints[0], endpoints[1]);
+        std::swap(pBits[0], pBits[1]);
+        for (uint32_t& index : indices)
+        {
+            index = 15 - index;
+        }
+    }
+
+    BitWriter writer;
+    writer.Write(1u << 6, 7);
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        writer.Write(static_cast<uint32_t>(endpoints[0][c]) >> 1, 7);
+        writer.Write(static_cast<uint32_t>(endpoints[1][c]) >> 1, 7);
+    }
+    writer.Write(pBits[0], 1);
+    writer.Write(pBits[1], 1);
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        writer.Write(indices[i], i == 0 ? 3 : 4);
+    }
+    writer.Store(block);
+}
+
+void EncodeBlock(TextureFormat format, const uint32_t texels[16], uint8_t* block)
+{
+    switch (format)
+    {
+    case TextureFormat::BC1: EncodeBC1Block(texels, block); break;
+    case TextureFormat::BC3: EncodeBC3Block(texels, block); break;
+    case TextureFormat::BC7: EncodeBC7Block(texels, block); break;
+    default:
+        DebugOutput("Failed to encode block: unsupported format\n");
+        throw std::runtime_error("Failed to encode block: unsupported format");
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+// ==================================================================================
+// BC1 / BC3 / BC7 ̃ubN (4x4 eNZ) ̃fR[h
+// SoftwareTexture keNX`𒼐ڃTv邽߂ɎgB
+// o͂ R8G8B8A8 (R ʃoCg)  4x4 ̍sD 16 B
+// [_̓WJƃpbg̕Ԃ SSE2 gꍇ (DirectXMath  _XM_SSE_INTRINSICS_) 4 `l܂Ƃ߂ČvZB
+// ==================================================================================
+
+enum class TextureFormat {
+    R8G8B8A8,
+    BC1,    // 8byte / ubN (RGB + 1bit At@)
+    BC3,    // 16byte / ubN (BC1 ̃J[ + 8bit At@)
+    BC7,    // 16byte / ubN (8 [hAp[eBVt)
+};
+
+constexpr uint32_t c_BlockSize = 4;
+
+inline uint32_t GetBlockBytes(TextureFormat format)
+{
+    return format == TextureFormat::BC1 ? 8 : 16;
+}
+
+void DecodeBC1Block(const uint8_t* block, uint32_t texels[16]);
+void DecodeBC3Block(const uint8_t* block, uint32_t texels[16]);
+void DecodeBC7Block(const uint8_t* block, uint32_t texels[16]);
+
+void DecodeBlock(TextureFormat format, const uint8_t* block, uint32_t texels[16]);
+
+// ȈՃGR[_ (ubN̍ŏlƍől[_ɂ)B
+// i葬xD悵ĂAx`}[Ñf[^쐬pBBC7 ̓[h 6 o͂B
+void EncodeBC1Block(const uint32_t texels[16], uint8_t* block);
+void EncodeBC3Block(const uint32_t texels[16], uint8_t* block);
+void EncodeBC7Block(const uint32_t texels[16], uint8_t* block);
+
+void EncodeBlock(TextureFormat format, const uint32_t texels[16], uint8_t* block);
@@ -0,0 +1,368 @@
+#include "BvhBuilder.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <future>
+#include <thread>
+
+using namespace DirectX;
+
+namespace
+{
+    // SAH ]Ɏgr
+    constexpr uint32_t c_BinCount = 16;
+
+    // Op`̑m[h́ArWvƃTuc[\z񉻂
+    // (gXbh BuildNode  threadBudget ̕ŁÂтɍE̎q֕)
+    constexpr uint32_t c_ParallelThreshold = 8192;
+
+    struct Bounds
+    {
+        XMFLOAT3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+        XMFLOAT3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        void Grow(const XMFLOAT3& p)
+        {
+            min = { std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z) };
+            max = { std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z) };
+        }
+
+        void Grow(const Bounds& b)
+        {
+            if (b.IsEmpty())
+            {
+                return;
+            }
+            Grow(b.min);
+            Grow(b.max);
+        }
+
+        bool IsEmpty() const { return min.x > max.x; }
+
+        float SurfaceArea() const
+        {
+            if (IsEmpty())
+            {
+                return 0.0f;
+            }
+            float dx = max.x - min.x;
+            float dy = max.y - min.y;
+            float dz = max.z - min.z;
+            return 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+    };
+
+    float Component(const XMFLOAT3& v, uint32_t axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    Bounds TriangleBounds(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t triangle)
+    {
+        Bounds b;
+        b.Grow(vertices[TriangleVertexIndex(indices, triangle, 0)].pos);
+        b.Grow(vertices[TriangleVertexIndex(indices, triangle, 1)].pos);
+        b.Grow(vertices[TriangleVertexIndex(indices, triangle, 2)].pos);
+        return b;
+    }
+
+    struct BuildContext
+    {
+        std::vector<Bounds> triangleBounds;
+        std::vector<XMFLOAT3> centroids;
+        std::vector<uint32_t>* indices = nullptr;
+        std::vector<BvhNode>* nodes = nullptr;
+        std::atomic<uint32_t> nodeCount{ 0 };
+        uint32_t maxLeafTriangles = c_BvhMaxLeafTriangles;
+    };
+
+    // [first, first + count) ̎Op`̃oEfBO{bNXƏdS̃oEfBO{bNX
+    void ComputeRangeBounds(const BuildContext& ctx, uint32_t first, uint32_t count, Bounds& bounds, Bounds& centroidBounds)
+    {
+        const auto& indices = *ctx.indices;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            bounds.Grow(ctx.triangleBounds[indices[i]]);
+            centroidBounds.Grow(ctx.centroids[indices[i]]);
+        }
+    }
+
+    struct Bin
+    {
+        Bounds bounds;
+        uint32_t count = 0;
+    };
+
+    void FillBins(const BuildContext& ctx, uint32_t first, uint32_t count, uint32_t axis, float binMin, float binScale, Bin* bins)
+    {
+        const auto& indices = *ctx.indices;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            uint32_t t = indices[i];
+            uint32_t b = std::min(c_BinCount - 1, static_cast<uint32_t>((Component(ctx.centroids[t], axis) - binMin) * binScale));
+            bins[b].bounds.Grow(ctx.triangleBounds[t]);
+            ++bins[b].count;
+        }
+    }
+
+    // threadBudget ͂̃Tuc[ɎgĂ悢Xbh (g܂)
+    void BuildNode(BuildContext& ctx, uint32_t nodeIndex, uint32_t first, uint32_t count, uint32_t depth, uint32_t threadBudget)
+    {
+        auto& indices = *ctx.indices;
+        const uint32_t workerCount = count >= c_ParallelThreshold ? threadBudget : 1u;
+
+        // 1. m[h̃oEfBO{bNX
+        Bounds bounds;
+        Bounds centroidBounds;
+        if (workerCount > 1)
+        {
+            std::vector<Bounds> partialBounds(workerCount);
+            std::vector<Bounds> partialCentroids(workerCount);
+            std::vector<std::future<void>> tasks;
+            const uint32_t chunk = (count + workerCount - 1) / workerCount;
+            for (uint32_t w = 0; w < workerCount; ++w)
+            {
+                uint32_t chunkFirst = first + w * chunk;
+                uint32_t chunkCount = std::min(chunk, first + count - std::min(chunkFirst, first + count));
+                tasks.push_back(std::async(std::launch::async, [&, w, chunkFirst, chunkCount]()
+                {
+                    ComputeRangeBounds(ctx, chunkFirst, chunkCount, partialBounds[w], partialCentroids[w]);
+                }));
+            }
+            for (uint32_t w = 0; w < workerCount; ++w)
+            {
+                tasks[w].get();
+                bounds.Grow(partialBounds[w]);
+                centroidBounds.Grow(partialCentroids[w]);
+            }
+        }
+        else
+        {
+            ComputeRangeBounds(ctx, first, count, bounds, centroidBounds);
+        }
+
+        BvhNode& node = (*ctx.nodes)[nodeIndex];
+        node.boundsMin = bounds.min;
+        node.boundsMax = bounds.max;
+        node.leftFirst = first;
+        node.triangleCount = count;
+
+        if (count <= ctx.maxLeafTriangles || depth + 1 >= c_BvhMaxDepth)
+        {
+            return;
+        }
+
+        // 2. eŃrɕ SAH ŏɂȂ镪ʒuT
+        float bestCost = FLT_MAX;
+        uint32_t bestAxis = 0;
+        uint32_t bestSplit = 0;
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            float binMin = Component(centroidBounds.min, axis);
+            float extent = Component(centroidBounds.max, axis) - binMin;
+            if (extent <= 0.0f)
+            {
+                continue;
+            }
+            float binScale = c_BinCount / extent;
+
+            Bin bins[c_BinCount];
+            if (workerCount > 1)
+            {
+                std::vector<std::array<Bin, c_BinCount>> partialBins(workerCount);
+                std::vector<std::future<void>> tasks;
+                const uint32_t chunk = (count + workerCount - 1) / workerCount;
+                for (uint32_t w = 0; w < workerCount; ++w)
+                {
+                    uint32_t chunkFirst = first + w * chunk;
+                    uint32_t chunkCount = std::min(chunk, first + count - std::min(chunkFirst, first + count));
+                    tasks.push_back(std::async(std::launch::async, [&, w, chunkFirst, chunkCount]()
+                    {
+                        FillBins(ctx, chunkFirst, chunkCount, axis, binMin, binScale, partialBins[w].data());
+                    }));
+                }
+                for (uint32_t w = 0; w < workerCount; ++w)
+                {
+                    tasks[w].get();
+                    for (uint32_t b = 0; b < c_BinCount; ++b)
+                    {
+                        bins[b].bounds.Grow(partialBins[w][b].bounds);
+                        bins[b].count += partialBins[w][b].count;
+                    }
+                }
+            }
+            else
+            {
+                FillBins(ctx, first, count, axis, binMin, binScale, bins);
+            }
+
+            // EݐςāAeʒũRXg]
+            float leftArea[c_BinCount - 1];
+            uint32_t leftCount[c_BinCount - 1];
+            Bounds accumulated;
+            uint32_t accumulatedCount = 0;
+            for (uint32_t b = 0; b < c_BinCount - 1; ++b)
+            {
+                accumulated.Grow(bins[b].bounds);
+                accumulatedCount += bins[b].count;
+                leftArea[b] = accumulated.SurfaceArea();
+                leftCount[b] = accumulatedCount;
+            }
+
+            accumulated = Bounds();
+            accumulatedCount = 0;
+            for (uint32_t b = c_BinCount - 1; b > 0; --b)
+            {
+                accumulated.Grow(bins[b].bounds);
+                accumulatedCount += bins[b].count;
+                float cost = leftCount[b - 1] * leftArea[b - 1] + accumulatedCount * accumulated.SurfaceArea();
+                if (leftCount[b - 1] > 0 && accumulatedCount > 0 && cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b;
+                }
+            }
+        }
+
+        // dSׂēʒuɂꍇ͕łȂ̂Ń[tɂ
+        if (bestCost == FLT_MAX)
+        {
+            return;
+        }
+
+        // 3. ʒuŎOp`CfbNXבւ
+        float binMin = Component(centroidBounds.min, bestAxis);
+        float binScale = c_BinCount / (Component(centroidBounds.max, bestAxis) - binMin);
+        auto middle = std::partition(indices.begin() + first, indices.begin() + first + count, [&](uint32_t t)
+        {
+            uint32_t b = std::min(c_BinCount - 1, static_cast<uint32_t>((Component(ctx.centroids[t], bestAxis) - binMin) * binScale));
+            return b < bestSplit;
+        });
+        uint32_t leftCount = static_cast<uint32_t>(middle - (indices.begin() + first));
+
+        // 4. qm[h͗אڂ2vfƂĊmۂ
+        uint32_t children = ctx.nodeCount.fetch_add(2);
+        node.leftFirst = children;
+        node.triangleCount = 0;
+
+        if (workerCount > 1)
+        {
+            // Xbh͎Op`̔ŕ (ǂ 1 ȏB\Z 1 ɂȂTuc[͒ɍ\z)
+            const uint32_t leftBudget = std::clamp(static_cast<uint32_t>(static_cast<uint64_t>(threadBudget) * leftCount / count), 1u, threadBudget - 1);
+            auto left = std::async(std::launch::async, [&, leftBudget]() { BuildNode(ctx, children, first, leftCount, depth + 1, leftBudget); });
+            BuildNode(ctx, children + 1, first + leftCount, count - leftCount, depth + 1, threadBudget - leftBudget);
+            left.get();
+        }
+        else
+        {
+            BuildNode(ctx, children, first, leftCount, depth + 1, 1);
+            BuildNode(ctx, children + 1, first + leftCount, count - leftCount, depth + 1, 1);
+        }
+    }
+}
+
+Bvh BuildBvh(const std::vector<Vertex>& vertices, uint32_t maxLeafTriangles)
+{
+    return BuildBvh(vertices, std::vector<uint32_t>(), maxLeafTriangles);
+}
+
+Bvh BuildBvh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t maxLeafTriangles)
+{
+    Bvh bvh;
+    const uint32_t triangleCount = TriangleCount(vertices, indices);
+    if (triangleCount == 0)
+    {
+        return bvh;
+    }
+
+    BuildContext ctx;
+    ctx.maxLeafTriangles = std::max(1u, maxLeafTriangles);
+    ctx.triangleBounds.resize(triangleCount);
+    ctx.centroids.resize(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        ctx.triangleBounds[t] = TriangleBounds(vertices, indices, t);
+        XMVECTOR centroid = XMVectorScale(
+            XMVectorAdd(XMVectorAdd(XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, 0)].pos),
+                                    XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, 1)].pos)),
+                        XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, 2)].pos)),
+            1.0f / 3.0f);
+        XMStoreFloat3(&ctx.centroids[t], centroid);
+    }
+
+    bvh.triangleIndices.resize(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        bvh.triangleIndices[t] = t;
+    }
+
+    // m[h͍ő 2N - 1
+    std::vector<BvhNode> nodes(triangleCount * 2 - 1);
+    ctx.indices = &bvh.triangleIndices;
+    ctx.nodes = &nodes;
+    ctx.nodeCount = 1;
+    BuildNode(ctx, 0, 0, triangleCount, 0, std::max(1u, std::thread::hardware_concurrency()));
+
+    // \zł̓m[h̊mۏsɂȂ邽߁A[D揇ɕג
+    // (Z͗אڂ܂܁Ae͏ɎqOɗ)
+    bvh.nodes.reserve(ctx.nodeCount);
+    bvh.nodes.push_back(nodes[0]);
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // (\z̃CfbNX, בւ̃CfbNX)
+    stack.emplace_back(0u, 0u);
+    while (!stack.empty())
+    {
+        auto [source, target] = stack.back();
+        stack.pop_back();
+
+        const BvhNode& node = nodes[source];
+        if (node.triangleCount > 0)
+        {
+            continue;
+        }
+
+        uint32_t children = static_cast<uint32_t>(bvh.nodes.size());
+        bvh.nodes.push_back(nodes[node.leftFirst]);
+        bvh.nodes.push_back(nodes[node.leftFirst + 1]);
+        bvh.nodes[target].leftFirst = children;
+
+        stack.emplace_back(node.leftFirst + 1, children + 1);
+        stack.emplace_back(node.leftFirst, children);
+    }
+
+    return bvh;
+}
+
+void RefitBvh(Bvh& bvh, const std::vector<Vertex>& vertices)
+{
+    RefitBvh(bvh, vertices, std::vector<uint32_t>());
+}
+
+void RefitBvh(Bvh& bvh, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    // e͎qOɕł̂ŁA瑖ΎqɍXV
+    for (size_t i = bvh.nodes.size(); i-- > 0;)
+    {
+        BvhNode& node = bvh.nodes[i];
+        Bounds bounds;
+        if (node.triangleCount > 0)
+        {
+            for (uint32_t t = 0; t < node.triangleCount; ++t)
+            {
+                bounds.Grow(TriangleBounds(vertices, indices, bvh.triangleIndices[node.leftFirst + t]));
+            }
+        }
+        else
+        {
+            const BvhNode& left = bvh.nodes[node.leftFirst];
+            const BvhNode& right = bvh.nodes[node.leftFirst + 1];
+            bounds.Grow(left.boundsMin);
+            bounds.Grow(left.boundsMax);
+            bounds.Grow(right.boundsMin);
+            bounds.Grow(right.boundsMax);
+        }
+        node.boundsMin = bounds.min;
+        node.boundsMax = bounds.max;
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "RasterizerTypes.h"
+
+// [t̎Op`̊l
+constexpr uint32_t c_BvhMaxLeafTriangles = 4;
+
+// BVH ̍ő[ (TriangleRasterizer.hlsl  BVH_MAX_DEPTH ƈv邱)
+constexpr uint32_t c_BvhMaxDepth = 32;
+
+// ÓIV[p BVH
+// nodes ͐[D揇ɕсAe͏ɎqOɂ (RefitBvh ͋tɑ邾ł悢)
+struct Bvh {
+    std::vector<BvhNode> nodes;
+    std::vector<uint32_t> triangleIndices; // [tQƂOp`CfbNX
+};
+
+// Op`Xg (3_ = 1Op`) ɑ΂ binned SAH  BVH \z
+// 傫ȃm[h̃rWvƃTuc[̍\z̓[J[Xbhŕɍs (ɓ̂̓n[hEFÃXbh܂)
+Bvh BuildBvh(const std::vector<Vertex>& vertices, uint32_t maxLeafTriangles = c_BvhMaxLeafTriangles);
+// CfbNXtOp`Xgp (Op` t = indices[t * 3] ~ indices[t * 3 + 2])
+Bvh BuildBvh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t maxLeafTriangles = c_BvhMaxLeafTriangles);
+
+// _̈ړɁA؍\ۂ܂܃oEfBO{bNXXV (̉^Eό`p)
+void RefitBvh(Bvh& bvh, const std::vector<Vertex>& vertices);
+void RefitBvh(Bvh& bvh, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
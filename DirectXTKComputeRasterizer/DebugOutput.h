@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#endif
+
+// fobOo (Windows ł OutputDebugStringAAȊOł͕WG[o)
+// D3D11 ɈˑȂ CPU ł̃R[h (SoftwareRasterizer Ȃ) ͂g
+inline void DebugOutput(const char* message)
+{
+#ifdef _WIN32
+    OutputDebugStringA(message);
+#else
+    std::fputs(message, stderr);
+#endif
+}
@@ -1,109 +1,1638 @@
 #include "pch.h"
 #include "DirectXTKComputeRasterizer.h"
+#include "MeshletBuilder.h"
+#include "BvhBuilder.h"
+#include "MaterialTable.h"
+#include "SoftwareRasterizer.h"
 #include <d3dcompiler.h>
+#include <DDSTextureLoader.h>
+#include <WICTextureLoader.h>
+#include <filesystem>
+
+using namespace DirectX;
+
+namespace
+{
+    // ShaderPermutation ̃Gg[|Cg̔ԍ (L[̉ 2bit)
+    constexpr uint32_t c_ShaderEntryMain = 0;
+    constexpr uint32_t c_ShaderEntryMultiView = 1;
+    constexpr uint32_t c_ShaderEntryDepthOnly = 2;
+
+    // TriangleRasterizer.hlsl  RASTER_* (`Ȃ RasterState ɂȂ)
+    void DefineRasterState(ShaderPermutation& permutation, const RasterState& state)
+    {
+        permutation.Define("RASTER_TEXTURED", state.textured ? 1 : 0, 1);
+        permutation.Define("RASTER_VERTEX_COLOR", state.vertexColor ? 1 : 0, 1);
+        permutation.Define("RASTER_DEPTH_TEST", state.depthTest ? 1 : 0, 1);
+        permutation.Define("RASTER_CULL_MODE", static_cast<uint32_t>(state.cullMode), 2);
+        permutation.Define("RASTER_BLEND", static_cast<uint32_t>(state.blendMode), 2);
+    }
+
+    // ^C̑傫A[xobt@AێIX^CY (TILE_*ADEPTH_*ARASTER_CONSERVATIVEB`Ȃ 16x16AD32FloatAOff ɂȂ)
+    void DefineTarget(ShaderPermutation& permutation, const TileSize& tileSize, const DepthBufferDesc& depth, ConservativeMode conservative)
+    {
+        permutation.Define("TILE_WIDTH", tileSize.width, 7);
+        permutation.Define("TILE_HEIGHT", tileSize.height, 7);
+        permutation.Define("DEPTH_FORMAT", static_cast<uint32_t>(depth.format), 2);
+        permutation.Define("DEPTH_REVERSED", depth.reversedZ ? 1 : 0, 1);
+        permutation.Define("RASTER_CONSERVATIVE", static_cast<uint32_t>(conservative), 2);
+    }
+
+    // [JWł̃Jʒu߂ (sȅꍇ w = 0 ̎)
+    XMFLOAT4 XM_CALLCONV ComputeViewOrigin(FXMMATRIX worldView, CXMMATRIX projection)
+    {
+        XMMATRIX invWorldView = XMMatrixInverse(nullptr, worldView);
+
+        XMFLOAT4X4 proj;
+        XMStoreFloat4x4(&proj, projection);
+
+        XMFLOAT4 origin;
+        if (proj._34 == 0.0f && proj._44 == 1.0f)
+        {
+            // se: [x (LH Ȃ +Z, RH Ȃ -Z) 
+            XMVECTOR forward = XMVectorSet(0.0f, 0.0f, proj._33 >= 0.0f ? 1.0f : -1.0f, 0.0f);
+            XMStoreFloat4(&origin, XMVector3Normalize(XMVector3TransformNormal(forward, invWorldView)));
+            origin.w = 0.0f;
+        }
+        else
+        {
+            // e: r[Ԃ̌_Jʒu
+            XMStoreFloat4(&origin, XMVector3TransformCoord(g_XMIdentityR3, invWorldView));
+            origin.w = 1.0f;
+        }
+        return origin;
+    }
+
+    // ^C̑傫̎ɎgOp`
+    constexpr uint32_t c_CalibrationTriangles = 4096;
+
+    // [x UAV ̃tH[}bg (D24UnormS8 ͐[xƃXeV 1 uint ɋl߂)
+    DXGI_FORMAT GetDepthTextureFormat(DepthFormat format)
+    {
+        static const DXGI_FORMAT c_DepthFormats[c_DepthFormatCount] = {
+            DXGI_FORMAT_R32_FLOAT,
+            DXGI_FORMAT_R32_UINT,
+            DXGI_FORMAT_R16_UNORM,
+        };
+        return c_DepthFormats[static_cast<uint32_t>(format)];
+    }
+
+    // G-buffer ̃^[Qbg̃tH[}bg (RasterState.h  GBufferTarget ̃Rgƈv邱)
+    DXGI_FORMAT GetGBufferTextureFormat(GBufferTarget target, GBufferFormat format)
+    {
+        static const DXGI_FORMAT c_GBufferFormats[c_GBufferTargetCount][2] = {
+            { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R8G8B8A8_UNORM }, // Albedo
+            { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R16G16_UNORM },   // Normal
+            { DXGI_FORMAT_R32G32_UINT, DXGI_FORMAT_R32_UINT },              // Id
+            { DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R16G16_FLOAT },         // Motion
+        };
+        return c_GBufferFormats[static_cast<uint32_t>(target)][format == GBufferFormat::Packed ? 1 : 0];
+    }
+}
 
 void DirectXTKComputeRasterizer::Initialize(ID3D11Device* device, ID3D11DeviceContext* context, int screenWidth, int screenHeight, DXGI_FORMAT format)
 {
-    OutputDebugStringA("=== DirectXTKComputeRasterizer::Initialize START ===\n");
-    
-    // CommonStates̏
-    commonstate = std::make_unique<DirectX::CommonStates>(device);
+    OutputDebugStringA("=== DirectXTKComputeRasterizer::Initialize START ===\n");
+    
+    // CommonStates̏
+    commonstate = std::make_unique<DirectX::CommonStates>(device);
+
+    // 1. eNX`̍쐬
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = screenWidth;
+    texDesc.Height = screenHeight;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = format;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, &pOutputTexture);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create output texture\n");
+        throw std::runtime_error("Failed to create output texture");
+    }
+    OutputDebugStringA("Output texture created successfully\n");
+
+    // 2. UAV̍쐬
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = texDesc.Format;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
+    uavDesc.Texture2D.MipSlice = 0;
+
+    hr = device->CreateUnorderedAccessView(pOutputTexture.Get(), &uavDesc, &pUAV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create UAV\n");
+        throw std::runtime_error("Failed to create UAV");
+    }
+    OutputDebugStringA("UAV created successfully\n");
+
+    // 3. Constant Buffer̍쐬
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.ByteWidth = sizeof(CBData);
+    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    hr = device->CreateBuffer(&cbDesc, nullptr, &pConstantBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create constant buffer\n");
+        throw std::runtime_error("Failed to create constant buffer");
+    }
+    OutputDebugStringA("Constant buffer created successfully\n");
+
+    // 4. Rs[gVF[_[̃RpCƍ쐬 ( RasterState ̑gݍ킹͎gƂɃRpC)
+    pComputeShader = GetRasterShader(device, RasterState());
+
+    // 5. bVbgJOp̃VF[_[ƃobt@쐬
+    CreateComputeShader(device, L"MeshletCull.hlsl", "CSCullMeshlets", &pCullShader);
+    CreateCullResources(device);
+
+    // 6. eXgp̎Op`쐬
+    CreateTestTriangle(device);
+
+    // 7. tH[obNp̔eNX`쐬
+    CreateFallbackTexture(device);
+
+    // 8. IȃWIg / BVH XVp̃Abv[hO쐬
+    m_uploadRing.Initialize(device);
+
+    // 9. t@XgNAp̃^CƂ̃tO쐬
+    CreateTileClearFlags(device, screenWidth, screenHeight);
+
+    // 10. [xobt@쐬 ( D32Float)
+    SetDepthBuffer(device, m_depthBufferDesc);
+
+    // 11. `̓v ([xvpX̎؂ւp) ̃obt@쐬
+    CreateRasterStatsResources(device);
+
+    // 12. VU[`̒萔obt@ƃ^C̕т쐬
+    CreateScissorResources(device, screenWidth, screenHeight);
+    
+    OutputDebugStringA("=== DirectXTKComputeRasterizer::Initialize END ===\n");
+}
+
+void DirectXTKComputeRasterizer::CreateComputeShader(ID3D11Device* device, const wchar_t* fileName, const char* entryPoint, ID3D11ComputeShader** shader,
+                                                     const D3D_SHADER_MACRO* defines)
+{
+    Microsoft::WRL::ComPtr<ID3DBlob> csBlob;
+    Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+    HRESULT hr = D3DCompileFromFile(
+        fileName,
+        defines,
+        D3D_COMPILE_STANDARD_FILE_INCLUDE,
+        entryPoint,
+        "cs_5_0",
+        D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG,
+        0,
+        &csBlob,
+        &errorBlob
+    );
+
+    if (FAILED(hr))
+    {
+        if (errorBlob)
+        {
+            OutputDebugStringA("Shader compilation failed:\n");
+            OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+        }
+        throw std::runtime_error("Shader compilation failed");
+    }
+    OutputDebugStringA("Shader compiled successfully\n");
+
+    hr = device->CreateComputeShader(
+        csBlob->GetBufferPointer(),
+        csBlob->GetBufferSize(),
+        nullptr,
+        shader
+    );
+
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create compute shader\n");
+        throw std::runtime_error("Failed to create compute shader");
+    }
+    OutputDebugStringA("Compute shader created successfully\n");
+}
+
+ShaderPermutation::ShaderPermutation(const char* entryPoint, uint32_t entryIndex)
+    : m_entryPoint(entryPoint)
+{
+    Define(nullptr, entryIndex, 2);
+}
+
+void ShaderPermutation::Define(const char* name, uint32_t value, uint32_t bits)
+{
+    if ((bits < 32 && value >= (1u << bits)) || m_keyBits + bits > 64)
+    {
+        OutputDebugStringA("Failed to define shader permutation: value does not fit in the key\n");
+        throw std::runtime_error("Failed to define shader permutation: value does not fit in the key");
+    }
+    m_key |= static_cast<uint64_t>(value) << m_keyBits;
+    m_keyBits += bits;
+
+    // OȂ΃L[ (Gg[|Cg̔ԍ)
+    if (name != nullptr)
+    {
+        m_names.push_back(name);
+        m_values.push_back(std::to_string(value));
+    }
+}
+
+const D3D_SHADER_MACRO* ShaderPermutation::GetDefines()
+{
+    m_macros.clear();
+    for (size_t i = 0; i < m_names.size(); ++i)
+    {
+        m_macros.push_back({ m_names[i], m_values[i].c_str() });
+    }
+    m_macros.push_back({ nullptr, nullptr });
+    return m_macros.data();
+}
+
+std::string ShaderPermutation::GetDescription() const
+{
+    std::string description = std::string(m_entryPoint) + " (";
+    for (size_t i = 0; i < m_names.size(); ++i)
+    {
+        description += (i > 0 ? " " : "") + std::string(m_names[i]) + "=" + m_values[i];
+    }
+    return description + ")";
+}
+
+ID3D11ComputeShader* DirectXTKComputeRasterizer::GetPermutationShader(ID3D11Device* device, ShaderPermutation& permutation)
+{
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader>& shader = m_shaderCache[permutation.GetKey()];
+    if (!shader)
+    {
+        const std::string debugMsg = "Compiling " + permutation.GetDescription() + "\n";
+        OutputDebugStringA(debugMsg.c_str());
+
+        CreateComputeShader(device, L"TriangleRasterizer.hlsl", permutation.GetEntryPoint(), shader.ReleaseAndGetAddressOf(), permutation.GetDefines());
+    }
+    return shader.Get();
+}
+
+ID3D11ComputeShader* DirectXTKComputeRasterizer::GetRasterShader(ID3D11Device* device, const RasterState& state, bool depthPrepass, bool variableRate, bool gbuffer,
+                                                                  bool lighting)
+{
+    if (depthPrepass && (!state.depthTest || state.blendMode != BlendMode::Opaque))
+    {
+        OutputDebugStringA("Failed to get raster shader: depth prepass requires depth test and opaque blending\n");
+        throw std::runtime_error("Failed to get raster shader: depth prepass requires depth test and opaque blending");
+    }
+    if (depthPrepass && m_antiAliasMode != AntiAliasMode::Off)
+    {
+        OutputDebugStringA("Failed to get raster shader: depth prepass is not supported with anti-aliasing\n");
+        throw std::runtime_error("Failed to get raster shader: depth prepass is not supported with anti-aliasing");
+    }
+    if (variableRate && (depthPrepass || !CanUseVariableRateShading(state) || m_antiAliasMode != AntiAliasMode::Off))
+    {
+        OutputDebugStringA("Failed to get raster shader: variable-rate shading requires depth test and opaque blending without depth prepass or anti-aliasing\n");
+        throw std::runtime_error("Failed to get raster shader: variable-rate shading requires depth test and opaque blending without depth prepass or anti-aliasing");
+    }
+    if (gbuffer && (!CanWriteGBuffer(state) || m_antiAliasMode != AntiAliasMode::Off))
+    {
+        OutputDebugStringA("Failed to get raster shader: G-buffer requires depth test and opaque blending without anti-aliasing\n");
+        throw std::runtime_error("Failed to get raster shader: G-buffer requires depth test and opaque blending without anti-aliasing");
+    }
+    if (lighting && (!(depthPrepass || variableRate) || gbuffer))
+    {
+        OutputDebugStringA("Failed to get raster shader: tiled lighting requires a depth prepass or variable-rate shading without G-buffer\n");
+        throw std::runtime_error("Failed to get raster shader: tiled lighting requires a depth prepass or variable-rate shading without G-buffer");
+    }
+
+    ShaderPermutation permutation("CSMain", c_ShaderEntryMain);
+    DefineRasterState(permutation, state);
+    DefineTarget(permutation, c_TileSizes[m_tileSizeIndex], m_depthBufferDesc, m_conservativeMode);
+    permutation.Define("RASTER_DEPTH_PREPASS", depthPrepass ? 1 : 0, 1);
+    permutation.Define("RASTER_SAMPLES", GetAntiAliasSampleCount(m_antiAliasMode), 4);
+    permutation.Define("RASTER_VRS", variableRate ? 1 : 0, 1);
+    permutation.Define("RASTER_GBUFFER", gbuffer ? 1 : 0, 1);
+    permutation.Define("RASTER_LIGHTING", lighting ? 1 : 0, 1);
+    return GetPermutationShader(device, permutation);
+}
+
+ID3D11ComputeShader* DirectXTKComputeRasterizer::GetMultiViewShader(ID3D11Device* device, const RasterState& state, uint32_t viewCount)
+{
+    if (viewCount == 0 || viewCount > c_MaxViews)
+    {
+        OutputDebugStringA("Failed to get multi-view shader: view count is out of range\n");
+        throw std::runtime_error("Failed to get multi-view shader: view count is out of range");
+    }
+
+    // GetRasterShader Ɠ}NɁAr[ (MULTI_VIEW_COUNT) 
+    ShaderPermutation permutation("CSMainMultiView", c_ShaderEntryMultiView);
+    DefineRasterState(permutation, state);
+    DefineTarget(permutation, c_TileSizes[m_tileSizeIndex], m_depthBufferDesc, m_conservativeMode);
+    permutation.Define("MULTI_VIEW_COUNT", viewCount, 4);
+    return GetPermutationShader(device, permutation);
+}
+
+void DirectXTKComputeRasterizer::SetMultiView(ID3D11Device* device, FXMMATRIX world, const XMMATRIX* viewProjections, uint32_t viewCount)
+{
+    if (viewCount > c_MaxViews)
+    {
+        OutputDebugStringA("Failed to set multi-view: view count is out of range\n");
+        throw std::runtime_error("Failed to set multi-view: view count is out of range");
+    }
+
+    if (viewCount > 0 && !pMultiViewConstantBuffer)
+    {
+        D3D11_BUFFER_DESC cbDesc = {};
+        cbDesc.ByteWidth = sizeof(MultiViewCBData);
+        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        HRESULT hr = device->CreateBuffer(&cbDesc, nullptr, &pMultiViewConstantBuffer);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create multi-view constant buffer\n");
+            throw std::runtime_error("Failed to create multi-view constant buffer");
+        }
+    }
+
+    // r[ςƂo͐蒼
+    if (viewCount > 0 && viewCount != m_viewCount)
+    {
+        CreateMultiViewTargets(device, viewCount);
+    }
+    m_viewCount = viewCount;
+
+    // HLSL ͗Dœǂނߓ]uĎ
+    for (uint32_t v = 0; v < viewCount; ++v)
+    {
+        XMStoreFloat4x4(&m_viewWorldViewProj[v], XMMatrixTranspose(XMMatrixMultiply(world, viewProjections[v])));
+    }
+}
+
+void DirectXTKComputeRasterizer::CreateMultiViewTargets(ID3D11Device* device, uint32_t viewCount)
+{
+    // F pOutputTextureA[x SetDepthBuffer ƓtH[}bg viewCount XCX̔z
+    D3D11_TEXTURE2D_DESC outputDesc;
+    pOutputTexture->GetDesc(&outputDesc);
+
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = outputDesc.Width;
+    texDesc.Height = outputDesc.Height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = viewCount;
+    texDesc.Format = outputDesc.Format;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, pMultiViewTexture.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create multi-view texture\n");
+        throw std::runtime_error("Failed to create multi-view texture");
+    }
+
+    hr = device->CreateUnorderedAccessView(pMultiViewTexture.Get(), nullptr, pMultiViewUAV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create multi-view UAV\n");
+        throw std::runtime_error("Failed to create multi-view UAV");
+    }
+
+    hr = device->CreateShaderResourceView(pMultiViewTexture.Get(), nullptr, pMultiViewSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create multi-view SRV\n");
+        throw std::runtime_error("Failed to create multi-view SRV");
+    }
+
+    texDesc.Format = GetDepthTextureFormat(m_depthBufferDesc.format);
+
+    hr = device->CreateTexture2D(&texDesc, nullptr, pMultiViewDepthTexture.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create multi-view depth texture\n");
+        throw std::runtime_error("Failed to create multi-view depth texture");
+    }
+
+    hr = device->CreateUnorderedAccessView(pMultiViewDepthTexture.Get(), nullptr, pMultiViewDepthUAV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create multi-view depth UAV\n");
+        throw std::runtime_error("Failed to create multi-view depth UAV");
+    }
+
+    hr = device->CreateShaderResourceView(pMultiViewDepthTexture.Get(), nullptr, pMultiViewDepthSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create multi-view depth SRV\n");
+        throw std::runtime_error("Failed to create multi-view depth SRV");
+    }
+
+    char debugMsg[128];
+    sprintf_s(debugMsg, "Multi-view targets created: %u views\n", viewCount);
+    OutputDebugStringA(debugMsg);
+}
+
+void DirectXTKComputeRasterizer::SetAntiAliasing(ID3D11Device* device, AntiAliasMode mode)
+{
+    if (mode != AntiAliasMode::Off && !pCoveragePixelBuffer)
+    {
+        // sNZƂ̐擪Ǝc̃tOg (ǂ uint2)BTvɈ˂Ȃ傫Ȃ̂1x
+        D3D11_TEXTURE2D_DESC outputDesc;
+        pOutputTexture->GetDesc(&outputDesc);
+        const uint32_t pixelCount = outputDesc.Width * outputDesc.Height;
+        const uint32_t fragmentCapacity = GetCoverageFragmentCapacity(outputDesc.Width, outputDesc.Height);
+
+        CreateCoverageBuffer(device, pixelCount, pCoveragePixelBuffer, pCoveragePixelUAV, pCoveragePixelSRV);
+        CreateCoverageBuffer(device, std::max(fragmentCapacity, 1u), pCoverageFragmentBuffer, pCoverageFragmentUAV, pCoverageFragmentSRV);
+        m_coverageBufferBytes = (static_cast<size_t>(pixelCount) + fragmentCapacity) * sizeof(uint32_t) * 2;
+
+        CreateComputeShader(device, L"TriangleRasterizer.hlsl", "CSResolveCoverage", pResolveCoverageShader.ReleaseAndGetAddressOf());
+
+        char debugMsg[128];
+        sprintf_s(debugMsg, "Coverage buffers created: %u pixels, %u extra fragments (%zu bytes)\n", pixelCount, fragmentCapacity, m_coverageBufferBytes);
+        OutputDebugStringA(debugMsg);
+    }
+    m_antiAliasMode = mode;
+}
+
+void DirectXTKComputeRasterizer::CreateCoverageBuffer(ID3D11Device* device, uint32_t elementCount, Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer,
+                                                      Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>& uav, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+{
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = elementCount * sizeof(uint32_t) * 2;
+    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(uint32_t) * 2;
+
+    HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, buffer.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create coverage buffer\n");
+        throw std::runtime_error("Failed to create coverage buffer");
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = elementCount;
+
+    hr = device->CreateUnorderedAccessView(buffer.Get(), &uavDesc, uav.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create coverage UAV\n");
+        throw std::runtime_error("Failed to create coverage UAV");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = elementCount;
+
+    hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create coverage SRV\n");
+        throw std::runtime_error("Failed to create coverage SRV");
+    }
+}
+
+void DirectXTKComputeRasterizer::SetShadingRateMode(ID3D11Device* device, ShadingRateMode mode)
+{
+    if (mode != ShadingRateMode::Off && !pShadingRateBuffer)
+    {
+        // [g̃^CƂ uint (ShadingRate)Bŏ͑S 1x1
+        D3D11_TEXTURE2D_DESC outputDesc;
+        pOutputTexture->GetDesc(&outputDesc);
+        const uint32_t tileCount = GetShadingRateTileCount(outputDesc.Width, outputDesc.Height);
+        const std::vector<uint32_t> rates(tileCount, static_cast<uint32_t>(ShadingRate::Rate1x1));
+
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = tileCount * sizeof(uint32_t);
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = sizeof(uint32_t);
+
+        D3D11_SUBRESOURCE_DATA initData = {};
+        initData.pSysMem = rates.data();
+
+        HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &pShadingRateBuffer);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create shading rate buffer\n");
+            throw std::runtime_error("Failed to create shading rate buffer");
+        }
+
+        D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+        uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+        uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+        uavDesc.Buffer.NumElements = tileCount;
+
+        hr = device->CreateUnorderedAccessView(pShadingRateBuffer.Get(), &uavDesc, &pShadingRateUAV);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create shading rate UAV\n");
+            throw std::runtime_error("Failed to create shading rate UAV");
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = tileCount;
+
+        hr = device->CreateShaderResourceView(pShadingRateBuffer.Get(), &srvDesc, &pShadingRateSRV);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create shading rate SRV\n");
+            throw std::runtime_error("Failed to create shading rate SRV");
+        }
+
+        // Auto őÕt[̐Fǂ (pOutputTexture  SHADER_RESOURCE łĂ)
+        hr = device->CreateShaderResourceView(pOutputTexture.Get(), nullptr, &pOutputSRV);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create output SRV\n");
+            throw std::runtime_error("Failed to create output SRV");
+        }
+
+        CreateComputeShader(device, L"ShadingRate.hlsl", "CSShadingRateFromColor", pShadingRateShader.ReleaseAndGetAddressOf());
+
+        char debugMsg[128];
+        sprintf_s(debugMsg, "Shading rate buffer created: %u tiles\n", tileCount);
+        OutputDebugStringA(debugMsg);
+    }
+    m_shadingRateMode = mode;
+}
+
+void DirectXTKComputeRasterizer::SetShadingRates(ID3D11DeviceContext* context, const std::vector<ShadingRate>& rates)
+{
+    D3D11_BUFFER_DESC bufferDesc = {};
+    if (pShadingRateBuffer)
+    {
+        pShadingRateBuffer->GetDesc(&bufferDesc);
+    }
+    if (rates.size() * sizeof(uint32_t) != bufferDesc.ByteWidth)
+    {
+        OutputDebugStringA("Failed to set shading rates: call SetShadingRateMode first and pass one rate per shading rate tile\n");
+        throw std::runtime_error("Failed to set shading rates: call SetShadingRateMode first and pass one rate per shading rate tile");
+    }
+
+    std::vector<uint32_t> values(rates.size());
+    for (size_t i = 0; i < rates.size(); ++i)
+    {
+        values[i] = static_cast<uint32_t>(rates[i]);
+    }
+    context->UpdateSubresource(pShadingRateBuffer.Get(), 0, nullptr, values.data(), 0, 0);
+}
+
+ID3D11ComputeShader* DirectXTKComputeRasterizer::GetDepthOnlyShader(ID3D11Device* device, const DepthBufferDesc& desc, CullMode cullMode, ConservativeMode conservativeMode)
+{
+    // [xȂ̂ RASTER_* ̂JO conservative g
+    ShaderPermutation permutation("CSMainDepthOnly", c_ShaderEntryDepthOnly);
+    permutation.Define("RASTER_CULL_MODE", static_cast<uint32_t>(cullMode), 2);
+    DefineTarget(permutation, c_TileSizes[m_tileSizeIndex], desc, conservativeMode);
+    return GetPermutationShader(device, permutation);
+}
+
+void DirectXTKComputeRasterizer::CreateShadowMap(ID3D11Device* device, uint32_t width, uint32_t height, const DepthBufferDesc& desc, ShadowMap& shadowMap)
+{
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = width;
+    texDesc.Height = height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = GetDepthTextureFormat(desc.format);
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, shadowMap.pTexture.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create shadow map texture\n");
+        throw std::runtime_error("Failed to create shadow map texture");
+    }
+
+    hr = device->CreateUnorderedAccessView(shadowMap.pTexture.Get(), nullptr, shadowMap.pUAV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create shadow map UAV\n");
+        throw std::runtime_error("Failed to create shadow map UAV");
+    }
+
+    hr = device->CreateShaderResourceView(shadowMap.pTexture.Get(), nullptr, shadowMap.pSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create shadow map SRV\n");
+        throw std::runtime_error("Failed to create shadow map SRV");
+    }
+
+    shadowMap.width = width;
+    shadowMap.height = height;
+    shadowMap.desc = desc;
+
+    char debugMsg[128];
+    sprintf_s(debugMsg, "Shadow map created: %u x %u, format %u, reversed-Z %u\n",
+              width, height, static_cast<uint32_t>(desc.format), desc.reversedZ ? 1u : 0u);
+    OutputDebugStringA(debugMsg);
+}
+
+void DirectXTKComputeRasterizer::RenderShadowMap(ID3D11Device* device, ID3D11DeviceContext* context, const ShadowMap& shadowMap, FXMMATRIX worldLightViewProj,
+                                                 ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV, uint32_t triangleCount,
+                                                 CullMode cullMode, ConservativeMode conservative)
+{
+    // 萔obt@̓Cg̍sƃVhE}bv̉𑜓xg
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = context->Map(pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to map constant buffer for shadow map\n");
+        throw std::runtime_error("Failed to map constant buffer for shadow map");
+    }
+
+    CBData* cbData = reinterpret_cast<CBData*>(mapped.pData);
+    memset(cbData, 0, sizeof(CBData));
+    cbData->worldViewProj = XMMatrixTranspose(worldLightViewProj);
+    cbData->screenSize = XMFLOAT2(static_cast<float>(shadowMap.width), static_cast<float>(shadowMap.height));
+    cbData->triangleCount = triangleCount;
+    cbData->indexedTriangles = indexBufferSRV != nullptr ? 1 : 0;
+    context->Unmap(pConstantBuffer.Get(), 0);
+
+    context->CSSetConstantBuffers(0, 1, pConstantBuffer.GetAddressOf());
+    context->CSSetShader(GetDepthOnlyShader(device, shadowMap.desc, cullMode, conservative), nullptr, 0);
+    context->CSSetShaderResources(0, 1, &vertexBufferSRV);
+    if (indexBufferSRV != nullptr)
+    {
+        context->CSSetShaderResources(7, 1, &indexBufferSRV);
+    }
+
+    // VhE}bv CSMain ̐[xobt@ƓXbg2 (SsNẐŃNAȂ)
+    ID3D11UnorderedAccessView* shadowUAV = shadowMap.pUAV.Get();
+    context->CSSetUnorderedAccessViews(2, 1, &shadowUAV, nullptr);
+
+    const TileSize& tileSize = c_TileSizes[m_tileSizeIndex];
+    context->Dispatch((shadowMap.width + tileSize.width - 1) / tileSize.width, (shadowMap.height + tileSize.height - 1) / tileSize.height, 1);
+    OutputDebugStringA("Shadow map dispatch completed\n");
+
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    ID3D11Buffer* nullCB = nullptr;
+    context->CSSetUnorderedAccessViews(2, 1, &nullUAV, nullptr);
+    context->CSSetShaderResources(0, 1, &nullSRV);
+    context->CSSetShaderResources(7, 1, &nullSRV);
+    context->CSSetConstantBuffers(0, 1, &nullCB);
+    context->CSSetShader(nullptr, nullptr, 0);
+}
+
+void DirectXTKComputeRasterizer::SetTileSize(uint32_t tileSizeIndex)
+{
+    if (tileSizeIndex >= c_TileSizeCount)
+    {
+        OutputDebugStringA("Failed to set tile size: index is out of range\n");
+        throw std::runtime_error("Failed to set tile size: index is out of range");
+    }
+
+    // NAtO̕т^C̑傫ŕς
+    if (tileSizeIndex != m_tileSizeIndex)
+    {
+        m_tileClearFlagsValid = false;
+    }
+    m_tileSizeIndex = tileSizeIndex;
+}
+
+void DirectXTKComputeRasterizer::SetClearColor(const XMFLOAT4& color)
+{
+    if (memcmp(&color, &m_clearColor, sizeof(color)) != 0)
+    {
+        m_clearColor = color;
+        m_tileClearFlagsValid = false;
+    }
+}
+
+void DirectXTKComputeRasterizer::SetGBuffer(ID3D11Device* device, const GBufferDesc& desc)
+{
+    if (!pGBufferConstantBuffer)
+    {
+        D3D11_BUFFER_DESC cbDesc = {};
+        cbDesc.ByteWidth = sizeof(GBufferCBData);
+        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        HRESULT hr = device->CreateBuffer(&cbDesc, nullptr, &pGBufferConstantBuffer);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create G-buffer constant buffer\n");
+            throw std::runtime_error("Failed to create G-buffer constant buffer");
+        }
+    }
+
+    D3D11_TEXTURE2D_DESC outputDesc;
+    pOutputTexture->GetDesc(&outputDesc);
+
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = outputDesc.Width;
+    texDesc.Height = outputDesc.Height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    for (uint32_t t = 0; t < c_GBufferTargetCount; ++t)
+    {
+        pGBufferTextures[t].Reset();
+        pGBufferUAVs[t].Reset();
+        pGBufferSRVs[t].Reset();
+        if (desc.formats[t] == GBufferFormat::Off) continue;
+
+        texDesc.Format = GetGBufferTextureFormat(static_cast<GBufferTarget>(t), desc.formats[t]);
+
+        HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, &pGBufferTextures[t]);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create G-buffer texture\n");
+            throw std::runtime_error("Failed to create G-buffer texture");
+        }
+
+        hr = device->CreateUnorderedAccessView(pGBufferTextures[t].Get(), nullptr, &pGBufferUAVs[t]);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create G-buffer UAV\n");
+            throw std::runtime_error("Failed to create G-buffer UAV");
+        }
+
+        hr = device->CreateShaderResourceView(pGBufferTextures[t].Get(), nullptr, &pGBufferSRVs[t]);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create G-buffer SRV\n");
+            throw std::runtime_error("Failed to create G-buffer SRV");
+        }
+    }
+
+    // V^[Qbg̒g͕sȂ̂ŁANAꂽ܂܂̃^C
+    m_gbufferDesc = desc;
+    m_tileClearFlagsValid = false;
+
+    char debugMsg[128];
+    sprintf_s(debugMsg, "G-buffer created: %u bytes/pixel\n", GetGBufferBytesPerPixel(desc));
+    OutputDebugStringA(debugMsg);
+}
+
+void DirectXTKComputeRasterizer::CreateVertexNormalBuffer(ID3D11Device* device, const std::vector<XMFLOAT3>& normals, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& normalSRV)
+{
+    if (normals.empty())
+    {
+        normalSRV.Reset();
+        return;
+    }
+
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(XMFLOAT3) * normals.size());
+    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(XMFLOAT3);
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = normals.data();
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &buffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create vertex normal buffer\n");
+        throw std::runtime_error("Failed to create vertex normal buffer");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = static_cast<UINT>(normals.size());
+
+    hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, normalSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create vertex normal SRV\n");
+        throw std::runtime_error("Failed to create vertex normal SRV");
+    }
+}
+
+void DirectXTKComputeRasterizer::SetPreviousTransform(FXMMATRIX world, CXMMATRIX view, CXMMATRIX projection)
+{
+    XMStoreFloat4x4(&m_previousWorldViewProj, XMMatrixMultiply(XMMatrixMultiply(world, view), projection));
+    m_previousTransformValid = true;
+}
+
+void DirectXTKComputeRasterizer::SetLights(ID3D11Device* device, ID3D11DeviceContext* context, const PointLight* lights, uint32_t count)
+{
+    if (!pLightConstantBuffer)
+    {
+        D3D11_BUFFER_DESC cbDesc = {};
+        cbDesc.ByteWidth = sizeof(LightCBData);
+        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        HRESULT hr = device->CreateBuffer(&cbDesc, nullptr, &pLightConstantBuffer);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create light constant buffer\n");
+            throw std::runtime_error("Failed to create light constant buffer");
+        }
+    }
+
+    // t[悤 DYNAMIC ŎAȂȂ 2 {L
+    if (count > m_lightCapacity)
+    {
+        uint32_t capacity = std::max(m_lightCapacity, 64u);
+        while (capacity < count)
+        {
+            capacity *= 2;
+        }
+
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = capacity * sizeof(PointLight);
+        bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+        bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = sizeof(PointLight);
+
+        HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, pLightBuffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create light buffer\n");
+            throw std::runtime_error("Failed to create light buffer");
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = capacity;
+
+        hr = device->CreateShaderResourceView(pLightBuffer.Get(), &srvDesc, pLightSRV.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create light SRV\n");
+            throw std::runtime_error("Failed to create light SRV");
+        }
+        m_lightCapacity = capacity;
+    }
+
+    if (count > 0)
+    {
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        HRESULT hr = context->Map(pLightBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to map light buffer\n");
+            throw std::runtime_error("Failed to map light buffer");
+        }
+        memcpy(mapped.pData, lights, count * sizeof(PointLight));
+        context->Unmap(pLightBuffer.Get(), 0);
+    }
+    m_lightCount = count;
+}
+
+void DirectXTKComputeRasterizer::SetDepthBuffer(ID3D11Device* device, const DepthBufferDesc& desc)
+{
+    D3D11_TEXTURE2D_DESC outputDesc;
+    pOutputTexture->GetDesc(&outputDesc);
+
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = outputDesc.Width;
+    texDesc.Height = outputDesc.Height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = GetDepthTextureFormat(desc.format);
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, pDepthTexture.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create depth texture\n");
+        throw std::runtime_error("Failed to create depth texture");
+    }
+
+    hr = device->CreateUnorderedAccessView(pDepthTexture.Get(), nullptr, pDepthUAV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create depth UAV\n");
+        throw std::runtime_error("Failed to create depth UAV");
+    }
+
+    hr = device->CreateShaderResourceView(pDepthTexture.Get(), nullptr, pDepthSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create depth SRV\n");
+        throw std::runtime_error("Failed to create depth SRV");
+    }
+
+    // V[xobt@̒g͕sȂ̂ŁANAꂽ܂܂̃^C
+    m_depthBufferDesc = desc;
+    m_tileClearFlagsValid = false;
+
+    // }`r[̐[xtH[}bgɂ
+    if (m_viewCount > 0)
+    {
+        CreateMultiViewTargets(device, m_viewCount);
+    }
+
+    char debugMsg[128];
+    sprintf_s(debugMsg, "Depth buffer created: format %u, reversed-Z %u (%u bytes/pixel)\n",
+              static_cast<uint32_t>(desc.format), desc.reversedZ ? 1u : 0u, GetDepthBytesPerPixel(desc.format));
+    OutputDebugStringA(debugMsg);
+}
+
+void DirectXTKComputeRasterizer::CreateRasterStatsResources(ID3D11Device* device)
+{
+    // CSMain  InterlockedAdd ő (Rasterize ̂т 0 ɂ)
+    D3D11_BUFFER_DESC statsDesc = {};
+    statsDesc.ByteWidth = sizeof(RasterStats);
+    statsDesc.Usage = D3D11_USAGE_DEFAULT;
+    statsDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    statsDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_ALLOWS_RAW_VIEWS;
+
+    HRESULT hr = device->CreateBuffer(&statsDesc, nullptr, &pRasterStatsBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create raster stats buffer\n");
+        throw std::runtime_error("Failed to create raster stats buffer");
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = sizeof(RasterStats) / sizeof(uint32_t);
+    uavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
+
+    hr = device->CreateUnorderedAccessView(pRasterStatsBuffer.Get(), &uavDesc, &pRasterStatsUAV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create raster stats UAV\n");
+        throw std::runtime_error("Failed to create raster stats UAV");
+    }
+
+    // v̓ǂݖ߂pXe[WOobt@
+    D3D11_BUFFER_DESC stagingDesc = {};
+    stagingDesc.ByteWidth = sizeof(RasterStats);
+    stagingDesc.Usage = D3D11_USAGE_STAGING;
+    stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+    for (auto& staging : pRasterStatsStaging)
+    {
+        hr = device->CreateBuffer(&stagingDesc, nullptr, &staging);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create raster stats staging buffer\n");
+            throw std::runtime_error("Failed to create raster stats staging buffer");
+        }
+    }
+    OutputDebugStringA("Raster stats resources created successfully\n");
+}
+
+void DirectXTKComputeRasterizer::ReadBackRasterStats(ID3D11DeviceContext* context)
+{
+    if (m_rasterStatsFrame < c_RasterStatsLatency)
+    {
+        return;
+    }
+
+    // łÂRs[ (c_RasterStatsLatency t[O) AGPU ҂ɓǂ߂ꍇ̂ݔf
+    ID3D11Buffer* staging = pRasterStatsStaging[m_rasterStatsFrame % c_RasterStatsLatency].Get();
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (SUCCEEDED(context->Map(staging, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+    {
+        memcpy(&m_rasterStats, mapped.pData, sizeof(RasterStats));
+        context->Unmap(staging, 0);
+
+        char statsMsg[256];
+        sprintf_s(statsMsg, "Depth-pass fragments: %u, shaded fragments: %u, covered pixels: %u (overdraw %.2f)\n",
+                  m_rasterStats.depthPassFragments, m_rasterStats.shadedFragments, m_rasterStats.coveredPixels, GetOverdraw());
+        OutputDebugStringA(statsMsg);
+
+        if (m_variableRateActive)
+        {
+            sprintf_s(statsMsg, "Variable-rate shading: %u shared pixels (%.1f%% of covered pixels not shaded)\n",
+                      m_rasterStats.sharedShadedPixels, GetShadingRateSavings() * 100.0f);
+            OutputDebugStringA(statsMsg);
+        }
+
+        if (m_lightingActive)
+        {
+            sprintf_s(statsMsg, "Tiled lighting: %.1f lights/tile, %u tiles over %u lights\n",
+                      GetAverageTileLights(), m_rasterStats.overflowedLightTiles, c_MaxTileLights);
+            OutputDebugStringA(statsMsg);
+        }
+    }
+}
+
+void DirectXTKComputeRasterizer::CreateTileClearFlags(ID3D11Device* device, int screenWidth, int screenHeight)
+{
+    // ǂ̃^C̑傫ł悤Ał^C̐mۂ
+    uint32_t tileCount = 0;
+    for (const TileSize& tileSize : c_TileSizes)
+    {
+        tileCount = std::max(tileCount, ((screenWidth + tileSize.width - 1) / tileSize.width) * ((screenHeight + tileSize.height - 1) / tileSize.height));
+    }
+
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = tileCount * sizeof(uint32_t);
+    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(uint32_t);
+
+    HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, &pTileClearFlagBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create tile clear flag buffer\n");
+        throw std::runtime_error("Failed to create tile clear flag buffer");
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = tileCount;
+
+    hr = device->CreateUnorderedAccessView(pTileClearFlagBuffer.Get(), &uavDesc, &pTileClearFlagUAV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create tile clear flag UAV\n");
+        throw std::runtime_error("Failed to create tile clear flag UAV");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = tileCount;
+
+    hr = device->CreateShaderResourceView(pTileClearFlagBuffer.Get(), &srvDesc, &pTileClearFlagSRV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create tile clear flag SRV\n");
+        throw std::runtime_error("Failed to create tile clear flag SRV");
+    }
+
+    // o̓eNX`̒g͕sȂ̂ŁAŏ Render őS^C
+    m_tileClearFlagsValid = false;
+    OutputDebugStringA("Tile clear flags created successfully\n");
+}
+
+void DirectXTKComputeRasterizer::CreateScissorResources(ID3D11Device* device, int screenWidth, int screenHeight)
+{
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.ByteWidth = sizeof(ScissorCBData);
+    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    HRESULT hr = device->CreateBuffer(&cbDesc, nullptr, &pScissorConstantBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create scissor constant buffer\n");
+        throw std::runtime_error("Failed to create scissor constant buffer");
+    }
+
+    // ǂ̃^C̑傫ł悤Ał^C̐mۂ (^C̃NAtOƓ)
+    uint32_t tileCount = 0;
+    for (const TileSize& tileSize : c_TileSizes)
+    {
+        tileCount = std::max(tileCount, ((screenWidth + tileSize.width - 1) / tileSize.width) * ((screenHeight + tileSize.height - 1) / tileSize.height));
+    }
+
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = tileCount * sizeof(uint32_t);
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(uint32_t);
+
+    hr = device->CreateBuffer(&bufferDesc, nullptr, &pScissorTileBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create scissor tile buffer\n");
+        throw std::runtime_error("Failed to create scissor tile buffer");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = tileCount;
+
+    hr = device->CreateShaderResourceView(pScissorTileBuffer.Get(), &srvDesc, &pScissorTileSRV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create scissor tile SRV\n");
+        throw std::runtime_error("Failed to create scissor tile SRV");
+    }
+
+    m_scissorTileCapacity = tileCount;
+    m_scissorTiles.reserve(tileCount);
+    OutputDebugStringA("Scissor resources created successfully\n");
+}
+
+void DirectXTKComputeRasterizer::SetScissorRects(const ScissorRect* rects, uint32_t count)
+{
+    if (count > c_MaxScissorRects)
+    {
+        OutputDebugStringA("Failed to set scissor rects: too many rects\n");
+        throw std::runtime_error("Failed to set scissor rects: too many rects");
+    }
+
+    // NAtO͂̂܂܎g (`͂ݏo^ĆAONAĂƂtOc)
+    std::copy(rects, rects + count, m_scissorRects);
+    m_scissorRectCount = count;
+}
+
+// ݂̃^C̑傫ŁAVU[`ƏdȂ^Cׂ b2  t12 ֏ށB߂l̓^C
+uint32_t DirectXTKComputeRasterizer::UpdateScissorTiles(ID3D11DeviceContext* context, int screenWidth, int screenHeight)
+{
+    ScissorRect clipped[c_MaxScissorRects] = {};
+    for (uint32_t r = 0; r < m_scissorRectCount; ++r)
+    {
+        clipped[r] = ClipScissorRect(m_scissorRects[r], screenWidth, screenHeight);
+    }
+
+    const TileSize& tileSize = c_TileSizes[m_tileSizeIndex];
+    const uint32_t tileCountX = (screenWidth + tileSize.width - 1) / tileSize.width;
+    const uint32_t tileCountY = (screenHeight + tileSize.height - 1) / tileSize.height;
+    m_scissorTiles.clear();
+    for (uint32_t ty = 0; ty < tileCountY; ++ty)
+    {
+        const uint32_t top = ty * tileSize.height;
+        const uint32_t bottom = std::min(top + tileSize.height, static_cast<uint32_t>(screenHeight));
+        for (uint32_t tx = 0; tx < tileCountX; ++tx)
+        {
+            const uint32_t left = tx * tileSize.width;
+            const uint32_t right = std::min(left + tileSize.width, static_cast<uint32_t>(screenWidth));
+            for (uint32_t r = 0; r < m_scissorRectCount; ++r)
+            {
+                if (!IsScissorRectEmpty(clipped[r]) && ScissorRectOverlaps(clipped[r], left, top, right, bottom))
+                {
+                    m_scissorTiles.push_back(tx | (ty << 16));
+                    break;
+                }
+            }
+        }
+    }
+    const uint32_t tileCount = static_cast<uint32_t>(m_scissorTiles.size());
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = context->Map(pScissorConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to map scissor constant buffer\n");
+        throw std::runtime_error("Failed to map scissor constant buffer");
+    }
+    ScissorCBData* scissorData = reinterpret_cast<ScissorCBData*>(mapped.pData);
+    *scissorData = ScissorCBData();
+    scissorData->tileCount = tileCount;
+    scissorData->dispatchWidth = std::max(std::min(tileCountX, tileCount), 1u);
+    std::copy(clipped, clipped + m_scissorRectCount, scissorData->rects);
+    context->Unmap(pScissorConstantBuffer.Get(), 0);
+
+    if (tileCount > 0)
+    {
+        hr = context->Map(pScissorTileBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to map scissor tile buffer\n");
+            throw std::runtime_error("Failed to map scissor tile buffer");
+        }
+        memcpy(mapped.pData, m_scissorTiles.data(), tileCount * sizeof(uint32_t));
+        context->Unmap(pScissorTileBuffer.Get(), 0);
+    }
+
+    context->CSSetConstantBuffers(2, 1, pScissorConstantBuffer.GetAddressOf());
+    context->CSSetShaderResources(12, 1, pScissorTileSRV.GetAddressOf());
+    return tileCount;
+}
+
+uint32_t DirectXTKComputeRasterizer::AutoTuneTileSize(ID3D11Device* device, ID3D11DeviceContext* context, int screenWidth, int screenHeight, int iterations)
+{
+    OutputDebugStringA("=== AutoTuneTileSize START ===\n");
+
+    // rp̃V[ (ʑŜɎU΂Op`) ̒_obt@
+    const std::vector<Vertex> vertices = CreateCalibrationScene(c_CalibrationTriangles, static_cast<float>(screenWidth) / screenHeight);
+
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * vertices.size());
+    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(Vertex);
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = vertices.data();
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+    HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &vertexBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create calibration vertex buffer\n");
+        throw std::runtime_error("Failed to create calibration vertex buffer");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = static_cast<UINT>(vertices.size());
+
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> vertexSRV;
+    hr = device->CreateShaderResourceView(vertexBuffer.Get(), &srvDesc, &vertexSRV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create calibration vertex SRV\n");
+        throw std::runtime_error("Failed to create calibration vertex SRV");
+    }
+
+    // ^CX^vNG
+    D3D11_QUERY_DESC disjointDesc = { D3D11_QUERY_TIMESTAMP_DISJOINT, 0 };
+    D3D11_QUERY_DESC timestampDesc = { D3D11_QUERY_TIMESTAMP, 0 };
+    Microsoft::WRL::ComPtr<ID3D11Query> disjointQuery, beginQuery, endQuery;
+    if (FAILED(device->CreateQuery(&disjointDesc, &disjointQuery)) ||
+        FAILED(device->CreateQuery(&timestampDesc, &beginQuery)) ||
+        FAILED(device->CreateQuery(&timestampDesc, &endQuery)))
+    {
+        OutputDebugStringA("Failed to create timestamp queries\n");
+        throw std::runtime_error("Failed to create timestamp queries");
+    }
+
+    // rp̃V[ NDC WȂ̂ŁȀ (PʍsABVH ƃ}eAƃ}`r[ȂAʏ̃X^CY) ŕ`
+    // Ԃ͗OŔꍇ܂߂ăXR[v̏IŖ߂Br̃t[̓v͐[xvpX Auto ȂǂɎgȂ悤̂āA
+    // ǂݖ߂҂̃Rs[r̃t[̂̂Ȃ̂ŁAǂݖ߂͎ Render 琔
+    struct CalibrationState
+    {
+        DirectXTKComputeRasterizer& rasterizer;
+        const XMFLOAT4X4 world, view, projection;
+        const uint32_t bvhNodeCount;
+        const uint32_t materialCount;
+        const RasterState rasterState;
+        const DepthPrepassMode depthPrepassMode;
+        const uint32_t viewCount;
+        const ConservativeMode conservativeMode;
+        const AntiAliasMode antiAliasMode;
+        const ShadingRateMode shadingRateMode;
+        const uint32_t scissorRectCount;
+        const GBufferDesc gbufferDesc;
+        const uint32_t lightCount;
+        const XMFLOAT4X4 previousWorldViewProj;
+        const bool previousTransformValid;
+        const uint32_t tileSizeIndex;
+        const RasterStats rasterStats;
+        const uint64_t rasterStatsFrame;
+        const CullStats cullStats;
+        const uint64_t cullStatsFrame;
+        const uint32_t dispatchedTileCount;
+        const bool depthPrepassActive, variableRateActive, gbufferActive, lightingActive;
+
+        explicit CalibrationState(DirectXTKComputeRasterizer& r)
+            : rasterizer(r), world(r.m_world), view(r.m_view), projection(r.m_projection), bvhNodeCount(r.m_bvhNodeCount),
+              materialCount(r.m_materialCount), rasterState(r.m_rasterState), depthPrepassMode(r.m_depthPrepassMode),
+              viewCount(r.m_viewCount), conservativeMode(r.m_conservativeMode), antiAliasMode(r.m_antiAliasMode),
+              shadingRateMode(r.m_shadingRateMode), scissorRectCount(r.m_scissorRectCount), gbufferDesc(r.m_gbufferDesc),
+              lightCount(r.m_lightCount), previousWorldViewProj(r.m_previousWorldViewProj), previousTransformValid(r.m_previousTransformValid),
+              tileSizeIndex(r.m_tileSizeIndex), rasterStats(r.m_rasterStats), rasterStatsFrame(r.m_rasterStatsFrame),
+              cullStats(r.m_cullStats), cullStatsFrame(r.m_cullStatsFrame), dispatchedTileCount(r.m_dispatchedTileCount),
+              depthPrepassActive(r.m_depthPrepassActive), variableRateActive(r.m_variableRateActive),
+              gbufferActive(r.m_gbufferActive), lightingActive(r.m_lightingActive)
+        {
+            XMStoreFloat4x4(&r.m_world, XMMatrixIdentity());
+            r.m_view = r.m_world;
+            r.m_projection = r.m_world;
+            r.m_bvhNodeCount = 0;
+            r.m_materialCount = 0;
+            r.m_rasterState = RasterState();
+            r.m_depthPrepassMode = DepthPrepassMode::Off;
+            r.m_viewCount = 0;
+            r.m_conservativeMode = ConservativeMode::Off;
+            r.m_antiAliasMode = AntiAliasMode::Off;
+            r.m_shadingRateMode = ShadingRateMode::Off;
+            r.m_scissorRectCount = 0;
+            r.m_gbufferDesc = GBufferDesc();
+            r.m_lightCount = 0;
+        }
+
+        ~CalibrationState()
+        {
+            DirectXTKComputeRasterizer& r = rasterizer;
+            r.m_world = world;
+            r.m_view = view;
+            r.m_projection = projection;
+            r.m_bvhNodeCount = bvhNodeCount;
+            r.m_materialCount = materialCount;
+            r.m_rasterState = rasterState;
+            r.m_depthPrepassMode = depthPrepassMode;
+            r.m_viewCount = viewCount;
+            r.m_conservativeMode = conservativeMode;
+            r.m_antiAliasMode = antiAliasMode;
+            r.m_shadingRateMode = shadingRateMode;
+            r.m_scissorRectCount = scissorRectCount;
+            r.m_gbufferDesc = gbufferDesc;
+            r.m_lightCount = lightCount;
+            r.m_previousWorldViewProj = previousWorldViewProj;
+            r.m_previousTransformValid = previousTransformValid;
+            r.m_tileSizeIndex = tileSizeIndex;
+            r.m_tileClearFlagsValid = false;
+
+            // ߂ Render ̓vƏԂɖ߂ (Xe[WOɎcr̃t[̃Rs[͓ǂ܂Ȃ)
+            r.m_rasterStats = rasterStats;
+            if (r.m_rasterStatsFrame != rasterStatsFrame)
+            {
+                r.m_rasterStatsFrame = 0;
+            }
+            r.m_cullStats = cullStats;
+            if (r.m_cullStatsFrame != cullStatsFrame)
+            {
+                r.m_cullStatsFrame = 0;
+            }
+            r.m_dispatchedTileCount = dispatchedTileCount;
+            r.m_depthPrepassActive = depthPrepassActive;
+            r.m_variableRateActive = variableRateActive;
+            r.m_gbufferActive = gbufferActive;
+            r.m_lightingActive = lightingActive;
+        }
+    };
+
+    const uint32_t triangleCount = static_cast<uint32_t>(vertices.size() / 3);
+    uint32_t bestTileSize = m_tileSizeIndex;
+    double bestSeconds = 1e30;
+    {
+        CalibrationState calibration(*this);
+
+        for (uint32_t tileSize = 0; tileSize < c_TileSizeCount; ++tileSize)
+        {
+            m_tileSizeIndex = tileSize;
+            m_tileClearFlagsValid = false;
+
+            // 1ڂ̓VF[_[̃RpCƃhCȍ܂ނ̂őȂ
+            Rasterize(device, context, vertexSRV.Get(), nullptr, triangleCount, screenWidth, screenHeight);
+
+            double tileSeconds = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                context->Begin(disjointQuery.Get());
+                context->End(beginQuery.Get());
+                Rasterize(device, context, vertexSRV.Get(), nullptr, triangleCount, screenWidth, screenHeight);
+                context->End(endQuery.Get());
+                context->End(disjointQuery.Get());
+
+                D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+                UINT64 begin = 0, end = 0;
+                while (context->GetData(disjointQuery.Get(), &disjoint, sizeof(disjoint), 0) == S_FALSE) SwitchToThread();
+                while (context->GetData(beginQuery.Get(), &begin, sizeof(begin), 0) == S_FALSE) SwitchToThread();
+                while (context->GetData(endQuery.Get(), &end, sizeof(end), 0) == S_FALSE) SwitchToThread();
+
+                // NbNςv͎gȂ
+                if (!disjoint.Disjoint)
+                {
+                    tileSeconds = std::min(tileSeconds, static_cast<double>(end - begin) / static_cast<double>(disjoint.Frequency));
+                }
+            }
+
+            char debugMsg[128];
+            sprintf_s(debugMsg, "Tile %ux%u: %.3f ms\n", c_TileSizes[tileSize].width, c_TileSizes[tileSize].height, tileSeconds * 1000.0);
+            OutputDebugStringA(debugMsg);
+
+            if (tileSeconds < bestSeconds)
+            {
+                bestSeconds = tileSeconds;
+                bestTileSize = tileSize;
+            }
+        }
+    }
+
+    m_tileSizeIndex = bestTileSize;
+    m_tileClearFlagsValid = false;
+
+    char resultMsg[128];
+    sprintf_s(resultMsg, "Selected tile size: %ux%u\n", c_TileSizes[bestTileSize].width, c_TileSizes[bestTileSize].height);
+    OutputDebugStringA(resultMsg);
+    OutputDebugStringA("=== AutoTuneTileSize END ===\n");
+    return bestTileSize;
+}
+
+void DirectXTKComputeRasterizer::CreateCullResources(ID3D11Device* device)
+{
+    // JOʂ̃JE^ (CullMeshlets  UAV Ƃď݁ACSMain  ByteAddressBuffer Ƃēǂ)
+    D3D11_BUFFER_DESC counterDesc = {};
+    counterDesc.ByteWidth = sizeof(CullStats);
+    counterDesc.Usage = D3D11_USAGE_DEFAULT;
+    counterDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    counterDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_ALLOWS_RAW_VIEWS;
+
+    HRESULT hr = device->CreateBuffer(&counterDesc, nullptr, &pCullCounterBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create cull counter buffer\n");
+        throw std::runtime_error("Failed to create cull counter buffer");
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = sizeof(CullStats) / sizeof(uint32_t);
+    uavDesc.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
+
+    hr = device->CreateUnorderedAccessView(pCullCounterBuffer.Get(), &uavDesc, &pCullCounterUAV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create cull counter UAV\n");
+        throw std::runtime_error("Failed to create cull counter UAV");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFEREX;
+    srvDesc.BufferEx.NumElements = sizeof(CullStats) / sizeof(uint32_t);
+    srvDesc.BufferEx.Flags = D3D11_BUFFEREX_SRV_FLAG_RAW;
+
+    hr = device->CreateShaderResourceView(pCullCounterBuffer.Get(), &srvDesc, &pCullCounterSRV);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create cull counter SRV\n");
+        throw std::runtime_error("Failed to create cull counter SRV");
+    }
+
+    // v̓ǂݖ߂pXe[WOobt@
+    D3D11_BUFFER_DESC stagingDesc = {};
+    stagingDesc.ByteWidth = sizeof(CullStats);
+    stagingDesc.Usage = D3D11_USAGE_STAGING;
+    stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+    for (auto& staging : pCullStatsStaging)
+    {
+        hr = device->CreateBuffer(&stagingDesc, nullptr, &staging);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create cull stats staging buffer\n");
+            throw std::runtime_error("Failed to create cull stats staging buffer");
+        }
+    }
+    OutputDebugStringA("Cull resources created successfully\n");
+}
+
+void DirectXTKComputeRasterizer::CreateMeshletBuffer(ID3D11Device* device, const std::vector<Meshlet>& meshlets, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& meshletSRV)
+{
+    if (meshlets.empty())
+    {
+        meshletSRV.Reset();
+        return;
+    }
 
-    // 1. eNX`̍쐬
-    D3D11_TEXTURE2D_DESC texDesc = {};
-    texDesc.Width = screenWidth;
-    texDesc.Height = screenHeight;
-    texDesc.MipLevels = 1;
-    texDesc.ArraySize = 1;
-    texDesc.Format = format;
-    texDesc.SampleDesc.Count = 1;
-    texDesc.Usage = D3D11_USAGE_DEFAULT;
-    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Meshlet) * meshlets.size());
+    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(Meshlet);
 
-    HRESULT hr = device->CreateTexture2D(&texDesc, nullptr, &pOutputTexture);
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = meshlets.data();
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &buffer);
     if (FAILED(hr))
     {
-        OutputDebugStringA("Failed to create output texture\n");
-        throw std::runtime_error("Failed to create output texture");
+        OutputDebugStringA("Failed to create meshlet buffer\n");
+        throw std::runtime_error("Failed to create meshlet buffer");
     }
-    OutputDebugStringA("Output texture created successfully\n");
 
-    // 2. UAV̍쐬
-    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-    uavDesc.Format = texDesc.Format;
-    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
-    uavDesc.Texture2D.MipSlice = 0;
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.FirstElement = 0;
+    srvDesc.Buffer.NumElements = static_cast<UINT>(meshlets.size());
 
-    hr = device->CreateUnorderedAccessView(pOutputTexture.Get(), &uavDesc, &pUAV);
+    hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, meshletSRV.ReleaseAndGetAddressOf());
     if (FAILED(hr))
     {
-        OutputDebugStringA("Failed to create UAV\n");
-        throw std::runtime_error("Failed to create UAV");
+        OutputDebugStringA("Failed to create meshlet SRV\n");
+        throw std::runtime_error("Failed to create meshlet SRV");
     }
-    OutputDebugStringA("UAV created successfully\n");
+}
 
-    // 3. Constant Buffer̍쐬
-    D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.ByteWidth = sizeof(CBData);
-    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+void DirectXTKComputeRasterizer::SetTransform(FXMMATRIX world, CXMMATRIX view, CXMMATRIX projection)
+{
+    XMStoreFloat4x4(&m_world, world);
+    XMStoreFloat4x4(&m_view, view);
+    XMStoreFloat4x4(&m_projection, projection);
+}
 
-    hr = device->CreateBuffer(&cbDesc, nullptr, &pConstantBuffer);
+void DirectXTKComputeRasterizer::CreateBvhBuffers(ID3D11Device* device, const Bvh& bvh,
+                                                  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& nodeSRV,
+                                                  Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& triangleIndexSRV)
+{
+    if (bvh.nodes.empty())
+    {
+        nodeSRV.Reset();
+        triangleIndexSRV.Reset();
+        return;
+    }
+
+    // m[h (RefitBvh  UpdateBvhNodes ōXVł悤 DEFAULT ō쐬)
+    D3D11_BUFFER_DESC nodeDesc = {};
+    nodeDesc.ByteWidth = static_cast<UINT>(sizeof(BvhNode) * bvh.nodes.size());
+    nodeDesc.Usage = D3D11_USAGE_DEFAULT;
+    nodeDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    nodeDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    nodeDesc.StructureByteStride = sizeof(BvhNode);
+
+    D3D11_SUBRESOURCE_DATA nodeData = {};
+    nodeData.pSysMem = bvh.nodes.data();
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> nodeBuffer;
+    HRESULT hr = device->CreateBuffer(&nodeDesc, &nodeData, &nodeBuffer);
     if (FAILED(hr))
     {
-        OutputDebugStringA("Failed to create constant buffer\n");
-        throw std::runtime_error("Failed to create constant buffer");
+        OutputDebugStringA("Failed to create BVH node buffer\n");
+        throw std::runtime_error("Failed to create BVH node buffer");
     }
-    OutputDebugStringA("Constant buffer created successfully\n");
 
-    // 4. Rs[gVF[_[̃RpCƍ쐬
-    Microsoft::WRL::ComPtr<ID3DBlob> csBlob;
-    Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
-    hr = D3DCompileFromFile(
-        L"TriangleRasterizer.hlsl",
-        nullptr,
-        D3D_COMPILE_STANDARD_FILE_INCLUDE,
-        "CSMain",
-        "cs_5_0",
-        D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG,
-        0,
-        &csBlob,
-        &errorBlob
-    );
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = static_cast<UINT>(bvh.nodes.size());
 
+    hr = device->CreateShaderResourceView(nodeBuffer.Get(), &srvDesc, nodeSRV.ReleaseAndGetAddressOf());
     if (FAILED(hr))
     {
-        if (errorBlob)
-        {
-            OutputDebugStringA("Shader compilation failed:\n");
-            OutputDebugStringA((char*)errorBlob->GetBufferPointer());
-        }
-        throw std::runtime_error("Shader compilation failed");
+        OutputDebugStringA("Failed to create BVH node SRV\n");
+        throw std::runtime_error("Failed to create BVH node SRV");
     }
-    OutputDebugStringA("Shader compiled successfully\n");
 
-    hr = device->CreateComputeShader(
-        csBlob->GetBufferPointer(),
-        csBlob->GetBufferSize(),
-        nullptr,
-        &pComputeShader
-    );
+    // [tQƂOp`CfbNX (؍\͕ςȂ̂ IMMUTABLE)
+    D3D11_BUFFER_DESC indexDesc = {};
+    indexDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * bvh.triangleIndices.size());
+    indexDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    indexDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    indexDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    indexDesc.StructureByteStride = sizeof(uint32_t);
+
+    D3D11_SUBRESOURCE_DATA indexData = {};
+    indexData.pSysMem = bvh.triangleIndices.data();
 
+    Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
+    hr = device->CreateBuffer(&indexDesc, &indexData, &indexBuffer);
     if (FAILED(hr))
     {
-        OutputDebugStringA("Failed to create compute shader\n");
-        throw std::runtime_error("Failed to create compute shader");
+        OutputDebugStringA("Failed to create BVH triangle index buffer\n");
+        throw std::runtime_error("Failed to create BVH triangle index buffer");
     }
-    OutputDebugStringA("Compute shader created successfully\n");
 
-    // 5. eXgp̎Op`쐬
-    CreateTestTriangle(device);
+    srvDesc.Buffer.NumElements = static_cast<UINT>(bvh.triangleIndices.size());
+    hr = device->CreateShaderResourceView(indexBuffer.Get(), &srvDesc, triangleIndexSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create BVH triangle index SRV\n");
+        throw std::runtime_error("Failed to create BVH triangle index SRV");
+    }
+}
 
-    // 6. tH[obNp̔eNX`쐬
-    CreateFallbackTexture(device);
-    
-    OutputDebugStringA("=== DirectXTKComputeRasterizer::Initialize END ===\n");
+void DirectXTKComputeRasterizer::UpdateBvhNodes(ID3D11DeviceContext* context, ID3D11ShaderResourceView* nodeSRV, const Bvh& bvh)
+{
+    Microsoft::WRL::ComPtr<ID3D11Resource> nodeResource;
+    nodeSRV->GetResource(&nodeResource);
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> nodeBuffer;
+    nodeResource.As(&nodeBuffer);
+    m_uploadRing.Upload(context, nodeBuffer.Get(), 0, bvh.nodes.data(), static_cast<uint32_t>(sizeof(BvhNode) * bvh.nodes.size()));
+}
+
+void DirectXTKComputeRasterizer::SetBvh(ID3D11ShaderResourceView* nodeSRV, ID3D11ShaderResourceView* triangleIndexSRV, uint32_t nodeCount)
+{
+    pBvhNodeSRV = nodeSRV;
+    pBvhTriangleIndexSRV = triangleIndexSRV;
+    m_bvhNodeCount = (nodeSRV != nullptr && triangleIndexSRV != nullptr) ? nodeCount : 0;
+}
+
+void DirectXTKComputeRasterizer::SetMaterials(const MaterialTable* materials, ID3D11ShaderResourceView* triangleMaterialSRV, uint32_t drawMaterial)
+{
+    if (materials == nullptr)
+    {
+        pMaterialTextureSRV.Reset();
+        pMaterialSRV.Reset();
+        pTriangleMaterialSRV.Reset();
+        m_materialCount = 0;
+        m_drawMaterial = 0;
+        return;
+    }
+
+    pMaterialTextureSRV = materials->GetTextureSRV();
+    pMaterialSRV = materials->GetMaterialSRV();
+    pTriangleMaterialSRV = triangleMaterialSRV;
+    m_materialCount = materials->GetMaterialCount();
+    m_drawMaterial = drawMaterial;
 }
 
 void DirectXTKComputeRasterizer::CreateTestTriangle(ID3D11Device* device)
@@ -112,7 +1641,7 @@ void DirectXTKComputeRasterizer::CreateTestTriangle(ID3D11Device* device)
     
     // eXgp̎Op`f[^iNDCWnŉʒɕ\j
     // 1̎Op` = 3_
-    Vertex triangleVertices[] = {
+    std::vector<Vertex> triangleVertices = {
         // ʒu(x, y, z)                   F(r, g, b, a)              UV(u, v)
         { DirectX::XMFLOAT3(0.0f, 0.5f, 0.5f),   DirectX::XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f), DirectX::XMFLOAT2(0.5f, 0.0f) },  // 
         //  ւiɒ`j
@@ -120,18 +1649,23 @@ void DirectXTKComputeRasterizer::CreateTestTriangle(ID3D11Device* device)
         { DirectX::XMFLOAT3(0.5f, -0.5f, 0.5f),  DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f), DirectX::XMFLOAT2(1.0f, 1.0f) },  // E
     };
 
-    m_testTriangleCount = 1; // 1̎Op`
+    // bVbg̍\z (Op`̕בւN邽߁Aobt@쐬ɍs)
+    std::vector<Meshlet> meshlets = BuildMeshlets(triangleVertices);
+    CreateMeshletBuffer(device, meshlets, pTestMeshletSRV);
+    m_testMeshletCount = static_cast<uint32_t>(meshlets.size());
+
+    m_testTriangleCount = static_cast<uint32_t>(triangleVertices.size() / 3);
 
     // StructuredBuffer̍쐬
     D3D11_BUFFER_DESC bufferDesc = {};
-    bufferDesc.ByteWidth = sizeof(triangleVertices);
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * triangleVertices.size());
     bufferDesc.Usage = D3D11_USAGE_DEFAULT;
     bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
     bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
     bufferDesc.StructureByteStride = sizeof(Vertex);
 
     D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = triangleVertices;
+    initData.pSysMem = triangleVertices.data();
 
     HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &pTestVertexBuffer);
     if (FAILED(hr))
@@ -146,7 +1680,7 @@ void DirectXTKComputeRasterizer::CreateTestTriangle(ID3D11Device* device)
     srvDesc.Format = DXGI_FORMAT_UNKNOWN;
     srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
     srvDesc.Buffer.FirstElement = 0;
-    srvDesc.Buffer.NumElements = 3; // 3_
+    srvDesc.Buffer.NumElements = static_cast<UINT>(triangleVertices.size()); // Op` x 3_
 
     hr = device->CreateShaderResourceView(pTestVertexBuffer.Get(), &srvDesc, &pTestVertexBufferSRV);
     if (FAILED(hr))
@@ -202,23 +1736,208 @@ void DirectXTKComputeRasterizer::CreateFallbackTexture(ID3D11Device* device)
     OutputDebugStringA("=== CreateFallbackTexture END ===\n");
 }
 
-void DirectXTKComputeRasterizer::Render(DX::DeviceResources* DR, ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV, uint32_t triangleCount, int screenWidth, int screenHeight)
+void LoadTextureFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName,
+                     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& textureSRV)
+{
+    const std::wstring extension = std::filesystem::path(fileName).extension().wstring();
+
+    HRESULT hr;
+    if (_wcsicmp(extension.c_str(), L".dds") == 0)
+    {
+        hr = DirectX::CreateDDSTextureFromFile(device, context, fileName, nullptr, textureSRV.ReleaseAndGetAddressOf());
+    }
+    else
+    {
+        hr = DirectX::CreateWICTextureFromFile(device, context, fileName, nullptr, textureSRV.ReleaseAndGetAddressOf());
+    }
+
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to load texture\n");
+        throw std::runtime_error("Failed to load texture");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    textureSRV->GetDesc(&srvDesc);
+
+    char textureMsg[128];
+    sprintf_s(textureMsg, "Texture loaded: %u mip levels\n", srvDesc.Texture2D.MipLevels);
+    OutputDebugStringA(textureMsg);
+}
+
+void DirectXTKComputeRasterizer::LoadBaseTexture(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName)
+{
+    // context nƁA~bvȂ摜 GenerateMips Ń~bv`F[
+    // (CSMain  UV ̔ LOD IԂ̂ŁAk̓~bvȂƃLbV𖳑ʂɂGCAX)
+    LoadTextureFile(device, context, fileName, pBaseTextureSRV);
+}
+
+void DirectXTKComputeRasterizer::CullMeshlets(ID3D11Device* device, ID3D11DeviceContext* context, ID3D11ShaderResourceView* meshletSRV, uint32_t meshletCount)
+{
+    // bVbgXg̗eʂȂ΍蒼
+    if (meshletCount > m_visibleMeshletCapacity)
+    {
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = sizeof(uint32_t) * meshletCount;
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = sizeof(uint32_t);
+
+        HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, pVisibleMeshletBuffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create visible meshlet buffer\n");
+            throw std::runtime_error("Failed to create visible meshlet buffer");
+        }
+
+        D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+        uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+        uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+        uavDesc.Buffer.NumElements = meshletCount;
+
+        hr = device->CreateUnorderedAccessView(pVisibleMeshletBuffer.Get(), &uavDesc, pVisibleMeshletUAV.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create visible meshlet UAV\n");
+            throw std::runtime_error("Failed to create visible meshlet UAV");
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = meshletCount;
+
+        hr = device->CreateShaderResourceView(pVisibleMeshletBuffer.Get(), &srvDesc, pVisibleMeshletSRV.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create visible meshlet SRV\n");
+            throw std::runtime_error("Failed to create visible meshlet SRV");
+        }
+
+        m_visibleMeshletCapacity = meshletCount;
+    }
+
+    // JE^̃NA
+    static const UINT zero[4] = {};
+    context->ClearUnorderedAccessViewUint(pCullCounterUAV.Get(), zero);
+
+    // JOs (萔obt@͌ĂяoŐݒς)
+    ID3D11UnorderedAccessView* uavs[] = { pVisibleMeshletUAV.Get(), pCullCounterUAV.Get() };
+    context->CSSetShader(pCullShader.Get(), nullptr, 0);
+    context->CSSetShaderResources(2, 1, &meshletSRV);
+    context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+
+    context->Dispatch((meshletCount + 63) / 64, 1, 1);
+
+    ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+    context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+
+    // vǂݖ߂pobt@փRs[ (t[ ReadBackCullStats œǂ)
+    context->CopyResource(pCullStatsStaging[m_cullStatsFrame % c_CullStatsLatency].Get(), pCullCounterBuffer.Get());
+    ++m_cullStatsFrame;
+
+    ReadBackCullStats(context);
+}
+
+void DirectXTKComputeRasterizer::ReadBackCullStats(ID3D11DeviceContext* context)
+{
+    if (m_cullStatsFrame < c_CullStatsLatency)
+    {
+        return;
+    }
+
+    // łÂRs[ (c_CullStatsLatency t[O) AGPU ҂ɓǂ߂ꍇ̂ݔf
+    ID3D11Buffer* staging = pCullStatsStaging[m_cullStatsFrame % c_CullStatsLatency].Get();
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (SUCCEEDED(context->Map(staging, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+    {
+        memcpy(&m_cullStats, mapped.pData, sizeof(CullStats));
+        context->Unmap(staging, 0);
+
+        char statsMsg[256];
+        sprintf_s(statsMsg, "Meshlets visible: %u, frustum culled: %u, backface culled: %u, triangles culled: %u\n",
+                  m_cullStats.visibleMeshlets, m_cullStats.frustumCulledMeshlets,
+                  m_cullStats.backfaceCulledMeshlets, m_cullStats.culledTriangles);
+        OutputDebugStringA(statsMsg);
+    }
+}
+
+void DirectXTKComputeRasterizer::Render(DX::DeviceResources* DR, ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV, uint32_t triangleCount, int screenWidth, int screenHeight,
+                                        ID3D11ShaderResourceView* meshletSRV, uint32_t meshletCount)
 {
     OutputDebugStringA("=== Render START ===\n");
     
     auto device = DR->GetD3DDevice();
     auto context = DR->GetD3DDeviceContext();
     auto swapChain = DR->GetSwapChain();
+
+    Rasterize(device, context, vertexBufferSRV, indexBufferSRV, triangleCount, screenWidth, screenHeight, meshletSRV, meshletCount);
+
+    // obNobt@ւ̓] (}`r[̏o͂ GetMultiViewSRV g)
+    if (m_viewCount == 0)
+    {
+        ID3D11Texture2D* pBackBuffer = nullptr;
+        HRESULT hr = swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&pBackBuffer);
+
+        if (SUCCEEDED(hr) && pBackBuffer != nullptr)
+        {
+            OutputDebugStringA("Copying to back buffer...\n");
+            context->CopyResource(pBackBuffer, pOutputTexture.Get());
+            pBackBuffer->Release();
+            OutputDebugStringA("Copy completed\n");
+        }
+        else
+        {
+            OutputDebugStringA("Failed to get back buffer\n");
+        }
+    }
+
+    // ̃t[̃Abv[h߂ (GPU I͈͎͂̃t[ėp)
+    m_uploadRing.EndFrame(context);
+    
+    OutputDebugStringA("=== Render END ===\n");
+}
+
+void DirectXTKComputeRasterizer::Rasterize(ID3D11Device* device, ID3D11DeviceContext* context, ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV,
+                                           uint32_t triangleCount, int screenWidth, int screenHeight, ID3D11ShaderResourceView* meshletSRV, uint32_t meshletCount)
+{
     auto samplerState = commonstate->LinearWrap();
 
     // vertexBufferSRVw肳ĂȂꍇ́AeXgp̎Op`gp
     if (vertexBufferSRV == nullptr && pTestVertexBufferSRV != nullptr)
     {
         vertexBufferSRV = pTestVertexBufferSRV.Get();
+        indexBufferSRV = nullptr;
         triangleCount = m_testTriangleCount;
+        meshletSRV = pTestMeshletSRV.Get();
+        meshletCount = m_testMeshletCount;
         OutputDebugStringA("Using test triangle\n");
     }
 
+    // }`r[͑SOp`er[ŕ] (BVH ƃbVbgJO͎r[̎łgȂ)
+    const bool multiView = m_viewCount > 0;
+    if (meshletSRV == nullptr || m_bvhNodeCount > 0 || multiView)
+    {
+        meshletCount = 0;
+    }
+    const uint32_t bvhNodeCount = multiView ? 0 : m_bvhNodeCount;
+    // JobW}XÑA`GCAX͎r[
+    const bool coverage = !multiView && m_antiAliasMode != AntiAliasMode::Off;
+    // VU[`r[
+    const bool scissor = !multiView && m_scissorRectCount > 0;
+    // G-buffer ͕sŐ[xeXg̎r[ (A`GCAX̊Ԃ͏Ȃ)
+    const bool gbuffer = !multiView && !coverage && IsGBufferEnabled(m_gbufferDesc) && CanWriteGBuffer(m_rasterState);
+    if (gbuffer != m_gbufferActive)
+    {
+        // G-buffer Ȃt[ɃNAꂽ^ĆAG-buffer Â܂܂Ȃ̂ŏ
+        m_tileClearFlagsValid = false;
+        m_gbufferActive = gbuffer;
+    }
+    // ^CPʂ̃CgJOsŐ[xeXg̎r[ (A`GCAX G-buffer ̊Ԃ͏Ƃ炳Ȃ)
+    m_lightingActive = !multiView && !coverage && !gbuffer && m_lightCount > 0 && CanUseTiledLighting(m_rasterState);
+    const XMMATRIX worldViewProj = XMMatrixMultiply(XMMatrixMultiply(XMLoadFloat4x4(&m_world), XMLoadFloat4x4(&m_view)), XMLoadFloat4x4(&m_projection));
+
     // Constant Buffer̍XV
     D3D11_MAPPED_SUBRESOURCE mapped;
     HRESULT hr = context->Map(pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
@@ -226,11 +1945,23 @@ void DirectXTKComputeRasterizer::Render(DX::DeviceResources* DR, ID3D11ShaderRes
     {
         CBData* cbData = reinterpret_cast<CBData*>(mapped.pData);
 
-        // Pʍsݒ (NDCWnŕ`)
-        cbData->worldViewProj = DirectX::XMMatrixIdentity();
+        // SetTransform Őݒ肳ꂽs (͒Pʍs = NDCWnŕ`)
+        XMMATRIX worldView = XMMatrixMultiply(XMLoadFloat4x4(&m_world), XMLoadFloat4x4(&m_view));
+        XMMATRIX projection = XMLoadFloat4x4(&m_projection);
+
+        // HLSL ͗Dœǂނߓ]uēn
+        cbData->worldViewProj = XMMatrixTranspose(XMMatrixMultiply(worldView, projection));
         cbData->screenSize = DirectX::XMFLOAT2(static_cast<float>(screenWidth), static_cast<float>(screenHeight));
         cbData->triangleCount = triangleCount;
-        cbData->padding = 0.0f;
+        cbData->meshletCount = meshletCount;
+        cbData->viewOrigin = ComputeViewOrigin(worldView, projection);
+        cbData->bvhNodeCount = bvhNodeCount;
+        cbData->indexedTriangles = indexBufferSRV != nullptr ? 1 : 0;
+        cbData->materialCount = m_materialCount;
+        cbData->triangleMaterials = pTriangleMaterialSRV ? 1 : 0;
+        cbData->drawMaterial = m_drawMaterial;
+        cbData->scissorRectCount = scissor ? m_scissorRectCount : 0;
+        cbData->clearColor = m_clearColor;
 
         context->Unmap(pConstantBuffer.Get(), 0);
 
@@ -240,9 +1971,112 @@ void DirectXTKComputeRasterizer::Render(DX::DeviceResources* DR, ID3D11ShaderRes
         OutputDebugStringA(debugMsg);
     }
 
-    // Rs[gVF[_[ƃ\[X̐ݒ
-    context->CSSetShader(pComputeShader.Get(), nullptr, 0);
     context->CSSetConstantBuffers(0, 1, pConstantBuffer.GetAddressOf());
+
+    // }`r[̃r[Ƃ̍s
+    if (multiView)
+    {
+        hr = context->Map(pMultiViewConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (SUCCEEDED(hr))
+        {
+            MultiViewCBData* multiViewData = reinterpret_cast<MultiViewCBData*>(mapped.pData);
+            for (uint32_t v = 0; v < m_viewCount; ++v)
+            {
+                multiViewData->worldViewProj[v] = XMLoadFloat4x4(&m_viewWorldViewProj[v]);
+            }
+            context->Unmap(pMultiViewConstantBuffer.Get(), 0);
+        }
+        context->CSSetConstantBuffers(1, 1, pMultiViewConstantBuffer.GetAddressOf());
+    }
+
+    // G-buffer ̑Õt[̍sƖ@̕ϊ
+    if (gbuffer)
+    {
+        hr = context->Map(pGBufferConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (SUCCEEDED(hr))
+        {
+            GBufferCBData* gbufferData = reinterpret_cast<GBufferCBData*>(mapped.pData);
+            gbufferData->previousWorldViewProj = XMMatrixTranspose(m_previousTransformValid ? XMLoadFloat4x4(&m_previousWorldViewProj) : worldViewProj);
+            // @ World ̋t]uŕϊ (HLSL ͓]uēǂނ̂ŋtŝ܂ܓn)
+            gbufferData->normalWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_world));
+            for (uint32_t t = 0; t < c_GBufferTargetCount; ++t)
+            {
+                gbufferData->formats[t] = static_cast<uint32_t>(m_gbufferDesc.formats[t]);
+            }
+            gbufferData->interpolatedNormals = pVertexNormalSRV ? 1 : 0;
+            context->Unmap(pGBufferConstantBuffer.Get(), 0);
+        }
+        context->CSSetConstantBuffers(3, 1, pGBufferConstantBuffer.GetAddressOf());
+        context->CSSetShaderResources(13, 1, pVertexNormalSRV.GetAddressOf());
+    }
+
+    // ^CPʂ̃CgJO̍sƃCg (@ G-buffer Ɠ_Ƃ̖@ t13 ǂ)
+    if (m_lightingActive)
+    {
+        hr = context->Map(pLightConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        if (SUCCEEDED(hr))
+        {
+            LightCBData* lightData = reinterpret_cast<LightCBData*>(mapped.pData);
+            lightData->world = XMMatrixTranspose(XMLoadFloat4x4(&m_world));
+            lightData->normalWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_world));
+            lightData->viewProj = XMMatrixTranspose(XMMatrixMultiply(XMLoadFloat4x4(&m_view), XMLoadFloat4x4(&m_projection)));
+            lightData->ambientColor = m_ambientLight;
+            lightData->lightCount = m_lightCount;
+            lightData->interpolatedNormals = pVertexNormalSRV ? 1 : 0;
+            context->Unmap(pLightConstantBuffer.Get(), 0);
+        }
+        context->CSSetConstantBuffers(4, 1, pLightConstantBuffer.GetAddressOf());
+        context->CSSetShaderResources(13, 1, pVertexNormalSRV.GetAddressOf());
+        context->CSSetShaderResources(14, 1, pLightSRV.GetAddressOf());
+    }
+
+    // bVbgPʂ̃JO ( / @R[)
+    if (meshletCount > 0)
+    {
+        CullMeshlets(device, context, meshletSRV, meshletCount);
+
+        ID3D11ShaderResourceView* meshletSRVs[] = { meshletSRV, pVisibleMeshletSRV.Get(), pCullCounterSRV.Get() };
+        context->CSSetShaderResources(2, 3, meshletSRVs);
+        OutputDebugStringA("Meshlet culling completed\n");
+    }
+
+    // ÓIV[p BVH
+    if (bvhNodeCount > 0)
+    {
+        ID3D11ShaderResourceView* bvhSRVs[] = { pBvhNodeSRV.Get(), pBvhTriangleIndexSRV.Get() };
+        context->CSSetShaderResources(5, 2, bvhSRVs);
+        OutputDebugStringA("BVH SRVs set\n");
+    }
+
+    // σ[gVF[fBO͕sŐ[xeXg̎r[ ([xvpX˂)
+    m_variableRateActive = !multiView && !coverage && m_shadingRateMode != ShadingRateMode::Off && CanUseVariableRateShading(m_rasterState);
+    if (m_variableRateActive && m_shadingRateMode == ShadingRateMode::Auto)
+    {
+        // Õt[̐F烌[g߂ (pOutputTexture  CSMain  UAV oChOɓǂ)
+        ID3D11ShaderResourceView* colorSRV = pOutputSRV.Get();
+        context->CSSetShader(pShadingRateShader.Get(), nullptr, 0);
+        context->CSSetShaderResources(0, 1, &colorSRV);
+        context->CSSetUnorderedAccessViews(0, 1, pShadingRateUAV.GetAddressOf(), nullptr);
+        context->Dispatch((screenWidth + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize, (screenHeight + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize, 1);
+
+        ID3D11ShaderResourceView* nullRateSRV = nullptr;
+        ID3D11UnorderedAccessView* nullRateUAV = nullptr;
+        context->CSSetShaderResources(0, 1, &nullRateSRV);
+        context->CSSetUnorderedAccessViews(0, 1, &nullRateUAV, nullptr);
+        OutputDebugStringA("Shading rates updated\n");
+    }
+    if (m_variableRateActive)
+    {
+        context->CSSetShaderResources(11, 1, pShadingRateSRV.GetAddressOf());
+    }
+
+    // [xvpXg (Auto Ȃǂݖ߂ŐV̏d˕`Ō߂BCgJO̓^C̐[x͈̔͂v̂ŏɎg)
+    m_depthPrepassActive = !multiView && !coverage && !m_variableRateActive
+                        && (m_lightingActive || ShouldUseDepthPrepass(m_depthPrepassMode, m_rasterState, GetOverdraw(), m_depthPrepassActive));
+
+    // Rs[gVF[_[ƃ\[X̐ݒ (SetRasterState ̑gݍ킹ɓꉻ CSMain)
+    context->CSSetShader(multiView ? GetMultiViewShader(device, m_rasterState, m_viewCount)
+                                   : GetRasterShader(device, m_rasterState, m_depthPrepassActive, m_variableRateActive, gbuffer, m_lightingActive), nullptr, 0);
     context->CSSetSamplers(0, 1, &samplerState);
 
     // _obt@̐ݒ
@@ -252,57 +2086,153 @@ void DirectXTKComputeRasterizer::Render(DX::DeviceResources* DR, ID3D11ShaderRes
         OutputDebugStringA("Vertex buffer SRV set\n");
     }
 
-    if (pFallbackTextureSRV)
+    if (indexBufferSRV != nullptr)
+    {
+        context->CSSetShaderResources(7, 1, &indexBufferSRV);
+        OutputDebugStringA("Index buffer SRV set\n");
+    }
+
+    if (pBaseTextureSRV)
+    {
+        ID3D11ShaderResourceView* baseTextureSRV = pBaseTextureSRV.Get();
+        context->CSSetShaderResources(1, 1, &baseTextureSRV);
+        OutputDebugStringA("Base texture SRV set\n");
+    }
+    else if (pFallbackTextureSRV)
     {
         ID3D11ShaderResourceView* baseTextureSRV = pFallbackTextureSRV.Get();
         context->CSSetShaderResources(1, 1, &baseTextureSRV);
         OutputDebugStringA("Fallback texture SRV set\n");
     }
 
-    // UAVXbg0ɐݒ
-    context->CSSetUnorderedAccessViews(0, 1, pUAV.GetAddressOf(), nullptr);
-    OutputDebugStringA("UAV set\n");
+    // }eA (s0  LinearWrap ɉāAMaterialSampler ̎c3)
+    if (m_materialCount > 0)
+    {
+        ID3D11ShaderResourceView* materialSRVs[] = { pTriangleMaterialSRV.Get(), pMaterialSRV.Get(), pMaterialTextureSRV.Get() };
+        context->CSSetShaderResources(8, 3, materialSRVs);
+
+        ID3D11SamplerState* materialSamplers[] = { commonstate->LinearClamp(), commonstate->PointWrap(), commonstate->PointClamp() };
+        context->CSSetSamplers(1, 3, materialSamplers);
+        OutputDebugStringA("Material SRVs set\n");
+    }
+
+    if (multiView)
+    {
+        // r[Ƃ̐FƐ[xXbg45ɐݒ (SsNẐŃNAȂ)
+        ID3D11UnorderedAccessView* multiViewUAVs[] = { pMultiViewUAV.Get(), pMultiViewDepthUAV.Get() };
+        context->CSSetUnorderedAccessViews(4, 2, multiViewUAVs, nullptr);
+        OutputDebugStringA("Multi-view UAVs set\n");
+    }
+    else
+    {
+        // NAJ[^C̑傫ς́AS^C悤tO 0 ɂ
+        static const UINT zero[4] = {};
+        if (!m_tileClearFlagsValid)
+        {
+            context->ClearUnorderedAccessViewUint(pTileClearFlagUAV.Get(), zero);
+            m_tileClearFlagsValid = true;
+        }
+
+        // v͖ 0 琔
+        context->ClearUnorderedAccessViewUint(pRasterStatsUAV.Get(), zero);
+
+        // UAVXbg0ɁANAtOXbg1ɁA[xobt@Xbg2ɁAvXbg3ɐݒ
+        ID3D11UnorderedAccessView* uavs[] = { pUAV.Get(), pTileClearFlagUAV.Get(), pDepthUAV.Get(), pRasterStatsUAV.Get() };
+        context->CSSetUnorderedAccessViews(0, 4, uavs, nullptr);
+        OutputDebugStringA("UAV set\n");
+
+        // kTvXbg67ɐݒ (SsNẐŃNAȂ)
+        if (coverage)
+        {
+            ID3D11UnorderedAccessView* coverageUAVs[] = { pCoveragePixelUAV.Get(), pCoverageFragmentUAV.Get() };
+            context->CSSetUnorderedAccessViews(6, 2, coverageUAVs, nullptr);
+            OutputDebugStringA("Coverage UAVs set\n");
+        }
+
+        // G-buffer ̃^[QbgXbg47ɐݒ (Off ̃^[Qbg nullptr ̂܂܏Ȃ)
+        if (gbuffer)
+        {
+            ID3D11UnorderedAccessView* gbufferUAVs[c_GBufferTargetCount];
+            for (uint32_t t = 0; t < c_GBufferTargetCount; ++t)
+            {
+                gbufferUAVs[t] = pGBufferUAVs[t].Get();
+            }
+            context->CSSetUnorderedAccessViews(4, c_GBufferTargetCount, gbufferUAVs, nullptr);
+            OutputDebugStringA("G-buffer UAVs set\n");
+        }
+    }
+
+    // Dispatchs (1O[v = 1^C)
+    const TileSize& tileSize = c_TileSizes[m_tileSizeIndex];
+    UINT x = (screenWidth + tileSize.width - 1) / tileSize.width;
+    UINT y = (screenHeight + tileSize.height - 1) / tileSize.height;
+    m_dispatchedTileCount = x * y;
 
-    // Dispatchs
-    UINT x = (UINT)ceil(screenWidth / 16.0f);
-    UINT y = (UINT)ceil(screenHeight / 16.0f);
+    // VU[`΁A`ƏdȂ^C x ̍sɋl߂ Dispatch 
+    if (scissor)
+    {
+        m_dispatchedTileCount = UpdateScissorTiles(context, screenWidth, screenHeight);
+        x = std::min(x, m_dispatchedTileCount);
+        y = x > 0 ? (m_dispatchedTileCount + x - 1) / x : 0;
+    }
     
     char dispatchMsg[256];
     sprintf_s(dispatchMsg, "Dispatching: %u x %u thread groups\n", x, y);
     OutputDebugStringA(dispatchMsg);
     
-    context->Dispatch(x, y, 1);
+    if (m_dispatchedTileCount > 0)
+    {
+        context->Dispatch(x, y, 1);
+    }
     OutputDebugStringA("Dispatch completed\n");
 
+    // kTv pOutputTexture ։ (UAV ͂̂܂܁BDispatch ̊Ԃŏ݂͊)
+    if (coverage)
+    {
+        context->CSSetShader(pResolveCoverageShader.Get(), nullptr, 0);
+        context->Dispatch((screenWidth + 7) / 8, (screenHeight + 7) / 8, 1);
+        OutputDebugStringA("Coverage resolve completed\n");
+    }
+
     // UAṼAoCh (dv: CopyResourcȇOɕK{)
-    ID3D11UnorderedAccessView* nullUAV = nullptr;
-    context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+    ID3D11UnorderedAccessView* nullUAVs[8] = {};
+    context->CSSetUnorderedAccessViews(0, 8, nullUAVs, nullptr);
     OutputDebugStringA("UAV unbound\n");
 
-    // obNobt@ւ̓]
-    ID3D11Texture2D* pBackBuffer = nullptr;
-    hr = swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&pBackBuffer);
-
-    if (SUCCEEDED(hr) && pBackBuffer != nullptr)
-    {
-        OutputDebugStringA("Copying to back buffer...\n");
-        context->CopyResource(pBackBuffer, pOutputTexture.Get());
-        pBackBuffer->Release();
-        OutputDebugStringA("Copy completed\n");
-    }
-    else
+    // vǂݖ߂pobt@փRs[ (t[ ReadBackRasterStats œǂ)
+    // ̃t[̓xNǵÃt[̕ϊÕt[ƂĎg
+    if (!multiView)
     {
-        OutputDebugStringA("Failed to get back buffer\n");
+        XMStoreFloat4x4(&m_previousWorldViewProj, worldViewProj);
+        m_previousTransformValid = true;
+
+        context->CopyResource(pRasterStatsStaging[m_rasterStatsFrame % c_RasterStatsLatency].Get(), pRasterStatsBuffer.Get());
+        ++m_rasterStatsFrame;
+        ReadBackRasterStats(context);
     }
 
     // \[X̃N[Abv
     ID3D11ShaderResourceView* nullSRV = nullptr;
     ID3D11Buffer* nullCB = nullptr;
 
+    ID3D11ShaderResourceView* nullMeshletSRVs[3] = {};
+    ID3D11ShaderResourceView* nullBvhSRVs[2] = {};
+    ID3D11ShaderResourceView* nullMaterialSRVs[3] = {};
+
     context->CSSetShaderResources(0, 1, &nullSRV);
     context->CSSetShaderResources(1, 1, &nullSRV);
+    context->CSSetShaderResources(2, 3, nullMeshletSRVs);
+    context->CSSetShaderResources(5, 2, nullBvhSRVs);
+    context->CSSetShaderResources(7, 1, &nullSRV);
+    context->CSSetShaderResources(8, 3, nullMaterialSRVs);
+    context->CSSetShaderResources(11, 1, &nullSRV);
+    context->CSSetShaderResources(12, 1, &nullSRV);
+    context->CSSetShaderResources(13, 1, &nullSRV);
+    context->CSSetShaderResources(14, 1, &nullSRV);
     context->CSSetConstantBuffers(0, 1, &nullCB);
+    context->CSSetConstantBuffers(1, 1, &nullCB);
+    context->CSSetConstantBuffers(2, 1, &nullCB);
+    context->CSSetConstantBuffers(3, 1, &nullCB);
+    context->CSSetConstantBuffers(4, 1, &nullCB);
     context->CSSetShader(nullptr, nullptr, 0);
-    
-    OutputDebugStringA("=== Render END ===\n");
 }
\ No newline at end of file
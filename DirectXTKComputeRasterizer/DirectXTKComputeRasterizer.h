@@ -3,22 +3,106 @@
 #include <DeviceResources.h>
 #include <wrl.h>
 #include <CommonStates.h>
-
-// _\
-struct Vertex {
-    DirectX::XMFLOAT3 pos;
-    DirectX::XMFLOAT4 color;
-    DirectX::XMFLOAT2 uv;
-};
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "UploadRing.h"
+#include "RasterState.h"
+#include "RasterizerTypes.h"
 
 // 萔obt@\ (16byteEɒ)
 struct CBData {
     DirectX::XMMATRIX worldViewProj;
     DirectX::XMFLOAT2 screenSize;
     uint32_t triangleCount;
-    float    padding;
+    uint32_t meshletCount;
+    DirectX::XMFLOAT4 viewOrigin; // [JWł̃Jʒu (w = 0 Ȃ畽se̎)
+    uint32_t bvhNodeCount;        // BVH m[h (0 Ȃ BVH ɂ^CPʂ̃JOgȂ)
+    uint32_t indexedTriangles;    // 1 ȂCfbNXobt@oRŒ_QƂ
+    uint32_t materialCount;       // }eA (0 Ȃ BaseTexture g)
+    uint32_t triangleMaterials;   // 1 ȂOp`Ƃ̃}eA ID QƂ
+    uint32_t drawMaterial;        // triangleMaterials = 0 ̂Ƃ̑SOp`̃}eA
+    uint32_t scissorRectCount;    // VU[`̐ (0 ȂgȂB` ScissorCBData)
+    uint32_t padding[2];
+    DirectX::XMFLOAT4 clearColor; // Op``ȂsNZ̐F
+};
+
+// }`r[̒萔obt@ (b1BTriangleRasterizer.hlsl  MultiViewConstants Ɠ)
+struct MultiViewCBData {
+    DirectX::XMMATRIX worldViewProj[c_MaxViews];
+};
+
+// VU[`̒萔obt@ (b2BTriangleRasterizer.hlsl  ScissorConstants Ɠ)
+struct ScissorCBData {
+    uint32_t tileCount;           // ScissorTiles ̃^C
+    uint32_t dispatchWidth;       // Dispatch  x ̃O[v (O[v (x, y)  y * dispatchWidth + x Ԗڂ̃^C)
+    uint32_t padding[2];
+    ScissorRect rects[c_MaxScissorRects]; // ʓɐ؂l߂`
+};
+
+// G-buffer ̒萔obt@ (b3BTriangleRasterizer.hlsl  GBufferConstants Ɠ)
+struct GBufferCBData {
+    DirectX::XMMATRIX previousWorldViewProj; // Õt[ Local -> Clip s (]uς)
+    DirectX::XMMATRIX normalWorld;           // @ Local -> World s (World ̋t]u]u = World ̋ts)
+    uint32_t formats[c_GBufferTargetCount];  // GBufferTarget ̏ GBufferFormat
+    uint32_t interpolatedNormals;            // 1 Ȃ璸_Ƃ̖@Ԃ (0 Ȃʂ̖@)
+    uint32_t padding[3];
 };
 
+// ^CPʂ̃CgJO̒萔obt@ (b4BTriangleRasterizer.hlsl  LightConstants Ɠ)
+struct LightCBData {
+    DirectX::XMMATRIX world;                 // Local -> World s (]uς)
+    DirectX::XMMATRIX normalWorld;           // @ Local -> World s (GBufferCBData::normalWorld Ɠ)
+    DirectX::XMMATRIX viewProj;              // World -> Clip s (]uς݁B^C̎[hW֖߂)
+    DirectX::XMFLOAT3 ambientColor;
+    uint32_t lightCount;
+    uint32_t interpolatedNormals;            // 1 Ȃ璸_Ƃ̖@Ԃ (0 Ȃʂ̖@)
+    uint32_t padding[3];
+};
+
+// [x`` (CreateShadowMap ōARenderShadowMap ŕ`B𑜓x͉ʂƖ֌W)
+struct ShadowMap {
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> pTexture;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pSRV;   // GetDepthSRV Ɠ D24UnormS8  uint
+    uint32_t width = 0;
+    uint32_t height = 0;
+    DepthBufferDesc desc;
+};
+
+// TriangleRasterizer.hlsl ̃Gg[|Cgƃ}N̑gݍ킹 (VF[_[̃oG[V)
+// Define }N̒l̂܂܃L[̃rbgɋl߂̂ŁARpC}NƃLbV̌ɎgL[͕Kv
+class ShaderPermutation
+{
+public:
+    ShaderPermutation(const char* entryPoint, uint32_t entryIndex);
+
+    // name  value Œ` (value  bits rbgɎ܂邱ƁBL[Ŝ 64bit ܂)
+    void Define(const char* name, uint32_t value, uint32_t bits);
+
+    const char* GetEntryPoint() const { return m_entryPoint; }
+    uint64_t GetKey() const { return m_key; }
+    // D3DCompileFromFile ɓn}N ({ nullptr, nullptr } ŏIB Define ܂ł͗L)
+    const D3D_SHADER_MACRO* GetDefines();
+    // fobOo͗p "CSMain (NAME=value ...)"
+    std::string GetDescription() const;
+
+private:
+    const char* m_entryPoint;
+    uint64_t m_key = 0;
+    uint32_t m_keyBits = 0;
+    std::vector<const char*> m_names;
+    std::vector<std::string> m_values;
+    std::vector<D3D_SHADER_MACRO> m_macros;
+};
+
+struct Bvh;
+class MaterialTable;
+
+// 摜t@Cǂݍ (.dds ̓t@C̃~bvAȊO WIC œǂݍ context  GenerateMips ō)
+void LoadTextureFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName,
+                     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& textureSRV);
+
 class DirectXTKComputeRasterizer
 {
 public:
@@ -27,18 +111,325 @@ public:
     void Initialize(ID3D11Device* device, ID3D11DeviceContext* context, int screenWidth, int screenHeight, DXGI_FORMAT format);
     void CreateTestTriangle(ID3D11Device* device);
     void CreateFallbackTexture(ID3D11Device* device);
+    // 摜t@C BaseTexture Ƃēǂݍ (.dds ̓t@C̃~bvAȊO WIC œǂݍ GenerateMips ō)
+    void LoadBaseTexture(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName);
+    // ȍ~ Render ŎgeNX` (nullptr Ȃ甒̃tH[obNeNX`)
+    void SetBaseTexture(ID3D11ShaderResourceView* textureSRV) { pBaseTextureSRV = textureSRV; }
+    void CreateMeshletBuffer(ID3D11Device* device, const std::vector<Meshlet>& meshlets, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& meshletSRV);
+
+    void SetTransform(DirectX::FXMMATRIX world, DirectX::CXMMATRIX view, DirectX::CXMMATRIX projection);
+
+    // ÓIV[p BVH (BvhBuilder ō\z)  GPU obt@
+    void CreateBvhBuffers(ID3D11Device* device, const Bvh& bvh,
+                          Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& nodeSRV,
+                          Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& triangleIndexSRV);
+    // RefitBvh ̃m[h GPU obt@֔f
+    void UpdateBvhNodes(ID3D11DeviceContext* context, ID3D11ShaderResourceView* nodeSRV, const Bvh& bvh);
+    // ȍ~ Render  BVH ɂ^CPʂ̎Op`Wg (nodeSRV = nullptr Ŗ)
+    // BVH ̓bVbgJOD悳
+    void SetBvh(ID3D11ShaderResourceView* nodeSRV, ID3D11ShaderResourceView* triangleIndexSRV, uint32_t nodeCount);
+
+    // ȍ~ Render Ŏg}eA (materials = nullptr  BaseTexture ɖ߂)
+    // triangleMaterialSRV (MaterialTable::CreateTriangleMaterialBuffer) nƎOp`ƁAnullptr ȂSOp` drawMaterial
+    void SetMaterials(const MaterialTable* materials, ID3D11ShaderResourceView* triangleMaterialSRV = nullptr, uint32_t drawMaterial = 0);
+
+    // ȍ~ Render ŎgpCvC̓ꉻ (eNX`A_J[̂݁AʁAȂ)
+    void SetRasterState(const RasterState& state) { m_rasterState = state; }
+    // state ƌ݂̃^C̑傫A[xobt@AێIX^CYAA`GCAXɓꉻ CSMain (̓RpĈŁA`OɌĂł Render ̒ő҂Ȃ)
+    // depthPrepass  variableRate (σ[gVF[fBO)  state sŐ[xeXĝƂAǂ炩 true ɂł
+    // gbuffer (G-buffer ) sŐ[xeXĝƂŁAA`GCAXƂ͕pȂ
+    // lighting (^CPʂ̃CgJO)  depthPrepass  variableRate ̂ǂ炩Ƒgݍ킹Agbuffer Ƃ͕pȂ
+    ID3D11ComputeShader* GetRasterShader(ID3D11Device* device, const RasterState& state, bool depthPrepass = false, bool variableRate = false, bool gbuffer = false,
+                                         bool lighting = false);
+
+    // ێIX^CY (Off / Overestimate / Underestimate)Bȍ~ Render ƃ}`r[Ɏg
+    // 𑜓x̕` (IN[Wobt@A{NZAՓ˃ObhȂ) 𖈃t[`prz肷
+    void SetConservativeRaster(ConservativeMode mode) { m_conservativeMode = mode; }
+    ConservativeMode GetConservativeRaster() const { return m_conservativeMode; }
+
+    // JobW}XÑA`GCAX (Off / Coverage4x / Coverage8x)Bȍ~ Render ŎgAkTṽobt@
+    // CSMain ͈kTv (GetCoveragePixelSRV / GetCoverageFragmentSRVBт RasterState.h  c_Coverage*) A
+    // CSResolveCoverage  pOutputTexture ։B[xvpXƃt@XgNA͎gȂ (}`r[ł͖)
+    void SetAntiAliasing(ID3D11Device* device, AntiAliasMode mode);
+    AntiAliasMode GetAntiAliasing() const { return m_antiAliasMode; }
+    // kTv (uint2 ̃sNZƂ̐擪ƁAc̃tOg)
+    ID3D11ShaderResourceView* GetCoveragePixelSRV() const { return pCoveragePixelSRV.Get(); }
+    ID3D11ShaderResourceView* GetCoverageFragmentSRV() const { return pCoverageFragmentSRV.Get(); }
+    // kTṽobt@̃oCg (Tv SSAA ̐FƐ[xƂ̔rp)
+    size_t GetCoverageBufferBytes() const { return m_coverageBufferBytes; }
+
+    // σ[gVF[fBO (Off / Explicit / Auto)Bȍ~ Render ŎgA[g̃obt@
+    // sŐ[xeXg RasterState ̎r[Ŏg ([xvpX˂)AA`GCAXƂ͕pȂ
+    // Auto  Render ̍ŏɑÕt[ pOutputTexture  CSShadingRateFromColor Ń[g߂
+    void SetShadingRateMode(ID3D11Device* device, ShadingRateMode mode);
+    ShadingRateMode GetShadingRateMode() const { return m_shadingRateMode; }
+    // Explicit ̃[g (GetShadingRateTileCount(ʂ̕, ) Bт ty * ceil(ʂ̕ / c_ShadingRateTileSize) + tx)
+    void SetShadingRates(ID3D11DeviceContext* context, const std::vector<ShadingRate>& rates);
+    // ߂ Render ŉσ[gVF[fBOg
+    bool IsVariableRateShadingActive() const { return m_variableRateActive; }
+    // ߂ Render ̃[g (uint  ShadingRateBAuto Ȃ炻̃t[Ō߂)
+    ID3D11ShaderResourceView* GetShadingRateSRV() const { return pShadingRateSRV.Get(); }
+    // ǂݖ߂ŐV RasterStats ŁAhꂽsNẐh炸ɍς񂾊
+    float GetShadingRateSavings() const { return m_rasterStats.coveredPixels > 0 ? static_cast<float>(m_rasterStats.sharedShadedPixels) / m_rasterStats.coveredPixels : 0.0f; }
 
-    void Render(DX::DeviceResources* DR, ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV, uint32_t triangleCount, int screenWidth, int screenHeight);
+    // [xvpX (Off / On / Auto)BAuto ͓ǂݖ߂ŐV RasterStats ̏d˕`Ńt[Ƃɐ؂ւ
+    void SetDepthPrepass(DepthPrepassMode mode) { m_depthPrepassMode = mode; }
+    // ߂ Render Ő[xvpXg
+    bool IsDepthPrepassActive() const { return m_depthPrepassActive; }
+
+    // Op``ȂsNZ̐F (ςƎ Render őS^C)
+    void SetClearColor(const DirectX::XMFLOAT4& color);
+    // ^CƂ̃NAtO (uintB1 Ȃ炻̃^C pOutputTexture ̓NAJ[̂܂)
+    // т݂͌̃^C̑傫 ty * ceil(screenWidth / tileWidth) + txB
+    // ǂݖ߂GR[hȂǂ̌íAtO̗^Cǂ܂ɃNAJ[Ŗ߂
+    ID3D11ShaderResourceView* GetTileClearFlagSRV() const { return pTileClearFlagSRV.Get(); }
+
+    // ȍ~ Render ̃VU[` (ő c_MaxScissorRects Bcount = 0 Ŗ)
+    // `ƏdȂ^C Dispatch Aǂ̋`ɂȂsNZ̐FƐ[x͏Ȃ
+    // r[Ŏg (}`r[ƃVhE}bv͑Ŝ`)
+    void SetScissorRects(const ScissorRect* rects, uint32_t count);
+    uint32_t GetScissorRectCount() const { return m_scissorRectCount; }
+    // ߂ Render  Dispatch ^C (VU[`ȂΑS^C)
+    uint32_t GetDispatchedTileCount() const { return m_dispatchedTileCount; }
+
+    // G-buffer: ȍ~ Render ŐFƐ[xɉāAdesc ̊e^[Qbg (AxhA@AOp`ƃ}eA IDAxNg) 𓯂 Dispatch ŏ
+    // ^[QbgƂ Off / Full / Packed I (tH[}bg RasterState.h  GBufferTargetBOff ̃^[Qbg͍炸Ȃ)
+    // sŐ[xeXg RasterState ̎r[ŏ ([x GetDepthSRV)A}`r[ƃA`GCAX̊Ԃ͏Ȃ
+    void SetGBuffer(ID3D11Device* device, const GBufferDesc& desc);
+    const GBufferDesc& GetGBufferDesc() const { return m_gbufferDesc; }
+    // ߂ Render  G-buffer 
+    bool IsGBufferActive() const { return m_gbufferActive; }
+    // ߂ Render  target (Off Ȃ nullptr)
+    ID3D11ShaderResourceView* GetGBufferSRV(GBufferTarget target) const { return pGBufferSRVs[static_cast<uint32_t>(target)].Get(); }
+    // G-buffer ̖@Ɏg_Ƃ̖@ ([JWB_obt@Ɠ)
+    void CreateVertexNormalBuffer(ID3D11Device* device, const std::vector<DirectX::XMFLOAT3>& normals, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& normalSRV);
+    // ȍ~ Render ŕԂ钸_Ƃ̖@ (nullptr ȂJ֌ʂ̖@)
+    void SetVertexNormals(ID3D11ShaderResourceView* normalSRV) { pVertexNormalSRV = normalSRV; }
+    //  Render ̓xNgɎgÕt[̕ϊ (͒O Render  SetTransformBJ̃Jbgł͍̕ϊn)
+    void SetPreviousTransform(DirectX::FXMMATRIX world, DirectX::CXMMATRIX view, DirectX::CXMMATRIX projection);
+
+    // ^CPʂ̃CgJO: ȍ~ Render  lights  count ̓_ ([hW) ŏƂ炷 (count = 0 Ŗ)
+    // [x̃pX̌Ƀ^C (XbhO[v) Ƃ̐[x͈̔͂ƎŃCgIсAhƂ̓^C̃Xg̃Cg𑫂
+    // sŐ[xeXg RasterState ̎r[Ŏg ([xvpXBσ[gVF[fBOȂ炻̐[x̃pX)A
+    // A`GCAX G-buffer ̊Ԃ͏Ƃ炳ȂB@ SetVertexNormals ̒_Ƃ̖@ (Ȃ΃J֌ʂ̖@)
+    void SetLights(ID3D11Device* device, ID3D11DeviceContext* context, const PointLight* lights, uint32_t count);
+    uint32_t GetLightCount() const { return m_lightCount; }
+    // ǂ̃Cg͂Ȃʂ̖邳 (͍)
+    void SetAmbientLight(const DirectX::XMFLOAT3& color) { m_ambientLight = color; }
+    // ߂ Render Ń^CPʂ̃CgJOg
+    bool IsTiledLightingActive() const { return m_lightingActive; }
+    // ǂݖ߂ŐV RasterStats ŁADispatch ^C̃Xg̃Cg
+    float GetAverageTileLights() const { return m_dispatchedTileCount > 0 ? static_cast<float>(m_rasterStats.tileLights) / m_dispatchedTileCount : 0.0f; }
+
+    // [xobt@̃tH[}bg reversed-Z ([xobt@蒼A Render őS^C)
+    // reversed-Z ̂Ƃ SetTransform  near  far ւˉesn
+    void SetDepthBuffer(ID3D11Device* device, const DepthBufferDesc& desc);
+    const DepthBufferDesc& GetDepthBufferDesc() const { return m_depthBufferDesc; }
+    // ߂ Render ̐[x (D32Float / D16Unorm  floatAD24UnormS8  uint ŉ 24bit [x)
+    ID3D11ShaderResourceView* GetDepthSRV() const { return pDepthSRV.Get(); }
+
+    // }`r[: ȍ~ Render  viewProjections  viewCount ̃r[1 Dispatch ŕ` (viewCount = 0 Ŗ)
+    // Op`1xǂ݁Ar[ƂɕϊBo͂̓r[Ƃ̃XCX Texture2DArray (GetMultiViewSRV)
+    // }`r[̊Ԃ BVHAbVbgJOA[xvpXAt@XgNAA`̓vg킸A
+    // pOutputTexture ƃobNobt@ւ̃Rs[XVȂ
+    void SetMultiView(ID3D11Device* device, DirectX::FXMMATRIX world, const DirectX::XMMATRIX* viewProjections, uint32_t viewCount);
+    uint32_t GetViewCount() const { return m_viewCount; }
+    // ߂ Render ̃r[Ƃ̐FƐ[x (XCX = r[B[x̃tH[}bg GetDepthSRV Ɠ)
+    ID3D11ShaderResourceView* GetMultiViewSRV() const { return pMultiViewSRV.Get(); }
+    ID3D11ShaderResourceView* GetMultiViewDepthSRV() const { return pMultiViewDepthSRV.Get(); }
+    // state ƌ݂̃^C̑傫A[xobt@AviewCount ɓꉻ CSMainMultiView
+    ID3D11ComputeShader* GetMultiViewShader(ID3D11Device* device, const RasterState& state, uint32_t viewCount);
+
+    // VhE}bv: width x heightAdesc ̃tH[}bg̐[x̕`
+    void CreateShadowMap(ID3D11Device* device, uint32_t width, uint32_t height, const DepthBufferDesc& desc, ShadowMap& shadowMap);
+    // worldLightViewProj (Local -> Cg Clip sB]uȂ) Ő[x shadowMap ֕`
+    // FAUVAeNX`Ȃ CSMainDepthOnly gBconservative  SetConservativeRaster Ɠ
+    // (BVHAbVbgJOA}eAApOutputTexture Ɛ[xobt@͎gȂ)
+    void RenderShadowMap(ID3D11Device* device, ID3D11DeviceContext* context, const ShadowMap& shadowMap, DirectX::FXMMATRIX worldLightViewProj,
+                         ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV, uint32_t triangleCount,
+                         CullMode cullMode = CullMode::Back, ConservativeMode conservative = ConservativeMode::Off);
+    // desc ̐[x cullModeÃ݂^C̑傫ɓꉻ CSMainDepthOnly
+    ID3D11ComputeShader* GetDepthOnlyShader(ID3D11Device* device, const DepthBufferDesc& desc, CullMode cullMode, ConservativeMode conservativeMode);
+
+    // ȍ~ Render ̃^C (XbhO[v) ̑傫 (c_TileSizes ̔ԍ)
+    void SetTileSize(uint32_t tileSizeIndex);
+    uint32_t GetTileSize() const { return m_tileSizeIndex; }
+    // e^C̑傫Ŋrp̃V[` GPU Ԃ𑪂Aő̂̂ȍ~ Render Ŏg
+    // N (Initialize ̌) 1ĂԁB߂l͑I c_TileSizes ̔ԍ
+    // `̏ԂƓǂݖ߂v͌ĂԑÔ̂ɖ߂ (OŔꍇBr̃t[̓v͎̂Ă)
+    uint32_t AutoTuneTileSize(ID3D11Device* device, ID3D11DeviceContext* context, int screenWidth, int screenHeight, int iterations = 5);
+
+    // indexBufferSRV nꍇ͎Op` t ̒_ indices[t * 3 + k] QƂ (nullptr Ȃ 3_ = 1Op`)
+    // meshletSRV nꍇ́A`OɃbVbgPʂŃJO
+    void Render(DX::DeviceResources* DR, ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV, uint32_t triangleCount, int screenWidth, int screenHeight,
+                ID3D11ShaderResourceView* meshletSRV = nullptr, uint32_t meshletCount = 0);
+    // Render ̂ pOutputTexture ֕`܂ (obNobt@ւ̃Rs[ƃAbv[hO̒߂sȂ)
+    void Rasterize(ID3D11Device* device, ID3D11DeviceContext* context, ID3D11ShaderResourceView* vertexBufferSRV, ID3D11ShaderResourceView* indexBufferSRV,
+                   uint32_t triangleCount, int screenWidth, int screenHeight, ID3D11ShaderResourceView* meshletSRV = nullptr, uint32_t meshletCount = 0);
+
+    // DynamicGeometry Ȃǂ̕XVɎgAbv[hO (Render ̏I[Ńt[߂)
+    UploadRing& GetUploadRing() { return m_uploadRing; }
+
+    // ߂ GPU ǂݖ߂JOv
+    const CullStats& GetCullStats() const { return m_cullStats; }
+    // ߂ GPU ǂݖ߂`̓v (c_RasterStatsLatency t[O)
+    const RasterStats& GetRasterStats() const { return m_rasterStats; }
+    // d˕` ([xeXgʂ / hꂽsNZ)
+    float GetOverdraw() const { return m_rasterStats.coveredPixels > 0 ? static_cast<float>(m_rasterStats.depthPassFragments) / m_rasterStats.coveredPixels : 0.0f; }
    
     Microsoft::WRL::ComPtr<ID3D11Texture2D> pOutputTexture = nullptr;
-    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pComputeShader;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pComputeShader;   //  RasterState  CSMain
     Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pUAV;
     Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
     Microsoft::WRL::ComPtr<ID3D11Buffer> pTestVertexBuffer;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTestVertexBufferSRV;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pFallbackTextureSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pBaseTextureSRV;
     std::unique_ptr<DirectX::CommonStates> commonstate;
-    
+
+    // bVbgJOp
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pCullShader;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTestMeshletSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pVisibleMeshletBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pVisibleMeshletUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pVisibleMeshletSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pCullCounterBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pCullCounterUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pCullCounterSRV;
+
+    // JOv̓ǂݖ߂p (GPU ҂Ȃ悤t[OŎ)
+    static constexpr uint32_t c_CullStatsLatency = 3;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pCullStatsStaging[c_CullStatsLatency];
+    uint64_t m_cullStatsFrame = 0;
+    CullStats m_cullStats = {};
+
+    // ϊs (NX̃ACgɈˑȂ悤 XMFLOAT4X4 ŕێ)
+    DirectX::XMFLOAT4X4 m_world = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    DirectX::XMFLOAT4X4 m_view = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    DirectX::XMFLOAT4X4 m_projection = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+    // SetBvh Őݒ肳ꂽÓIV[p BVH
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pBvhNodeSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pBvhTriangleIndexSRV;
+    uint32_t m_bvhNodeCount = 0;
+
+    // SetMaterials Őݒ肳ꂽ}eA
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pMaterialTextureSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pMaterialSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTriangleMaterialSRV;
+    uint32_t m_materialCount = 0;
+    uint32_t m_drawMaterial = 0;
+
+    // CSMain / CSMainMultiView / CSMainDepthOnly ̃oG[V (ShaderPermutation ̃L[ƁB߂ĎgƂɃRpC)
+    std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<ID3D11ComputeShader>> m_shaderCache;
+    ConservativeMode m_conservativeMode = ConservativeMode::Off;
+    DepthPrepassMode m_depthPrepassMode = DepthPrepassMode::Off;
+    bool m_depthPrepassActive = false;
+
+    // `̓v (CSMain ŏ݁AJOvƓt[xœǂݖ߂)
+    static constexpr uint32_t c_RasterStatsLatency = 3;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pRasterStatsBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pRasterStatsUAV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pRasterStatsStaging[c_RasterStatsLatency];
+    uint64_t m_rasterStatsFrame = 0;
+    RasterStats m_rasterStats = {};
+    RasterState m_rasterState;
+    uint32_t m_tileSizeIndex = c_DefaultTileSize;
+
+    // t@XgNAp̃^CƂ̃tO (ł^C̐mۂ)
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pTileClearFlagBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pTileClearFlagUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTileClearFlagSRV;
+    DirectX::XMFLOAT4 m_clearColor = { 0.1f, 0.1f, 0.15f, 1.0f };
+    bool m_tileClearFlagsValid = false; // false Ȃ玟 Render ̑OɃtO 0 ɂ (S^C)
+
+    // VU[` (`ƏdȂ^C x | y << 16 ̕сBł^C̐mۂ)
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pScissorConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pScissorTileBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pScissorTileSRV;
+    ScissorRect m_scissorRects[c_MaxScissorRects] = {};
+    uint32_t m_scissorRectCount = 0;
+    uint32_t m_scissorTileCapacity = 0;
+    std::vector<uint32_t> m_scissorTiles;
+    uint32_t m_dispatchedTileCount = 0;
+
+    // G-buffer (SetGBuffer ō蒼BOff ̃^[Qbg nullptr)
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pGBufferConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> pGBufferTextures[c_GBufferTargetCount];
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pGBufferUAVs[c_GBufferTargetCount];
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pGBufferSRVs[c_GBufferTargetCount];
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pVertexNormalSRV;
+    GBufferDesc m_gbufferDesc;
+    bool m_gbufferActive = false;
+    DirectX::XMFLOAT4X4 m_previousWorldViewProj = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 }; // ]uȂ Local -> Clip s
+    bool m_previousTransformValid = false; // false ȂÕt[̕ϊƂ݂Ȃ (Ȃ)
+
+    // ^CPʂ̃CgJO (SetLights ŃCgeʂ𒴂蒼)
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pLightConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pLightBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pLightSRV;
+    uint32_t m_lightCapacity = 0;
+    uint32_t m_lightCount = 0;
+    DirectX::XMFLOAT3 m_ambientLight = { 0.0f, 0.0f, 0.0f };
+    bool m_lightingActive = false;
+
+    // [xobt@ (SetDepthBuffer ō蒼)
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> pDepthTexture;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pDepthUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pDepthSRV;
+    DepthBufferDesc m_depthBufferDesc;
+
+    // }`r[ (SetMultiView ō蒼)
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pMultiViewConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> pMultiViewTexture;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pMultiViewUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pMultiViewSRV;
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> pMultiViewDepthTexture;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pMultiViewDepthUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pMultiViewDepthSRV;
+    DirectX::XMFLOAT4X4 m_viewWorldViewProj[c_MaxViews] = {}; // ]uς݂ Local -> Clip s
+    uint32_t m_viewCount = 0;
+
+    // JobW}XÑA`GCAX (SetAntiAliasing ō)
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pResolveCoverageShader;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pCoveragePixelBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pCoveragePixelUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pCoveragePixelSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pCoverageFragmentBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pCoverageFragmentUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pCoverageFragmentSRV;
+    AntiAliasMode m_antiAliasMode = AntiAliasMode::Off;
+    size_t m_coverageBufferBytes = 0;
+
+    // σ[gVF[fBO (SetShadingRateMode ōBpOutputSRV  Auto őÕt[̐Fǂ)
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pShadingRateShader;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pShadingRateBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pShadingRateUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pShadingRateSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pOutputSRV;
+    ShadingRateMode m_shadingRateMode = ShadingRateMode::Off;
+    bool m_variableRateActive = false;
+
+    UploadRing m_uploadRing;
+
     uint32_t m_testTriangleCount = 0;
+    uint32_t m_testMeshletCount = 0;
+    uint32_t m_visibleMeshletCapacity = 0;
+
+private:
+    void CreateComputeShader(ID3D11Device* device, const wchar_t* fileName, const char* entryPoint, ID3D11ComputeShader** shader,
+                             const D3D_SHADER_MACRO* defines = nullptr);
+    ID3D11ComputeShader* GetPermutationShader(ID3D11Device* device, ShaderPermutation& permutation);
+    void CreateCullResources(ID3D11Device* device);
+    void CreateTileClearFlags(ID3D11Device* device, int screenWidth, int screenHeight);
+    void CreateScissorResources(ID3D11Device* device, int screenWidth, int screenHeight);
+    uint32_t UpdateScissorTiles(ID3D11DeviceContext* context, int screenWidth, int screenHeight);
+    void CreateRasterStatsResources(ID3D11Device* device);
+    void CreateMultiViewTargets(ID3D11Device* device, uint32_t viewCount);
+    void CreateCoverageBuffer(ID3D11Device* device, uint32_t elementCount, Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer,
+                              Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>& uav, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv);
+    void ReadBackRasterStats(ID3D11DeviceContext* context);
+    void CullMeshlets(ID3D11Device* device, ID3D11DeviceContext* context, ID3D11ShaderResourceView* meshletSRV, uint32_t meshletCount);
+    void ReadBackCullStats(ID3D11DeviceContext* context);
 };
 
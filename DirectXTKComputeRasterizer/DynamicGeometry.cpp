@@ -0,0 +1,104 @@
+#include "pch.h"
+#include "DynamicGeometry.h"
+
+namespace
+{
+    void CreateStructuredBuffer(ID3D11Device* device, uint32_t stride, uint32_t count, const char* name,
+                                Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+    {
+        char errorMsg[128];
+        // eʂŔ͈͂؂̂ŁA傫 32bit Ɏ܂炸ɏȃobt@ł̂͋Ȃ
+        if (static_cast<uint64_t>(stride) * count > UINT32_MAX)
+        {
+            sprintf_s(errorMsg, "Dynamic %s buffer is too large", name);
+            OutputDebugStringA(errorMsg);
+            OutputDebugStringA("\n");
+            throw std::runtime_error(errorMsg);
+        }
+
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = stride * count;
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = stride;
+
+        HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, buffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            sprintf_s(errorMsg, "Failed to create dynamic %s buffer", name);
+            OutputDebugStringA(errorMsg);
+            OutputDebugStringA("\n");
+            throw std::runtime_error(errorMsg);
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = count;
+
+        hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            sprintf_s(errorMsg, "Failed to create dynamic %s SRV", name);
+            OutputDebugStringA(errorMsg);
+            OutputDebugStringA("\n");
+            throw std::runtime_error(errorMsg);
+        }
+    }
+}
+
+void DynamicGeometry::Initialize(ID3D11Device* device, UploadRing* uploadRing, uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    m_uploadRing = uploadRing;
+    m_vertexCapacity = vertexCapacity;
+    m_indexCapacity = indexCapacity;
+    m_triangleCount = 0;
+
+    // e͎Ȃ (ŏ UpdateVertices / UpdateIndices œ])
+    CreateStructuredBuffer(device, sizeof(Vertex), vertexCapacity, "vertex", pVertexBuffer, pVertexSRV);
+
+    if (indexCapacity > 0)
+    {
+        CreateStructuredBuffer(device, sizeof(uint32_t), indexCapacity, "index", pIndexBuffer, pIndexSRV);
+    }
+    else
+    {
+        pIndexBuffer.Reset();
+        pIndexSRV.Reset();
+    }
+}
+
+void DynamicGeometry::UpdateVertices(ID3D11DeviceContext* context, uint32_t firstVertex, const Vertex* vertices, uint32_t count)
+{
+    if (static_cast<uint64_t>(firstVertex) + count > m_vertexCapacity)
+    {
+        OutputDebugStringA("Dynamic vertex update out of range\n");
+        throw std::runtime_error("Dynamic vertex update out of range");
+    }
+
+    m_uploadRing->Upload(context, pVertexBuffer.Get(), firstVertex * sizeof(Vertex), vertices, count * sizeof(Vertex));
+}
+
+void DynamicGeometry::UpdateIndices(ID3D11DeviceContext* context, uint32_t firstIndex, const uint32_t* indices, uint32_t count)
+{
+    if (static_cast<uint64_t>(firstIndex) + count > m_indexCapacity)
+    {
+        OutputDebugStringA("Dynamic index update out of range\n");
+        throw std::runtime_error("Dynamic index update out of range");
+    }
+
+    m_uploadRing->Upload(context, pIndexBuffer.Get(), firstIndex * sizeof(uint32_t), indices, count * sizeof(uint32_t));
+}
+
+void DynamicGeometry::SetTriangleCount(uint32_t triangleCount)
+{
+    const uint32_t capacity = (m_indexCapacity > 0 ? m_indexCapacity : m_vertexCapacity) / 3;
+    if (triangleCount > capacity)
+    {
+        OutputDebugStringA("Dynamic triangle count exceeds capacity\n");
+        throw std::runtime_error("Dynamic triangle count exceeds capacity");
+    }
+
+    m_triangleCount = triangleCount;
+}
\ No newline at end of file
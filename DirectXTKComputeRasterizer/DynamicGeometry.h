@@ -0,0 +1,37 @@
+#pragma once
+#include "DirectXTKComputeRasterizer.h"
+#include "UploadRing.h"
+
+// ==================================================================================
+// t[钸_ / CfbNXobt@
+// GPU  DEFAULT ̍\obt@ŁARender ɂ̂܂ܓn SRV B
+// XV͔͈͒Pʂ UploadRing oRōŝŁAω_]łB
+// CPU  (SoftwareRasterizer p)  SoftwareDynamicGeometryB
+// ==================================================================================
+class DynamicGeometry
+{
+public:
+    // indexCapacity  0 ȂCfbNX` (3_ = 1Op`)
+    void Initialize(ID3D11Device* device, UploadRing* uploadRing, uint32_t vertexCapacity, uint32_t indexCapacity = 0);
+
+    // vertices[0 .. count)  firstVertex ȍ~
+    void UpdateVertices(ID3D11DeviceContext* context, uint32_t firstVertex, const Vertex* vertices, uint32_t count);
+    void UpdateIndices(ID3D11DeviceContext* context, uint32_t firstIndex, const uint32_t* indices, uint32_t count);
+
+    // `悷Op`̐ (eʂ͈͓̔ŕς)
+    void SetTriangleCount(uint32_t triangleCount);
+
+    ID3D11ShaderResourceView* GetVertexSRV() const { return pVertexSRV.Get(); }
+    ID3D11ShaderResourceView* GetIndexSRV() const { return pIndexSRV.Get(); }
+    uint32_t GetTriangleCount() const { return m_triangleCount; }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pVertexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pVertexSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pIndexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pIndexSRV;
+    UploadRing* m_uploadRing = nullptr;
+    uint32_t m_vertexCapacity = 0;
+    uint32_t m_indexCapacity = 0;
+    uint32_t m_triangleCount = 0;
+};
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "pch.h"
 #include "Game.h"
+#include <chrono>
 
 extern void ExitGame() noexcept;
 
@@ -77,13 +78,16 @@ void Game::Render()
     m_deviceResources->PIXBeginEvent(L"Render");
 
     // eXgp̎Op`` (nullptrnƎIɃeXgOp`g)
+    // SetMeshFile ŃbVw肳Ă΂`悷
     m_rasterizer->Render(
         m_deviceResources.get(), 
-        nullptr,  // nullptrnƃeXgOp`g
-        nullptr, 
-        0,  // 0nƃeXgOp`̐g
+        m_mesh.vertexSRV.Get(),  // nullptrnƃeXgOp`g
+        m_mesh.indexSRV.Get(), 
+        m_mesh.triangleCount,  // 0nƃeXgOp`̐g
         static_cast<int>(m_deviceResources->GetScreenViewport().Width),
-        static_cast<int>(m_deviceResources->GetScreenViewport().Height)
+        static_cast<int>(m_deviceResources->GetScreenViewport().Height),
+        m_mesh.meshletSRV.Get(),
+        m_mesh.meshletCount
     );
     
     m_deviceResources->PIXEndEvent();
@@ -192,6 +196,64 @@ void Game::CreateDeviceDependentResources()
         height,
         backBufferFormat // ɒǉ
     );
+
+    // reversed-Z (ˉes LoadMesh  near  far ւč)
+    DepthBufferDesc depthDesc;
+    depthDesc.reversedZ = true;
+    m_rasterizer->SetDepthBuffer(device, depthDesc);
+
+    // d˕`t[[xvpXg
+    m_rasterizer->SetDepthPrepass(DepthPrepassMode::Auto);
+
+    // ̃}VƉ𑜓xōő̃^C (XbhO[v) ̑傫I
+    m_rasterizer->AutoTuneTileSize(device, context, width, height);
+
+    if (!m_meshFileName.empty())
+    {
+        LoadMesh();
+    }
+
+    if (!m_textureFileName.empty())
+    {
+        m_rasterizer->LoadBaseTexture(device, context, m_textureFileName.c_str());
+    }
+}
+
+// SetMeshFile Ŏw肳ꂽ .dxrmesh }bvŊJAGPU obt@֓]
+void Game::LoadMesh()
+{
+    auto device = m_deviceResources->GetD3DDevice();
+    auto context = m_deviceResources->GetD3DDeviceContext();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    MeshFile file;
+    file.Open(m_meshFileName.c_str());
+    CreateMeshBuffers(device, context, file, m_mesh);
+
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    char loadMsg[256];
+    sprintf_s(loadMsg, "Mesh file: %.1f MB in %.3f ms (%.1f MB/s)\n",
+              file.GetFileSize() / (1024.0 * 1024.0), seconds * 1000.0, file.GetFileSize() / (1024.0 * 1024.0) / std::max(seconds, 1e-9));
+    OutputDebugStringA(loadMsg);
+
+    m_rasterizer->SetBvh(m_mesh.bvhNodeSRV.Get(), m_mesh.bvhTriangleIndexSRV.Get(), m_mesh.bvhNodeCount);
+
+    // bVŜʂɎ܂悤ɁAAABB ͂ދ΂ߑO猩Ju (OBJ ƓEn)
+    const MeshFileHeader& header = file.GetHeader();
+    XMVECTOR boundsMin = XMLoadFloat3(&header.boundsMin);
+    XMVECTOR boundsMax = XMLoadFloat3(&header.boundsMax);
+    XMVECTOR center = XMVectorScale(XMVectorAdd(boundsMin, boundsMax), 0.5f);
+    float radius = std::max(XMVectorGetX(XMVector3Length(XMVectorSubtract(boundsMax, center))), 1e-3f);
+
+    XMVECTOR eye = XMVectorAdd(center, XMVectorScale(XMVector3Normalize(XMVectorSet(0.5f, 0.5f, 1.0f, 0.0f)), radius * 2.5f));
+    XMMATRIX view = XMMatrixLookAtRH(eye, center, g_XMIdentityR1);
+
+    const auto viewport = m_deviceResources->GetScreenViewport();
+    // reversed-Z Ȃ̂ near  far ւ (O = 1A = 0)
+    XMMATRIX projection = XMMatrixPerspectiveFovRH(XMConvertToRadians(60.0f), viewport.Width / viewport.Height, radius * 10.0f, radius * 0.1f);
+
+    m_rasterizer->SetTransform(XMMatrixIdentity(), view, projection);
 }
 
 // Allocate all memory resources that change on a window SizeChanged event.
@@ -7,7 +7,9 @@
 #include "DeviceResources.h"
 #include "StepTimer.h"
 #include "DirectXTKComputeRasterizer.h"
+#include "MeshFile.h"
 #include <memory>
+#include <string>
 
 
 // A basic game implementation that creates a D3D11 device and
@@ -28,6 +30,11 @@ public:
     // Initialization and management
     void Initialize(HWND window, int width, int height);
 
+    // Initialize OɌĂԂƁAeXgOp`̑ .dxrmesh ǂݍŕ`悷
+    void SetMeshFile(const wchar_t* fileName) { m_meshFileName = fileName; }
+    // Initialize OɌĂԂƁÃtH[obN̑ɉ摜t@C BaseTexture ƂĎg
+    void SetTextureFile(const wchar_t* fileName) { m_textureFileName = fileName; }
+
     // Basic game loop
     void Tick();
 
@@ -56,10 +63,17 @@ private:
 
     void CreateDeviceDependentResources();
     void CreateWindowSizeDependentResources();
+    void LoadMesh();
 
     // Device resources.
     std::unique_ptr<DX::DeviceResources>    m_deviceResources;
 	std::unique_ptr<DirectXTKComputeRasterizer> m_rasterizer;
+
+    // SetMeshFile Ŏw肳ꂽbV
+    std::wstring                            m_meshFileName;
+    MeshBuffers                             m_mesh;
+    // SetTextureFile Ŏw肳ꂽeNX`
+    std::wstring                            m_textureFileName;
     // Rendering loop timer.
     DX::StepTimer                           m_timer;
 };
@@ -4,6 +4,7 @@
 
 #include "pch.h"
 #include "Game.h"
+#include <shellapi.h>
 
 using namespace DirectX;
 
@@ -35,7 +36,6 @@ extern "C"
 int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow)
 {
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
 
     if (!XMVerifyCPUSupport())
         return 1;
@@ -46,6 +46,22 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     g_game = std::make_unique<Game>();
 
+    // R}hC: [mesh.dxrmesh [texture]]
+    // .dxrmesh w肳Ă΃eXgOp`̑ɕ`悵A摜w肳Ă BaseTexture ƂĎg
+    if (lpCmdLine != nullptr && *lpCmdLine != L'\0')
+    {
+        int argCount = 0;
+        LPWSTR* args = CommandLineToArgvW(lpCmdLine, &argCount);
+        if (args != nullptr)
+        {
+            if (argCount >= 1)
+                g_game->SetMeshFile(args[0]);
+            if (argCount >= 2)
+                g_game->SetTextureFile(args[1]);
+            LocalFree(args);
+        }
+    }
+
     // Register class and create window
     {
         // Register class
@@ -0,0 +1,352 @@
+#include "pch.h"
+#include "MaterialTable.h"
+#include <numeric>
+
+namespace
+{
+    bool IsBlockCompressed(DXGI_FORMAT format)
+    {
+        return (format >= DXGI_FORMAT_BC1_TYPELESS && format <= DXGI_FORMAT_BC5_SNORM) ||
+               (format >= DXGI_FORMAT_BC6H_TYPELESS && format <= DXGI_FORMAT_BC7_UNORM_SRGB);
+    }
+
+    uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void CreateImmutableStructuredBuffer(ID3D11Device* device, uint32_t stride, uint32_t count, const void* data, const char* name,
+                                         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+    {
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = stride * count;
+        bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+        bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = stride;
+
+        D3D11_SUBRESOURCE_DATA initData = {};
+        initData.pSysMem = data;
+
+        char errorMsg[128];
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+        HRESULT hr = device->CreateBuffer(&bufferDesc, &initData, &buffer);
+        if (FAILED(hr))
+        {
+            sprintf_s(errorMsg, "Failed to create %s buffer", name);
+            OutputDebugStringA(errorMsg);
+            OutputDebugStringA("\n");
+            throw std::runtime_error(errorMsg);
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = count;
+
+        hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            sprintf_s(errorMsg, "Failed to create %s SRV", name);
+            OutputDebugStringA(errorMsg);
+            OutputDebugStringA("\n");
+            throw std::runtime_error(errorMsg);
+        }
+    }
+}
+
+uint32_t MaterialTable::AddTexture(ID3D11ShaderResourceView* textureSRV)
+{
+    Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+    textureSRV->GetResource(&resource);
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+    if (FAILED(resource.As(&texture)))
+    {
+        OutputDebugStringA("Failed to add material texture: not a 2D texture\n");
+        throw std::runtime_error("Failed to add material texture: not a 2D texture");
+    }
+
+    m_textures.push_back(texture);
+    return static_cast<uint32_t>(m_textures.size() - 1);
+}
+
+uint32_t MaterialTable::AddTextureFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName)
+{
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> textureSRV;
+    LoadTextureFile(device, context, fileName, textureSRV);
+    return AddTexture(textureSRV.Get());
+}
+
+uint32_t MaterialTable::AddMaterial(const MaterialDesc& desc)
+{
+    m_materials.push_back(desc);
+    return static_cast<uint32_t>(m_materials.size() - 1);
+}
+
+void MaterialTable::Build(ID3D11Device* device, ID3D11DeviceContext* context, MaterialTextureLayout layout)
+{
+    OutputDebugStringA("=== MaterialTable::Build START ===\n");
+
+    if (m_materials.empty())
+    {
+        OutputDebugStringA("Failed to build material table: no materials\n");
+        throw std::runtime_error("Failed to build material table: no materials");
+    }
+
+    m_placements.clear();
+    pTextureSRV.Reset();
+    m_atlas = layout == MaterialTextureLayout::Atlas;
+
+    if (!m_textures.empty())
+    {
+        // CopySubresourceRegion ł܂Ƃ߂̂ŁAtH[}bg͑SeNX`œłȂ΂ȂȂ
+        D3D11_TEXTURE2D_DESC desc;
+        m_textures[0]->GetDesc(&desc);
+        uint32_t mipLevels = desc.MipLevels;
+        for (const auto& texture : m_textures)
+        {
+            D3D11_TEXTURE2D_DESC textureDesc;
+            texture->GetDesc(&textureDesc);
+            if (textureDesc.Format != desc.Format)
+            {
+                OutputDebugStringA("Failed to build material table: texture formats differ\n");
+                throw std::runtime_error("Failed to build material table: texture formats differ");
+            }
+            mipLevels = std::min(mipLevels, textureDesc.MipLevels);
+        }
+
+        if (m_atlas)
+        {
+            BuildAtlas(device, context, desc, std::min(mipLevels, c_AtlasMaxMipLevels));
+        }
+        else
+        {
+            BuildArray(device, context, desc, mipLevels);
+        }
+    }
+
+    // GPU p̃}eA
+    std::vector<Material> materials;
+    materials.reserve(m_materials.size());
+    for (const MaterialDesc& desc : m_materials)
+    {
+        Material material = {};
+        material.tint = desc.tint;
+        material.uvTransform = DirectX::XMFLOAT4(1.0f, 1.0f, 0.0f, 0.0f);
+        material.textureIndex = c_MaterialNoTexture;
+        material.sampler = static_cast<uint32_t>(desc.sampler);
+
+        if (desc.textureIndex != c_MaterialNoTexture)
+        {
+            if (desc.textureIndex >= m_placements.size())
+            {
+                OutputDebugStringA("Failed to build material table: texture index out of range\n");
+                throw std::runtime_error("Failed to build material table: texture index out of range");
+            }
+
+            const TexturePlacement& placement = m_placements[desc.textureIndex];
+            material.textureIndex = placement.slice;
+            if (m_atlas)
+            {
+                const float invWidth = 1.0f / m_textureWidth;
+                const float invHeight = 1.0f / m_textureHeight;
+                material.uvTransform = DirectX::XMFLOAT4(placement.width * invWidth, placement.height * invHeight,
+                                                         placement.x * invWidth, placement.y * invHeight);
+                material.atlas = 1;
+            }
+        }
+        materials.push_back(material);
+    }
+
+    CreateImmutableStructuredBuffer(device, sizeof(Material), static_cast<uint32_t>(materials.size()), materials.data(),
+                                    "material", pMaterialSRV);
+
+    char buildMsg[160];
+    sprintf_s(buildMsg, "Material table built: %zu materials, %zu textures (%s %u x %u)\n",
+              m_materials.size(), m_textures.size(), m_atlas ? "atlas" : "array", m_textureWidth, m_textureHeight);
+    OutputDebugStringA(buildMsg);
+    OutputDebugStringA("=== MaterialTable::Build END ===\n");
+}
+
+void MaterialTable::BuildArray(ID3D11Device* device, ID3D11DeviceContext* context, const D3D11_TEXTURE2D_DESC& desc, uint32_t mipLevels)
+{
+    for (const auto& texture : m_textures)
+    {
+        D3D11_TEXTURE2D_DESC textureDesc;
+        texture->GetDesc(&textureDesc);
+        if (textureDesc.Width != desc.Width || textureDesc.Height != desc.Height)
+        {
+            OutputDebugStringA("Failed to build material texture array: texture sizes differ (use MaterialTextureLayout::Atlas)\n");
+            throw std::runtime_error("Failed to build material texture array: texture sizes differ");
+        }
+    }
+
+    D3D11_TEXTURE2D_DESC arrayDesc = {};
+    arrayDesc.Width = desc.Width;
+    arrayDesc.Height = desc.Height;
+    arrayDesc.MipLevels = mipLevels;
+    arrayDesc.ArraySize = static_cast<UINT>(m_textures.size());
+    arrayDesc.Format = desc.Format;
+    arrayDesc.SampleDesc.Count = 1;
+    arrayDesc.Usage = D3D11_USAGE_DEFAULT;
+    arrayDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> textureArray;
+    HRESULT hr = device->CreateTexture2D(&arrayDesc, nullptr, &textureArray);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create material texture array\n");
+        throw std::runtime_error("Failed to create material texture array");
+    }
+
+    for (uint32_t slice = 0; slice < m_textures.size(); ++slice)
+    {
+        D3D11_TEXTURE2D_DESC textureDesc;
+        m_textures[slice]->GetDesc(&textureDesc);
+        for (uint32_t level = 0; level < mipLevels; ++level)
+        {
+            context->CopySubresourceRegion(textureArray.Get(), D3D11CalcSubresource(level, slice, mipLevels), 0, 0, 0,
+                                           m_textures[slice].Get(), D3D11CalcSubresource(level, 0, textureDesc.MipLevels), nullptr);
+        }
+        m_placements.push_back({ slice, 0, 0, desc.Width, desc.Height });
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+    srvDesc.Texture2DArray.MipLevels = mipLevels;
+    srvDesc.Texture2DArray.ArraySize = arrayDesc.ArraySize;
+
+    hr = device->CreateShaderResourceView(textureArray.Get(), &srvDesc, pTextureSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create material texture array SRV\n");
+        throw std::runtime_error("Failed to create material texture array SRV");
+    }
+
+    m_textureWidth = desc.Width;
+    m_textureHeight = desc.Height;
+}
+
+void MaterialTable::BuildAtlas(ID3D11Device* device, ID3D11DeviceContext* context, const D3D11_TEXTURE2D_DESC& desc, uint32_t mipLevels)
+{
+    // e~bvŋ`̈ʒu (BC ̓ubNE) ɂȂ悤
+    const uint32_t alignment = (IsBlockCompressed(desc.Format) ? 4u : 1u) << (mipLevels - 1);
+
+    std::vector<D3D11_TEXTURE2D_DESC> textureDescs(m_textures.size());
+    uint64_t totalArea = 0;
+    uint32_t maxWidth = 0;
+    for (size_t i = 0; i < m_textures.size(); ++i)
+    {
+        m_textures[i]->GetDesc(&textureDescs[i]);
+        const uint32_t width = AlignUp(textureDescs[i].Width, alignment);
+        const uint32_t height = AlignUp(textureDescs[i].Height, alignment);
+        totalArea += static_cast<uint64_t>(width) * height;
+        maxWidth = std::max(maxWidth, width);
+    }
+
+    // ɒI (s) ֍l߂B͂ݏo畝{ɂĂ蒼
+    std::vector<uint32_t> order(m_textures.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return textureDescs[a].Height > textureDescs[b].Height; });
+
+    uint32_t atlasWidth = alignment;
+    while (atlasWidth < maxWidth || static_cast<uint64_t>(atlasWidth) * atlasWidth < totalArea)
+    {
+        atlasWidth *= 2;
+    }
+
+    m_placements.assign(m_textures.size(), {});
+    uint32_t atlasHeight = 0;
+    for (;;)
+    {
+        if (atlasWidth > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+        {
+            OutputDebugStringA("Failed to build material atlas: textures do not fit\n");
+            throw std::runtime_error("Failed to build material atlas: textures do not fit");
+        }
+
+        uint32_t x = 0, y = 0, shelfHeight = 0;
+        for (uint32_t index : order)
+        {
+            const uint32_t width = AlignUp(textureDescs[index].Width, alignment);
+            const uint32_t height = AlignUp(textureDescs[index].Height, alignment);
+            if (x + width > atlasWidth)
+            {
+                x = 0;
+                y += shelfHeight;
+                shelfHeight = 0;
+            }
+            m_placements[index] = { 0, x, y, textureDescs[index].Width, textureDescs[index].Height };
+            x += width;
+            shelfHeight = std::max(shelfHeight, height);
+        }
+
+        atlasHeight = y + shelfHeight;
+        if (atlasHeight <= atlasWidth)
+        {
+            break;
+        }
+        atlasWidth *= 2;
+    }
+
+    D3D11_TEXTURE2D_DESC atlasDesc = {};
+    atlasDesc.Width = atlasWidth;
+    atlasDesc.Height = atlasHeight;
+    atlasDesc.MipLevels = mipLevels;
+    atlasDesc.ArraySize = 1;
+    atlasDesc.Format = desc.Format;
+    atlasDesc.SampleDesc.Count = 1;
+    atlasDesc.Usage = D3D11_USAGE_DEFAULT;
+    atlasDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> atlas;
+    HRESULT hr = device->CreateTexture2D(&atlasDesc, nullptr, &atlas);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create material atlas\n");
+        throw std::runtime_error("Failed to create material atlas");
+    }
+
+    for (size_t i = 0; i < m_textures.size(); ++i)
+    {
+        const TexturePlacement& placement = m_placements[i];
+        for (uint32_t level = 0; level < mipLevels; ++level)
+        {
+            context->CopySubresourceRegion(atlas.Get(), D3D11CalcSubresource(level, 0, mipLevels),
+                                           placement.x >> level, placement.y >> level, 0,
+                                           m_textures[i].Get(), D3D11CalcSubresource(level, 0, textureDescs[i].MipLevels), nullptr);
+        }
+    }
+
+    // CSMain ͔zƓ Texture2DArray Ƃēǂ
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+    srvDesc.Texture2DArray.MipLevels = mipLevels;
+    srvDesc.Texture2DArray.ArraySize = 1;
+
+    hr = device->CreateShaderResourceView(atlas.Get(), &srvDesc, pTextureSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create material atlas SRV\n");
+        throw std::runtime_error("Failed to create material atlas SRV");
+    }
+
+    m_textureWidth = atlasWidth;
+    m_textureHeight = atlasHeight;
+}
+
+void MaterialTable::CreateTriangleMaterialBuffer(ID3D11Device* device, const std::vector<uint32_t>& triangleMaterials,
+                                                 Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& triangleMaterialSRV) const
+{
+    if (triangleMaterials.empty())
+    {
+        triangleMaterialSRV.Reset();
+        return;
+    }
+
+    CreateImmutableStructuredBuffer(device, sizeof(uint32_t), static_cast<uint32_t>(triangleMaterials.size()),
+                                    triangleMaterials.data(), "triangle material", triangleMaterialSRV);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "DirectXTKComputeRasterizer.h"
+
+// ==================================================================================
+// }eAe[u
+// cs_5_0 ł̓eNX`𓮓IɑIׂȂ (oChXȂ) ̂ŁAS}eÃeNX`
+// 1 Texture2DArray (TCYȂXCXAႤTCYȂAgX) ɂ܂Ƃ߁A
+// }eA StructuredBuffer ɒuBOp` (܂ Render P) ̃}eA ID ň̂ŁA
+// }eASĂV[Ŝ 1  Render ŕ`B
+// ==================================================================================
+
+// }eÃeNX`ȂƂ\ textureIndex (tint œh)
+constexpr uint32_t c_MaterialNoTexture = UINT32_MAX;
+
+// Tv[ (rbg 0 = Nv, rbg 1 = |CgBRasterizerCommon.hlsli  MATERIAL_SAMPLER_* ƈv邱)
+enum class MaterialSampler : uint32_t {
+    LinearWrap = 0,
+    LinearClamp = 1,
+    PointWrap = 2,
+    PointClamp = 3,
+};
+
+// eNX`̂܂Ƃߕ
+enum class MaterialTextureLayout {
+    Array,  // 1eNX` = 1XCX (SeNX`TCYEtH[}bgE~bvł邱)
+    Atlas,  // 1̃eNX`ɋl߂ (TCYĂ悢B~bv c_AtlasMaxMipLevels ܂)
+};
+
+// AgX̃~bv̏ (` 2^(n-1) eNZEɑ̂ŁA₷ƌԂ)
+constexpr uint32_t c_AtlasMaxMipLevels = 5;
+
+struct MaterialDesc {
+    uint32_t textureIndex = c_MaterialNoTexture; // AddTexture ̖߂l
+    MaterialSampler sampler = MaterialSampler::LinearWrap;
+    DirectX::XMFLOAT4 tint = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+// GPU  Material ƓCAEg (48byte)
+struct Material {
+    DirectX::XMFLOAT4 tint;
+    DirectX::XMFLOAT4 uvTransform;  // xy = XP[, zw = ItZbg (AgX̋`)
+    uint32_t textureIndex;          // MaterialTextures ̃XCX
+    uint32_t sampler;               // MaterialSampler
+    uint32_t atlas;                 // 1 Ȃ UV `Ńbv / NvĂǂ
+    uint32_t padding;
+};
+
+class MaterialTable
+{
+public:
+    // ߂l̓eNX`̔ԍ (MaterialDesc::textureIndex ɓn)
+    uint32_t AddTexture(ID3D11ShaderResourceView* textureSRV);
+    uint32_t AddTextureFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* fileName);
+
+    // ߂l̓}eA ID
+    uint32_t AddMaterial(const MaterialDesc& desc);
+
+    // eNX`܂Ƃ߁A}eÃobt@ (AddTexture / AddMaterial ̌ɌĂ)
+    void Build(ID3D11Device* device, ID3D11DeviceContext* context, MaterialTextureLayout layout);
+
+    // Op`Ƃ̃}eA ID (Op`̔ԍ = Render ̎Op`̔ԍ)
+    void CreateTriangleMaterialBuffer(ID3D11Device* device, const std::vector<uint32_t>& triangleMaterials,
+                                      Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& triangleMaterialSRV) const;
+
+    ID3D11ShaderResourceView* GetTextureSRV() const { return pTextureSRV.Get(); }
+    ID3D11ShaderResourceView* GetMaterialSRV() const { return pMaterialSRV.Get(); }
+    uint32_t GetMaterialCount() const { return static_cast<uint32_t>(m_materials.size()); }
+
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTextureSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pMaterialSRV;
+
+private:
+    struct TexturePlacement {
+        uint32_t slice;
+        uint32_t x, y;
+        uint32_t width, height;
+    };
+
+    void BuildArray(ID3D11Device* device, ID3D11DeviceContext* context, const D3D11_TEXTURE2D_DESC& desc, uint32_t mipLevels);
+    void BuildAtlas(ID3D11Device* device, ID3D11DeviceContext* context, const D3D11_TEXTURE2D_DESC& desc, uint32_t mipLevels);
+
+    std::vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>> m_textures;
+    std::vector<TexturePlacement> m_placements;
+    std::vector<MaterialDesc> m_materials;
+    uint32_t m_textureWidth = 0;
+    uint32_t m_textureHeight = 0;
+    bool m_atlas = false;
+};
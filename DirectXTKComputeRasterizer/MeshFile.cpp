@@ -0,0 +1,319 @@
+#include "pch.h"
+#include "MeshFile.h"
+#include <cfloat>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    template <typename T>
+    void SetSection(MeshFileHeader& header, MeshFileSectionType type, const std::vector<T>& data, uint64_t& offset)
+    {
+        MeshFileSection& section = header.sections[type];
+        section.offset = data.empty() ? 0 : AlignUp(offset, c_MeshFileSectionAlignment);
+        section.size = sizeof(T) * data.size();
+        section.stride = sizeof(T);
+        section.count = static_cast<uint32_t>(data.size());
+        if (!data.empty())
+        {
+            offset = section.offset + section.size;
+        }
+    }
+
+    template <typename T>
+    void WriteSection(std::ofstream& stream, const MeshFileSection& section, const std::vector<T>& data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        // ZNVE܂Ń[Ŗ߂
+        static const char zeros[c_MeshFileSectionAlignment] = {};
+        uint64_t position = static_cast<uint64_t>(stream.tellp());
+        stream.write(zeros, static_cast<std::streamsize>(section.offset - position));
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(section.size));
+    }
+
+    void StreamSection(ID3D11Device* device, ID3D11DeviceContext* context, const MeshFile& file, MeshFileSectionType type,
+                       const char* name, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+    {
+        StreamFileSection(device, context, file.GetSection(type), file.GetSectionData(type), name, srv);
+    }
+}
+
+void StreamFileSection(ID3D11Device* device, ID3D11DeviceContext* context, const MeshFileSection& section, const uint8_t* data,
+                       const char* name, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+{
+    srv.Reset();
+
+    if (section.count == 0)
+    {
+        return;
+    }
+
+    char errorMsg[256];
+    if (section.size > UINT32_MAX)
+    {
+        sprintf_s(errorMsg, "%s section is too large for a single buffer", name);
+        OutputDebugStringA(errorMsg);
+        OutputDebugStringA("\n");
+        throw std::runtime_error(errorMsg);
+    }
+
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = static_cast<UINT>(section.size);
+    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = section.stride;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, &buffer);
+    if (FAILED(hr))
+    {
+        sprintf_s(errorMsg, "Failed to create %s buffer", name);
+        OutputDebugStringA(errorMsg);
+        OutputDebugStringA("\n");
+        throw std::runtime_error(errorMsg);
+    }
+
+    const UINT size = static_cast<UINT>(section.size);
+    for (UINT offset = 0; offset < size;)
+    {
+        const UINT chunk = std::min(c_MeshStreamChunkSize, size - offset);
+        const D3D11_BOX box = { offset, 0, 0, offset + chunk, 1, 1 };
+        context->UpdateSubresource(buffer.Get(), 0, &box, data + offset, 0, 0);
+        offset += chunk;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = section.count;
+
+    hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        sprintf_s(errorMsg, "Failed to create %s SRV", name);
+        OutputDebugStringA(errorMsg);
+        OutputDebugStringA("\n");
+        throw std::runtime_error(errorMsg);
+    }
+}
+
+void WriteMeshFile(const wchar_t* fileName, const MeshData& mesh)
+{
+    MeshFileHeader header = {};
+    header.magic = c_MeshFileMagic;
+    header.version = c_MeshFileVersion;
+    header.triangleCount = TriangleCount(mesh.vertices, mesh.indices);
+    header.sectionCount = MeshFileSection_Count;
+
+    header.boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    header.boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const auto& vertex : mesh.vertices)
+    {
+        header.boundsMin = { std::min(header.boundsMin.x, vertex.pos.x), std::min(header.boundsMin.y, vertex.pos.y), std::min(header.boundsMin.z, vertex.pos.z) };
+        header.boundsMax = { std::max(header.boundsMax.x, vertex.pos.x), std::max(header.boundsMax.y, vertex.pos.y), std::max(header.boundsMax.z, vertex.pos.z) };
+    }
+
+    uint64_t offset = sizeof(MeshFileHeader);
+    SetSection(header, MeshFileSection_Vertices, mesh.vertices, offset);
+    SetSection(header, MeshFileSection_Indices, mesh.indices, offset);
+    SetSection(header, MeshFileSection_Meshlets, mesh.meshlets, offset);
+    SetSection(header, MeshFileSection_BvhNodes, mesh.bvh.nodes, offset);
+    SetSection(header, MeshFileSection_BvhTriangleIndices, mesh.bvh.triangleIndices, offset);
+
+    std::ofstream stream(std::filesystem::path(fileName), std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        OutputDebugStringA("Failed to create mesh file\n");
+        throw std::runtime_error("Failed to create mesh file");
+    }
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteSection(stream, header.sections[MeshFileSection_Vertices], mesh.vertices);
+    WriteSection(stream, header.sections[MeshFileSection_Indices], mesh.indices);
+    WriteSection(stream, header.sections[MeshFileSection_Meshlets], mesh.meshlets);
+    WriteSection(stream, header.sections[MeshFileSection_BvhNodes], mesh.bvh.nodes);
+    WriteSection(stream, header.sections[MeshFileSection_BvhTriangleIndices], mesh.bvh.triangleIndices);
+
+    if (!stream)
+    {
+        OutputDebugStringA("Failed to write mesh file\n");
+        throw std::runtime_error("Failed to write mesh file");
+    }
+}
+
+void MeshFile::Open(const wchar_t* fileName)
+{
+    Close();
+
+    // 擪珇ɓǂނƂĂ̂ŁAǂ݂Lɂ
+    m_file = CreateFileW(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        OutputDebugStringA("Failed to open mesh file\n");
+        throw std::runtime_error("Failed to open mesh file");
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(m_file, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) < sizeof(MeshFileHeader)
+        || static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX)
+    {
+        Close();
+        OutputDebugStringA("Invalid mesh file size\n");
+        throw std::runtime_error("Invalid mesh file size");
+    }
+    m_fileSize = static_cast<uint64_t>(fileSize.QuadPart);
+
+    m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        Close();
+        OutputDebugStringA("Failed to create mesh file mapping\n");
+        throw std::runtime_error("Failed to create mesh file mapping");
+    }
+
+    m_view = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_view == nullptr)
+    {
+        Close();
+        OutputDebugStringA("Failed to map mesh file\n");
+        throw std::runtime_error("Failed to map mesh file");
+    }
+
+    // wb_̌ (\̂̂܂ GPU ɓn̂ŁAvfTCŸvmF)
+    const MeshFileHeader& header = GetHeader();
+    if (header.magic != c_MeshFileMagic || header.version != c_MeshFileVersion || header.sectionCount != MeshFileSection_Count)
+    {
+        Close();
+        OutputDebugStringA("Unsupported mesh file format\n");
+        throw std::runtime_error("Unsupported mesh file format");
+    }
+
+    static const uint32_t expectedStrides[MeshFileSection_Count] = {
+        sizeof(Vertex), sizeof(uint32_t), sizeof(Meshlet), sizeof(BvhNode), sizeof(uint32_t)
+    };
+    for (uint32_t i = 0; i < MeshFileSection_Count; ++i)
+    {
+        const MeshFileSection& section = header.sections[i];
+        if (section.count == 0)
+        {
+            continue;
+        }
+        if (section.stride != expectedStrides[i] || section.size != static_cast<uint64_t>(section.stride) * section.count
+            || section.offset % c_MeshFileSectionAlignment != 0 || section.offset > m_fileSize || section.size > m_fileSize - section.offset)
+        {
+            Close();
+            OutputDebugStringA("Corrupted mesh file section\n");
+            throw std::runtime_error("Corrupted mesh file section");
+        }
+    }
+
+    const MeshFileSection& triangleSource = header.sections[header.sections[MeshFileSection_Indices].count > 0 ? MeshFileSection_Indices : MeshFileSection_Vertices];
+    if (static_cast<uint64_t>(header.triangleCount) * 3 > triangleSource.count)
+    {
+        Close();
+        OutputDebugStringA("Corrupted mesh file triangle count\n");
+        throw std::runtime_error("Corrupted mesh file triangle count");
+    }
+
+    // g͂̂܂܃VF[_[ CPU łYɎĝŁA͈͊OwĂȂňxm߂
+    const uint32_t vertexCount = header.sections[MeshFileSection_Vertices].count;
+    const uint32_t* indices = reinterpret_cast<const uint32_t*>(GetSectionData(MeshFileSection_Indices));
+    bool valid = true;
+    for (uint32_t i = 0; valid && i < header.sections[MeshFileSection_Indices].count; ++i)
+    {
+        valid = indices[i] < vertexCount;
+    }
+    if (!valid)
+    {
+        Close();
+        OutputDebugStringA("Corrupted mesh file index\n");
+        throw std::runtime_error("Corrupted mesh file index");
+    }
+
+    const Meshlet* meshlets = reinterpret_cast<const Meshlet*>(GetSectionData(MeshFileSection_Meshlets));
+    for (uint32_t i = 0; valid && i < header.sections[MeshFileSection_Meshlets].count; ++i)
+    {
+        valid = meshlets[i].firstTriangle <= header.triangleCount && meshlets[i].triangleCount <= header.triangleCount - meshlets[i].firstTriangle;
+    }
+    if (!valid)
+    {
+        Close();
+        OutputDebugStringA("Corrupted mesh file meshlet\n");
+        throw std::runtime_error("Corrupted mesh file meshlet");
+    }
+
+    // q͏ɐeɕ (BuildBvh ̕בւ) ̂ŁAȊO͏zƂ݂Ȃ
+    const uint32_t nodeCount = header.sections[MeshFileSection_BvhNodes].count;
+    const uint32_t bvhTriangleCount = header.sections[MeshFileSection_BvhTriangleIndices].count;
+    const BvhNode* nodes = reinterpret_cast<const BvhNode*>(GetSectionData(MeshFileSection_BvhNodes));
+    for (uint32_t i = 0; valid && i < nodeCount; ++i)
+    {
+        const BvhNode& node = nodes[i];
+        valid = node.triangleCount == 0
+            ? node.leftFirst > i && node.leftFirst < nodeCount - 1
+            : node.leftFirst <= bvhTriangleCount && node.triangleCount <= bvhTriangleCount - node.leftFirst;
+    }
+    const uint32_t* triangleIndices = reinterpret_cast<const uint32_t*>(GetSectionData(MeshFileSection_BvhTriangleIndices));
+    for (uint32_t i = 0; valid && i < bvhTriangleCount; ++i)
+    {
+        valid = triangleIndices[i] < header.triangleCount;
+    }
+    if (!valid)
+    {
+        Close();
+        OutputDebugStringA("Corrupted mesh file BVH\n");
+        throw std::runtime_error("Corrupted mesh file BVH");
+    }
+}
+
+void MeshFile::Close()
+{
+    if (m_view != nullptr)
+    {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_fileSize = 0;
+}
+
+void CreateMeshBuffers(ID3D11Device* device, ID3D11DeviceContext* context, const MeshFile& file, MeshBuffers& buffers)
+{
+    OutputDebugStringA("=== CreateMeshBuffers START ===\n");
+
+    StreamSection(device, context, file, MeshFileSection_Vertices, "mesh vertex", buffers.vertexSRV);
+    StreamSection(device, context, file, MeshFileSection_Indices, "mesh index", buffers.indexSRV);
+    StreamSection(device, context, file, MeshFileSection_Meshlets, "mesh meshlet", buffers.meshletSRV);
+    StreamSection(device, context, file, MeshFileSection_BvhNodes, "mesh BVH node", buffers.bvhNodeSRV);
+    StreamSection(device, context, file, MeshFileSection_BvhTriangleIndices, "mesh BVH triangle index", buffers.bvhTriangleIndexSRV);
+
+    const MeshFileHeader& header = file.GetHeader();
+    buffers.triangleCount = header.triangleCount;
+    buffers.meshletCount = header.sections[MeshFileSection_Meshlets].count;
+    buffers.bvhNodeCount = header.sections[MeshFileSection_BvhNodes].count;
+
+    char debugMsg[256];
+    sprintf_s(debugMsg, "Mesh loaded: %u triangles, %u meshlets, %u BVH nodes\n",
+              buffers.triangleCount, buffers.meshletCount, buffers.bvhNodeCount);
+    OutputDebugStringA(debugMsg);
+    OutputDebugStringA("=== CreateMeshBuffers END ===\n");
+}
\ No newline at end of file
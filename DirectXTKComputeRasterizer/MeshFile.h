@@ -0,0 +1,108 @@
+#pragma once
+#include "DirectXTKComputeRasterizer.h"
+#include "BvhBuilder.h"
+
+// ==================================================================================
+// oCibVt@C (.dxrmesh)
+// X^CU GPU obt@ƂĎgCAEĝ܂܃t@Cɕׂ́B
+// [MeshFileHeader][Vertices][Indices][Meshlets][BvhNodes][BvhTriangleIndices]
+// eZNV c_MeshFileSectionAlignment EɒuA}bvr[
+// ԃobt@ GPU obt@֓]B
+// ==================================================================================
+
+constexpr uint32_t c_MeshFileMagic = 0x4D525844; // "DXRM"
+constexpr uint32_t c_MeshFileVersion = 1;        // CAEgςグ邱
+constexpr uint64_t c_MeshFileSectionAlignment = 256;
+
+enum MeshFileSectionType : uint32_t
+{
+    MeshFileSection_Vertices = 0,          // Vertex[]
+    MeshFileSection_Indices,               // uint32_t[] (Ȃ 3_ = 1Op`̔CfbNX`)
+    MeshFileSection_Meshlets,              // Meshlet[] (Op`̓bVbgɕł)
+    MeshFileSection_BvhNodes,              // BvhNode[]
+    MeshFileSection_BvhTriangleIndices,    // uint32_t[]
+    MeshFileSection_Count
+};
+
+struct MeshFileSection {
+    uint64_t offset; // t@C擪̃oCgItZbg
+    uint64_t size;   // oCg
+    uint32_t stride; // vfTCY (ǂݍݎɍ\̂̃CAEgƈv邩؂)
+    uint32_t count;  // vf
+};
+
+struct MeshFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t triangleCount;
+    uint32_t sectionCount;        // MeshFileSection_Count
+    DirectX::XMFLOAT3 boundsMin;  // S_ AABB (Jzup)
+    float    padding0;
+    DirectX::XMFLOAT3 boundsMax;
+    float    padding1;
+    MeshFileSection sections[MeshFileSection_Count];
+};
+
+static_assert(sizeof(MeshFileSection) == 24, "MeshFileSection layout changed");
+static_assert(sizeof(MeshFileHeader) == 48 + 24 * MeshFileSection_Count, "MeshFileHeader layout changed");
+
+// Ro[^[o CPU ̃bV
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    Bvh bvh;
+};
+
+// mesh  .dxrmesh Ƃďo
+void WriteMeshFile(const wchar_t* fileName, const MeshData& mesh);
+
+// }bvŊJ .dxrmesh (ǂݎp)
+class MeshFile
+{
+public:
+    MeshFile() = default;
+    ~MeshFile() { Close(); }
+
+    MeshFile(const MeshFile&) = delete;
+    MeshFile& operator=(const MeshFile&) = delete;
+
+    // t@CŜ}bvAwb_ƃZNV͈̔͂؂
+    void Open(const wchar_t* fileName);
+    void Close();
+
+    bool IsOpen() const { return m_view != nullptr; }
+    uint64_t GetFileSize() const { return m_fileSize; }
+    const MeshFileHeader& GetHeader() const { return *reinterpret_cast<const MeshFileHeader*>(m_view); }
+    const MeshFileSection& GetSection(MeshFileSectionType type) const { return GetHeader().sections[type]; }
+    const uint8_t* GetSectionData(MeshFileSectionType type) const { return m_view + GetSection(type).offset; }
+
+private:
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+    const uint8_t* m_view = nullptr;
+    uint64_t m_fileSize = 0;
+};
+
+// GPU ̃bV (Render / SetBvh ɂ̂܂ܓn)
+struct MeshBuffers {
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> vertexSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> indexSRV;     // CfbNX`Ȃ nullptr
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> meshletSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> bvhNodeSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> bvhTriangleIndexSRV;
+    uint32_t triangleCount = 0;
+    uint32_t meshletCount = 0;
+    uint32_t bvhNodeCount = 0;
+};
+
+// }bvt@C̊eZNVAc_MeshStreamChunkSize  GPU obt@֓]
+// (y[W̓ANZXǂݍ܂̂ŁAt@CŜxɃ֍ڂȂ)
+constexpr uint32_t c_MeshStreamChunkSize = 16 * 1024 * 1024;
+
+void CreateMeshBuffers(ID3D11Device* device, ID3D11DeviceContext* context, const MeshFile& file, MeshBuffers& buffers);
+
+// }bvt@C 1ZNV (data  section.size oCg) ̍\obt@Ac_MeshStreamChunkSize ]
+// (̃ZNVȂ srv  nullptrB.dxrpoints ȂǓZNV`̃t@Cłg)
+void StreamFileSection(ID3D11Device* device, ID3D11DeviceContext* context, const MeshFileSection& section, const uint8_t* data,
+                       const char* name, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv);
\ No newline at end of file
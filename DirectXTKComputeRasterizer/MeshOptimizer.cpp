@@ -0,0 +1,334 @@
+#include "MeshOptimizer.h"
+#include "DebugOutput.h"
+#include "MeshletBuilder.h"
+#include <cfloat>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+
+using namespace DirectX;
+
+namespace
+{
+    // Forsyth ̃XRA֐̃p[^
+    constexpr float c_CacheDecayPower = 1.5f;
+    constexpr float c_LastTriangleScore = 0.75f;
+    constexpr float c_ValenceBoostScale = 2.0f;
+    constexpr float c_ValenceBoostPower = 0.5f;
+
+    // LbV̈ʒu (-1 = LbVO) ƎcOp`璸_̃XRA߂
+    float VertexScore(int cachePosition, uint32_t remainingTriangles)
+    {
+        if (remainingTriangles == 0)
+        {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // O̎Op`̒_́AOp`IёȂ悤Œlɂ
+                score = c_LastTriangleScore;
+            }
+            else
+            {
+                const float scaler = 1.0f / (c_VertexCacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, c_CacheDecayPower);
+            }
+        }
+
+        // cOp`̏Ȃ_D悵Ďg؂
+        score += c_ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -c_ValenceBoostPower);
+        return score;
+    }
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t firstTriangle, uint32_t triangleCount)
+{
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // 0. ͈͓Ŏg钸_̃[JԍɐU蒼 (bVbgƂɌĂłS_̍ƂȂ)
+    uint32_t* source = &indices[firstTriangle * 3];
+    std::vector<uint32_t> globalIndices(source, source + triangleCount * 3);
+    std::sort(globalIndices.begin(), globalIndices.end());
+    globalIndices.erase(std::unique(globalIndices.begin(), globalIndices.end()), globalIndices.end());
+    if (globalIndices.back() >= vertexCount)
+    {
+        DebugOutput("Index out of range in OptimizeVertexCache\n");
+        throw std::runtime_error("Index out of range in OptimizeVertexCache");
+    }
+    vertexCount = static_cast<uint32_t>(globalIndices.size());
+
+    std::vector<uint32_t> triangles(triangleCount * 3);
+    for (uint32_t i = 0; i < triangleCount * 3; ++i)
+    {
+        triangles[i] = static_cast<uint32_t>(std::lower_bound(globalIndices.begin(), globalIndices.end(), source[i]) - globalIndices.begin());
+    }
+
+    // 1. _ -> Op`̗אڃXg
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++remaining[triangles[i]];
+    }
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            adjacency[fill[triangles[t * 3 + k]]++] = t;
+        }
+    }
+
+    // 2. _̏XRA
+    std::vector<float> vertexScore(vertexCount, 0.0f);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        vertexScore[v] = VertexScore(-1, remaining[v]);
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+
+    // 3. XRAő̎Op`×~ɏo͂
+    //    ̓LbV̒_ɗאڂOp`̂݁B₪ȂΖo͂̐擪T
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(c_VertexCacheSize + 3);
+    nextCache.reserve(c_VertexCacheSize + 3);
+    uint32_t scanPosition = 0;
+
+    int best = 0;
+    while (best >= 0)
+    {
+        const uint32_t t = static_cast<uint32_t>(best);
+        emitted[t] = true;
+
+        // Op`̒_LbV̐擪
+        nextCache.clear();
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            uint32_t v = triangles[t * 3 + k];
+            output.push_back(globalIndices[v]);
+            nextCache.push_back(v);
+
+            // אڃXgo͍ς݂̎Op`菜
+            uint32_t* list = &adjacency[adjacencyOffsets[v]];
+            for (uint32_t i = 0; i < remaining[v]; ++i)
+            {
+                if (list[i] == t)
+                {
+                    list[i] = list[--remaining[v]];
+                    break;
+                }
+            }
+        }
+        for (uint32_t v : cache)
+        {
+            if (v != nextCache[0] && v != nextCache[1] && v != nextCache[2])
+            {
+                nextCache.push_back(v);
+            }
+        }
+
+        // LbV炠ӂꂽ_̓LbVÕXRAɖ߂
+        for (size_t i = c_VertexCacheSize; i < nextCache.size(); ++i)
+        {
+            vertexScore[nextCache[i]] = VertexScore(-1, remaining[nextCache[i]]);
+        }
+        if (nextCache.size() > c_VertexCacheSize)
+        {
+            nextCache.resize(c_VertexCacheSize);
+        }
+        cache.swap(nextCache);
+
+        // LbV̒_̃XRAXVAאڎOp`玟̌I
+        for (uint32_t i = 0; i < cache.size(); ++i)
+        {
+            vertexScore[cache[i]] = VertexScore(static_cast<int>(i), remaining[cache[i]]);
+        }
+
+        best = -1;
+        float bestScore = -FLT_MAX;
+        for (uint32_t v : cache)
+        {
+            const uint32_t* list = &adjacency[adjacencyOffsets[v]];
+            for (uint32_t i = 0; i < remaining[v]; ++i)
+            {
+                uint32_t candidate = list[i];
+                float score = vertexScore[triangles[candidate * 3]] + vertexScore[triangles[candidate * 3 + 1]] + vertexScore[triangles[candidate * 3 + 2]];
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = static_cast<int>(candidate);
+                }
+            }
+        }
+
+        if (best < 0)
+        {
+            while (scanPosition < triangleCount && emitted[scanPosition])
+            {
+                ++scanPosition;
+            }
+            if (scanPosition < triangleCount)
+            {
+                best = static_cast<int>(scanPosition);
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), source);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount)
+{
+    OptimizeVertexCache(indices, vertexCount, 0, static_cast<uint32_t>(indices.size() / 3));
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+    constexpr uint32_t c_Unassigned = UINT32_MAX;
+    std::vector<uint32_t> remap(vertices.size(), c_Unassigned);
+    std::vector<Vertex> sorted;
+    sorted.reserve(vertices.size());
+
+    for (auto& index : indices)
+    {
+        if (remap[index] == c_Unassigned)
+        {
+            remap[index] = static_cast<uint32_t>(sorted.size());
+            sorted.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(sorted);
+}
+
+void SortTrianglesMorton(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const XMFLOAT4X4* screenTransform)
+{
+    const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    XMMATRIX transform = screenTransform != nullptr ? XMLoadFloat4x4(screenTransform) : XMMatrixIdentity();
+
+    // dS (XN[Ԃ̏ꍇ͓e xy, z = 0)
+    std::vector<XMFLOAT3> centroids(triangleCount);
+    XMVECTOR boundsMin = g_XMFltMax;
+    XMVECTOR boundsMax = XMVectorNegate(g_XMFltMax);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        XMVECTOR centroid = XMVectorScale(
+            XMVectorAdd(XMVectorAdd(XMLoadFloat3(&vertices[indices[t * 3]].pos), XMLoadFloat3(&vertices[indices[t * 3 + 1]].pos)),
+                        XMLoadFloat3(&vertices[indices[t * 3 + 2]].pos)),
+            1.0f / 3.0f);
+        if (screenTransform != nullptr)
+        {
+            centroid = XMVectorSetZ(XMVector3TransformCoord(centroid, transform), 0.0f);
+        }
+        XMStoreFloat3(&centroids[t], centroid);
+        boundsMin = XMVectorMin(boundsMin, centroid);
+        boundsMax = XMVectorMax(boundsMax, centroid);
+    }
+
+    XMVECTOR extent = XMVectorMax(XMVectorSubtract(boundsMax, boundsMin), g_XMEpsilon);
+    std::vector<uint32_t> codes(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        XMFLOAT3 normalized;
+        XMStoreFloat3(&normalized, XMVectorDivide(XMVectorSubtract(XMLoadFloat3(&centroids[t]), boundsMin), extent));
+        codes[t] = MortonCode3D(normalized);
+    }
+
+    std::vector<uint32_t> order(triangleCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+
+    std::vector<uint32_t> sorted(indices.size());
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        std::copy_n(&indices[order[i] * 3], 3, &sorted[i * 3]);
+    }
+    indices.swap(sorted);
+}
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStats stats = {};
+    if (indices.empty() || vertexCount == 0)
+    {
+        return stats;
+    }
+
+    // FIFO LbV: _ (ϊ) oĂAcacheSize ȏOȂǂoĂ
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t transformed = 0;
+    for (uint32_t index : indices)
+    {
+        if (timestamps[index] == 0 || transformed + 1 - timestamps[index] > cacheSize)
+        {
+            ++transformed;
+            timestamps[index] = transformed;
+        }
+    }
+
+    stats.acmr = static_cast<float>(transformed) / (indices.size() / 3);
+    stats.atvr = static_cast<float>(transformed) / vertexCount;
+    return stats;
+}
+
+VertexFetchStats AnalyzeVertexFetch(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t vertexSize)
+{
+    VertexFetchStats stats = {};
+    if (indices.empty() || vertexCount == 0)
+    {
+        return stats;
+    }
+
+    // LRU LbV (Cԍ̃Xg, 擪ŋߎg)
+    std::list<uint64_t> lru;
+    uint64_t references = 0;
+    uint64_t misses = 0;
+    for (uint32_t index : indices)
+    {
+        const uint64_t firstLine = static_cast<uint64_t>(index) * vertexSize / c_FetchCacheLineSize;
+        const uint64_t lastLine = (static_cast<uint64_t>(index) * vertexSize + vertexSize - 1) / c_FetchCacheLineSize;
+        for (uint64_t line = firstLine; line <= lastLine; ++line)
+        {
+            ++references;
+            auto it = std::find(lru.begin(), lru.end(), line);
+            if (it != lru.end())
+            {
+                lru.splice(lru.begin(), lru, it);
+                continue;
+            }
+
+            ++misses;
+            lru.push_front(line);
+            if (lru.size() > c_FetchCacheLines)
+            {
+                lru.pop_back();
+            }
+        }
+    }
+
+    stats.missRate = static_cast<float>(misses) / references;
+    stats.overfetch = static_cast<float>(misses * c_FetchCacheLineSize) / (static_cast<uint64_t>(vertexCount) * vertexSize);
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include "RasterizerTypes.h"
+
+// ==================================================================================
+// CfbNXtbV̕בւ ([h / ItC1񂾂sz)
+// sNZ哱 CSMain ͓^C̃XbhOp`ɓǂނ߁A
+// Op`ƒ_̕т̂܂܃LbṼqbgɌB
+// ==================================================================================
+
+// ACMR ̌vƕבւőz肷钸_LbṼTCY (FIFO, _)
+constexpr uint32_t c_VertexCacheSize = 32;
+
+// _tFb`̌vőz肷LbV (LRU, c_FetchCacheLineSize byte x c_FetchCacheLines)
+constexpr uint32_t c_FetchCacheLineSize = 64;
+constexpr uint32_t c_FetchCacheLines = 64;
+
+// bVbggȂꍇɁAMorton ɕׂOp`̐̃ubNŃLbVœK
+constexpr uint32_t c_MortonBlockTriangles = 512;
+
+struct VertexCacheStats {
+    float acmr;  // Op`̒_ϊ (0.5 ~ 3.0, قǗǂ)
+    float atvr;  // _̒_ϊ (1.0 z)
+};
+
+struct VertexFetchStats {
+    float missRate;   // QƂLbVĈ~X
+    float overfetch;  // ǂݍ񂾃oCg / _obt@̃TCY (1.0 z)
+};
+
+// indices[firstTriangle * 3]  triangleCount ̎Op`A_LbV̍ėp鏇ɕבւ (Forsyth)
+// בւ͔͈͓ɕ̂ŁAbVbgƂɌĂׂ΃bVbg̍\͕ςȂ
+void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t firstTriangle, uint32_t triangleCount);
+void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+// _߂ĎQƂ鏇ɕבւAindices tւ (QƂȂ_͎菜)
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+// Op`dS Morton ɕבւ
+// screenTransform  nullptr ȂIuWFNg (3)Aw肵ꍇ͂̍sœeXN[ (2)
+void SortTrianglesMorton(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const DirectX::XMFLOAT4X4* screenTransform = nullptr);
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = c_VertexCacheSize);
+VertexFetchStats AnalyzeVertexFetch(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t vertexSize = sizeof(Vertex));
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "MeshletBuilder.h"
+#include <numeric>
+
+using namespace DirectX;
+
+namespace
+{
+    // minTriangles 𒴂bVbǵA@ς炱ȏ㗣ꂽOp`番 (cos 45x)
+    constexpr float c_NormalSplitThreshold = 0.7071f;
+
+    // @̂΂傫 (ŏςȉ) bVbg̓R[JOȂ
+    constexpr float c_MinConeDot = 0.1f;
+
+    // 10bit ̒lrbgԂ2bit󂯂ēWJ (3[gR[hp)
+    uint32_t ExpandBits(uint32_t v)
+    {
+        v = (v * 0x00010001u) & 0xFF0000FFu;
+        v = (v * 0x00000101u) & 0x0F00F00Fu;
+        v = (v * 0x00000011u) & 0xC30C30C3u;
+        v = (v * 0x00000005u) & 0x49249249u;
+        return v;
+    }
+
+    // Op`̖@ (CSMain ̊ŕ\ɂȂ鑤Bʐ0̏ꍇ̓[xNg)
+    XMVECTOR XM_CALLCONV FaceNormal(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t triangle)
+    {
+        XMVECTOR p0 = XMLoadFloat3(&vertices[TriangleVertexIndex(indices, triangle, 0)].pos);
+        XMVECTOR p1 = XMLoadFloat3(&vertices[TriangleVertexIndex(indices, triangle, 1)].pos);
+        XMVECTOR p2 = XMLoadFloat3(&vertices[TriangleVertexIndex(indices, triangle, 2)].pos);
+        return XMVector3Normalize(XMVector3Cross(XMVectorSubtract(p2, p0), XMVectorSubtract(p1, p0)));
+    }
+
+    bool XM_CALLCONV IsDegenerate(FXMVECTOR normal)
+    {
+        return XMVectorGetX(XMVector3LengthSq(normal)) == 0.0f;
+    }
+
+    // בւς݂̎Op`͈͂oEfBOXtBAƖ@R[vZ
+    void ComputeMeshletBounds(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, Meshlet& meshlet)
+    {
+        const uint32_t firstCorner = meshlet.firstTriangle * 3;
+        const uint32_t cornerCount = meshlet.triangleCount * 3;
+        auto position = [&](uint32_t corner) -> const XMFLOAT3&
+        {
+            return vertices[TriangleVertexIndex(indices, (firstCorner + corner) / 3, (firstCorner + corner) % 3)].pos;
+        };
+
+        // oEfBOXtBA: AABBSł_܂ł̋
+        XMVECTOR vmin = XMLoadFloat3(&position(0));
+        XMVECTOR vmax = vmin;
+        for (uint32_t i = 1; i < cornerCount; ++i)
+        {
+            XMVECTOR p = XMLoadFloat3(&position(i));
+            vmin = XMVectorMin(vmin, p);
+            vmax = XMVectorMax(vmax, p);
+        }
+        XMVECTOR center = XMVectorScale(XMVectorAdd(vmin, vmax), 0.5f);
+        float radiusSq = 0.0f;
+        for (uint32_t i = 0; i < cornerCount; ++i)
+        {
+            XMVECTOR d = XMVectorSubtract(XMLoadFloat3(&position(i)), center);
+            radiusSq = std::max(radiusSq, XMVectorGetX(XMVector3LengthSq(d)));
+        }
+        XMStoreFloat3(&meshlet.center, center);
+        meshlet.radius = std::sqrt(radiusSq);
+
+        // @R[:  = @̕, JbgIt = sin(Ɩ@̍őp)
+        XMVECTOR normalSum = XMVectorZero();
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+        {
+            normalSum = XMVectorAdd(normalSum, FaceNormal(vertices, indices, meshlet.firstTriangle + t));
+        }
+        XMVECTOR axis = XMVector3Normalize(normalSum);
+        XMStoreFloat3(&meshlet.coneAxis, axis);
+        meshlet.coneCutoff = 1.0f;
+
+        if (IsDegenerate(axis))
+        {
+            return;
+        }
+
+        float minDot = 1.0f;
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+        {
+            XMVECTOR n = FaceNormal(vertices, indices, meshlet.firstTriangle + t);
+            if (!IsDegenerate(n))
+            {
+                minDot = std::min(minDot, XMVectorGetX(XMVector3Dot(n, axis)));
+            }
+        }
+
+        if (minDot > c_MinConeDot)
+        {
+            meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    // Op`bVbgɕAVOp` order ɕԂ
+    std::vector<Meshlet> PartitionMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                           uint32_t maxTriangles, uint32_t minTriangles, std::vector<uint32_t>& order)
+    {
+        const uint32_t triangleCount = TriangleCount(vertices, indices);
+        std::vector<Meshlet> meshlets;
+        if (triangleCount == 0 || maxTriangles == 0)
+        {
+            return meshlets;
+        }
+        minTriangles = std::min(minTriangles, maxTriangles);
+
+        // 1. Op`̏dSƖ@vZ
+        std::vector<XMFLOAT3> centroids(triangleCount);
+        std::vector<XMFLOAT3> normals(triangleCount);
+        XMVECTOR boundsMin = g_XMFltMax;
+        XMVECTOR boundsMax = XMVectorNegate(g_XMFltMax);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            XMVECTOR centroid = XMVectorScale(
+                XMVectorAdd(XMVectorAdd(XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, 0)].pos),
+                                        XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, 1)].pos)),
+                            XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, 2)].pos)),
+                1.0f / 3.0f);
+            XMStoreFloat3(&centroids[t], centroid);
+            XMStoreFloat3(&normals[t], FaceNormal(vertices, indices, t));
+            boundsMin = XMVectorMin(boundsMin, centroid);
+            boundsMax = XMVectorMax(boundsMax, centroid);
+        }
+
+        // 2. dS̃[gR[hɎOp`ׂ (ԓIɋ߂Op`A)
+        XMVECTOR extent = XMVectorMax(XMVectorSubtract(boundsMax, boundsMin), g_XMEpsilon);
+        std::vector<uint32_t> codes(triangleCount);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            XMFLOAT3 normalized;
+            XMStoreFloat3(&normalized, XMVectorDivide(XMVectorSubtract(XMLoadFloat3(&centroids[t]), boundsMin), extent));
+            codes[t] = MortonCode3D(normalized);
+        }
+
+        order.resize(triangleCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+
+        // 3. 擪×~ɃbVbg֋l߂
+        //    maxTriangles ɒBƂA܂ minTriangles ȏŖ@傫OꂽOp`Ƃɕ
+        Meshlet current = {};
+        XMVECTOR normalSum = XMVectorZero();
+        for (uint32_t i = 0; i < triangleCount; ++i)
+        {
+            XMVECTOR n = XMLoadFloat3(&normals[order[i]]);
+
+            bool split = current.triangleCount >= maxTriangles;
+            if (!split && current.triangleCount >= minTriangles && !IsDegenerate(n))
+            {
+                XMVECTOR averageNormal = XMVector3Normalize(normalSum);
+                split = !IsDegenerate(averageNormal) && XMVectorGetX(XMVector3Dot(n, averageNormal)) < c_NormalSplitThreshold;
+            }
+
+            if (split)
+            {
+                meshlets.push_back(current);
+                current = {};
+                current.firstTriangle = i;
+                normalSum = XMVectorZero();
+            }
+
+            ++current.triangleCount;
+            normalSum = XMVectorAdd(normalSum, n);
+        }
+        meshlets.push_back(current);
+
+        return meshlets;
+    }
+}
+
+uint32_t MortonCode3D(const XMFLOAT3& p)
+{
+    auto quantize = [](float f)
+    {
+        return static_cast<uint32_t>(std::min(std::max(f * 1024.0f, 0.0f), 1023.0f));
+    };
+    return (ExpandBits(quantize(p.x)) << 2) | (ExpandBits(quantize(p.y)) << 1) | ExpandBits(quantize(p.z));
+}
+
+std::vector<Meshlet> BuildMeshlets(std::vector<Vertex>& vertices, uint32_t maxTriangles, uint32_t minTriangles)
+{
+    const std::vector<uint32_t> noIndices;
+    std::vector<uint32_t> order;
+    std::vector<Meshlet> meshlets = PartitionMeshlets(vertices, noIndices, maxTriangles, minTriangles, order);
+    if (meshlets.empty())
+    {
+        return meshlets;
+    }
+
+    // _VOp`ɕבւ
+    std::vector<Vertex> sorted(order.size() * 3);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        std::copy_n(&vertices[order[i] * 3], 3, &sorted[i * 3]);
+    }
+    vertices.swap(sorted);
+
+    for (auto& meshlet : meshlets)
+    {
+        ComputeMeshletBounds(vertices, noIndices, meshlet);
+    }
+    return meshlets;
+}
+
+std::vector<Meshlet> BuildMeshlets(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t maxTriangles, uint32_t minTriangles)
+{
+    std::vector<uint32_t> order;
+    std::vector<Meshlet> meshlets = PartitionMeshlets(vertices, indices, maxTriangles, minTriangles, order);
+    if (meshlets.empty())
+    {
+        return meshlets;
+    }
+
+    // CfbNXVOp`ɕבւ (_͋L̂œȂ)
+    std::vector<uint32_t> sorted(order.size() * 3);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        std::copy_n(&indices[order[i] * 3], 3, &sorted[i * 3]);
+    }
+    indices.swap(sorted);
+
+    for (auto& meshlet : meshlets)
+    {
+        ComputeMeshletBounds(vertices, indices, meshlet);
+    }
+    return meshlets;
+}
\ No newline at end of file
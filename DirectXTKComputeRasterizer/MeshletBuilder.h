@@ -0,0 +1,21 @@
+#pragma once
+#include "RasterizerTypes.h"
+
+// bVbg̎Op`̊l
+constexpr uint32_t c_MeshletMaxTriangles = 128;
+constexpr uint32_t c_MeshletMinTriangles = 64;
+
+// 0~1 ɐKꂽW 30bit [gR[h (z = 0 Ȃ xy ʂ2[gR[hɂȂ)
+uint32_t MortonCode3D(const DirectX::XMFLOAT3& p);
+
+// Op`Xg (3_ = 1Op`) bVbgɕ ([h / ItC1񂾂sz)
+// ԓIɋ߂ȂOp`bVbgɓ悤 vertices Op`PʂŕבւA
+// ebVbg̃oEfBOXtBAƖ@R[vZB
+std::vector<Meshlet> BuildMeshlets(std::vector<Vertex>& vertices,
+                                   uint32_t maxTriangles = c_MeshletMaxTriangles,
+                                   uint32_t minTriangles = c_MeshletMinTriangles);
+
+// CfbNXtOp`Xgp: _͋L̂œAindices Op`Pʂŕבւ
+std::vector<Meshlet> BuildMeshlets(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                                   uint32_t maxTriangles = c_MeshletMaxTriangles,
+                                   uint32_t minTriangles = c_MeshletMinTriangles);
\ No newline at end of file
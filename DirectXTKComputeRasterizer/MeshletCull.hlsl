@@ -0,0 +1,90 @@
+// ==================================================================================
+// MeshletCull.hlsl
+// bVbgPʂ̎JO / @R[ɂobNtFCXJO
+// ==================================================================================
+
+#include "RasterizerCommon.hlsli"
+
+// : bVbg
+StructuredBuffer<Meshlet> Meshlets : register(t2);
+
+// o: bVbg̃CfbNXƃJE^
+RWStructuredBuffer<uint> VisibleMeshlets : register(u0);
+RWByteAddressBuffer CullCounters : register(u1);
+
+// oEfBOXtBÅOɂ邩
+// WorldViewProj ̗񂩂 Local Ԃ6ʂoĔ肷 (Gribb-Hartmann@)
+bool IsSphereOutsideFrustum(float3 center, float radius)
+{
+    // columns[i] = WorldViewProj  i 
+    float4x4 columns = transpose(WorldViewProj);
+
+    float4 planes[6];
+    planes[0] = columns[3] + columns[0]; //    (-w <= x)
+    planes[1] = columns[3] - columns[0]; // E   (x <= w)
+    planes[2] = columns[3] + columns[1]; //    (-w <= y)
+    planes[3] = columns[3] - columns[1]; //    (y <= w)
+    planes[4] = columns[2];              // O (0 <= z)
+    planes[5] = columns[3] - columns[2]; //    (z <= w)
+
+    [unroll]
+    for (uint i = 0; i < 6; ++i)
+    {
+        float4 plane = planes[i] / length(planes[i].xyz);
+        if (dot(plane.xyz, center) + plane.w < -radius)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// bVbg̑SOp`Ă邩 (@R[ɂ锻)
+bool IsConeBackfacing(Meshlet meshlet)
+{
+    // @̂΂傫NX^̓R[JOȂ
+    if (meshlet.coneCutoff >= 1.0f)
+    {
+        return false;
+    }
+
+    if (ViewOrigin.w == 0.0f)
+    {
+        // se: ͑SNX^
+        return dot(ViewOrigin.xyz, meshlet.coneAxis) >= meshlet.coneCutoff;
+    }
+
+    // e: JXtBASւ̃xNgŔ (XtBAa̗]T)
+    float3 toCenter = meshlet.center - ViewOrigin.xyz;
+    return dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * length(toCenter) + meshlet.radius;
+}
+
+// --- C֐ ---
+// 1Xbh = 1bVbg
+[numthreads(64, 1, 1)]
+void CSCullMeshlets(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    uint index = dispatchThreadID.x;
+    if (index >= MeshletCount) return;
+
+    Meshlet meshlet = Meshlets[index];
+
+    if (IsSphereOutsideFrustum(meshlet.center, meshlet.radius))
+    {
+        CullCounters.InterlockedAdd(CULL_COUNTER_FRUSTUM_CULLED, 1);
+        CullCounters.InterlockedAdd(CULL_COUNTER_CULLED_TRIANGLES, meshlet.triangleCount);
+        return;
+    }
+
+    if (IsConeBackfacing(meshlet))
+    {
+        CullCounters.InterlockedAdd(CULL_COUNTER_BACKFACE_CULLED, 1);
+        CullCounters.InterlockedAdd(CULL_COUNTER_CULLED_TRIANGLES, meshlet.triangleCount);
+        return;
+    }
+
+    // Xg֒ǉ
+    uint slot;
+    CullCounters.InterlockedAdd(CULL_COUNTER_VISIBLE_MESHLETS, 1, slot);
+    VisibleMeshlets[slot] = index;
+}
@@ -0,0 +1,193 @@
+#include "pch.h"
+#include "PointCloudFile.h"
+#include <cfloat>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    template <typename T>
+    void SetSection(PointCloudFileHeader& header, PointCloudFileSectionType type, const std::vector<T>& data, uint64_t& offset)
+    {
+        MeshFileSection& section = header.sections[type];
+        section.offset = data.empty() ? 0 : AlignUp(offset, c_MeshFileSectionAlignment);
+        section.size = sizeof(T) * data.size();
+        section.stride = sizeof(T);
+        section.count = static_cast<uint32_t>(data.size());
+        if (!data.empty())
+        {
+            offset = section.offset + section.size;
+        }
+    }
+
+    template <typename T>
+    void WriteSection(std::ofstream& stream, const MeshFileSection& section, const std::vector<T>& data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        // ZNVE܂Ń[Ŗ߂
+        static const char zeros[c_MeshFileSectionAlignment] = {};
+        uint64_t position = static_cast<uint64_t>(stream.tellp());
+        stream.write(zeros, static_cast<std::streamsize>(section.offset - position));
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(section.size));
+    }
+}
+
+void WritePointCloudFile(const wchar_t* fileName, const std::vector<PointVertex>& points, const std::vector<PointChunk>& chunks)
+{
+    PointCloudFileHeader header = {};
+    header.magic = c_PointCloudFileMagic;
+    header.version = c_PointCloudFileVersion;
+    header.pointCount = static_cast<uint32_t>(points.size());
+    header.sectionCount = PointCloudFileSection_Count;
+
+    // `N AABB ͑S_𕢂̂ŁA_ǂݒɂ܂Ƃ߂
+    header.boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+    header.boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const auto& chunk : chunks)
+    {
+        header.boundsMin = { std::min(header.boundsMin.x, chunk.boundsMin.x), std::min(header.boundsMin.y, chunk.boundsMin.y), std::min(header.boundsMin.z, chunk.boundsMin.z) };
+        header.boundsMax = { std::max(header.boundsMax.x, chunk.boundsMax.x), std::max(header.boundsMax.y, chunk.boundsMax.y), std::max(header.boundsMax.z, chunk.boundsMax.z) };
+    }
+
+    uint64_t offset = sizeof(PointCloudFileHeader);
+    SetSection(header, PointCloudFileSection_Points, points, offset);
+    SetSection(header, PointCloudFileSection_Chunks, chunks, offset);
+
+    std::ofstream stream(std::filesystem::path(fileName), std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        OutputDebugStringA("Failed to create point cloud file\n");
+        throw std::runtime_error("Failed to create point cloud file");
+    }
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteSection(stream, header.sections[PointCloudFileSection_Points], points);
+    WriteSection(stream, header.sections[PointCloudFileSection_Chunks], chunks);
+
+    if (!stream)
+    {
+        OutputDebugStringA("Failed to write point cloud file\n");
+        throw std::runtime_error("Failed to write point cloud file");
+    }
+}
+
+void PointCloudFile::Open(const wchar_t* fileName)
+{
+    Close();
+
+    m_file = CreateFileW(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        OutputDebugStringA("Failed to open point cloud file\n");
+        throw std::runtime_error("Failed to open point cloud file");
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(m_file, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) < sizeof(PointCloudFileHeader)
+        || static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX)
+    {
+        Close();
+        OutputDebugStringA("Invalid point cloud file size\n");
+        throw std::runtime_error("Invalid point cloud file size");
+    }
+    m_fileSize = static_cast<uint64_t>(fileSize.QuadPart);
+
+    m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        Close();
+        OutputDebugStringA("Failed to create point cloud file mapping\n");
+        throw std::runtime_error("Failed to create point cloud file mapping");
+    }
+
+    m_view = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_view == nullptr)
+    {
+        Close();
+        OutputDebugStringA("Failed to map point cloud file\n");
+        throw std::runtime_error("Failed to map point cloud file");
+    }
+
+    // wb_̌ (\̂̂܂ GPU ɓn̂ŁAvfTCŸvmF)
+    const PointCloudFileHeader& header = GetHeader();
+    if (header.magic != c_PointCloudFileMagic || header.version != c_PointCloudFileVersion || header.sectionCount != PointCloudFileSection_Count)
+    {
+        Close();
+        OutputDebugStringA("Unsupported point cloud file format\n");
+        throw std::runtime_error("Unsupported point cloud file format");
+    }
+
+    static const uint32_t expectedStrides[PointCloudFileSection_Count] = { sizeof(PointVertex), sizeof(PointChunk) };
+    for (uint32_t i = 0; i < PointCloudFileSection_Count; ++i)
+    {
+        const MeshFileSection& section = header.sections[i];
+        if (section.count == 0)
+        {
+            continue;
+        }
+        if (section.stride != expectedStrides[i] || section.size != static_cast<uint64_t>(section.stride) * section.count
+            || section.offset % c_MeshFileSectionAlignment != 0 || section.offset > m_fileSize || section.size > m_fileSize - section.offset)
+        {
+            Close();
+            OutputDebugStringA("Corrupted point cloud file section\n");
+            throw std::runtime_error("Corrupted point cloud file section");
+        }
+    }
+
+    // `N_͈̔͂zĂƁAXvbg͈͊Oǂ
+    const uint32_t pointCount = GetPointCount();
+    const PointChunk* chunks = GetChunks();
+    bool valid = header.pointCount == pointCount;
+    for (uint32_t i = 0; valid && i < GetChunkCount(); ++i)
+    {
+        valid = chunks[i].pointCount <= c_PointChunkSize && chunks[i].firstPoint <= pointCount
+            && chunks[i].pointCount <= pointCount - chunks[i].firstPoint;
+    }
+    if (!valid)
+    {
+        Close();
+        OutputDebugStringA("Corrupted point cloud file chunk\n");
+        throw std::runtime_error("Corrupted point cloud file chunk");
+    }
+}
+
+void PointCloudFile::Close()
+{
+    if (m_view != nullptr)
+    {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_fileSize = 0;
+}
+
+void CreatePointCloudBuffers(ID3D11Device* device, ID3D11DeviceContext* context, const PointCloudFile& file, PointCloudBuffers& buffers)
+{
+    StreamFileSection(device, context, file.GetSection(PointCloudFileSection_Points), file.GetSectionData(PointCloudFileSection_Points), "point", buffers.pointSRV);
+    StreamFileSection(device, context, file.GetSection(PointCloudFileSection_Chunks), file.GetSectionData(PointCloudFileSection_Chunks), "point chunk", buffers.chunkSRV);
+    buffers.pointCount = file.GetPointCount();
+    buffers.chunkCount = file.GetChunkCount();
+
+    char debugMsg[256];
+    sprintf_s(debugMsg, "Point cloud loaded: %u points, %u chunks\n", buffers.pointCount, buffers.chunkCount);
+    OutputDebugStringA(debugMsg);
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "MeshFile.h"
+#include "PointSplat.h"
+
+// ==================================================================================
+// oCi_Qt@C (.dxrpoints)
+// BuildPointChunks ŕבւ_ƃ`NAPointSplatPass / SoftwarePointSplatter g
+// CAEĝ܂܃t@Cɕׂ́B
+// [PointCloudFileHeader][Points][Chunks]
+// ZNV̌`Ɣzu .dxrmesh Ɠ (MeshFileSectionAc_MeshFileSectionAlignment E)B
+// }bvr[̂܂ CPU ł̃XvbgɓnAGPU obt@֓]B
+// ==================================================================================
+
+constexpr uint32_t c_PointCloudFileMagic = 0x50525844; // "DXRP"
+constexpr uint32_t c_PointCloudFileVersion = 1;        // CAEgςグ邱
+
+enum PointCloudFileSectionType : uint32_t
+{
+    PointCloudFileSection_Points = 0,   // PointVertex[] (`N)
+    PointCloudFileSection_Chunks,       // PointChunk[]
+    PointCloudFileSection_Count
+};
+
+struct PointCloudFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pointCount;
+    uint32_t sectionCount;        // PointCloudFileSection_Count
+    DirectX::XMFLOAT3 boundsMin;  // S_ AABB (Jzup)
+    float    padding0;
+    DirectX::XMFLOAT3 boundsMax;
+    float    padding1;
+    MeshFileSection sections[PointCloudFileSection_Count];
+};
+
+static_assert(sizeof(PointCloudFileHeader) == 48 + 24 * PointCloudFileSection_Count, "PointCloudFileHeader layout changed");
+
+// BuildPointChunks ς݂ points / chunks  .dxrpoints Ƃďo
+void WritePointCloudFile(const wchar_t* fileName, const std::vector<PointVertex>& points, const std::vector<PointChunk>& chunks);
+
+// }bvŊJ .dxrpoints (ǂݎp)
+class PointCloudFile
+{
+public:
+    PointCloudFile() = default;
+    ~PointCloudFile() { Close(); }
+
+    PointCloudFile(const PointCloudFile&) = delete;
+    PointCloudFile& operator=(const PointCloudFile&) = delete;
+
+    // t@CŜ}bvAwb_ƃZNV͈̔́A`N̓_͈̔͂؂
+    void Open(const wchar_t* fileName);
+    void Close();
+
+    bool IsOpen() const { return m_view != nullptr; }
+    uint64_t GetFileSize() const { return m_fileSize; }
+    const PointCloudFileHeader& GetHeader() const { return *reinterpret_cast<const PointCloudFileHeader*>(m_view); }
+    const MeshFileSection& GetSection(PointCloudFileSectionType type) const { return GetHeader().sections[type]; }
+    const uint8_t* GetSectionData(PointCloudFileSectionType type) const { return m_view + GetSection(type).offset; }
+
+    uint32_t GetPointCount() const { return GetSection(PointCloudFileSection_Points).count; }
+    uint32_t GetChunkCount() const { return GetSection(PointCloudFileSection_Chunks).count; }
+    const PointVertex* GetPoints() const { return reinterpret_cast<const PointVertex*>(GetSectionData(PointCloudFileSection_Points)); }
+    const PointChunk* GetChunks() const { return reinterpret_cast<const PointChunk*>(GetSectionData(PointCloudFileSection_Chunks)); }
+
+private:
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+    const uint8_t* m_view = nullptr;
+    uint64_t m_fileSize = 0;
+};
+
+// GPU ̓_Q (PointSplatPass::Splat ɂ̂܂ܓn)
+struct PointCloudBuffers {
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pointSRV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> chunkSRV;
+    uint32_t pointCount = 0;
+    uint32_t chunkCount = 0;
+};
+
+// }bvt@C̊eZNVAc_MeshStreamChunkSize  GPU obt@֓]
+void CreatePointCloudBuffers(ID3D11Device* device, ID3D11DeviceContext* context, const PointCloudFile& file, PointCloudBuffers& buffers);
@@ -0,0 +1,454 @@
+#include "pch.h"
+#include "PointSplat.h"
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <cfloat>
+#include <future>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <d3dcompiler.h>
+
+using namespace DirectX;
+
+namespace
+{
+    // eXbh̗vf [0, count) ɍs func(vf, Xbh) Ă (Xbh 0 ͌Ăяo)
+    template <typename Func>
+    void ParallelFor(uint32_t workerCount, uint32_t count, Func&& func)
+    {
+        std::atomic<uint32_t> next = 0;
+        auto worker = [&](uint32_t w)
+        {
+            for (uint32_t n = next++; n < count; n = next++)
+            {
+                func(n, w);
+            }
+        };
+
+        std::vector<std::future<void>> tasks;
+        for (uint32_t w = 1; w < workerCount; ++w)
+        {
+            tasks.push_back(std::async(std::launch::async, worker, w));
+        }
+        worker(0);
+        for (auto& task : tasks)
+        {
+            task.get();
+        }
+    }
+
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> CompilePointSplatShader(ID3D11Device* device, const wchar_t* shaderFileName, const char* entryPoint)
+    {
+        Microsoft::WRL::ComPtr<ID3DBlob> csBlob;
+        Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+        HRESULT hr = D3DCompileFromFile(
+            shaderFileName,
+            nullptr,
+            D3D_COMPILE_STANDARD_FILE_INCLUDE,
+            entryPoint,
+            "cs_5_0",
+            D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG,
+            0,
+            &csBlob,
+            &errorBlob
+        );
+
+        if (FAILED(hr))
+        {
+            if (errorBlob)
+            {
+                OutputDebugStringA("Point splat shader compilation failed:\n");
+                OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+            }
+            throw std::runtime_error("Point splat shader compilation failed");
+        }
+
+        Microsoft::WRL::ComPtr<ID3D11ComputeShader> shader;
+        hr = device->CreateComputeShader(csBlob->GetBufferPointer(), csBlob->GetBufferSize(), nullptr, &shader);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create point splat shader\n");
+            throw std::runtime_error("Failed to create point splat shader");
+        }
+        return shader;
+    }
+
+    void CreateTargetBuffer(ID3D11Device* device, uint32_t count, Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>& uav)
+    {
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = count * sizeof(uint32_t);
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = sizeof(uint32_t);
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+        HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, &buffer);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create point splat target buffer\n");
+            throw std::runtime_error("Failed to create point splat target buffer");
+        }
+
+        D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+        uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+        uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+        uavDesc.Buffer.NumElements = count;
+
+        hr = device->CreateUnorderedAccessView(buffer.Get(), &uavDesc, uav.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create point splat target UAV\n");
+            throw std::runtime_error("Failed to create point splat target UAV");
+        }
+    }
+}
+
+void BuildPointChunks(std::vector<PointVertex>& points, std::vector<PointChunk>& chunks)
+{
+    chunks.clear();
+    const uint32_t pointCount = static_cast<uint32_t>(points.size());
+    if (pointCount == 0)
+    {
+        return;
+    }
+
+    // 1. Ŝ AABB ŐKʒũ[gɕׂ
+    XMVECTOR boundsMin = g_XMFltMax;
+    XMVECTOR boundsMax = XMVectorNegate(g_XMFltMax);
+    for (const PointVertex& point : points)
+    {
+        const XMVECTOR p = XMLoadFloat3(&point.pos);
+        boundsMin = XMVectorMin(boundsMin, p);
+        boundsMax = XMVectorMax(boundsMax, p);
+    }
+
+    const XMVECTOR extent = XMVectorMax(XMVectorSubtract(boundsMax, boundsMin), g_XMEpsilon);
+    std::vector<uint32_t> codes(pointCount);
+    for (uint32_t i = 0; i < pointCount; ++i)
+    {
+        XMFLOAT3 normalized;
+        XMStoreFloat3(&normalized, XMVectorDivide(XMVectorSubtract(XMLoadFloat3(&points[i].pos), boundsMin), extent));
+        codes[i] = MortonCode3D(normalized);
+    }
+
+    std::vector<uint32_t> order(pointCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+
+    std::vector<PointVertex> sorted(pointCount);
+    for (uint32_t i = 0; i < pointCount; ++i)
+    {
+        sorted[i] = points[order[i]];
+    }
+    points.swap(sorted);
+
+    // 2. 擪 c_PointChunkSize ̃`NɂA`NVbt
+    std::mt19937 random(12345);
+    chunks.reserve((pointCount + c_PointChunkSize - 1) / c_PointChunkSize);
+    for (uint32_t first = 0; first < pointCount; first += c_PointChunkSize)
+    {
+        const uint32_t count = std::min(c_PointChunkSize, pointCount - first);
+        std::shuffle(points.begin() + first, points.begin() + first + count, random);
+
+        XMVECTOR chunkMin = g_XMFltMax;
+        XMVECTOR chunkMax = XMVectorNegate(g_XMFltMax);
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const XMVECTOR p = XMLoadFloat3(&points[i].pos);
+            chunkMin = XMVectorMin(chunkMin, p);
+            chunkMax = XMVectorMax(chunkMax, p);
+        }
+
+        PointChunk chunk = {};
+        XMStoreFloat3(&chunk.boundsMin, chunkMin);
+        XMStoreFloat3(&chunk.boundsMax, chunkMax);
+        chunk.firstPoint = first;
+        chunk.pointCount = count;
+        chunks.push_back(chunk);
+    }
+}
+
+uint32_t GetPointChunkDrawCount(const PointChunk& chunk, FXMMATRIX worldViewProj, uint32_t width, uint32_t height, float density)
+{
+    if (density <= 0.0f)
+    {
+        return chunk.pointCount;
+    }
+
+    // AABB 8_ʂ֎ʂOڋ`
+    float minX = FLT_MAX, minY = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (uint32_t k = 0; k < 8; ++k)
+    {
+        const XMVECTOR corner = XMVectorSet((k & 1) ? chunk.boundsMax.x : chunk.boundsMin.x,
+                                            (k & 2) ? chunk.boundsMax.y : chunk.boundsMin.y,
+                                            (k & 4) ? chunk.boundsMax.z : chunk.boundsMin.z, 1.0f);
+        XMFLOAT4 clip;
+        XMStoreFloat4(&clip, XMVector4Transform(corner, worldViewProj));
+
+        // J܂`N͉ʏ̑傫܂Ȃ̂ŊԈȂ
+        if (clip.w <= 1e-6f)
+        {
+            return chunk.pointCount;
+        }
+        const float x = (clip.x / clip.w + 1.0f) * 0.5f * width;
+        const float y = (1.0f - clip.y / clip.w) * 0.5f * height;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    // ʊÕ`N͕`ȂBʂɎ߂`̖ʐ (1 sNZ 1 sNZ) x density _`
+    if (maxX < 0.0f || maxY < 0.0f || minX > static_cast<float>(width) || minY > static_cast<float>(height))
+    {
+        return 0;
+    }
+    const float area = std::max(std::min(maxX, static_cast<float>(width)) - std::max(minX, 0.0f), 1.0f)
+                     * std::max(std::min(maxY, static_cast<float>(height)) - std::max(minY, 0.0f), 1.0f);
+    return static_cast<uint32_t>(std::min(static_cast<float>(chunk.pointCount), std::ceil(area * density)));
+}
+
+void SoftwarePointSplatter::Initialize(uint32_t width, uint32_t height)
+{
+    m_width = width;
+    m_height = height;
+    m_splats = std::make_unique<std::atomic<uint64_t>[]>(static_cast<size_t>(width) * height);
+    m_color.assign(static_cast<size_t>(width) * height, 0);
+    Clear();
+}
+
+void SoftwarePointSplatter::Clear()
+{
+    const size_t pixelCount = static_cast<size_t>(m_width) * m_height;
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+    {
+        m_splats[pixel].store(c_PointSplatEmpty, std::memory_order_relaxed);
+    }
+    m_splattedPoints = 0;
+    m_skippedPoints = 0;
+}
+
+void SoftwarePointSplatter::Splat(const PointVertex* points, const PointChunk* chunks, uint32_t chunkCount, FXMMATRIX worldViewProj)
+{
+    const uint32_t workerCount = std::max(1u, std::min(m_threadCount != 0 ? m_threadCount : std::thread::hardware_concurrency(), chunkCount));
+    std::vector<uint64_t> splatted(workerCount, 0);
+    std::vector<uint64_t> skipped(workerCount, 0);
+
+    const XMMATRIX transform = worldViewProj;
+    const float width = static_cast<float>(m_width);
+    const float height = static_cast<float>(m_height);
+    ParallelFor(workerCount, chunkCount, [&](uint32_t c, uint32_t w)
+    {
+        const PointChunk& chunk = chunks[c];
+        const uint32_t drawCount = GetPointChunkDrawCount(chunk, transform, m_width, m_height, m_desc.density);
+        splatted[w] += drawCount;
+        skipped[w] += chunk.pointCount - drawCount;
+
+        const PointVertex* chunkPoints = points + chunk.firstPoint;
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            XMFLOAT4 clip;
+            XMStoreFloat4(&clip, XMVector3Transform(XMLoadFloat3(&chunkPoints[i].pos), transform));
+            if (!(clip.w > 0.0f)) continue;
+
+            // [x 0 ~ 1 ŉʓ̓_ (NaN Ƃ)
+            const float invW = 1.0f / clip.w;
+            const float depth = clip.z * invW;
+            const float x = (clip.x * invW + 1.0f) * 0.5f * width;
+            const float y = (1.0f - clip.y * invW) * 0.5f * height;
+            if (!(depth >= 0.0f && depth <= 1.0f && x >= 0.0f && x < width && y >= 0.0f && y < height)) continue;
+
+            // 64bit  atomic ̍ŏl (ȂȂȂ珑Ȃ)
+            std::atomic<uint64_t>& target = m_splats[static_cast<size_t>(y) * m_width + static_cast<uint32_t>(x)];
+            const uint64_t value = PackPointSplat(depth, chunkPoints[i].color);
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    });
+
+    for (uint32_t w = 0; w < workerCount; ++w)
+    {
+        m_splattedPoints += splatted[w];
+        m_skippedPoints += skipped[w];
+    }
+}
+
+void SoftwarePointSplatter::Resolve()
+{
+    // sƂɕɉ (ǂނ̂ m_splats Ȃ̂ōs̏ԂɂȂ)
+    const uint32_t workerCount = std::max(1u, std::min(m_threadCount != 0 ? m_threadCount : std::thread::hardware_concurrency(), m_height));
+    std::vector<size_t> covered(workerCount, 0);
+    std::vector<size_t> filled(workerCount, 0);
+    const int radius = static_cast<int>(c_PointHoleFillRadius);
+
+    ParallelFor(workerCount, m_height, [&](uint32_t y, uint32_t w)
+    {
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            const size_t pixel = static_cast<size_t>(y) * m_width + x;
+            const uint64_t value = m_splats[pixel].load(std::memory_order_relaxed);
+            if (value != c_PointSplatEmpty)
+            {
+                m_color[pixel] = static_cast<uint32_t>(value);
+                ++covered[w];
+                continue;
+            }
+
+            // : ܂̕`ꂽsNZ\΁AłO̓_̐Fg
+            uint64_t nearest = c_PointSplatEmpty;
+            uint32_t neighbors = 0;
+            if (m_desc.holeFill)
+            {
+                const int y0 = std::max(static_cast<int>(y) - radius, 0);
+                const int y1 = std::min(static_cast<int>(y) + radius, static_cast<int>(m_height) - 1);
+                const int x0 = std::max(static_cast<int>(x) - radius, 0);
+                const int x1 = std::min(static_cast<int>(x) + radius, static_cast<int>(m_width) - 1);
+                for (int ny = y0; ny <= y1; ++ny)
+                {
+                    for (int nx = x0; nx <= x1; ++nx)
+                    {
+                        const uint64_t neighbor = m_splats[static_cast<size_t>(ny) * m_width + nx].load(std::memory_order_relaxed);
+                        if (neighbor == c_PointSplatEmpty) continue;
+                        nearest = std::min(nearest, neighbor);
+                        ++neighbors;
+                    }
+                }
+            }
+
+            if (neighbors >= c_PointHoleFillMinNeighbors)
+            {
+                m_color[pixel] = static_cast<uint32_t>(nearest);
+                ++filled[w];
+            }
+            else
+            {
+                m_color[pixel] = m_desc.clearColor;
+            }
+        }
+    });
+
+    m_coveredPixels = 0;
+    m_filledPixels = 0;
+    for (uint32_t w = 0; w < workerCount; ++w)
+    {
+        m_coveredPixels += covered[w];
+        m_filledPixels += filled[w];
+    }
+}
+
+void PointSplatPass::Initialize(ID3D11Device* device, const wchar_t* shaderFileName)
+{
+    pSplatDepthShader = CompilePointSplatShader(device, shaderFileName, "CSSplatDepth");
+    pSplatColorShader = CompilePointSplatShader(device, shaderFileName, "CSSplatColor");
+    pResolveShader = CompilePointSplatShader(device, shaderFileName, "CSResolve");
+
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.ByteWidth = sizeof(PointSplatCBData);
+    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    HRESULT hr = device->CreateBuffer(&cbDesc, nullptr, &pConstantBuffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create point splat constant buffer\n");
+        throw std::runtime_error("Failed to create point splat constant buffer");
+    }
+    OutputDebugStringA("Point splat shaders created successfully\n");
+}
+
+void PointSplatPass::CreateTargets(ID3D11Device* device, uint32_t width, uint32_t height)
+{
+    CreateTargetBuffer(device, width * height, pDepthUAV);
+    CreateTargetBuffer(device, width * height, pColorUAV);
+    m_width = width;
+    m_height = height;
+}
+
+void PointSplatPass::Clear(ID3D11DeviceContext* context)
+{
+    // [xFől (C++  c_PointSplatEmpty ̏ʂƉ)
+    const UINT empty[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+    context->ClearUnorderedAccessViewUint(pDepthUAV.Get(), empty);
+    context->ClearUnorderedAccessViewUint(pColorUAV.Get(), empty);
+}
+
+void PointSplatPass::UpdateConstants(ID3D11DeviceContext* context, FXMMATRIX worldViewProj, uint32_t chunkCount, const PointSplatDesc& desc)
+{
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = context->Map(pConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to map point splat constant buffer\n");
+        throw std::runtime_error("Failed to map point splat constant buffer");
+    }
+
+    // HLSL ͗Dœǂނߓ]uēn
+    PointSplatCBData* data = reinterpret_cast<PointSplatCBData*>(mapped.pData);
+    data->worldViewProj = XMMatrixTranspose(worldViewProj);
+    data->screenSize = XMFLOAT2(static_cast<float>(m_width), static_cast<float>(m_height));
+    data->density = desc.density;
+    data->chunkCount = chunkCount;
+    data->holeFill = desc.holeFill ? 1 : 0;
+    data->clearColor = desc.clearColor;
+    context->Unmap(pConstantBuffer.Get(), 0);
+}
+
+void PointSplatPass::Splat(ID3D11DeviceContext* context, ID3D11ShaderResourceView* pointSRV, ID3D11ShaderResourceView* chunkSRV, uint32_t chunkCount,
+                           FXMMATRIX worldViewProj, const PointSplatDesc& desc)
+{
+    if (chunkCount == 0)
+    {
+        return;
+    }
+
+    if (chunkCount > D3D11_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION)
+    {
+        OutputDebugStringA("Too many point chunks\n");
+        throw std::runtime_error("Too many point chunks");
+    }
+
+    UpdateConstants(context, worldViewProj, chunkCount, desc);
+
+    ID3D11ShaderResourceView* srvs[] = { pointSRV, chunkSRV };
+    ID3D11UnorderedAccessView* uavs[] = { pDepthUAV.Get(), pColorUAV.Get() };
+    context->CSSetConstantBuffers(0, 1, pConstantBuffer.GetAddressOf());
+    context->CSSetShaderResources(0, 2, srvs);
+    context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+
+    // 1O[v = 1`NB[x̍ŏl܂ĂA̐[x̓_̐F̍ŏl
+    context->CSSetShader(pSplatDepthShader.Get(), nullptr, 0);
+    context->Dispatch(chunkCount, 1, 1);
+    context->CSSetShader(pSplatColorShader.Get(), nullptr, 0);
+    context->Dispatch(chunkCount, 1, 1);
+
+    ID3D11ShaderResourceView* nullSRVs[2] = {};
+    ID3D11UnorderedAccessView* nullUAVs[2] = {};
+    ID3D11Buffer* nullCB = nullptr;
+    context->CSSetShaderResources(0, 2, nullSRVs);
+    context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+    context->CSSetConstantBuffers(0, 1, &nullCB);
+    context->CSSetShader(nullptr, nullptr, 0);
+}
+
+void PointSplatPass::Resolve(ID3D11DeviceContext* context, ID3D11UnorderedAccessView* outputUAV, const PointSplatDesc& desc)
+{
+    UpdateConstants(context, XMMatrixIdentity(), 0, desc);
+
+    ID3D11UnorderedAccessView* uavs[] = { pDepthUAV.Get(), pColorUAV.Get(), outputUAV };
+    context->CSSetConstantBuffers(0, 1, pConstantBuffer.GetAddressOf());
+    context->CSSetUnorderedAccessViews(0, 3, uavs, nullptr);
+    context->CSSetShader(pResolveShader.Get(), nullptr, 0);
+    context->Dispatch((m_width + 15) / 16, (m_height + 15) / 16, 1);
+
+    ID3D11UnorderedAccessView* nullUAVs[3] = {};
+    ID3D11Buffer* nullCB = nullptr;
+    context->CSSetUnorderedAccessViews(0, 3, nullUAVs, nullptr);
+    context->CSSetConstantBuffers(0, 1, &nullCB);
+    context->CSSetShader(nullptr, nullptr, 0);
+}
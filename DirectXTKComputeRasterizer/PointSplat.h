@@ -0,0 +1,162 @@
+#pragma once
+#include "DirectXTKComputeRasterizer.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+// ==================================================================================
+// _Q̃Xvbg
+// LiDAR Ȃǂ̓_QOp`̃[vʂɕ`B_ƂɕϊEeA[x ( 32bit) 
+// F ( 32bit) ܂Ƃ߂ 64bit l̍ŏlsNZɎc (łO̓_cA[xȂ
+// F̏ɂȂ̂ŁA_`ԂXbhɂ炸ʂɂȂ)B
+// _ c_PointChunkSize ̃`NɕA`N̉ʏ̑傫`_̐߂
+// (LODB`N̓_̓VbtĂ̂ŁA擪̉_̓`NŜaɕWɂȂ)B
+// Ōɓ_̊Ԃ̌A܂̍łO̓_̐FŖ߂ĉB
+// ==================================================================================
+
+// 1`N̓_̐ (GPU ł1O[v = 1`N)
+constexpr uint32_t c_PointChunkSize = 4096;
+constexpr uint32_t c_PointSplatGroupSize = 256;
+
+// `ĂȂsNZ̒l (ǂ̓_傫)
+constexpr uint64_t c_PointSplatEmpty = UINT64_MAX;
+
+// : ܂ (2 x c_PointHoleFillRadius + 1 ̐`) ̕`ꂽsNZ c_PointHoleFillMinNeighbors ȏ゠̃sNZ𖄂߂
+// (_Q̉̊O܂ōLȂ)
+constexpr uint32_t c_PointHoleFillRadius = 2;
+constexpr uint32_t c_PointHoleFillMinNeighbors = 6;
+
+// _ (16byte): GPU  PointVertex ƓCAEg
+struct PointVertex {
+    DirectX::XMFLOAT3 pos;  // [JW
+    uint32_t color;         // R8G8B8A8
+};
+
+// _̃`N (32byte): GPU  PointChunk ƓCAEg
+struct PointChunk {
+    DirectX::XMFLOAT3 boundsMin;
+    uint32_t firstPoint;
+    DirectX::XMFLOAT3 boundsMax;
+    uint32_t pointCount;    // c_PointChunkSize ȉ
+};
+
+static_assert(sizeof(PointVertex) == 16, "PointVertex layout changed");
+static_assert(sizeof(PointChunk) == 32, "PointChunk layout changed");
+
+// Xvbg̐ݒ
+struct PointSplatDesc {
+    float density = 1.0f;       // `N̉ʏ̊Oڋ` 1 sNZɕ`_̐̏ (0 ȂԈȂ)
+    bool holeFill = true;       // ̂Ƃɓ_̊Ԃ̌𖄂߂邩
+    uint32_t clearColor = 0;    // _`ȂsNZ̐F (R8G8B8A8)
+};
+
+// [x (0 ~ 1) ƐF 1 64bit lɂ܂Ƃ߂ (0 ȏ float ̃rbg͑召̏B-0 ͕𗎂Ƃ 0 ɂ)
+inline uint64_t PackPointSplat(float depth, uint32_t color)
+{
+    uint32_t depthBits;
+    memcpy(&depthBits, &depth, sizeof(depthBits));
+    return (static_cast<uint64_t>(depthBits & 0x7FFFFFFF) << 32) | color;
+}
+
+inline float GetPointSplatDepth(uint64_t value)
+{
+    const uint32_t depthBits = static_cast<uint32_t>(value >> 32);
+    float depth;
+    memcpy(&depth, &depthBits, sizeof(depth));
+    return depth;
+}
+
+// points ԓIɋ߂ ([g) ɕבւAc_PointChunkSize ̃`Nɕ
+// `N̓_ LOD Ő擪`悤ɃVbt (̎͌Œ)
+void BuildPointChunks(std::vector<PointVertex>& points, std::vector<PointChunk>& chunks);
+
+// `N density ŕ`Ƃ̓_̐ (GPU ł ChunkDrawCount ƓBʊOȂ 0AJ܂ȂS_)
+uint32_t GetPointChunkDrawCount(const PointChunk& chunk, DirectX::FXMMATRIX worldViewProj, uint32_t width, uint32_t height, float density);
+
+// CPU : 64bit  atomic ̍ŏlœ_`
+class SoftwarePointSplatter
+{
+public:
+    void Initialize(uint32_t width, uint32_t height);
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+
+    void SetDesc(const PointSplatDesc& desc) { m_desc = desc; }
+    const PointSplatDesc& GetDesc() const { return m_desc; }
+    // _`Xbh (0 Ȃn[hEFÃXbhB 1)
+    void SetThreadCount(uint32_t count) { m_threadCount = count; }
+    uint32_t GetThreadCount() const { return m_threadCount; }
+
+    // SsNZ c_PointSplatEmpty ɂ
+    void Clear();
+    // chunks ̓_ (}bvt@C̃r[ł悢)  worldViewProj ŕϊĕ`BClear  Resolve ܂łɉxłĂׂ
+    void Splat(const PointVertex* points, const PointChunk* chunks, uint32_t chunkCount, DirectX::FXMMATRIX worldViewProj);
+    // `_Fɂ (holeFill Ȃ猊𖄂߂)
+    void Resolve();
+
+    const std::vector<uint32_t>& GetColorBuffer() const { return m_color; }
+    // sNZ̐[xƐF 64bit l (Splat ̌Ac_PointSplatEmpty Ȃ_Ȃ)
+    uint64_t GetSplat(uint32_t x, uint32_t y) const { return m_splats[static_cast<size_t>(y) * m_width + x].load(std::memory_order_relaxed); }
+
+    // v (Clear  0 ɖ߂B߂͒߂ Resolve)
+    uint64_t GetSplattedPoints() const { return m_splattedPoints; }     // LOD őI΂ĕϊ_
+    uint64_t GetSkippedPoints() const { return m_skippedPoints; }       // LOD ƉʊÕ`NŔ΂_
+    size_t GetCoveredPixels() const { return m_coveredPixels; }         // _`ꂽsNZ
+    size_t GetFilledPixels() const { return m_filledPixels; }           // ߂ŐFtsNZ
+
+private:
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    PointSplatDesc m_desc;
+    uint32_t m_threadCount = 1;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> m_splats;
+    std::vector<uint32_t> m_color;
+
+    uint64_t m_splattedPoints = 0;
+    uint64_t m_skippedPoints = 0;
+    size_t m_coveredPixels = 0;
+    size_t m_filledPixels = 0;
+};
+
+// GPU ł̒萔obt@ (PointSplat.hlsl  PointSplatConstants ƓCAEg)
+struct PointSplatCBData {
+    DirectX::XMMATRIX worldViewProj;
+    DirectX::XMFLOAT2 screenSize;
+    float density;
+    uint32_t chunkCount;
+    uint32_t holeFill;
+    uint32_t clearColor;
+    uint32_t padding[2];
+};
+
+// GPU : cs_5_0 ɂ 64bit  atomic Ȃ̂ŁA[x InterlockedMin ̃pX̌ɁA
+// [xv_F InterlockedMin pXœŏl߂ (_2ϊ)
+class PointSplatPass
+{
+public:
+    void Initialize(ID3D11Device* device, const wchar_t* shaderFileName = L"PointSplat.hlsl");
+
+    // width x height ̐[xƐF̃obt@ (𑜓xςĂђ)
+    void CreateTargets(ID3D11Device* device, uint32_t width, uint32_t height);
+
+    // SsNZ_Ȃɂ
+    void Clear(ID3D11DeviceContext* context);
+    // pointSRV / chunkSRV (CreatePointCloudBuffers) ̓_`
+    void Splat(ID3D11DeviceContext* context, ID3D11ShaderResourceView* pointSRV, ID3D11ShaderResourceView* chunkSRV, uint32_t chunkCount,
+               DirectX::FXMMATRIX worldViewProj, const PointSplatDesc& desc);
+    // `_ outputUAV (R8G8B8A8  RWTexture2DBCreateTargets ̑傫) ɉ
+    void Resolve(ID3D11DeviceContext* context, ID3D11UnorderedAccessView* outputUAV, const PointSplatDesc& desc);
+
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pSplatDepthShader;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pSplatColorShader;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pResolveShader;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pDepthUAV;    // sNZƂ̐[x (float ̃rbg)
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> pColorUAV;    // sNZƂ̐F ([xŏ̓_̒ōŏ)
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+
+private:
+    void UpdateConstants(ID3D11DeviceContext* context, DirectX::FXMMATRIX worldViewProj, uint32_t chunkCount, const PointSplatDesc& desc);
+};
@@ -0,0 +1,208 @@
+// ==================================================================================
+// PointSplat.hlsl
+// _Q̃Xvbg (C++  PointSplat.h  SoftwarePointSplatter ƓʂɂȂ)
+// CSSplatDepth / CSSplatColor: 1O[v = 1`NBLOD őI񂾃`N̐擪̓_ϊĕ`
+//   cs_5_0 ɂ 64bit  atomic Ȃ̂ŁA[x̍ŏl߂ĂA̐[x̓_̐F̍ŏl
+//   ([xƐF܂Ƃ߂ 64bit l̍ŏlƓ)
+// CSResolve: 1Xbh = 1sNZB`_̐Fo͂A_̊Ԃ̌܂̍łO̓_Ŗ߂
+// ==================================================================================
+
+#define POINT_SPLAT_GROUP_SIZE 256          // C++  c_PointSplatGroupSize ƈv邱
+#define POINT_HOLE_FILL_RADIUS 2            // C++  c_PointHoleFillRadius ƈv邱
+#define POINT_HOLE_FILL_MIN_NEIGHBORS 6     // C++  c_PointHoleFillMinNeighbors ƈv邱
+#define POINT_SPLAT_EMPTY 0xFFFFFFFF        // _`ĂȂsNZ̐[xƐF
+
+// _ (C++  PointVertex ƓCAEg)
+struct PointVertex {
+    float3 pos;     // [JW
+    uint color;     // R8G8B8A8
+};
+
+// _̃`N (C++  PointChunk ƓCAEg)
+struct PointChunk {
+    float3 boundsMin;
+    uint firstPoint;
+    float3 boundsMax;
+    uint pointCount;
+};
+
+// 萔obt@ (C++  PointSplatCBData ƓCAEg)
+cbuffer PointSplatConstants : register(b0)
+{
+    matrix WorldViewProj;   // Local -> Clip s
+    float2 ScreenSize;
+    float Density;          // `N̉ʏ̊Oڋ` 1 sNZɕ`_̐̏ (0 ȂԈȂ)
+    uint ChunkCount;
+    uint HoleFill;          // 1 Ȃ CSResolve Ō𖄂߂
+    uint ClearColor;        // _`ȂsNZ̐F (R8G8B8A8)
+    uint2 Padding;
+};
+
+StructuredBuffer<PointVertex> Points : register(t0);
+StructuredBuffer<PointChunk> Chunks : register(t1);
+
+// sNZƂ̐[x (0 ~ 1  float ̃rbg) ƁA̐[x̓_̐F̍ŏl
+RWStructuredBuffer<uint> SplatDepth : register(u0);
+RWStructuredBuffer<uint> SplatColor : register(u1);
+
+// o: F (CSResolve)
+RWTexture2D<unorm float4> Output : register(u2);
+
+groupshared uint gs_DrawCount;
+
+// `N Density ŕ`Ƃ̓_̐ (C++  GetPointChunkDrawCount Ɠ)
+uint ChunkDrawCount(PointChunk chunk)
+{
+    if (Density <= 0.0f)
+    {
+        return chunk.pointCount;
+    }
+
+    // AABB 8_ʂ֎ʂOڋ` (J܂`N͊ԈȂ)
+    float2 screenMin = 3.402823466e+38f;
+    float2 screenMax = -3.402823466e+38f;
+    [unroll] for (uint k = 0; k < 8; ++k)
+    {
+        float3 corner = float3((k & 1) ? chunk.boundsMax.x : chunk.boundsMin.x,
+                               (k & 2) ? chunk.boundsMax.y : chunk.boundsMin.y,
+                               (k & 4) ? chunk.boundsMax.z : chunk.boundsMin.z);
+        float4 clip = mul(float4(corner, 1.0f), WorldViewProj);
+        if (clip.w <= 1e-6f)
+        {
+            return chunk.pointCount;
+        }
+        float2 s = float2((clip.x / clip.w + 1.0f) * 0.5f * ScreenSize.x, (1.0f - clip.y / clip.w) * 0.5f * ScreenSize.y);
+        screenMin = min(screenMin, s);
+        screenMax = max(screenMax, s);
+    }
+
+    // ʊÕ`N͕`ȂBʂɎ߂`̖ʐ (1 sNZ 1 sNZ) x Density _`
+    if (any(screenMax < 0.0f) || any(screenMin > ScreenSize))
+    {
+        return 0;
+    }
+    float2 size = max(min(screenMax, ScreenSize) - max(screenMin, 0.0f), 1.0f);
+    return uint(min(float(chunk.pointCount), ceil(size.x * size.y * Density)));
+}
+
+// _ʂ֎ʂ ([x 0 ~ 1 ŉʓȂ trueBC++  SoftwarePointSplatter::Splat Ɠ)
+bool ProjectPoint(float3 pos, out uint pixelIndex, out uint depthBits)
+{
+    pixelIndex = 0;
+    depthBits = 0;
+
+    float4 clip = mul(float4(pos, 1.0f), WorldViewProj);
+    if (!(clip.w > 0.0f))
+    {
+        return false;
+    }
+
+    float invW = 1.0f / clip.w;
+    float depth = clip.z * invW;
+    float2 s = float2((clip.x * invW + 1.0f) * 0.5f * ScreenSize.x, (1.0f - clip.y * invW) * 0.5f * ScreenSize.y);
+    if (!(depth >= 0.0f && depth <= 1.0f && s.x >= 0.0f && s.x < ScreenSize.x && s.y >= 0.0f && s.y < ScreenSize.y))
+    {
+        return false;
+    }
+
+    // -0 ͕𗎂Ƃ 0 ɂ (0 ȏ float ̃rbg͑召̏)
+    pixelIndex = uint(s.y) * uint(ScreenSize.x) + uint(s.x);
+    depthBits = asuint(depth) & 0x7FFFFFFF;
+    return true;
+}
+
+// `N̕`_̐O[vŋL
+void BeginChunk(PointChunk chunk, uint groupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gs_DrawCount = ChunkDrawCount(chunk);
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[numthreads(POINT_SPLAT_GROUP_SIZE, 1, 1)]
+void CSSplatDepth(uint3 groupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    PointChunk chunk = Chunks[groupID.x];
+    BeginChunk(chunk, groupIndex);
+
+    for (uint i = groupIndex; i < gs_DrawCount; i += POINT_SPLAT_GROUP_SIZE)
+    {
+        uint pixelIndex, depthBits;
+        if (ProjectPoint(Points[chunk.firstPoint + i].pos, pixelIndex, depthBits))
+        {
+            InterlockedMin(SplatDepth[pixelIndex], depthBits);
+        }
+    }
+}
+
+[numthreads(POINT_SPLAT_GROUP_SIZE, 1, 1)]
+void CSSplatColor(uint3 groupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    PointChunk chunk = Chunks[groupID.x];
+    BeginChunk(chunk, groupIndex);
+
+    // CSSplatDepth Ō܂łO̐[x̓_F
+    for (uint i = groupIndex; i < gs_DrawCount; i += POINT_SPLAT_GROUP_SIZE)
+    {
+        PointVertex splatPoint = Points[chunk.firstPoint + i];
+        uint pixelIndex, depthBits;
+        if (ProjectPoint(splatPoint.pos, pixelIndex, depthBits) && SplatDepth[pixelIndex] == depthBits)
+        {
+            InterlockedMin(SplatColor[pixelIndex], splatPoint.color);
+        }
+    }
+}
+
+[numthreads(16, 16, 1)]
+void CSResolve(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    int2 size = int2(ScreenSize);
+    int2 pixel = int2(dispatchThreadID.xy);
+    if (any(pixel >= size))
+    {
+        return;
+    }
+
+    uint index = pixel.y * size.x + pixel.x;
+    uint depth = SplatDepth[index];
+    uint color = SplatColor[index];
+
+    // : ܂̕`ꂽsNZ\΁AłO̓_ ([xAF̏ɏ) ̐Fg
+    if (depth == POINT_SPLAT_EMPTY && HoleFill != 0)
+    {
+        uint nearestDepth = POINT_SPLAT_EMPTY;
+        uint nearestColor = POINT_SPLAT_EMPTY;
+        uint neighbors = 0;
+        for (int dy = -POINT_HOLE_FILL_RADIUS; dy <= POINT_HOLE_FILL_RADIUS; ++dy)
+        {
+            for (int dx = -POINT_HOLE_FILL_RADIUS; dx <= POINT_HOLE_FILL_RADIUS; ++dx)
+            {
+                int2 neighbor = pixel + int2(dx, dy);
+                if (any(neighbor < 0) || any(neighbor >= size)) continue;
+
+                uint neighborIndex = neighbor.y * size.x + neighbor.x;
+                uint neighborDepth = SplatDepth[neighborIndex];
+                if (neighborDepth == POINT_SPLAT_EMPTY) continue;
+
+                uint neighborColor = SplatColor[neighborIndex];
+                if (neighborDepth < nearestDepth || (neighborDepth == nearestDepth && neighborColor < nearestColor))
+                {
+                    nearestDepth = neighborDepth;
+                    nearestColor = neighborColor;
+                }
+                ++neighbors;
+            }
+        }
+
+        if (neighbors >= POINT_HOLE_FILL_MIN_NEIGHBORS)
+        {
+            depth = nearestDepth;
+            color = nearestColor;
+        }
+    }
+
+    uint value = depth == POINT_SPLAT_EMPTY ? ClearColor : color;
+    Output[pixel] = float4(value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24) / 255.0f;
+}
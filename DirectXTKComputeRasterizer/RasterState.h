@@ -0,0 +1,367 @@
+#pragma once
+#include <cstdint>
+
+// ==================================================================================
+// X^CU[̃pCvCꉻ
+// `悲ƂɎg@\ (eNX`A_J[A[xeXgAJOAuh) ̑gݍ킹B
+// GPU ł TriangleRasterizer.hlsl  RASTER_* }NACPU ł SoftwareRasterizer ̃ev[gɂȂA
+// gݍ킹Ƃɕ̂ȂJ[lփRpCB
+// ʃ^C̑傫RpC̒萔ŁANɌvđIׂ (AutoTuneTileSize)B
+// [xobt@̃tH[}bg reversed-Z lɁAGPU ł DEPTH_* }NɂȂB
+// ==================================================================================
+
+enum class CullMode : uint32_t {
+    None,   // ʂ`
+    Back,   // v (XN[Ŗʐς) ̖ʂ̂Ă
+    Front,  // v̖ʂ̂Ă
+};
+
+enum class BlendMode : uint32_t {
+    Opaque, // ㏑ ([x)
+    Alpha,  // src.a ō ([x͔rŏȂBOp`̏ɏd˂)
+};
+
+// ێIX^CY: sNZSł͂ȂsNZ̐`ŎOp`𔻒肷
+// (ӂsNZ̔̍L肾炷BGPU ł RASTER_CONSERVATIVE }N)
+// RasterState ̑gݍ킹Ƃ͕ʂɁAVF[_[̃LbV CPU ł̎Op`̃ZbgAbvŐ؂ւ
+enum class ConservativeMode : uint32_t {
+    Off,            // sNZS (ʏ)
+    Overestimate,   // sNZɏłΓh (IN[W̎󂯑A{NZAՓ˃Obh)B[x͒_͈̔͂Ɏ߂
+    Underestimate,  // sNZŜ̂Ƃh (IN[_[)
+};
+constexpr uint32_t c_ConservativeModeCount = 3;
+
+// JobW}XÑA`GCAX: MSAA Ɠ 4 / 8 ̃TvŃGbWƐ[x𔻒肵ă}XNɂA
+// F͎Op`ƂɃsNZ1񂾂߂BsNŽʂ́utOg (FƂꂪĂTṽ}XN)v
+// kĎ (c_Coverage* ̕)ApXŃ}XÑTvŏdݕtĕς
+// (GPU ł RASTER_SAMPLES }NBێIX^CYƓ RasterState ̑gݍ킹Ƃ͕ʂɐ؂ւ)
+enum class AntiAliasMode : uint32_t {
+    Off,
+    Coverage4x,
+    Coverage8x,
+};
+constexpr uint32_t c_AntiAliasModeCount = 3;
+constexpr uint32_t c_MaxCoverageSamples = 8;
+
+constexpr uint32_t GetAntiAliasSampleCount(AntiAliasMode mode)
+{
+    return mode == AntiAliasMode::Coverage8x ? 8u : mode == AntiAliasMode::Coverage4x ? 4u : 1u;
+}
+
+// Tvʒu (sNZS 1/16 sNZPʁBD3D ̕Wp^[BTriangleRasterizer.hlsl  c_SamplePositions ƈv邱)
+constexpr int8_t c_SamplePositions4x[4][2] = { { -2, -6 }, { 6, -2 }, { -6, 2 }, { 2, 6 } };
+constexpr int8_t c_SamplePositions8x[8][2] = { { 1, -3 }, { -1, 3 }, { 5, 1 }, { -3, -5 }, { -5, 5 }, { -7, -1 }, { 3, 7 }, { 7, -7 } };
+
+// kTv̕ (TriangleRasterizer.hlsl  COVERAGE_* ƈv邱)
+// sNZƂ uint x 2 (ŏ̃tOg̐F R8G8B8A8, }XN | c̃tOg << 8 | c̐擪 << 11)B
+// c̃tOg (F, }XN)  uint x 2 ŕʂ̃obt@֋l߂ (ĝ͎Op`̉̃sNZ)B
+// TvƂ̐[x͕`ԂA[xobt@ɂ͍łÕTv̐[x
+constexpr uint32_t c_CoverageMaskBits = 0xFF;
+constexpr uint32_t c_CoverageCountShift = 8;
+constexpr uint32_t c_CoverageOffsetShift = 11;
+constexpr uint32_t c_CoverageMaxFragments = 1u << (32 - c_CoverageOffsetShift);
+
+// c̃tOg̃obt@̑傫 (sNZ̔Ac̐擪̃rbg܂)
+// ӂꂽsNZ͉ς݂̐FSTv𕢂1̃tOgƂď
+constexpr uint32_t GetCoverageFragmentCapacity(uint32_t width, uint32_t height)
+{
+    return width * height / 2 < c_CoverageMaxFragments ? width * height / 2 : c_CoverageMaxFragments;
+}
+
+// σ[gVF[fBO: ʂ c_ShadingRateTileSize sNZ̐` ([g̃^C) ɕA^CƂ̃[g
+// ubN (1x1 / 2x2 / 4x4 sNZ) ƂɐF1񂾂߂B[xƎOp`̓O̓sNZƂ̂܂܁B
+// [x̃pXŊesNŽOp`߂ĂAubNœOp`̃sNẐŏ̂̂
+// ubN̒SœhAc͂̐Fg (GPU ł RASTER_VRS }NBsŐ[xeXĝƂ)
+enum class ShadingRate : uint8_t {
+    Rate1x1,
+    Rate2x2,
+    Rate4x4,
+};
+constexpr uint32_t c_ShadingRateCount = 3;
+
+enum class ShadingRateMode : uint32_t {
+    Off,
+    Explicit,   // SetShadingRates œn[g
+    Auto,       // Õt[̐F̃^CƂ̕UŌ߂ (SelectShadingRate)
+};
+
+// [g̃^C̑傫 (sNZBc_TileSizes ̑SĂ̕ӂ 4 ̔{Ȃ̂ŁAubN̓XbhO[v܂Ȃ)
+// TriangleRasterizer.hlsl  SHADING_RATE_TILE_SIZE ƈv邱
+constexpr uint32_t c_ShadingRateTileSize = 16;
+
+// ubN1ӂ̃sNZ
+constexpr uint32_t GetShadingRateBlockSize(ShadingRate rate)
+{
+    return 1u << static_cast<uint32_t>(rate);
+}
+
+//  width x height ̃[g̃^C̐ (т ty * ceil(width / c_ShadingRateTileSize) + tx)
+constexpr uint32_t GetShadingRateTileCount(uint32_t width, uint32_t height)
+{
+    return ((width + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize) * ((height + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize);
+}
+
+// ShadingRateMode::Auto 臒l (^C̋Px (0 ~ 255) ̕UBTriangleRasterizer.hlsl  SHADING_RATE_VARIANCE_* ƈv邱)
+// R (U) ^CقǑeh
+constexpr float c_ShadingRateVariance4x4 = 4.0f;
+constexpr float c_ShadingRateVariance2x2 = 64.0f;
+
+constexpr ShadingRate SelectShadingRate(float lumaVariance)
+{
+    return lumaVariance < c_ShadingRateVariance4x4 ? ShadingRate::Rate4x4
+         : lumaVariance < c_ShadingRateVariance2x2 ? ShadingRate::Rate2x2
+         : ShadingRate::Rate1x1;
+}
+
+// G-buffer: FƐ[xɉāAxCeBO|XgvZXɎg^[Qbg𓯂X^CYŏ
+// (GPU ł RASTER_GBUFFER }NBsŐ[xeXĝƂB[x͐[xobt@ (DepthBufferDesc) ̂܂܎g)
+// e^[Qbg͌ĂOp`ɂ1sNZ1񂾂߁AtH[}bg̓^[QbgƂɐxƑшőI
+enum class GBufferTarget : uint32_t {
+    Albedo, // _J[ x eNX` (CeBOO̐F)BFull = R16G16B16A16_FLOAT, Packed = R8G8B8A8_UNORM
+    Normal, // [hԂ̖@BFull = R16G16B16A16_FLOAT (xyz), Packed = R16G16_UNORM (ʑ)
+    Id,     // Op`ƃ}eA̔ԍBFull = R32G32_UINT, Packed = R32_UINT (Op`̉ 24bit | }eA << 24)
+    Motion, // Õt[̈ʒu - ̈ʒu (sNZ)BFull = R32G32_FLOAT, Packed = R16G16_FLOAT
+};
+constexpr uint32_t c_GBufferTargetCount = 4;
+
+enum class GBufferFormat : uint32_t {
+    Off,    // Ȃ
+    Full,
+    Packed, // 1sNZ 4byte
+};
+
+struct GBufferDesc {
+    GBufferFormat formats[c_GBufferTargetCount] = {}; // GBufferTarget ̏
+};
+
+// Op``ȂsNZ Id (Full ͗APacked ͑Srbg)
+constexpr uint32_t c_GBufferNoTriangle = 0xFFFFFFFF;
+constexpr uint32_t c_GBufferPackedTriangleMask = 0xFFFFFF;
+constexpr uint32_t c_GBufferPackedMaterialShift = 24;
+
+constexpr bool IsGBufferEnabled(const GBufferDesc& desc)
+{
+    for (GBufferFormat format : desc.formats)
+    {
+        if (format != GBufferFormat::Off) return true;
+    }
+    return false;
+}
+
+// ^[Qbg1sNZ̃oCg (Off  0)
+constexpr uint32_t GetGBufferBytesPerPixel(GBufferFormat format)
+{
+    return format == GBufferFormat::Full ? 8u : format == GBufferFormat::Packed ? 4u : 0u;
+}
+
+// S^[Qbg1sNZ̃oCg (ш̌ςɎg)
+constexpr uint32_t GetGBufferBytesPerPixel(const GBufferDesc& desc)
+{
+    uint32_t bytes = 0;
+    for (GBufferFormat format : desc.formats)
+    {
+        bytes += GetGBufferBytesPerPixel(format);
+    }
+    return bytes;
+}
+
+// [xvpX: ɐ[xőSOp`] (̕ԂeNX`ǂ܂Ȃ)A
+// ɍłO̐[xƈvOp`hBd˕` (ȌȂ) قǓh񐔂
+enum class DepthPrepassMode : uint32_t {
+    Off,
+    On,
+    Auto,   // Õt[̏d˕` ([xeXgʂ / hꂽsNZ) Ő؂ւ
+};
+
+struct RasterState {
+    bool textured = true;       // false ȂeNX` (}eA) ǂ܂Ȃ
+    bool vertexColor = true;    // false Ȃ璸_J[ԂȂ ()
+    bool depthTest = true;      // false Ȃ[xrA̎Op`ŏ㏑
+    CullMode cullMode = CullMode::Back;
+    BlendMode blendMode = BlendMode::Opaque;
+};
+
+// gݍ킹̐ (2 x 2 x 2 x 3 x 2)
+constexpr uint32_t c_RasterPermutationCount = 48;
+
+// RasterState  0 ~ c_RasterPermutationCount - 1 ̔ԍ̕ϊ
+constexpr uint32_t GetRasterPermutation(const RasterState& state)
+{
+    return (state.textured ? 1u : 0u)
+         + (state.vertexColor ? 2u : 0u)
+         + (state.depthTest ? 4u : 0u)
+         + static_cast<uint32_t>(state.cullMode) * 8u
+         + static_cast<uint32_t>(state.blendMode) * 24u;
+}
+
+constexpr RasterState GetRasterState(uint32_t permutation)
+{
+    RasterState state;
+    state.textured = (permutation & 1) != 0;
+    state.vertexColor = (permutation & 2) != 0;
+    state.depthTest = (permutation & 4) != 0;
+    state.cullMode = static_cast<CullMode>((permutation / 8) % 3);
+    state.blendMode = static_cast<BlendMode>(permutation / 24);
+    return state;
+}
+
+// ʃ^C (= CSMain ̃XbhO[v) ̑傫̌
+// GPU ł TILE_WIDTH / TILE_HEIGHT }NACPU ł SoftwareRasterizer ̃ev[gɂȂ
+// (GPU  1O[v 1024 Xbh܂)
+struct TileSize {
+    uint32_t width;
+    uint32_t height;
+};
+
+constexpr TileSize c_TileSizes[] = {
+    { 8, 8 },
+    { 16, 8 },
+    { 16, 16 },
+    { 32, 8 },
+    { 32, 16 },
+    { 32, 32 },
+};
+constexpr uint32_t c_TileSizeCount = static_cast<uint32_t>(sizeof(c_TileSizes) / sizeof(c_TileSizes[0]));
+
+//  16x16 (Ȃꍇ)
+constexpr uint32_t c_DefaultTileSize = 2;
+
+// width x height  c_TileSizes ̔ԍ (Ȃ c_TileSizeCount)
+constexpr uint32_t FindTileSize(uint32_t width, uint32_t height)
+{
+    for (uint32_t i = 0; i < c_TileSizeCount; ++i)
+    {
+        if (c_TileSizes[i].width == width && c_TileSizes[i].height == height)
+        {
+            return i;
+        }
+    }
+    return c_TileSizeCount;
+}
+
+// [xobt@̃tH[}bg (TriangleRasterizer.hlsl  DEPTH_FORMAT_* ƈv邱)
+// [x̔r̐xɊۂ߂ĂŝŁAtH[}bg𗎂ƂƂ Z t@CeBÔ܂܌
+enum class DepthFormat : uint32_t {
+    D32Float,   // float (GPU  UAV  R32_FLOAT)
+    D24UnormS8, //  24bit [x (unorm)A 8bit XeV (GPU  UAV  R32_UINTBXeV 0)
+    D16Unorm,   // 16bit unorm (GPU  UAV  R16_UNORM)
+};
+constexpr uint32_t c_DepthFormatCount = 3;
+
+struct DepthBufferDesc {
+    DepthFormat format = DepthFormat::D32Float;
+    // true ȂO = 1A = 0 (NAl 0A傫O)Bˉes near  far ւč
+    // (XMMatrixPerspectiveFovLH(fov, aspect, farZ, nearZ))Bfloat ̐x 0 t߂ɏW܂̂ŁA̐[xׂɂ
+    bool reversedZ = false;
+};
+
+// tH[}bg reversed-Z ̑gݍ킹 (VF[_[̓ꉻ̔ԍ)
+constexpr uint32_t c_DepthModeCount = c_DepthFormatCount * 2;
+
+constexpr uint32_t GetDepthMode(const DepthBufferDesc& desc)
+{
+    return static_cast<uint32_t>(desc.format) * 2 + (desc.reversedZ ? 1u : 0u);
+}
+
+// 1sNZ̃oCg (ш̌ςɎg)
+constexpr uint32_t GetDepthBytesPerPixel(DepthFormat format)
+{
+    return format == DepthFormat::D16Unorm ? 2u : 4u;
+}
+
+// unorm ̍ől (D32Float  0 = ۂ߂Ȃ)
+constexpr uint32_t GetDepthUnormMax(DepthFormat format)
+{
+    return format == DepthFormat::D16Unorm ? 0xFFFFu : format == DepthFormat::D24UnormS8 ? 0xFFFFFFu : 0u;
+}
+
+// }`r[ (1̕`ŕ̃r[֕`) ̃r[̏ (TriangleRasterizer.hlsl  MAX_VIEWS ƈv邱)
+// L[u}bv 6ʂXeI 2z肷
+constexpr uint32_t c_MaxViews = 6;
+
+// DepthPrepassMode::Auto ̐؂ւ臒l (t[؂ւȂ悤ALɂlƖɂl𗣂)
+// vpX̒ǉ̔p͎Op`Ƃ̃GbWƐ[x̕]ŁAh񐔂 1.5 {𒴂Ə̂ڈ
+constexpr float c_DepthPrepassEnableOverdraw = 1.5f;
+constexpr float c_DepthPrepassDisableOverdraw = 1.25f;
+
+// [xvpXg ([xgݍ킹 = sŐ[xeXĝƂ)
+// overdraw ͑Õt[̏d˕`Aactive ͑Õt[Ŏg
+constexpr bool ShouldUseDepthPrepass(DepthPrepassMode mode, const RasterState& state, float overdraw, bool active)
+{
+    if (!state.depthTest || state.blendMode != BlendMode::Opaque || mode == DepthPrepassMode::Off)
+    {
+        return false;
+    }
+    if (mode == DepthPrepassMode::On)
+    {
+        return true;
+    }
+    return overdraw >= (active ? c_DepthPrepassDisableOverdraw : c_DepthPrepassEnableOverdraw);
+}
+
+// σ[gVF[fBOg邩 ([x̃pXŌOp`߂̂ŁA[xgݍ킹)
+constexpr bool CanUseVariableRateShading(const RasterState& state)
+{
+    return state.depthTest && state.blendMode == BlendMode::Opaque;
+}
+
+// VU[` (sNZPʁBright  bottom ͊܂܂Ȃ)
+// `悲 / t[ƂɕwłA`ƏdȂ^ChAǂ̋`ɂȂsNZ͏Ȃ
+// (TriangleRasterizer.hlsl  MAX_SCISSOR_RECTS ƈv邱)
+struct ScissorRect {
+    uint32_t left = 0;
+    uint32_t top = 0;
+    uint32_t right = 0;
+    uint32_t bottom = 0;
+};
+constexpr uint32_t c_MaxScissorRects = 8;
+
+//  (width x height) ɐ؂l߂BɂȂ` right <= left  bottom <= top ɂȂ
+constexpr ScissorRect ClipScissorRect(const ScissorRect& rect, uint32_t width, uint32_t height)
+{
+    ScissorRect clipped = rect;
+    clipped.right = clipped.right < width ? clipped.right : width;
+    clipped.bottom = clipped.bottom < height ? clipped.bottom : height;
+    return clipped;
+}
+
+constexpr bool IsScissorRectEmpty(const ScissorRect& rect)
+{
+    return rect.right <= rect.left || rect.bottom <= rect.top;
+}
+
+// ` (left, top) - (right, bottom)  rect ƏdȂ邩
+constexpr bool ScissorRectOverlaps(const ScissorRect& rect, uint32_t left, uint32_t top, uint32_t right, uint32_t bottom)
+{
+    return left < rect.right && rect.left < right && top < rect.bottom && rect.top < bottom;
+}
+
+// ` (left, top) - (right, bottom)  rect Ɏ܂邩
+constexpr bool ScissorRectContains(const ScissorRect& rect, uint32_t left, uint32_t top, uint32_t right, uint32_t bottom)
+{
+    return rect.left <= left && rect.top <= top && right <= rect.right && bottom <= rect.bottom;
+}
+
+// G-buffer 邩 (ĂOp`[xŌ߂̂ŁA[xgݍ킹)
+constexpr bool CanWriteGBuffer(const RasterState& state)
+{
+    return state.depthTest && state.blendMode == BlendMode::Opaque;
+}
+
+// ^CPʂ̃CgJO: [x̃pXŌ܂^C (= CSMain ̃XbhO[v) Ƃ̐[x͈̔͂
+// ^C̎œ_IсA^C̃Cg̃Xgɂ̂ŏƂ炷 (GPU ł RASTER_LIGHTING }N)
+// [x͈̔͂v̂ŁAsŐ[xeXĝƂ ([xvpXσ[gVF[fBO̐[x̃pXg)
+// (TriangleRasterizer.hlsl  MAX_TILE_LIGHTS ƈv邱ƁB̃Cg͂̃^Cł͏Ƃ炳Ȃ)
+constexpr uint32_t c_MaxTileLights = 256;
+
+constexpr bool CanUseTiledLighting(const RasterState& state)
+{
+    return state.depthTest && state.blendMode == BlendMode::Opaque;
+}
+
+// _̋ɂ錸 (distanceSquared / radiusSquared  1  0 ɂȂBTriangleRasterizer.hlsl  LightFalloff Ɠ)
+constexpr float LightFalloff(float distanceSquared, float radiusSquared)
+{
+    const float falloff = 1.0f - distanceSquared / radiusSquared;
+    return falloff > 0.0f ? falloff * falloff : 0.0f;
+}
@@ -0,0 +1,79 @@
+// ==================================================================================
+// RasterizerCommon.hlsli
+// eRs[gVF[_[ŋL郊\[X`ƃ[eBeB
+// ==================================================================================
+
+#ifndef RASTERIZER_COMMON_HLSLI
+#define RASTERIZER_COMMON_HLSLI
+
+// _f[^ (C++  Vertex ƓCAEg)
+struct Vertex {
+    float3 pos;   // [JW
+    float4 color; // _J[
+    float2 uv;    // UVW
+};
+
+// bVbg (C++  Meshlet ƓCAEg)
+struct Meshlet {
+    float3 center;        // oEfBOXtBAS ([JW)
+    float  radius;        // oEfBOXtBAa
+    float3 coneAxis;      // @R[̎ (\ʂ̖@̕)
+    float  coneCutoff;    // @R[̃JbgIt (1.0 ȂR[JO)
+    uint   firstTriangle; // 擪Op`̃CfbNX
+    uint   triangleCount; // Op`̐
+    uint2  padding;
+};
+
+// BVH m[h (C++  BvhNode ƓCAEgBE̎q = leftFirst + 1)
+struct BvhNode {
+    float3 boundsMin;
+    uint   leftFirst;     // m[h: ̎q̃CfbNX, [t: BvhTriangleIndices ̐擪ʒu
+    float3 boundsMax;
+    uint   triangleCount; // 0 Ȃm[h
+};
+
+// }eA (C++  Material ƓCAEg)
+struct Material {
+    float4 tint;
+    float4 uvTransform;   // xy = XP[, zw = ItZbg (AgX̋`)
+    uint   textureIndex;  // MaterialTextures ̃XCX (MATERIAL_NO_TEXTURE Ȃ tint )
+    uint   sampler;       // MATERIAL_SAMPLER_* ̑gݍ킹
+    uint   atlas;         // 1 Ȃ UV `Ńbv / NvĂǂ
+    uint   padding;
+};
+
+#define MATERIAL_NO_TEXTURE     0xFFFFFFFF
+#define MATERIAL_SAMPLER_CLAMP  1 // C++  MaterialSampler ƈv邱
+#define MATERIAL_SAMPLER_POINT  2
+
+// 萔obt@: sƉʏ (C++  CBData ƓCAEg)
+cbuffer ConstantBuffer : register(b0)
+{
+    matrix WorldViewProj; // Local -> Clip s
+    float2 ScreenSize;    // ʉ𑜓x (Width, Height)
+    uint TriangleCount;   // `悷Op`̖
+    uint MeshletCount;    // bVbg (0 Ȃ烁bVbgJOgȂ)
+    float4 ViewOrigin;    // [JWł̃Jʒu (w = 0 ̏ꍇ͕se̎)
+    uint BvhNodeCount;    // BVH m[h (0 Ȃ BVH ɂ^CPʂ̃JOgȂ)
+    uint IndexedTriangles; // 1 Ȃ IndexBuffer oRŒ_QƂ (0 Ȃ 3_ = 1Op`)
+    uint MaterialCount;   // }eA (0 Ȃ BaseTexture g)
+    uint TriangleMaterialIDs; // 1 Ȃ TriangleMaterials }eA (0 Ȃ DrawMaterial)
+    uint DrawMaterial;
+    uint ScissorRectCount; // VU[`̐ (0 ȂgȂBTriangleRasterizer.hlsl  ScissorConstants)
+    uint2 Padding;
+    float4 ClearColor;    // Op``ȂsNZ̐F
+}
+
+// JOʂ̃JE^ (ByteAddressBuffer ̃ItZbg)
+#define CULL_COUNTER_VISIBLE_MESHLETS   0  // bVbg (= VisibleMeshlets ̗vf)
+#define CULL_COUNTER_FRUSTUM_CULLED     4  // JOꂽbVbg
+#define CULL_COUNTER_BACKFACE_CULLED    8  // @R[ŃJOꂽbVbg
+#define CULL_COUNTER_CULLED_TRIANGLES   12 // JOꂽbVbgɊ܂܂Op`
+
+// GbW֐: xNg(a->b)ɑ΂ē_cE𔻒
+// ߂l: ȂAȂOiɂj
+float EdgeFunction(float2 a, float2 b, float2 c) {
+    return (c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x);
+}
+
+#endif // RASTERIZER_COMMON_HLSLI
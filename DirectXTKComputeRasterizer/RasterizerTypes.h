@@ -0,0 +1,78 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+#include "RasterState.h"
+
+// ==================================================================================
+// GPU ł CPU  (SoftwareRasterizer) L^
+// D3D11  Windows ̃wb_[ɈˑȂ̂ŁACPU ł͂̃wb_[ DirectXMath Ńrhł
+// (GPU ̃\[Xƒ萔obt@ DirectXTKComputeRasterizer.h)B
+// ==================================================================================
+
+// _\
+struct Vertex {
+    DirectX::XMFLOAT3 pos;
+    DirectX::XMFLOAT4 color;
+    DirectX::XMFLOAT2 uv;
+};
+
+// _ ([hWBTriangleRasterizer.hlsl  PointLight Ɠ)
+// radius œ͂ȂȂ (LightFalloff)A^CPʂ̃CgJŐŔ肷
+struct PointLight {
+    DirectX::XMFLOAT3 position;
+    float    radius;
+    DirectX::XMFLOAT3 color;
+    float    intensity;
+};
+
+// Op` triangle  corner Ԗ (0~2) ̒_CfbNX
+// indices ̏ꍇ 3_ = 1Op`̔CfbNX`Ƃ݂Ȃ
+inline uint32_t TriangleVertexIndex(const std::vector<uint32_t>& indices, uint32_t triangle, uint32_t corner)
+{
+    return indices.empty() ? triangle * 3 + corner : indices[triangle * 3 + corner];
+}
+
+inline uint32_t TriangleCount(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    return static_cast<uint32_t>((indices.empty() ? vertices.size() : indices.size()) / 3);
+}
+
+// bVbg (NX^) \: MeshletBuilder AGPU  Meshlet ƓCAEg
+struct Meshlet {
+    DirectX::XMFLOAT3 center;   // oEfBOXtBAS ([JW)
+    float    radius;
+    DirectX::XMFLOAT3 coneAxis; // @R[̎
+    float    coneCutoff;        // @R[̃JbgIt (1.0 ȂR[JO)
+    uint32_t firstTriangle;
+    uint32_t triangleCount;
+    uint32_t padding[2];
+};
+
+// BVH m[h\ (32byte): BvhBuilder AGPU  BvhNode ƓCAEg
+// Zm[h͏ɗאڂĕ (E̎q = leftFirst + 1)
+struct BvhNode {
+    DirectX::XMFLOAT3 boundsMin;
+    uint32_t leftFirst;     // m[h: ̎q̃CfbNX, [t: triangleIndices ̐擪ʒu
+    DirectX::XMFLOAT3 boundsMax;
+    uint32_t triangleCount; // 0 Ȃm[h
+};
+
+// bVbgJO̓v (RasterizerCommon.hlsli  CULL_COUNTER_* Ɠ)
+struct CullStats {
+    uint32_t visibleMeshlets;
+    uint32_t frustumCulledMeshlets;
+    uint32_t backfaceCulledMeshlets;
+    uint32_t culledTriangles;
+};
+
+// CSMain ̕`̓v (TriangleRasterizer.hlsl  RASTER_STATS_* Ɠ)
+struct RasterStats {
+    uint32_t depthPassFragments;    // [xeXgʂ ([xvpXȂœh)
+    uint32_t shadedFragments;       // ۂɓh
+    uint32_t coveredPixels;         // 1ȏhꂽsNZ
+    uint32_t coverageFragments;     // JobW}XÑA`GCAXŎc̃tOg̃obt@ɋl߂ (eʂ𒴂͂ӂꂽ)
+    uint32_t sharedShadedPixels;    // σ[gVF[fBOŃubN̑̃sNZ̐Fg (h炸ɍς) sNZ
+    uint32_t tileLights;            // ^CPʂ̃CgJOŃ^C̃XgɓCg̉א (c_MaxTileLights ܂)
+    uint32_t overflowedLightTiles;  // Cg c_MaxTileLights 𒴂^C
+};
@@ -0,0 +1,81 @@
+#include "RingAllocator.h"
+
+void RingAllocator::Reset(uint64_t capacity)
+{
+    m_capacity = capacity;
+    m_head = 0;
+    m_tail = 0;
+    m_used = 0;
+    m_currentFrameSize = 0;
+    m_frames.clear();
+}
+
+uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+    if (size == 0 || size > m_capacity)
+    {
+        return c_InvalidOffset;
+    }
+
+    const uint64_t used = GetUsedSize();
+    const uint64_t aligned = (m_head + alignment - 1) / alignment * alignment;
+
+    // gp͈̔͂ [tail, head) (܂ԂĂꍇ [tail, capacity) + [0, head))
+    uint64_t offset = c_InvalidOffset;
+    if (used == 0)
+    {
+        // Ȃ擪蒼
+        m_head = 0;
+        m_tail = 0;
+        offset = 0;
+    }
+    else if (m_head > m_tail)
+    {
+        if (aligned + size <= m_capacity)
+        {
+            offset = aligned;
+        }
+        else if (size <= m_tail)
+        {
+            // ̗]̂ĂĐ擪֐܂Ԃ
+            m_currentFrameSize += m_capacity - m_head;
+            m_head = 0;
+            offset = 0;
+        }
+    }
+    else if (aligned + size <= m_tail)
+    {
+        offset = aligned;
+    }
+
+    if (offset == c_InvalidOffset)
+    {
+        return c_InvalidOffset;
+    }
+
+    m_currentFrameSize += (offset + size) - m_head;
+    m_head = offset + size;
+    return offset;
+}
+
+void RingAllocator::FinishFrame(uint64_t frameIndex)
+{
+    if (m_currentFrameSize == 0)
+    {
+        return;
+    }
+
+    m_frames.push_back({ frameIndex, m_head, m_currentFrameSize });
+    m_used += m_currentFrameSize;
+    m_currentFrameSize = 0;
+}
+
+void RingAllocator::Retire(uint64_t completedFrameIndex)
+{
+    while (!m_frames.empty() && m_frames.front().frameIndex <= completedFrameIndex)
+    {
+        m_tail = m_frames.front().end;
+        m_used -= m_frames.front().size;
+        m_frames.pop_front();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+// ̃Abv[hO̗e (UploadRing / SoftwareDynamicGeometryBc_FramesInFlight t[̍XV܂傫ɂ)
+constexpr uint32_t c_DefaultUploadRingSize = 4 * 1024 * 1024;
+
+// ==================================================================================
+// t[Pʂŉ郊OAP[^ (ItZbg̊Ǘ̂݁B͎Ȃ)
+// mۂ͈͂͂̃t[ FinishFrame Œ߁AGPU ̃t[I
+// Retire ōėp\ɂBD3D ɈˑȂ̂ŁAAbv[hȊO̗prɂgB
+// ==================================================================================
+class RingAllocator
+{
+public:
+    static constexpr uint64_t c_InvalidOffset = UINT64_MAX;
+
+    RingAllocator() = default;
+    explicit RingAllocator(uint64_t capacity) { Reset(capacity); }
+
+    // eʂݒ肵AׂĂ̊mۂj
+    void Reset(uint64_t capacity);
+
+    // size byte  alignment EɊmۂ (󂫂Ȃ c_InvalidOffset)
+    // Ɏ܂Ȃꍇ͐擪֐܂Ԃ (̗]͂̃t[̎gpʂɊ܂߂)
+    uint64_t Allocate(uint64_t size, uint64_t alignment = 16);
+
+    // ݂̃t[̊mۂ frameIndex ƂĒ߂
+    void FinishFrame(uint64_t frameIndex);
+
+    // completedFrameIndex ȑOɒ߂t[͈̔͂
+    void Retire(uint64_t completedFrameIndex);
+
+    uint64_t GetCapacity() const { return m_capacity; }
+    uint64_t GetUsedSize() const { return m_used + m_currentFrameSize; }
+    bool HasPendingFrames() const { return !m_frames.empty(); }
+    uint64_t GetOldestPendingFrame() const { return m_frames.front().frameIndex; }
+
+private:
+    struct FrameRange
+    {
+        uint64_t frameIndex;
+        uint64_t end;  // ̃t[̍Ō̊mۂ̏I[ ( tail)
+        uint64_t size; // ܂ԂƃACg̗]܂ގgp
+    };
+
+    uint64_t m_capacity = 0;
+    uint64_t m_head = 0;             // Ɋmۂʒu
+    uint64_t m_tail = 0;             // łÂ̊mۂ̐擪
+    uint64_t m_used = 0;             // ߂t[̖̎gp
+    uint64_t m_currentFrameSize = 0; // ܂߂ĂȂt[̎gp
+    std::deque<FrameRange> m_frames;
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+// ==================================================================================
+// ShadingRate.hlsl
+// σ[gVF[fBO (ShadingRateMode::Auto) ̃[gÕt[̐F猈߂
+// 1O[v = 1[g̃^CŁA^C̋Px̕UقǑe[gɂ
+// ==================================================================================
+
+#include "RasterizerCommon.hlsli"
+
+// : Õt[̐F (pOutputTexture)
+Texture2D<float4> PreviousColor : register(t0);
+
+// o: [g̃^CƂ̃[g (ShadingRateBTriangleRasterizer.hlsl  ShadingRates)
+RWStructuredBuffer<uint> ShadingRates : register(u0);
+
+#define SHADING_RATE_TILE_SIZE 16           // C++  c_ShadingRateTileSize ƈv邱
+#define SHADING_RATE_VARIANCE_4X4 4.0f      // C++  c_ShadingRateVariance* ƈv邱
+#define SHADING_RATE_VARIANCE_2X2 64.0f
+
+#define SHADING_RATE_1X1 0                  // ShadingRate ƈv邱
+#define SHADING_RATE_2X2 1
+#define SHADING_RATE_4X4 2
+
+groupshared uint gs_LumaSum;
+groupshared uint gs_LumaSquareSum;
+groupshared uint gs_PixelCount;
+
+[numthreads(SHADING_RATE_TILE_SIZE, SHADING_RATE_TILE_SIZE, 1)]
+void CSShadingRateFromColor(uint3 dispatchThreadID : SV_DispatchThreadID, uint3 groupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gs_LumaSum = 0;
+        gs_LumaSquareSum = 0;
+        gs_PixelCount = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Px 0 ~ 255 ̐ő (C++  SoftwareRasterizer Ɠۂ߁B256 sNZ̓ał uint Ɏ܂)
+    if (dispatchThreadID.x < uint(ScreenSize.x) && dispatchThreadID.y < uint(ScreenSize.y))
+    {
+        float3 color = saturate(PreviousColor[dispatchThreadID.xy].rgb);
+        uint luma = uint(dot(color, float3(0.299f, 0.587f, 0.114f)) * 255.0f + 0.5f);
+        InterlockedAdd(gs_LumaSum, luma);
+        InterlockedAdd(gs_LumaSquareSum, luma * luma);
+        InterlockedAdd(gs_PixelCount, 1);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        float count = float(gs_PixelCount);
+        float mean = gs_LumaSum / count;
+        float variance = gs_LumaSquareSum / count - mean * mean;
+
+        uint rate = variance < SHADING_RATE_VARIANCE_4X4 ? SHADING_RATE_4X4
+                  : variance < SHADING_RATE_VARIANCE_2X2 ? SHADING_RATE_2X2
+                  : SHADING_RATE_1X1;
+        uint rateTileCountX = (uint(ScreenSize.x) + SHADING_RATE_TILE_SIZE - 1) / SHADING_RATE_TILE_SIZE;
+        ShadingRates[groupID.y * rateTileCountX + groupID.x] = rate;
+    }
+}
@@ -0,0 +1,323 @@
+#include "pch.h"
+#include "Skinning.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <d3dcompiler.h>
+
+using namespace DirectX;
+
+namespace
+{
+    // CPU ł̃ob`: h[ draw  [firstVertex, firstVertex + count)
+    struct SkinningBatch {
+        uint32_t draw;
+        uint32_t firstVertex;
+        uint32_t count;
+    };
+
+    void CreateStructuredBuffer(ID3D11Device* device, uint32_t stride, uint32_t count, const void* initialData,
+                                Microsoft::WRL::ComPtr<ID3D11Buffer>& buffer, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+    {
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = stride * count;
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = stride;
+
+        D3D11_SUBRESOURCE_DATA initData = {};
+        initData.pSysMem = initialData;
+
+        HRESULT hr = device->CreateBuffer(&bufferDesc, initialData ? &initData : nullptr, buffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create skinning buffer\n");
+            throw std::runtime_error("Failed to create skinning buffer");
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = count;
+
+        hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, srv.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create skinning SRV\n");
+            throw std::runtime_error("Failed to create skinning SRV");
+        }
+    }
+}
+
+void SkinVertices(const SkinnedVertex* input, const XMFLOAT3X4* palette, uint32_t boneCount, const SkinningDraw& draw,
+                  uint32_t firstVertex, uint32_t count, Vertex* output)
+{
+    const SkinnedVertex* source = input + draw.firstInputVertex + firstVertex;
+    const XMFLOAT3X4* bones = palette + draw.firstBone;
+
+    // ̃h[QƂł{[ (_̃CfbNX͓ǂݍނƂɂƔׂ)
+    const uint32_t drawBoneCount = draw.firstBone < boneCount ? boneCount - draw.firstBone : 0;
+
+    // 4_ SoA 4[Ƃď
+    // {[s̍͒_Ƃɏc̐ϘaōsA 3x4 sƈʒu4_܂Ƃ߂1񂾂]uāA
+    // ʒu̕ϊ̓[Ƃ̐Ϙaōs (_Ƃ̐̓ςgȂ)
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const uint32_t laneCount = std::min(4u, count - i);
+
+        XMMATRIX rows[3];   // rows[r].r[lane] = s r s
+        XMMATRIX positions; // positions.r[lane] = (x, y, z, 1)
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            // [̃[͍Ō̒_Ŗ߂ (oȂ)
+            const SkinnedVertex& vertex = source[i + std::min(lane, laneCount - 1)];
+            const XMVECTOR weights = XMLoadFloat4(&vertex.boneWeights);
+
+            // d݂ 3x4 s̊es (GPU łƓ)
+            XMVECTOR row0 = XMVectorZero();
+            XMVECTOR row1 = XMVectorZero();
+            XMVECTOR row2 = XMVectorZero();
+            auto accumulate = [&](uint32_t bone, FXMVECTOR weight)
+            {
+                if (bone >= drawBoneCount)
+                {
+                    OutputDebugStringA("Skinning bone index out of range\n");
+                    throw std::runtime_error("Skinning bone index out of range");
+                }
+                const XMFLOAT3X4& m = bones[bone];
+                row0 = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(m.m[0])), weight, row0);
+                row1 = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(m.m[1])), weight, row1);
+                row2 = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(m.m[2])), weight, row2);
+            };
+            accumulate(vertex.boneIndices & 0xFF, XMVectorSplatX(weights));
+            accumulate((vertex.boneIndices >> 8) & 0xFF, XMVectorSplatY(weights));
+            accumulate((vertex.boneIndices >> 16) & 0xFF, XMVectorSplatZ(weights));
+            accumulate((vertex.boneIndices >> 24) & 0xFF, XMVectorSplatW(weights));
+
+            rows[0].r[lane] = row0;
+            rows[1].r[lane] = row1;
+            rows[2].r[lane] = row2;
+            positions.r[lane] = XMVectorSetW(XMLoadFloat3(&vertex.pos), 1.0f);
+        }
+
+        // ]uƊexNg4_̓ɂȂ (p.r[0] = 4_ xAm.r[1] = 4_ r s 1  ...)
+        const XMMATRIX p = XMMatrixTranspose(positions);
+        XMMATRIX result;
+        for (uint32_t r = 0; r < 3; ++r)
+        {
+            const XMMATRIX m = XMMatrixTranspose(rows[r]);
+            result.r[r] = XMVectorMultiplyAdd(m.r[2], p.r[2], XMVectorMultiplyAdd(m.r[1], p.r[1], XMVectorMultiplyAdd(m.r[0], p.r[0], m.r[3])));
+        }
+        result.r[3] = XMVectorZero();
+
+        // _Ƃ (x, y, z) ɖ߂ďo
+        result = XMMatrixTranspose(result);
+        for (uint32_t lane = 0; lane < laneCount; ++lane)
+        {
+            const SkinnedVertex& vertex = source[i + lane];
+            Vertex& vertexOut = output[i + lane];
+            XMStoreFloat3(&vertexOut.pos, result.r[lane]);
+            vertexOut.color = vertex.color;
+            vertexOut.uv = vertex.uv;
+        }
+    }
+}
+
+void SkinVerticesParallel(const std::vector<SkinnedVertex>& input, const std::vector<XMFLOAT3X4>& palette,
+                          const std::vector<SkinningDraw>& draws, std::vector<Vertex>& output, uint32_t workerCount)
+{
+    // h[ c_SkinningBatchSize _̃ob`ɕ (傫ȃh[XbhɕU)
+    std::vector<SkinningBatch> batches;
+    size_t outputSize = 0;
+    for (uint32_t d = 0; d < draws.size(); ++d)
+    {
+        const SkinningDraw& draw = draws[d];
+        if (static_cast<uint64_t>(draw.firstInputVertex) + draw.vertexCount > input.size())
+        {
+            OutputDebugStringA("Skinning draw exceeds the input vertices\n");
+            throw std::runtime_error("Skinning draw exceeds the input vertices");
+        }
+        for (uint32_t first = 0; first < draw.vertexCount; first += c_SkinningBatchSize)
+        {
+            batches.push_back({ d, first, std::min(c_SkinningBatchSize, draw.vertexCount - first) });
+        }
+        outputSize = std::max(outputSize, static_cast<size_t>(draw.firstOutputVertex) + draw.vertexCount);
+    }
+
+    if (output.size() < outputSize)
+    {
+        output.resize(outputSize);
+    }
+
+    // eXbh͎̃ob`ɍs (h[Ƃ̒_̕΂z)
+    std::atomic<size_t> nextBatch = 0;
+    auto worker = [&]()
+    {
+        for (size_t b = nextBatch++; b < batches.size(); b = nextBatch++)
+        {
+            const SkinningBatch& batch = batches[b];
+            const SkinningDraw& draw = draws[batch.draw];
+            SkinVertices(input.data(), palette.data(), static_cast<uint32_t>(palette.size()), draw, batch.firstVertex, batch.count,
+                         output.data() + draw.firstOutputVertex + batch.firstVertex);
+        }
+    };
+
+    workerCount = std::max(1u, std::min(workerCount, static_cast<uint32_t>(batches.size())));
+    std::vector<std::future<void>> tasks;
+    for (uint32_t w = 1; w < workerCount; ++w)
+    {
+        tasks.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+}
+
+void SkinningPass::Initialize(ID3D11Device* device, const wchar_t* shaderFileName)
+{
+    Microsoft::WRL::ComPtr<ID3DBlob> csBlob;
+    Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+    HRESULT hr = D3DCompileFromFile(
+        shaderFileName,
+        nullptr,
+        D3D_COMPILE_STANDARD_FILE_INCLUDE,
+        "CSSkin",
+        "cs_5_0",
+        D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG,
+        0,
+        &csBlob,
+        &errorBlob
+    );
+
+    if (FAILED(hr))
+    {
+        if (errorBlob)
+        {
+            OutputDebugStringA("Skinning shader compilation failed:\n");
+            OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+        }
+        throw std::runtime_error("Skinning shader compilation failed");
+    }
+
+    hr = device->CreateComputeShader(csBlob->GetBufferPointer(), csBlob->GetBufferSize(), nullptr, &pSkinningShader);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create skinning shader\n");
+        throw std::runtime_error("Failed to create skinning shader");
+    }
+    OutputDebugStringA("Skinning shader created successfully\n");
+}
+
+void SkinningPass::CreateInputBuffer(ID3D11Device* device, const std::vector<SkinnedVertex>& vertices,
+                                     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& inputSRV)
+{
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    CreateStructuredBuffer(device, sizeof(SkinnedVertex), static_cast<uint32_t>(vertices.size()), vertices.data(), buffer, inputSRV);
+}
+
+void SkinningPass::CreateOutputBuffer(ID3D11Device* device, uint32_t vertexCount,
+                                      Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>& outputUAV,
+                                      Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outputSRV)
+{
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * vertexCount);
+    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = sizeof(Vertex);
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, &buffer);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create skinned vertex buffer\n");
+        throw std::runtime_error("Failed to create skinned vertex buffer");
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = vertexCount;
+
+    hr = device->CreateUnorderedAccessView(buffer.Get(), &uavDesc, outputUAV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create skinned vertex UAV\n");
+        throw std::runtime_error("Failed to create skinned vertex UAV");
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = vertexCount;
+
+    hr = device->CreateShaderResourceView(buffer.Get(), &srvDesc, outputSRV.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create skinned vertex SRV\n");
+        throw std::runtime_error("Failed to create skinned vertex SRV");
+    }
+}
+
+void SkinningPass::ReserveBuffers(ID3D11Device* device, uint32_t boneCount, uint32_t drawCount)
+{
+    // ȂȂ{ɐL΂ (t[̍蒼)
+    if (boneCount > m_paletteCapacity)
+    {
+        m_paletteCapacity = std::max(boneCount, m_paletteCapacity * 2);
+        CreateStructuredBuffer(device, sizeof(XMFLOAT3X4), m_paletteCapacity, nullptr, pPaletteBuffer, pPaletteSRV);
+    }
+
+    if (drawCount > m_drawCapacity)
+    {
+        m_drawCapacity = std::max(drawCount, m_drawCapacity * 2);
+        CreateStructuredBuffer(device, sizeof(SkinningDraw), m_drawCapacity, nullptr, pDrawBuffer, pDrawSRV);
+    }
+}
+
+void SkinningPass::Dispatch(ID3D11DeviceContext* context, UploadRing& uploadRing,
+                            ID3D11ShaderResourceView* inputSRV, ID3D11UnorderedAccessView* outputUAV,
+                            const std::vector<SkinningDraw>& draws, const std::vector<XMFLOAT3X4>& palette)
+{
+    if (draws.empty() || palette.empty())
+    {
+        return;
+    }
+
+    if (draws.size() > D3D11_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION)
+    {
+        OutputDebugStringA("Too many skinning draws\n");
+        throw std::runtime_error("Too many skinning draws");
+    }
+
+    Microsoft::WRL::ComPtr<ID3D11Device> device;
+    context->GetDevice(&device);
+    ReserveBuffers(device.Get(), static_cast<uint32_t>(palette.size()), static_cast<uint32_t>(draws.size()));
+
+    uploadRing.Upload(context, pPaletteBuffer.Get(), 0, palette.data(), static_cast<uint32_t>(sizeof(XMFLOAT3X4) * palette.size()));
+    uploadRing.Upload(context, pDrawBuffer.Get(), 0, draws.data(), static_cast<uint32_t>(sizeof(SkinningDraw) * draws.size()));
+
+    uint32_t maxVertexCount = 0;
+    for (const auto& draw : draws)
+    {
+        maxVertexCount = std::max(maxVertexCount, draw.vertexCount);
+    }
+
+    ID3D11ShaderResourceView* srvs[] = { inputSRV, pPaletteSRV.Get(), pDrawSRV.Get() };
+    context->CSSetShader(pSkinningShader.Get(), nullptr, 0);
+    context->CSSetShaderResources(0, 3, srvs);
+    context->CSSetUnorderedAccessViews(0, 1, &outputUAV, nullptr);
+
+    // X: h[̒_, Y: h[
+    context->Dispatch((maxVertexCount + c_SkinningGroupSize - 1) / c_SkinningGroupSize, static_cast<UINT>(draws.size()), 1);
+
+    // o͂ Render  SRV Ƃēǂ߂悤ɃAoCh
+    ID3D11ShaderResourceView* nullSRVs[3] = {};
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+    context->CSSetShaderResources(0, 3, nullSRVs);
+    context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+    context->CSSetShader(nullptr, nullptr, 0);
+}
\ No newline at end of file
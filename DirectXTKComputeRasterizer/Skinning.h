@@ -0,0 +1,80 @@
+#pragma once
+#include "DirectXTKComputeRasterizer.h"
+#include "UploadRing.h"
+
+// ==================================================================================
+// X^CYO̒_XLjO
+// SkinnedVertex (oCh|[Y) h[Ƃ̃{[pbgŕϊAX^CUǂ Vertex o͂B
+// bV𕡐̃LN^[ŋLꍇ́AfirstInputVertex 
+// firstOutputVertex / firstBone قȂh[ׂB
+// o͂̒_̓oCh|[ỸbVbg / BVH ̋EɎ܂Ȃ̂ŁARender ɂ meshletSRV n BVH OB
+// ==================================================================================
+
+// 1h[̃pbgɒu{[ (boneIndices  8bit)
+constexpr uint32_t c_MaxBonesPerDraw = 256;
+
+// GPU ł1O[v / CPU ł1ob`钸_
+constexpr uint32_t c_SkinningGroupSize = 64;
+constexpr uint32_t c_SkinningBatchSize = 4096;
+
+// XLjOp̒_ (56byte): GPU  SkinnedVertex ƓCAEg
+struct SkinnedVertex {
+    DirectX::XMFLOAT3 pos;
+    DirectX::XMFLOAT4 color;
+    DirectX::XMFLOAT2 uv;
+    uint32_t boneIndices;           // 8bit x 4 (h[̃pbg̃CfbNX)
+    DirectX::XMFLOAT4 boneWeights;  // v 1 (gȂ{[ 0)
+};
+
+// XLjÕh[ (16byte): GPU  SkinningDraw ƓCAEg
+struct SkinningDraw {
+    uint32_t firstInputVertex;
+    uint32_t vertexCount;
+    uint32_t firstOutputVertex;
+    uint32_t firstBone;         // pbgẑ̃h[̐擪
+};
+
+inline uint32_t PackBoneIndices(uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3)
+{
+    return b0 | (b1 << 8) | (b2 << 16) | (b3 << 24);
+}
+
+// CPU : draw  [firstVertex, firstVertex + count)  DirectXMath  SIMD Zŕϊ (4_ SoA ̃[ɕׂ)
+// palette  XMStoreFloat3x4 Ŋi[ boneCount ̃{[s ({[ -> o͍W)
+// _̃{[ palette ̊O (draw.firstBone + CfbNX >= boneCount) wĂΗO𓊂
+void SkinVertices(const SkinnedVertex* input, const DirectX::XMFLOAT3X4* palette, uint32_t boneCount, const SkinningDraw& draw,
+                  uint32_t firstVertex, uint32_t count, Vertex* output);
+
+// CPU : Sh[ c_SkinningBatchSize _̃ob`ɕAworkerCount Xbhŏ
+void SkinVerticesParallel(const std::vector<SkinnedVertex>& input, const std::vector<DirectX::XMFLOAT3X4>& palette,
+                          const std::vector<SkinningDraw>& draws, std::vector<Vertex>& output, uint32_t workerCount);
+
+// GPU : Rs[gVF[_[őSh[1 Dispatch ŕϊ
+class SkinningPass
+{
+public:
+    void Initialize(ID3D11Device* device, const wchar_t* shaderFileName = L"Skinning.hlsl");
+
+    void CreateInputBuffer(ID3D11Device* device, const std::vector<SkinnedVertex>& vertices,
+                           Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& inputSRV);
+    // o͂ UAV ŏ݁ASRV  Render  vertexBufferSRV ɓn
+    void CreateOutputBuffer(ID3D11Device* device, uint32_t vertexCount,
+                            Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView>& outputUAV,
+                            Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& outputSRV);
+
+    // pbgƃh[ uploadRing œ]Ă Dispatch 
+    void Dispatch(ID3D11DeviceContext* context, UploadRing& uploadRing,
+                  ID3D11ShaderResourceView* inputSRV, ID3D11UnorderedAccessView* outputUAV,
+                  const std::vector<SkinningDraw>& draws, const std::vector<DirectX::XMFLOAT3X4>& palette);
+
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> pSkinningShader;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pPaletteBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pPaletteSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pDrawBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pDrawSRV;
+    uint32_t m_paletteCapacity = 0;
+    uint32_t m_drawCapacity = 0;
+
+private:
+    void ReserveBuffers(ID3D11Device* device, uint32_t boneCount, uint32_t drawCount);
+};
\ No newline at end of file
@@ -0,0 +1,78 @@
+// ==================================================================================
+// Skinning.hlsl
+// X^CYO̒_XLjO (`uhA1_ő4{[)
+// 1O[v = 1h[ SKINNING_GROUP_SIZE _BY ̃O[vԍh[̃CfbNX
+// ==================================================================================
+
+#include "RasterizerCommon.hlsli"
+
+#define SKINNING_GROUP_SIZE 64
+
+// XLjOp̒_ (C++  SkinnedVertex ƓCAEg)
+struct SkinnedVertex {
+    float3 pos;
+    float4 color;
+    float2 uv;
+    uint   boneIndices; // 8bit x 4 (h[̃pbg̃CfbNX)
+    float4 boneWeights; // v 1
+};
+
+// {[s (C++  XMStoreFloat3x4  3x4 s: eso͂ x, y, z)
+struct BoneMatrix {
+    float4 row0;
+    float4 row1;
+    float4 row2;
+};
+
+// h[ (C++  SkinningDraw ƓCAEg)
+struct SkinningDraw {
+    uint firstInputVertex;
+    uint vertexCount;
+    uint firstOutputVertex;
+    uint firstBone;         // BonePalette ̂̃h[̃pbg̐擪
+};
+
+StructuredBuffer<SkinnedVertex> InputVertices : register(t0);
+StructuredBuffer<BoneMatrix> BonePalette : register(t1);
+StructuredBuffer<SkinningDraw> Draws : register(t2);
+
+// o: X^CÛ܂ VertexBuffer Ƃēǂޒ_
+RWStructuredBuffer<Vertex> OutputVertices : register(u0);
+
+[numthreads(SKINNING_GROUP_SIZE, 1, 1)]
+void CSSkin(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    SkinningDraw draw = Draws[groupId.y];
+
+    uint vertexIndex = groupId.x * SKINNING_GROUP_SIZE + groupThreadId.x;
+    if (vertexIndex >= draw.vertexCount)
+    {
+        return;
+    }
+
+    SkinnedVertex input = InputVertices[draw.firstInputVertex + vertexIndex];
+    uint4 bones = (input.boneIndices >> uint4(0, 8, 16, 24)) & 0xFF;
+
+    // d݂ōsĂ1񂾂ϊ
+    float4 row0 = 0.0f;
+    float4 row1 = 0.0f;
+    float4 row2 = 0.0f;
+
+    [unroll]
+    for (uint i = 0; i < 4; ++i)
+    {
+        BoneMatrix bone = BonePalette[draw.firstBone + bones[i]];
+        row0 += bone.row0 * input.boneWeights[i];
+        row1 += bone.row1 * input.boneWeights[i];
+        row2 += bone.row2 * input.boneWeights[i];
+    }
+
+    float4 position = float4(input.pos, 1.0f);
+
+    Vertex output;
+    output.pos = float3(dot(row0, position), dot(row1, position), dot(row2, position));
+    output.color = input.color;
+    output.uv = input.uv;
+
+    OutputVertices[draw.firstOutputVertex + vertexIndex] = output;
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "SoftwareDynamicGeometry.h"
+#include "DebugOutput.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // `͈ (draw) eʕ̓e (storage) ̐擪 count vfɍ킹 ( storage ʂ)
+    template <typename T>
+    void ResizeDrawRange(const std::vector<T>& storage, std::vector<T>& draw, size_t count)
+    {
+        const size_t previous = draw.size();
+        draw.resize(count);
+        if (count > previous)
+        {
+            std::copy(storage.begin() + previous, storage.begin() + count, draw.begin() + previous);
+        }
+    }
+
+    // storage  destinationOffset byte ȍ~֏Adraw ƏdȂ镔 draw ɂ
+    template <typename T>
+    void WriteRange(std::vector<T>& storage, std::vector<T>& draw, uint32_t destinationOffset, const uint8_t* source, uint32_t size)
+    {
+        memcpy(reinterpret_cast<uint8_t*>(storage.data()) + destinationOffset, source, size);
+
+        const size_t drawSize = draw.size() * sizeof(T);
+        if (destinationOffset < drawSize)
+        {
+            memcpy(reinterpret_cast<uint8_t*>(draw.data()) + destinationOffset, source, std::min<size_t>(size, drawSize - destinationOffset));
+        }
+    }
+}
+
+void SoftwareDynamicGeometry::Initialize(uint32_t vertexCapacity, uint32_t indexCapacity, uint32_t uploadCapacity)
+{
+    // 1̊mۂ̓O 1/c_FramesInFlight ܂łȂ̂ŁAꂪ 0 byte ɂȂ傫ł͍XV𕪊łȂ
+    if (uploadCapacity < c_FramesInFlight)
+    {
+        DebugOutput("Dynamic geometry upload capacity is too small\n");
+        throw std::runtime_error("Dynamic geometry upload capacity is too small");
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_vertexCapacity = vertexCapacity;
+    m_indexCapacity = indexCapacity;
+
+    m_allocator.Reset(uploadCapacity);
+    m_frameIndex = 1;
+    m_triangleCount = 0;
+    m_reportedOverflow = false;
+
+    m_uploadBuffer.assign(uploadCapacity, 0);
+    m_copies.clear();
+    m_frames.clear();
+    m_completedFrameIndex = 0;
+
+    // e 0 (ŏ UpdateVertices / UpdateIndices ŏ)
+    m_vertices.assign(vertexCapacity, Vertex{});
+    m_indices.assign(indexCapacity, 0);
+    m_drawVertices.clear();
+    m_drawIndices.clear();
+    m_acquiredFrameIndex = 0;
+}
+
+void SoftwareDynamicGeometry::UpdateVertices(uint32_t firstVertex, const Vertex* vertices, uint32_t count)
+{
+    if (static_cast<uint64_t>(firstVertex) + count > m_vertexCapacity)
+    {
+        DebugOutput("Dynamic vertex update out of range\n");
+        throw std::runtime_error("Dynamic vertex update out of range");
+    }
+
+    Upload(false, firstVertex * static_cast<uint32_t>(sizeof(Vertex)), vertices, count * static_cast<uint32_t>(sizeof(Vertex)));
+}
+
+void SoftwareDynamicGeometry::UpdateIndices(uint32_t firstIndex, const uint32_t* indices, uint32_t count)
+{
+    if (static_cast<uint64_t>(firstIndex) + count > m_indexCapacity)
+    {
+        DebugOutput("Dynamic index update out of range\n");
+        throw std::runtime_error("Dynamic index update out of range");
+    }
+
+    Upload(true, firstIndex * static_cast<uint32_t>(sizeof(uint32_t)), indices, count * static_cast<uint32_t>(sizeof(uint32_t)));
+}
+
+void SoftwareDynamicGeometry::SetTriangleCount(uint32_t triangleCount)
+{
+    const uint32_t capacity = (m_indexCapacity > 0 ? m_indexCapacity : m_vertexCapacity) / 3;
+    if (triangleCount > capacity)
+    {
+        DebugOutput("Dynamic triangle count exceeds capacity\n");
+        throw std::runtime_error("Dynamic triangle count exceeds capacity");
+    }
+
+    m_triangleCount = triangleCount;
+}
+
+void SoftwareDynamicGeometry::Upload(bool indices, uint32_t destinationOffset, const void* data, uint32_t size)
+{
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+
+    // 1̊mۂ̓O 1/c_FramesInFlight ܂ (UploadRing Ɠ)
+    const uint32_t maxChunkSize = static_cast<uint32_t>(m_allocator.GetCapacity() / c_FramesInFlight);
+
+    while (size > 0)
+    {
+        const uint32_t chunkSize = std::min(size, maxChunkSize);
+
+        uint64_t offset = m_allocator.Allocate(chunkSize);
+        while (offset == RingAllocator::c_InvalidOffset && m_allocator.HasPendingFrames())
+        {
+            // O܂Ă: łÂt[`Î҂ĉ
+            WaitForFrame(m_allocator.GetOldestPendingFrame());
+            offset = m_allocator.Allocate(chunkSize);
+        }
+
+        PendingCopy copy = { m_frameIndex, indices, destinationOffset, chunkSize, offset, {} };
+        if (offset == RingAllocator::c_InvalidOffset)
+        {
+            // ̃t[ŃOg؂: XV𕡐Ď
+            if (!m_reportedOverflow)
+            {
+                DebugOutput("Dynamic geometry upload ring overflow, copying the update\n");
+                m_reportedOverflow = true;
+            }
+            copy.data.assign(source, source + chunkSize);
+        }
+        else
+        {
+            // mۂ͈͕͂`摤ǂݏI Retire ܂ōXV̂
+            memcpy(m_uploadBuffer.data() + offset, source, chunkSize);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_copies.push_back(std::move(copy));
+        }
+
+        source += chunkSize;
+        destinationOffset += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+void SoftwareDynamicGeometry::EndFrame()
+{
+    // `摤̃t[ c_FramesInFlight t[O`IĂȂΑ҂
+    if (m_frameIndex > c_FramesInFlight)
+    {
+        WaitForFrame(m_frameIndex - c_FramesInFlight);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frames.push_back({ m_frameIndex, m_triangleCount });
+    }
+
+    m_allocator.FinishFrame(m_frameIndex);
+    ++m_frameIndex;
+
+    m_allocator.Retire(GetCompletedFrameIndex());
+}
+
+bool SoftwareDynamicGeometry::AcquireFrame()
+{
+    // ߂t[̓]o (Rs[̂̓bN̊Oōs)
+    PendingFrame frame;
+    std::vector<PendingCopy> copies;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_frames.empty())
+        {
+            return false;
+        }
+
+        frame = m_frames.front();
+        m_frames.pop_front();
+
+        while (!m_copies.empty() && m_copies.front().frameIndex <= frame.frameIndex)
+        {
+            copies.push_back(std::move(m_copies.front()));
+            m_copies.pop_front();
+        }
+    }
+
+    const size_t drawCount = static_cast<size_t>(frame.triangleCount) * 3;
+    if (m_indexCapacity > 0)
+    {
+        ResizeDrawRange(m_indices, m_drawIndices, drawCount);
+    }
+    else
+    {
+        ResizeDrawRange(m_vertices, m_drawVertices, drawCount);
+    }
+
+    for (const PendingCopy& copy : copies)
+    {
+        ApplyCopy(copy);
+    }
+
+    m_acquiredFrameIndex = frame.frameIndex;
+    return true;
+}
+
+void SoftwareDynamicGeometry::ReleaseFrame()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completedFrameIndex = std::max(m_completedFrameIndex, m_acquiredFrameIndex);
+    }
+    m_frameCompleted.notify_all();
+}
+
+uint64_t SoftwareDynamicGeometry::GetCompletedFrameIndex() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completedFrameIndex;
+}
+
+void SoftwareDynamicGeometry::WaitForFrame(uint64_t frameIndex)
+{
+    uint64_t completedFrameIndex;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_frameCompleted.wait(lock, [&] { return m_completedFrameIndex >= frameIndex; });
+        completedFrameIndex = m_completedFrameIndex;
+    }
+
+    m_allocator.Retire(completedFrameIndex);
+}
+
+void SoftwareDynamicGeometry::ApplyCopy(const PendingCopy& copy)
+{
+    const uint8_t* source = copy.sourceOffset == RingAllocator::c_InvalidOffset ? copy.data.data() : m_uploadBuffer.data() + copy.sourceOffset;
+
+    if (copy.indices)
+    {
+        WriteRange(m_indices, m_drawIndices, copy.destinationOffset, source, copy.size);
+    }
+    else if (m_indexCapacity > 0)
+    {
+        // CfbNX`ł͒_ׂ͂ĕ`͈ (m_vertices ̂܂ Render ɓn)
+        memcpy(reinterpret_cast<uint8_t*>(m_vertices.data()) + copy.destinationOffset, source, copy.size);
+    }
+    else
+    {
+        WriteRange(m_vertices, m_drawVertices, copy.destinationOffset, source, copy.size);
+    }
+}
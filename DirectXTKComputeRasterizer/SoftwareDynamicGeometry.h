@@ -0,0 +1,92 @@
+#pragma once
+#include "RasterizerTypes.h"
+#include "RingAllocator.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// ==================================================================================
+// CPU ł DynamicGeometry (SoftwareRasterizer::Render ɓn_ / CfbNX𖈃t[)
+// GPU ł UploadRing ƓAXV͔͈͒PʂŃÕAbv[ḧ (RingAllocator) ɐς݁A
+// `摤̃t[`Oɒ_ / CfbNX֔fB
+// XV͕`摤ő c_FramesInFlight t[słA͈͂̍ėp͕`摤
+// ̃t[`IĂŝŁAʃXbhŕ`ĂĂ݂Ŏ~܂ȂB
+// `摤ʃXbhɂȂꍇ́AEndFrame ̂т AcquireFrame / ReleaseFrame ŕ`
+// (` c_FramesInFlight t[葽߂ EndFrame ҂)B
+// ==================================================================================
+class SoftwareDynamicGeometry
+{
+public:
+    static constexpr uint32_t c_FramesInFlight = 3;
+
+    // indexCapacity  0 ȂCfbNX` (3_ = 1Op`)
+    void Initialize(uint32_t vertexCapacity, uint32_t indexCapacity = 0, uint32_t uploadCapacity = c_DefaultUploadRingSize);
+
+    // XV: vertices[0 .. count)  firstVertex ȍ~ (EndFrame Œ߂t[猩)
+    void UpdateVertices(uint32_t firstVertex, const Vertex* vertices, uint32_t count);
+    void UpdateIndices(uint32_t firstIndex, const uint32_t* indices, uint32_t count);
+
+    // XV: `悷Op`̐ (eʂ͈͓̔ŕς)
+    void SetTriangleCount(uint32_t triangleCount);
+
+    // XV: t[߂ĕ`摤֓n (`摤 c_FramesInFlight t[xĂꍇ҂)
+    void EndFrame();
+
+    // `摤: ߂̃t[̍XV𔽉f (߂t[Ȃ false)
+    //  GetVertices / GetIndices  Render ɓnA`I ReleaseFrame Ŕ͈͂Ԃ
+    bool AcquireFrame();
+    void ReleaseFrame();
+
+    // `摤: AcquireFrame t[̒_ƃCfbNX (Op`̐̒BCfbNX`ȂCfbNX͋)
+    const std::vector<Vertex>& GetVertices() const { return m_indexCapacity > 0 ? m_vertices : m_drawVertices; }
+    const std::vector<uint32_t>& GetIndices() const { return m_drawIndices; }
+
+    uint64_t GetFrameIndex() const { return m_frameIndex; }
+    uint64_t GetCompletedFrameIndex() const;
+
+private:
+    // Abv[ḧ悩璸_ / CfbNXւ̓] (GPU ł CopySubresourceRegion)
+    struct PendingCopy
+    {
+        uint64_t frameIndex;
+        bool indices;
+        uint32_t destinationOffset;   // byte
+        uint32_t size;                // byte
+        uint64_t sourceOffset;        // Abv[ḧ̈ʒu (c_InvalidOffset Ȃ data)
+        std::vector<uint8_t> data;    // OɎ܂ȂXV̕ (GPU ł UpdateSubresource)
+    };
+
+    struct PendingFrame
+    {
+        uint64_t frameIndex;
+        uint32_t triangleCount;
+    };
+
+    void Upload(bool indices, uint32_t destinationOffset, const void* data, uint32_t size);
+    void WaitForFrame(uint64_t frameIndex);
+    void ApplyCopy(const PendingCopy& copy);
+
+    uint32_t m_vertexCapacity = 0;
+    uint32_t m_indexCapacity = 0;
+
+    // XVG
+    RingAllocator m_allocator;
+    uint64_t m_frameIndex = 1;
+    uint32_t m_triangleCount = 0;
+    bool m_reportedOverflow = false;
+
+    // G (m_mutex ŎBAbv[ḧ͊mۂ͈͂Ƃɂǂ炩G)
+    std::vector<uint8_t> m_uploadBuffer;
+    std::deque<PendingCopy> m_copies;
+    std::deque<PendingFrame> m_frames;
+    uint64_t m_completedFrameIndex = 0;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_frameCompleted;
+
+    // `摤G (m_vertices / m_indices ͗eʕ̓eAm_drawVertices / m_drawIndices ͕`Op`̕)
+    std::vector<Vertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    std::vector<Vertex> m_drawVertices;
+    std::vector<uint32_t> m_drawIndices;
+    uint64_t m_acquiredFrameIndex = 0;
+};
@@ -0,0 +1,2165 @@
+#include "SoftwareRasterizer.h"
+#include "DebugOutput.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+using namespace DirectX;
+
+namespace
+{
+    uint32_t PackColor(FXMVECTOR color)
+    {
+        XMVECTOR scaled = XMVectorMultiplyAdd(XMVectorSaturate(color), XMVectorReplicate(255.0f), XMVectorReplicate(0.5f));
+        XMFLOAT4 value;
+        XMStoreFloat4(&value, scaled);
+        return static_cast<uint32_t>(value.x)
+             | (static_cast<uint32_t>(value.y) << 8)
+             | (static_cast<uint32_t>(value.z) << 16)
+             | (static_cast<uint32_t>(value.w) << 24);
+    }
+
+    XMVECTOR UnpackColor(uint32_t value)
+    {
+        return XMVectorScale(XMVectorSet(static_cast<float>(value & 0xFF), static_cast<float>((value >> 8) & 0xFF),
+                                         static_cast<float>((value >> 16) & 0xFF), static_cast<float>(value >> 24)), 1.0f / 255.0f);
+    }
+
+    // dst ̏ src  src.a ō (rgb = lerp(dst, src, src.a), a = src.a + dst.a * (1 - src.a))
+    XMVECTOR XM_CALLCONV BlendColor(FXMVECTOR dst, FXMVECTOR src)
+    {
+        const float srcAlpha = XMVectorGetW(src);
+        const float dstAlpha = XMVectorGetW(dst);
+        return XMVectorSetW(XMVectorLerp(dst, src, srcAlpha), srcAlpha + dstAlpha * (1.0f - srcAlpha));
+    }
+
+    // Tṽ}XN̐ (GPU ł countbits)
+    uint32_t CountBits(uint32_t mask)
+    {
+        uint32_t count = 0;
+        for (; mask != 0; mask &= mask - 1)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    // 1s̐[x format ŏ (D24UnormS8 ̃XeV 0)
+    void StoreDepthRow(uint8_t* dest, const float* depth, uint32_t count, DepthFormat format)
+    {
+        switch (format)
+        {
+        case DepthFormat::D32Float:
+            memcpy(dest, depth, count * sizeof(float));
+            break;
+        case DepthFormat::D24UnormS8:
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const uint32_t value = static_cast<uint32_t>(std::min(std::max(depth[i], 0.0f), 1.0f) * 16777215.0f + 0.5f);
+                memcpy(dest + i * sizeof(uint32_t), &value, sizeof(value));
+            }
+            break;
+        case DepthFormat::D16Unorm:
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const uint16_t value = static_cast<uint16_t>(std::min(std::max(depth[i], 0.0f), 1.0f) * 65535.0f + 0.5f);
+                memcpy(dest + i * sizeof(uint16_t), &value, sizeof(value));
+            }
+            break;
+        }
+    }
+
+    // 1sNZ̐[x format  float œǂ
+    float LoadDepth(const uint8_t* source, DepthFormat format)
+    {
+        switch (format)
+        {
+        case DepthFormat::D24UnormS8:
+        {
+            uint32_t value;
+            memcpy(&value, source, sizeof(value));
+            return static_cast<float>(value & 0xFFFFFF) / 16777215.0f;
+        }
+        case DepthFormat::D16Unorm:
+        {
+            uint16_t value;
+            memcpy(&value, source, sizeof(value));
+            return static_cast<float>(value) / 65535.0f;
+        }
+        default:
+        {
+            float value;
+            memcpy(&value, source, sizeof(value));
+            return value;
+        }
+        }
+    }
+
+    // count  float  R16 ~ R16G16B16A16_FLOAT  1eNZƂď
+    void StoreHalfTexel(uint8_t* dest, const float* values, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const PackedVector::HALF value = PackedVector::XMConvertFloatToHalf(values[i]);
+            memcpy(dest + i * sizeof(value), &value, sizeof(value));
+        }
+    }
+
+    // ێIX^CYŖʐςŊGbW֐ edges ɑ (GPU ł IsPixelCoveredConservative)
+    // ӂsNZ̔̍L 0.5 * (|a| + |b|) O (ߑ]) /  (ߏ]) ւ炷
+    XMFLOAT3 ConservativeCoverageBias(const XMFLOAT3 edges[3], ConservativeMode mode)
+    {
+        if (mode == ConservativeMode::Off)
+        {
+            return XMFLOAT3(0.0f, 0.0f, 0.0f);
+        }
+        const float halfPixel = mode == ConservativeMode::Overestimate ? 0.5f : -0.5f;
+        return XMFLOAT3(halfPixel * (std::abs(edges[0].x) + std::abs(edges[0].y)),
+                        halfPixel * (std::abs(edges[1].x) + std::abs(edges[1].y)),
+                        halfPixel * (std::abs(edges[2].x) + std::abs(edges[2].y)));
+    }
+
+    // a -> b ̃GbW֐ EdgeFunction(a, b, p)  p.x * x + p.y * y + z ̌Wŕ\
+    XMFLOAT3 EdgeCoefficients(XMFLOAT2 a, XMFLOAT2 b, float invArea)
+    {
+        return XMFLOAT3((b.y - a.y) * invArea,
+                        (a.x - b.x) * invArea,
+                        (a.y * (b.x - a.x) - a.x * (b.y - a.y)) * invArea);
+    }
+}
+
+std::vector<Vertex> CreateCalibrationScene(uint32_t triangleCount, float aspect)
+{
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // 1ӂʂ̍ 1/8 x
+    const float size = 0.25f;
+    std::vector<Vertex> vertices;
+    vertices.reserve(static_cast<size_t>(triangleCount) * 3);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const float cx = position(random);
+        const float cy = position(random);
+        const float z = 0.1f + 0.8f * unit(random);
+        const float angle = XM_2PI * unit(random);
+        const XMFLOAT4 color(unit(random), unit(random), unit(random), 0.5f + 0.5f * unit(random));
+        const float winding = (t & 1) ? -1.0f : 1.0f;
+
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            const float a = angle + winding * k * XM_2PI / 3.0f;
+            Vertex vertex;
+            vertex.pos = XMFLOAT3(cx + size * cosf(a) / aspect, cy + size * sinf(a), z);
+            vertex.color = color;
+            vertex.uv = XMFLOAT2(0.5f + cosf(a), 0.5f + sinf(a));
+            vertices.push_back(vertex);
+        }
+    }
+    return vertices;
+}
+
+std::vector<uint32_t> BuildWireframeEdges(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    // ʒuŕבւ (ʒuȂԍ̏)Aʒu̒_ŏ̒_ɂ܂Ƃ߂
+    const auto positionLess = [&](uint32_t a, uint32_t b)
+    {
+        const XMFLOAT3& p = vertices[a].pos;
+        const XMFLOAT3& q = vertices[b].pos;
+        return std::tie(p.x, p.y, p.z) < std::tie(q.x, q.y, q.z);
+    };
+    std::vector<uint32_t> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), positionLess);
+
+    std::vector<uint32_t> remap(vertices.size());
+    for (size_t first = 0, i = 0; i < order.size(); ++i)
+    {
+        if (positionLess(order[first], order[i]))
+        {
+            first = i;
+        }
+        remap[order[i]] = order[first];
+    }
+
+    // ӂ (ԍ, 傫ԍ)  64bit ɂĕבւAd (ׂꂽӂ͕`Ȃ)
+    const uint32_t triangleCount = TriangleCount(vertices, indices);
+    std::vector<uint64_t> keys;
+    keys.reserve(static_cast<size_t>(triangleCount) * 3);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            const uint32_t a = remap[TriangleVertexIndex(indices, t, k)];
+            const uint32_t b = remap[TriangleVertexIndex(indices, t, (k + 1) % 3)];
+            if (a != b)
+            {
+                keys.push_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+            }
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<uint32_t> edges;
+    edges.reserve(keys.size() * 2);
+    for (uint64_t key : keys)
+    {
+        edges.push_back(static_cast<uint32_t>(key >> 32));
+        edges.push_back(static_cast<uint32_t>(key));
+    }
+    return edges;
+}
+
+XMFLOAT2 EncodeNormalOctahedral(const XMFLOAT3& normal)
+{
+    const float scale = 1.0f / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+    const float x = normal.x * scale;
+    const float y = normal.y * scale;
+    if (normal.z >= 0.0f)
+    {
+        return XMFLOAT2(x, y);
+    }
+    // ͑ΊpŐ܂Ԃ
+    return XMFLOAT2((1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f), (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f));
+}
+
+XMFLOAT3 DecodeNormalOctahedral(const XMFLOAT2& encoded)
+{
+    XMFLOAT3 normal(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+    if (normal.z < 0.0f)
+    {
+        normal.x = (1.0f - std::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f);
+        normal.y = (1.0f - std::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    XMStoreFloat3(&normal, XMVector3Normalize(XMLoadFloat3(&normal)));
+    return normal;
+}
+
+void SoftwareRasterizer::Initialize(uint32_t width, uint32_t height)
+{
+    m_width = width;
+    m_height = height;
+    m_color.assign(static_cast<size_t>(width) * height, 0);
+    m_depthStorage.assign(static_cast<size_t>(width) * height * GetDepthBytesPerPixel(m_depthBufferDesc.format), 0);
+    for (uint32_t t = 0; t < c_GBufferTargetCount; ++t)
+    {
+        m_gbuffer[t].assign(static_cast<size_t>(width) * height * GetGBufferBytesPerPixel(m_gbufferDesc.formats[t]), 0);
+    }
+    m_tileCleared.clear();
+    m_views.clear();
+}
+
+void SoftwareRasterizer::SetGBuffer(const GBufferDesc& desc)
+{
+    m_gbufferDesc = desc;
+    for (uint32_t t = 0; t < c_GBufferTargetCount; ++t)
+    {
+        m_gbuffer[t].assign(static_cast<size_t>(m_width) * m_height * GetGBufferBytesPerPixel(desc.formats[t]), 0);
+    }
+    // V^[Qbg̒g 0 Ȃ̂ŁANAꂽ܂܂̃^C
+    std::fill(m_tileCleared.begin(), m_tileCleared.end(), static_cast<uint8_t>(0));
+}
+
+void SoftwareRasterizer::SetNormalTransform(FXMMATRIX world)
+{
+    XMStoreFloat4x4(&m_world, world);
+    XMStoreFloat4x4(&m_normalWorld, XMMatrixTranspose(XMMatrixInverse(nullptr, world)));
+}
+
+void SoftwareRasterizer::SetPreviousTransform(FXMMATRIX worldViewProj)
+{
+    XMStoreFloat4x4(&m_previousWorldViewProj, worldViewProj);
+    m_previousTransformValid = true;
+}
+
+void SoftwareRasterizer::SetDepthBuffer(const DepthBufferDesc& desc)
+{
+    m_depthBufferDesc = desc;
+    m_depthStorage.assign(static_cast<size_t>(m_width) * m_height * GetDepthBytesPerPixel(desc.format), 0);
+    std::fill(m_tileCleared.begin(), m_tileCleared.end(), static_cast<uint8_t>(0));
+    m_views.clear();
+}
+
+float SoftwareRasterizer::GetDepth(uint32_t x, uint32_t y) const
+{
+    const DepthFormat format = m_depthBufferDesc.format;
+    return LoadDepth(&m_depthStorage[(static_cast<size_t>(y) * m_width + x) * GetDepthBytesPerPixel(format)], format);
+}
+
+void SoftwareShadowMap::Create(uint32_t shadowWidth, uint32_t shadowHeight, const DepthBufferDesc& depthDesc)
+{
+    width = shadowWidth;
+    height = shadowHeight;
+    desc = depthDesc;
+    storage.assign(static_cast<size_t>(width) * height * GetDepthBytesPerPixel(desc.format), 0);
+}
+
+float SoftwareShadowMap::GetDepth(uint32_t x, uint32_t y) const
+{
+    return LoadDepth(&storage[(static_cast<size_t>(y) * width + x) * GetDepthBytesPerPixel(desc.format)], desc.format);
+}
+
+void SoftwareRasterizer::SetTileSize(uint32_t tileSizeIndex)
+{
+    if (tileSizeIndex >= c_TileSizeCount)
+    {
+        DebugOutput("Failed to set tile size: index is out of range\n");
+        throw std::runtime_error("Failed to set tile size: index is out of range");
+    }
+
+    // ̃^[Qbg̃NAtO BinTriangles  m_binnedTileSizeIndex Ɣׂč蒼Br[͂̕тoĂȂ̂Ŏ̂Ă
+    if (tileSizeIndex != m_tileSizeIndex)
+    {
+        for (ViewTarget& view : m_views)
+        {
+            view.tileCleared.clear();
+        }
+    }
+    m_tileSizeIndex = tileSizeIndex;
+}
+
+void SoftwareRasterizer::SetClearColor(const XMFLOAT4& color)
+{
+    if (memcmp(&color, &m_clearColor, sizeof(color)) != 0)
+    {
+        m_clearColor = color;
+        std::fill(m_tileCleared.begin(), m_tileCleared.end(), static_cast<uint8_t>(0));
+        for (ViewTarget& view : m_views)
+        {
+            view.tileCleared.clear();
+        }
+    }
+}
+
+void SoftwareRasterizer::ResolveColor(uint32_t* dest, size_t rowPitch) const
+{
+    const TileSize tileSize = c_TileSizes[m_binnedTileSizeIndex];
+    const uint32_t clearColor = PackColor(XMLoadFloat4(&m_clearColor));
+    for (uint32_t y = 0; y < m_height; ++y)
+    {
+        uint32_t* destRow = reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(dest) + y * rowPitch);
+        const uint32_t* sourceRow = &m_color[static_cast<size_t>(y) * m_width];
+        const uint8_t* clearedRow = &m_tileCleared[(y / tileSize.height) * m_tilesX];
+        for (uint32_t tx = 0; tx < m_tilesX; ++tx)
+        {
+            const uint32_t x0 = tx * tileSize.width;
+            const uint32_t x1 = std::min(x0 + tileSize.width, m_width);
+            if (clearedRow[tx])
+            {
+                std::fill(destRow + x0, destRow + x1, clearColor);
+            }
+            else
+            {
+                std::copy(sourceRow + x0, sourceRow + x1, destRow + x0);
+            }
+        }
+    }
+}
+
+uint32_t SoftwareRasterizer::AutoTuneTileSize(int iterations)
+{
+    const std::vector<Vertex> vertices = CreateCalibrationScene(2048, static_cast<float>(m_width) / m_height);
+    const std::vector<uint32_t> indices;
+
+    // rp̃V[ NDC WȂ̂ŁAGPU łƓ̏ (PʍsAeNX`ƃCgȂAʏ̃X^CY) ŕ`
+    // Ԃƒ߂ Render ̓v͗OŔꍇ܂߂ăXR[v̏IŖ߂Br̃t[ŃNA^C
+    // G-buffer ĂȂ̂ŁANAtO͎ Render ō蒼
+    struct CalibrationState
+    {
+        SoftwareRasterizer& rasterizer;
+        const XMFLOAT4X4 worldViewProj;
+        const SoftwareTexture* const texture;
+        const RasterState rasterState;
+        const ConservativeMode conservativeMode;
+        const AntiAliasMode antiAliasMode;
+        const DepthPrepassMode depthPrepassMode;
+        const ShadingRateMode shadingRateMode;
+        const uint32_t scissorRectCount;
+        const GBufferDesc gbufferDesc;
+        std::vector<PointLight> lights;
+        const XMFLOAT4X4 lightViewProj;
+        const XMFLOAT4 viewOrigin;
+        const XMFLOAT4X4 previousWorldViewProj;
+        const bool previousTransformValid;
+        const uint32_t tileSizeIndex;
+        const size_t writtenPixelCount, rasterizedTileCount;
+        const uint64_t depthPassFragments, shadedFragments, coveredPixels, sharedShadedPixels, tileLights, overflowedLightTiles;
+        const bool depthPrepassActive, variableRateActive, gbufferActive, lightingActive;
+
+        explicit CalibrationState(SoftwareRasterizer& r)
+            : rasterizer(r), worldViewProj(r.m_worldViewProj), texture(r.m_texture), rasterState(r.m_rasterState),
+              conservativeMode(r.m_conservativeMode), antiAliasMode(r.m_antiAliasMode), depthPrepassMode(r.m_depthPrepassMode),
+              shadingRateMode(r.m_shadingRateMode), scissorRectCount(r.m_scissorRectCount), gbufferDesc(r.m_gbufferDesc),
+              lights(std::move(r.m_lights)), lightViewProj(r.m_lightViewProj), viewOrigin(r.m_viewOrigin),
+              previousWorldViewProj(r.m_previousWorldViewProj), previousTransformValid(r.m_previousTransformValid),
+              tileSizeIndex(r.m_tileSizeIndex), writtenPixelCount(r.m_writtenPixelCount), rasterizedTileCount(r.m_rasterizedTileCount),
+              depthPassFragments(r.m_depthPassFragments), shadedFragments(r.m_shadedFragments), coveredPixels(r.m_coveredPixels),
+              sharedShadedPixels(r.m_sharedShadedPixels), tileLights(r.m_tileLights), overflowedLightTiles(r.m_overflowedLightTiles),
+              depthPrepassActive(r.m_depthPrepassActive), variableRateActive(r.m_variableRateActive),
+              gbufferActive(r.m_gbufferActive), lightingActive(r.m_lightingActive)
+        {
+            XMStoreFloat4x4(&r.m_worldViewProj, XMMatrixIdentity());
+            r.m_texture = nullptr;
+            r.m_rasterState = RasterState();
+            r.m_conservativeMode = ConservativeMode::Off;
+            r.m_antiAliasMode = AntiAliasMode::Off;
+            r.m_depthPrepassMode = DepthPrepassMode::Off;
+            r.m_shadingRateMode = ShadingRateMode::Off;
+            r.m_scissorRectCount = 0;
+            r.m_gbufferDesc = GBufferDesc();
+            r.m_lights.clear();
+        }
+
+        ~CalibrationState()
+        {
+            SoftwareRasterizer& r = rasterizer;
+            r.m_worldViewProj = worldViewProj;
+            r.m_texture = texture;
+            r.m_rasterState = rasterState;
+            r.m_conservativeMode = conservativeMode;
+            r.m_antiAliasMode = antiAliasMode;
+            r.m_depthPrepassMode = depthPrepassMode;
+            r.m_shadingRateMode = shadingRateMode;
+            r.m_scissorRectCount = scissorRectCount;
+            r.m_gbufferDesc = gbufferDesc;
+            r.m_lights = std::move(lights);
+            r.m_lightViewProj = lightViewProj;
+            r.m_viewOrigin = viewOrigin;
+            r.m_previousWorldViewProj = previousWorldViewProj;
+            r.m_previousTransformValid = previousTransformValid;
+            r.m_tileSizeIndex = tileSizeIndex;
+            std::fill(r.m_tileCleared.begin(), r.m_tileCleared.end(), static_cast<uint8_t>(0));
+
+            r.m_writtenPixelCount = writtenPixelCount;
+            r.m_rasterizedTileCount = rasterizedTileCount;
+            r.m_depthPassFragments = depthPassFragments;
+            r.m_shadedFragments = shadedFragments;
+            r.m_coveredPixels = coveredPixels;
+            r.m_sharedShadedPixels = sharedShadedPixels;
+            r.m_tileLights = tileLights;
+            r.m_overflowedLightTiles = overflowedLightTiles;
+            r.m_depthPrepassActive = depthPrepassActive;
+            r.m_variableRateActive = variableRateActive;
+            r.m_gbufferActive = gbufferActive;
+            r.m_lightingActive = lightingActive;
+        }
+    };
+
+    uint32_t bestTileSize = m_tileSizeIndex;
+    double bestSeconds = 1e30;
+    {
+        CalibrationState calibration(*this);
+
+        for (uint32_t tileSize = 0; tileSize < c_TileSizeCount; ++tileSize)
+        {
+            SetTileSize(tileSize);
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = std::chrono::high_resolution_clock::now();
+                Render(vertices, indices);
+                const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+                if (seconds < bestSeconds)
+                {
+                    bestSeconds = seconds;
+                    bestTileSize = tileSize;
+                }
+            }
+        }
+    }
+
+    SetTileSize(bestTileSize);
+    return bestTileSize;
+}
+
+void SoftwareRasterizer::SetTransform(FXMMATRIX worldViewProj)
+{
+    XMStoreFloat4x4(&m_worldViewProj, worldViewProj);
+}
+
+bool SoftwareRasterizer::SetupTriangle(const Vertex* const v[3], FXMMATRIX worldViewProj, CullMode cullMode, TriangleSetup& setup) const
+{
+    const float width = static_cast<float>(m_width);
+    const float height = static_cast<float>(m_height);
+
+    XMFLOAT4 clip[3];
+    XMFLOAT2 screen[3];
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        XMStoreFloat4(&clip[k], XMVector3Transform(XMLoadFloat3(&v[k]->pos), worldViewProj));
+
+        // GPU łƓNbvȂ̂ŁAJʂ܂Op`͕`Ȃ
+        if (clip[k].w <= 1e-6f)
+        {
+            return false;
+        }
+        const float invW = 1.0f / clip[k].w;
+        screen[k] = XMFLOAT2((clip[k].x * invW + 1.0f) * 0.5f * width, (1.0f - clip[k].y * invW) * 0.5f * height);
+    }
+
+    // EdgeFunction(s0, s1, s2)
+    const float area = (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y)
+                     - (screen[2].y - screen[0].y) * (screen[1].x - screen[0].x);
+    if (area == 0.0f) return false;
+    if (cullMode == CullMode::Back && area < 0.0f) return false;
+    if (cullMode == CullMode::Front && area > 0.0f) return false;
+
+    // sNZS (x + 0.5) Op` AABB ɓ͈ (ߑ]ƃA`GCAX̃Tv̂߂ɔsNZL)
+    const float margin = m_conservativeMode == ConservativeMode::Overestimate || m_antiAliasMode != AntiAliasMode::Off ? 0.5f : 0.0f;
+    const float minX = std::min({ screen[0].x, screen[1].x, screen[2].x }) - margin;
+    const float maxX = std::max({ screen[0].x, screen[1].x, screen[2].x }) + margin;
+    const float minY = std::min({ screen[0].y, screen[1].y, screen[2].y }) - margin;
+    const float maxY = std::max({ screen[0].y, screen[1].y, screen[2].y }) + margin;
+    if (maxX < 0.5f || maxY < 0.5f || minX > width - 0.5f || minY > height - 0.5f) return false;
+
+    setup.minX = static_cast<uint32_t>(std::max(0.0f, std::ceil(minX - 0.5f)));
+    setup.minY = static_cast<uint32_t>(std::max(0.0f, std::ceil(minY - 0.5f)));
+    setup.maxX = static_cast<uint32_t>(std::min(width - 1.0f, std::floor(maxX - 0.5f)));
+    setup.maxY = static_cast<uint32_t>(std::min(height - 1.0f, std::floor(maxY - 0.5f)));
+    if (setup.minX > setup.maxX || setup.minY > setup.maxY) return false;
+
+    // ʐςŊĂƁA̎Op`łdSŴ܂ܓŐɂȂ
+    const float invArea = 1.0f / area;
+    setup.edges[0] = EdgeCoefficients(screen[1], screen[2], invArea);
+    setup.edges[1] = EdgeCoefficients(screen[2], screen[0], invArea);
+    setup.edges[2] = EdgeCoefficients(screen[0], screen[1], invArea);
+    setup.coverageBias = ConservativeCoverageBias(setup.edges, m_conservativeMode);
+
+    float invW[3];
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        invW[k] = 1.0f / clip[k].w;
+        XMStoreFloat4(&setup.colorOverW[k], XMVectorScale(XMLoadFloat4(&v[k]->color), invW[k]));
+        setup.uvOverW[k] = XMFLOAT2(v[k]->uv.x * invW[k], v[k]->uv.y * invW[k]);
+    }
+    setup.invW = XMFLOAT3(invW[0], invW[1], invW[2]);
+    setup.depthOverW = XMFLOAT3(clip[0].z * invW[0], clip[1].z * invW[1], clip[2].z * invW[2]);
+
+    return true;
+}
+
+void SoftwareRasterizer::SetupTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, CullMode cullMode)
+{
+    const XMMATRIX worldViewProj = XMLoadFloat4x4(&m_worldViewProj);
+    const uint32_t triangleCount = TriangleCount(vertices, indices);
+
+    m_triangles.clear();
+    m_triangles.reserve(triangleCount);
+
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const Vertex* v[3];
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            v[k] = &vertices[TriangleVertexIndex(indices, t, k)];
+        }
+
+        TriangleSetup setup;
+        if (SetupTriangle(v, worldViewProj, cullMode, setup))
+        {
+            setup.index = t;
+            m_triangles.push_back(setup);
+        }
+    }
+}
+
+void SoftwareRasterizer::BinTriangles()
+{
+    // ^CƂ̎Op`𐔂A擪ʒu߂ĂOp`̏ɋl߂ (^C̕`揇ۂ)
+    const TileSize tileSize = c_TileSizes[m_tileSizeIndex];
+    m_tilesX = (m_width + tileSize.width - 1) / tileSize.width;
+    m_tilesY = (m_height + tileSize.height - 1) / tileSize.height;
+    const uint32_t tileCount = m_tilesX * m_tilesY;
+    m_tileTriangleOffsets.assign(tileCount + 1, 0);
+
+    // ^C̕тςNAtO͎gȂ (S^CB^C̐ł傫ႦΕт͈Ⴄ)
+    if (m_tileCleared.size() != tileCount || m_binnedTileSizeIndex != m_tileSizeIndex)
+    {
+        m_tileCleared.assign(tileCount, 0);
+    }
+    m_binnedTileSizeIndex = m_tileSizeIndex;
+
+    for (const TriangleSetup& triangle : m_triangles)
+    {
+        for (uint32_t ty = triangle.minY / tileSize.height; ty <= triangle.maxY / tileSize.height; ++ty)
+        {
+            for (uint32_t tx = triangle.minX / tileSize.width; tx <= triangle.maxX / tileSize.width; ++tx)
+            {
+                ++m_tileTriangleOffsets[ty * m_tilesX + tx + 1];
+            }
+        }
+    }
+    for (uint32_t tile = 0; tile < tileCount; ++tile)
+    {
+        m_tileTriangleOffsets[tile + 1] += m_tileTriangleOffsets[tile];
+    }
+
+    m_tileTriangles.resize(m_tileTriangleOffsets[tileCount]);
+    std::vector<uint32_t> cursors(m_tileTriangleOffsets.begin(), m_tileTriangleOffsets.end() - 1);
+    for (uint32_t t = 0; t < static_cast<uint32_t>(m_triangles.size()); ++t)
+    {
+        const TriangleSetup& triangle = m_triangles[t];
+        for (uint32_t ty = triangle.minY / tileSize.height; ty <= triangle.maxY / tileSize.height; ++ty)
+        {
+            for (uint32_t tx = triangle.minX / tileSize.width; tx <= triangle.maxX / tileSize.width; ++tx)
+            {
+                m_tileTriangles[cursors[ty * m_tilesX + tx]++] = t;
+            }
+        }
+    }
+}
+
+template <uint32_t Permutation>
+XMVECTOR XM_CALLCONV SoftwareRasterizer::ShadeTriangle(const TriangleSetup& triangle, float w0, float w1, float w2, float footprint,
+                                                   const TileLightList* tileLights) const
+{
+    constexpr RasterState c_State = GetRasterState(Permutation);
+    const XMFLOAT3& e0 = triangle.edges[0];
+    const XMFLOAT3& e1 = triangle.edges[1];
+    const XMFLOAT3& e2 = triangle.edges[2];
+    const XMFLOAT3 invW = triangle.invW;
+
+    const float currentW = 1.0f / (w0 * invW.x + w1 * invW.y + w2 * invW.z);
+    XMVECTOR result = g_XMOne;
+    if constexpr (c_State.vertexColor)
+    {
+        XMVECTOR c = XMVectorScale(XMLoadFloat4(&triangle.colorOverW[0]), w0);
+        c = XMVectorMultiplyAdd(XMLoadFloat4(&triangle.colorOverW[1]), XMVectorReplicate(w1), c);
+        c = XMVectorMultiplyAdd(XMLoadFloat4(&triangle.colorOverW[2]), XMVectorReplicate(w2), c);
+        result = XMVectorScale(c, currentW);
+    }
+
+    if constexpr (c_State.textured)
+    {
+        const XMFLOAT2* uvOverW = triangle.uvOverW;
+        const XMFLOAT2 uv((w0 * uvOverW[0].x + w1 * uvOverW[1].x + w2 * uvOverW[2].x) * currentW,
+                          (w0 * uvOverW[0].y + w1 * uvOverW[1].y + w2 * uvOverW[2].y) * currentW);
+
+        // GPU łƓ͓IȔ (dSW x, y ̓GbW֐̌Ŵ́Bfootprint sNZɍL)
+        const float invWDdx = e0.x * invW.x + e1.x * invW.y + e2.x * invW.z;
+        const float invWDdy = e0.y * invW.x + e1.y * invW.y + e2.y * invW.z;
+        const float ddScale = currentW * footprint;
+        const XMFLOAT2 uvDdx((e0.x * uvOverW[0].x + e1.x * uvOverW[1].x + e2.x * uvOverW[2].x - uv.x * invWDdx) * ddScale,
+                             (e0.x * uvOverW[0].y + e1.x * uvOverW[1].y + e2.x * uvOverW[2].y - uv.y * invWDdx) * ddScale);
+        const XMFLOAT2 uvDdy((e0.y * uvOverW[0].x + e1.y * uvOverW[1].x + e2.y * uvOverW[2].x - uv.x * invWDdy) * ddScale,
+                             (e0.y * uvOverW[0].y + e1.y * uvOverW[1].y + e2.y * uvOverW[2].y - uv.y * invWDdy) * ddScale);
+
+        const XMFLOAT4 texColor = m_texture->SampleGrad(uv, uvDdx, uvDdy);
+        result = XMVectorMultiply(result, XMLoadFloat4(&texColor));
+    }
+
+    if (tileLights != nullptr)
+    {
+        const XMVECTOR weights = XMVectorScale(XMVectorSet(w0 * invW.x, w1 * invW.y, w2 * invW.z, 0.0f), currentW);
+        XMVECTOR normal;
+        const XMVECTOR position = LoadSurface(triangle, weights, &normal);
+        result = ShadeTileLights(result, position, normal, *tileLights);
+    }
+
+    return result;
+}
+
+XMVECTOR XM_CALLCONV SoftwareRasterizer::LoadSurface(const TriangleSetup& triangle, FXMVECTOR weights, XMVECTOR* normal) const
+{
+    uint32_t vertexIndices[3];
+    XMVECTOR corners[3];
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        vertexIndices[k] = TriangleVertexIndex(*m_indices, triangle.index, k);
+        corners[k] = XMLoadFloat3(&(*m_vertices)[vertexIndices[k]].pos);
+    }
+    const XMVECTOR position = XMVectorAdd(XMVectorAdd(XMVectorScale(corners[0], XMVectorGetX(weights)), XMVectorScale(corners[1], XMVectorGetY(weights))),
+                                          XMVectorScale(corners[2], XMVectorGetZ(weights)));
+    if (normal == nullptr) return position;
+
+    if (m_vertexNormals != nullptr)
+    {
+        const std::vector<XMFLOAT3>& normals = *m_vertexNormals;
+        *normal = XMVectorAdd(XMVectorAdd(XMVectorScale(XMLoadFloat3(&normals[vertexIndices[0]]), XMVectorGetX(weights)),
+                                          XMVectorScale(XMLoadFloat3(&normals[vertexIndices[1]]), XMVectorGetY(weights))),
+                              XMVectorScale(XMLoadFloat3(&normals[vertexIndices[2]]), XMVectorGetZ(weights)));
+    }
+    else
+    {
+        // ʂ̖@̓J̑֌
+        *normal = XMVector3Cross(XMVectorSubtract(corners[1], corners[0]), XMVectorSubtract(corners[2], corners[0]));
+        const XMVECTOR origin = XMLoadFloat4(&m_viewOrigin);
+        const XMVECTOR toViewer = m_viewOrigin.w != 0.0f ? XMVectorSubtract(origin, position) : XMVectorNegate(origin);
+        if (XMVectorGetX(XMVector3Dot(*normal, toViewer)) < 0.0f)
+        {
+            *normal = XMVectorNegate(*normal);
+        }
+    }
+    return position;
+}
+
+void SoftwareRasterizer::CullTileLights(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, float depthMin, float depthMax, TileLightList& tileLights) const
+{
+    // ^C NDC ͈̔ (Y ͏)
+    const float ndcMinX = static_cast<float>(x0) / m_width * 2.0f - 1.0f;
+    const float ndcMaxX = static_cast<float>(x1 + 1) / m_width * 2.0f - 1.0f;
+    const float ndcMinY = 1.0f - static_cast<float>(y1 + 1) / m_height * 2.0f;
+    const float ndcMaxY = 1.0f - static_cast<float>(y0) / m_height * 2.0f;
+
+    // dot(clip, plane) >= 0 ɂȂNbvW̕ʂAWorld -> Clip ̍sŃ[hW̕ʂɂ
+    const float clipPlanes[6][4] = {
+        { 1.0f, 0.0f, 0.0f, -ndcMinX },
+        { -1.0f, 0.0f, 0.0f, ndcMaxX },
+        { 0.0f, 1.0f, 0.0f, -ndcMinY },
+        { 0.0f, -1.0f, 0.0f, ndcMaxY },
+        { 0.0f, 0.0f, 1.0f, -depthMin },
+        { 0.0f, 0.0f, -1.0f, depthMax },
+    };
+    const XMFLOAT4X4& m = m_lightViewProj;
+    XMFLOAT4 planes[6];
+    for (uint32_t k = 0; k < 6; ++k)
+    {
+        const float* c = clipPlanes[k];
+        const XMVECTOR plane = XMVectorSet(m._11 * c[0] + m._12 * c[1] + m._13 * c[2] + m._14 * c[3],
+                                           m._21 * c[0] + m._22 * c[1] + m._23 * c[2] + m._24 * c[3],
+                                           m._31 * c[0] + m._32 * c[1] + m._33 * c[2] + m._34 * c[3],
+                                           m._41 * c[0] + m._42 * c[1] + m._43 * c[2] + m._44 * c[3]);
+        XMStoreFloat4(&planes[k], XMVectorScale(plane, 1.0f / std::max(XMVectorGetX(XMVector3Length(plane)), 1e-20f)));
+    }
+
+    // SĂ̕ʂ̓ (a̗]T) ɂ郉CgW߂Bӂꂽ͐邾
+    tileLights.count = 0;
+    for (uint32_t l = 0; l < static_cast<uint32_t>(m_lights.size()); ++l)
+    {
+        const PointLight& light = m_lights[l];
+        bool inside = true;
+        for (uint32_t k = 0; k < 6 && inside; ++k)
+        {
+            inside = planes[k].x * light.position.x + planes[k].y * light.position.y + planes[k].z * light.position.z + planes[k].w >= -light.radius;
+        }
+        if (!inside) continue;
+
+        if (tileLights.count < c_MaxTileLights)
+        {
+            tileLights.lights[tileLights.count] = l;
+        }
+        ++tileLights.count;
+    }
+}
+
+XMVECTOR XM_CALLCONV SoftwareRasterizer::ShadeTileLights(FXMVECTOR albedo, FXMVECTOR position, FXMVECTOR normal, const TileLightList& tileLights) const
+{
+    // Cg̓[hWȂ̂ŁAʒuƖ@[hWֈڂ
+    const XMVECTOR worldPosition = XMVector3Transform(position, XMLoadFloat4x4(&m_world));
+    const XMVECTOR worldNormal = XMVector3Normalize(XMVector3TransformNormal(normal, XMLoadFloat4x4(&m_normalWorld)));
+
+    // Lambert ̊gU +  (GPU ł ShadeTileLights)
+    XMVECTOR irradiance = XMLoadFloat3(&m_ambientLight);
+    const uint32_t count = std::min(tileLights.count, c_MaxTileLights);
+    for (uint32_t k = 0; k < count; ++k)
+    {
+        const PointLight& light = m_lights[tileLights.lights[k]];
+        const XMVECTOR toLight = XMVectorSubtract(XMLoadFloat3(&light.position), worldPosition);
+        const float distanceSquared = XMVectorGetX(XMVector3Dot(toLight, toLight));
+        const float radiusSquared = light.radius * light.radius;
+        if (distanceSquared >= radiusSquared) continue;
+
+        const float nDotL = XMVectorGetX(XMVector3Dot(worldNormal, toLight)) / std::sqrt(std::max(distanceSquared, 1e-12f));
+        const float scale = light.intensity * std::min(std::max(nDotL, 0.0f), 1.0f) * LightFalloff(distanceSquared, radiusSquared);
+        irradiance = XMVectorMultiplyAdd(XMLoadFloat3(&light.color), XMVectorReplicate(scale), irradiance);
+    }
+    return XMVectorSetW(XMVectorMultiply(albedo, irradiance), XMVectorGetW(albedo));
+}
+
+template <uint32_t TileSizeIndex, uint32_t Permutation>
+void SoftwareRasterizer::RasterizeTile(uint32_t tileX, uint32_t tileY, TileStats& stats)
+{
+    constexpr uint32_t c_TileWidth = c_TileSizes[TileSizeIndex].width;
+    constexpr uint32_t c_TileHeight = c_TileSizes[TileSizeIndex].height;
+    constexpr RasterState c_State = GetRasterState(Permutation);
+    constexpr bool c_Blend = c_State.blendMode == BlendMode::Alpha;
+    constexpr bool c_WriteDepth = c_State.depthTest && !c_Blend;
+
+    // pX (GPU ł RASTER_PASS_*)B[xvpXł Depth Ő[x߂ĂAShade Ő[xv̂h
+    enum class Pass { Full, Depth, Shade };
+
+    const uint32_t x0 = tileX * c_TileWidth;
+    const uint32_t y0 = tileY * c_TileHeight;
+    const uint32_t x1 = std::min(x0 + c_TileWidth, m_width) - 1;
+    const uint32_t y1 = std::min(y0 + c_TileHeight, m_height) - 1;
+
+    // [x̔řƐx (GPU ł DEPTH_CLOSER / QuantizeDepth)
+    const bool reversedZ = m_depthBufferDesc.reversedZ;
+    const float depthUnormMax = static_cast<float>(GetDepthUnormMax(m_depthBufferDesc.format));
+    // ߑ]ł͎Op`̊ÕsNZSŐ[xO}̂ŁA_̐[x͈̔͂Ɏ߂
+    const bool clampDepth = m_conservativeMode == ConservativeMode::Overestimate;
+
+    // GPU ł bestDepth / bestColor (^C̃sNZ)
+    float depth[c_TileWidth * c_TileHeight];
+    XMVECTOR color[c_TileWidth * c_TileHeight];
+    bool shaded[c_TileWidth * c_TileHeight] = {};
+    // Ōɐ[xeXgʂ (łO) Op` (m_triangles ̔ԍ)Bσ[gVF[fBO G-buffer Ŏg
+    constexpr uint32_t c_NoTriangle = c_GBufferNoTriangle;
+    const bool trackVisible = c_WriteDepth && m_gbufferWriting;
+    uint32_t visible[c_TileWidth * c_TileHeight];
+    std::fill(std::begin(visible), std::end(visible), c_NoTriangle);
+    std::fill(std::begin(depth), std::end(depth), reversedZ ? 0.0f : 1.0f);
+    std::fill(std::begin(color), std::end(color), XMLoadFloat4(&m_clearColor));
+
+    // Op`ȂAONAꂽ܂܂̃^C͉Ȃ
+    const uint32_t tile = tileY * m_tilesX + tileX;
+    if (m_fastClear && m_tileCleared[tile] && m_tileTriangleOffsets[tile] == m_tileTriangleOffsets[tile + 1])
+    {
+        return;
+    }
+
+    // VU[`͂ݏo^ĆA`̒̃sNZhď
+    const bool partial = GetScissorCoverage(x0, y0, x1, y1) == ScissorCoverage::Partial;
+    bool inside[c_TileWidth * c_TileHeight];
+    if (partial)
+    {
+        for (uint32_t y = y0; y <= y1; ++y)
+        {
+            for (uint32_t x = x0; x <= x1; ++x)
+            {
+                inside[(y - y0) * c_TileWidth + (x - x0)] = IsInsideScissor(x, y);
+            }
+        }
+    }
+
+    // [x̃pX̌ɏW߂^C̃Cg (CeBOȂȂ nullptr)
+    TileLightList tileLightList;
+    const TileLightList* tileLights = nullptr;
+
+    // ^C̎Op`ɕ] (passType  Pass  std::integral_constant)
+    uint32_t depthPassFragments = 0;
+    uint32_t shadedFragments = 0;
+    auto rasterizePass = [&](auto passType)
+    {
+        constexpr Pass c_Pass = decltype(passType)::value;
+
+        for (uint32_t n = m_tileTriangleOffsets[tile]; n < m_tileTriangleOffsets[tile + 1]; ++n)
+        {
+            const TriangleSetup& triangle = m_triangles[m_tileTriangles[n]];
+            const uint32_t minX = std::max(triangle.minX, x0);
+            const uint32_t maxX = std::min(triangle.maxX, x1);
+            const uint32_t minY = std::max(triangle.minY, y0);
+            const uint32_t maxY = std::min(triangle.maxY, y1);
+            if (minX > maxX || minY > maxY) continue;
+
+            const XMFLOAT3 e0 = triangle.edges[0];
+            const XMFLOAT3 e1 = triangle.edges[1];
+            const XMFLOAT3 e2 = triangle.edges[2];
+            const XMFLOAT3 bias = triangle.coverageBias;
+
+            for (uint32_t y = minY; y <= maxY; ++y)
+            {
+                const float py = static_cast<float>(y) + 0.5f;
+                for (uint32_t x = minX; x <= maxX; ++x)
+                {
+                    const float px = static_cast<float>(x) + 0.5f;
+
+                    // ʐςŊdSW (Op`̓ȂS 0 ȏBێIX^CYł bias 炵Ĕ肷)
+                    const float w0 = e0.x * px + e0.y * py + e0.z;
+                    const float w1 = e1.x * px + e1.y * py + e1.z;
+                    const float w2 = e2.x * px + e2.y * py + e2.z;
+                    if (w0 + bias.x < 0.0f || w1 + bias.y < 0.0f || w2 + bias.z < 0.0f) continue;
+
+                    const uint32_t pixel = (y - y0) * c_TileWidth + (x - x0);
+                    if (partial && !inside[pixel]) continue;
+
+                    if constexpr (c_State.depthTest)
+                    {
+                        // NDC  Z ͉ʏŐ` (GPU łƓ W |Ȃ)
+                        const XMFLOAT3& z = triangle.depthOverW;
+                        float currentDepth = w0 * z.x + w1 * z.y + w2 * z.z;
+                        if (clampDepth)
+                        {
+                            currentDepth = std::min(std::max(currentDepth, std::min({ z.x, z.y, z.z })), std::max({ z.x, z.y, z.z }));
+                        }
+                        if (depthUnormMax > 0.0f)
+                        {
+                            currentDepth = std::round(std::min(std::max(currentDepth, 0.0f), 1.0f) * depthUnormMax) / depthUnormMax;
+                        }
+
+                        if constexpr (c_Pass == Pass::Shade)
+                        {
+                            // łO̐[xƈvŏ̎Op`h (1pXōŌɐ[xeXgʂOp`Ɠ)
+                            if (currentDepth != depth[pixel] || shaded[pixel]) continue;
+                        }
+                        else
+                        {
+                            if (reversedZ ? !(currentDepth > depth[pixel]) : !(currentDepth < depth[pixel])) continue;
+                            ++depthPassFragments;
+                            if constexpr (c_WriteDepth)
+                            {
+                                depth[pixel] = currentDepth;
+                            }
+                            if constexpr (c_Pass == Pass::Depth)
+                            {
+                                visible[pixel] = m_tileTriangles[n];
+                                continue;
+                            }
+                            else if (trackVisible)
+                            {
+                                visible[pixel] = m_tileTriangles[n];
+                            }
+                        }
+                    }
+
+                    const XMVECTOR result = ShadeTriangle<Permutation>(triangle, w0, w1, w2, 1.0f, tileLights);
+                    if constexpr (c_Blend)
+                    {
+                        color[pixel] = BlendColor(color[pixel], result);
+                    }
+                    else
+                    {
+                        color[pixel] = result;
+                    }
+                    shaded[pixel] = true;
+                    ++shadedFragments;
+                }
+            }
+        }
+    };
+
+    // GPU ł ShadeVariableRate (ubNsDŌāAOp`Ăŏ̃sNZubN̒SœhAc͂̐Fg)
+    // ubN̑傫̓^C̕ӂ̖񐔂Ȃ̂ŁAubN̓^C܂Ȃ
+    uint32_t sharedShades = 0;
+    auto shadeVariableRate = [&]()
+    {
+        const uint32_t rateTileCountX = (m_width + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize;
+        for (uint32_t y = y0; y <= y1; ++y)
+        {
+            for (uint32_t x = x0; x <= x1; ++x)
+            {
+                const uint32_t pixel = (y - y0) * c_TileWidth + (x - x0);
+                const uint32_t t = visible[pixel];
+                if (t == c_NoTriangle) continue;
+
+                const uint32_t blockSize = GetShadingRateBlockSize(m_shadingRates[(y / c_ShadingRateTileSize) * rateTileCountX + x / c_ShadingRateTileSize]);
+                const uint32_t blockX = x & ~(blockSize - 1);
+                const uint32_t blockY = y & ~(blockSize - 1);
+
+                uint32_t owner = pixel;
+                bool found = false;
+                for (uint32_t by = 0; by < blockSize && !found; ++by)
+                {
+                    for (uint32_t bx = 0; bx < blockSize && !found; ++bx)
+                    {
+                        const uint32_t index = (blockY - y0 + by) * c_TileWidth + (blockX - x0 + bx);
+                        if (visible[index] == t)
+                        {
+                            owner = index;
+                            found = true;
+                        }
+                    }
+                }
+
+                shaded[pixel] = true;
+                if (owner != pixel)
+                {
+                    // sDŐɏsNZȂ̂ŁAF͌܂Ă
+                    color[pixel] = color[owner];
+                    ++sharedShades;
+                    continue;
+                }
+
+                const TriangleSetup& triangle = m_triangles[t];
+                const float cx = static_cast<float>(blockX) + blockSize * 0.5f;
+                const float cy = static_cast<float>(blockY) + blockSize * 0.5f;
+                const float w0 = triangle.edges[0].x * cx + triangle.edges[0].y * cy + triangle.edges[0].z;
+                const float w1 = triangle.edges[1].x * cx + triangle.edges[1].y * cy + triangle.edges[1].z;
+                const float w2 = triangle.edges[2].x * cx + triangle.edges[2].y * cy + triangle.edges[2].z;
+                color[pixel] = ShadeTriangle<Permutation>(triangle, w0, w1, w2, static_cast<float>(blockSize), tileLights);
+                ++shadedFragments;
+            }
+        }
+    };
+
+    // GPU ł CullTileLights (Op`ĂsNZ̐[x͈̔͂Ń^C̎A͂CgW߂)
+    auto cullTileLights = [&]()
+    {
+        float depthMin = FLT_MAX;
+        float depthMax = -FLT_MAX;
+        for (uint32_t y = y0; y <= y1; ++y)
+        {
+            for (uint32_t x = x0; x <= x1; ++x)
+            {
+                const uint32_t pixel = (y - y0) * c_TileWidth + (x - x0);
+                if (visible[pixel] == c_NoTriangle) continue;
+                depthMin = std::min(depthMin, depth[pixel]);
+                depthMax = std::max(depthMax, depth[pixel]);
+            }
+        }
+
+        tileLightList.count = 0;
+        if (depthMin <= depthMax)
+        {
+            CullTileLights(x0, y0, x1, y1, depthMin, depthMax, tileLightList);
+        }
+        stats.tileLights += std::min(tileLightList.count, c_MaxTileLights);
+        stats.overflowedLightTiles += tileLightList.count > c_MaxTileLights ? 1 : 0;
+        tileLights = &tileLightList;
+    };
+
+    // [xvpXƉσ[gVF[fBO͐[xgݍ킹 (sŐ[xeXg) 
+    // CeBO͐[x̃pX̐[xŃCgW߂̂ŁAǂ炩ƈꏏɎg
+    if constexpr (c_WriteDepth)
+    {
+        if (m_variableRateActive)
+        {
+            rasterizePass(std::integral_constant<Pass, Pass::Depth>());
+            if (m_lightingActive) cullTileLights();
+            shadeVariableRate();
+        }
+        else if (m_depthPrepassActive)
+        {
+            rasterizePass(std::integral_constant<Pass, Pass::Depth>());
+            if (m_lightingActive) cullTileLights();
+            rasterizePass(std::integral_constant<Pass, Pass::Shade>());
+        }
+        else
+        {
+            rasterizePass(std::integral_constant<Pass, Pass::Full>());
+        }
+    }
+    else
+    {
+        rasterizePass(std::integral_constant<Pass, Pass::Full>());
+    }
+
+    const uint32_t coveredPixels = static_cast<uint32_t>(std::count(std::begin(shaded), std::end(shaded), true));
+    stats.coveredPixels += coveredPixels;
+    stats.depthPassFragments += depthPassFragments;
+    stats.shadedFragments += shadedFragments;
+    stats.sharedShadedPixels += sharedShades;
+
+    // Oڋ`|1sNZ`ȂꍇANAꂽ܂܂Ȃ珑Ȃ
+    // VU[`͂ݏo^C͋`̊OȂ̂ŁAONAĂƂtOc
+    const bool covered = coveredPixels > 0;
+    const bool wasCleared = m_tileCleared[tile] != 0;
+    m_tileCleared[tile] = !covered && (wasCleared || !partial) ? 1 : 0;
+    if (m_fastClear && !covered && wasCleared)
+    {
+        return;
+    }
+
+    const DepthFormat depthFormat = m_depthBufferDesc.format;
+    const uint32_t depthBytes = GetDepthBytesPerPixel(depthFormat);
+    if (partial)
+    {
+        for (uint32_t y = y0; y <= y1; ++y)
+        {
+            for (uint32_t x = x0; x <= x1; ++x)
+            {
+                const uint32_t pixel = (y - y0) * c_TileWidth + (x - x0);
+                if (!inside[pixel]) continue;
+
+                const size_t index = static_cast<size_t>(y) * m_width + x;
+                m_color[index] = PackColor(color[pixel]);
+                StoreDepthRow(&m_depthStorage[index * depthBytes], &depth[pixel], 1, depthFormat);
+                if (trackVisible)
+                {
+                    WriteGBuffer(x, y, visible[pixel], color[pixel]);
+                }
+                ++stats.writtenPixels;
+            }
+        }
+        return;
+    }
+
+    stats.writtenPixels += static_cast<size_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+    for (uint32_t y = y0; y <= y1; ++y)
+    {
+        const uint32_t row = (y - y0) * c_TileWidth;
+        for (uint32_t x = x0; x <= x1; ++x)
+        {
+            m_color[static_cast<size_t>(y) * m_width + x] = PackColor(color[row + (x - x0)]);
+        }
+        StoreDepthRow(&m_depthStorage[(static_cast<size_t>(y) * m_width + x0) * depthBytes], &depth[row], x1 - x0 + 1, depthFormat);
+        if (trackVisible)
+        {
+            for (uint32_t x = x0; x <= x1; ++x)
+            {
+                WriteGBuffer(x, y, visible[row + (x - x0)], color[row + (x - x0)]);
+            }
+        }
+    }
+}
+
+template <uint32_t Permutation>
+void SoftwareRasterizer::RasterizeTileCoverage(uint32_t tileX, uint32_t tileY, TileStats& stats)
+{
+    constexpr RasterState c_State = GetRasterState(Permutation);
+    constexpr bool c_Blend = c_State.blendMode == BlendMode::Alpha;
+    constexpr bool c_WriteDepth = c_State.depthTest && !c_Blend;
+
+    const TileSize tileSize = c_TileSizes[m_tileSizeIndex];
+    const uint32_t x0 = tileX * tileSize.width;
+    const uint32_t y0 = tileY * tileSize.height;
+    const uint32_t x1 = std::min(x0 + tileSize.width, m_width) - 1;
+    const uint32_t y1 = std::min(y0 + tileSize.height, m_height) - 1;
+
+    const bool reversedZ = m_depthBufferDesc.reversedZ;
+    const float depthUnormMax = static_cast<float>(GetDepthUnormMax(m_depthBufferDesc.format));
+    // ێIX^CYł GPU łƓAsNZ̔ʂΑSTv𕢂
+    const bool conservative = m_conservativeMode != ConservativeMode::Off;
+    const bool clampDepth = m_conservativeMode == ConservativeMode::Overestimate;
+
+    // Tvʒu (sNZŜ)
+    const uint32_t sampleCount = GetAntiAliasSampleCount(m_antiAliasMode);
+    const int8_t (*positions)[2] = sampleCount == 8 ? c_SamplePositions8x : c_SamplePositions4x;
+    float sampleX[c_MaxCoverageSamples];
+    float sampleY[c_MaxCoverageSamples];
+    for (uint32_t s = 0; s < sampleCount; ++s)
+    {
+        sampleX[s] = positions[s][0] / 16.0f;
+        sampleY[s] = positions[s][1] / 16.0f;
+    }
+    const uint32_t allSamples = (1u << sampleCount) - 1;
+
+    // STvNAJ[1̃tOgɂ (GPU ł BeginCoverageSamples)
+    m_coverageTile.resize(static_cast<size_t>(tileSize.width) * tileSize.height);
+    for (CoveragePixel& pixel : m_coverageTile)
+    {
+        std::fill(std::begin(pixel.depth), std::end(pixel.depth), reversedZ ? 0.0f : 1.0f);
+        pixel.color[0] = m_clearColor;
+        pixel.mask[0] = allSamples;
+        pixel.fragmentCount = 1;
+        pixel.covered = false;
+    }
+
+    // mask ̃Tv color h (GPU ł AddFragmentBtOg̓Tv𕪂̂ŃTv𒴂Ȃ)
+    auto addFragment = [](CoveragePixel& pixel, FXMVECTOR color, uint32_t mask)
+    {
+        const uint32_t count = pixel.fragmentCount;
+        if constexpr (c_Blend)
+        {
+            // dȂtOgƂɍ (ꕔ̃TvdȂtOg2ɕ)
+            for (uint32_t f = 0; f < count; ++f)
+            {
+                const uint32_t overlap = pixel.mask[f] & mask;
+                if (overlap == 0) continue;
+
+                const XMVECTOR blended = BlendColor(XMLoadFloat4(&pixel.color[f]), color);
+                if (overlap == pixel.mask[f])
+                {
+                    XMStoreFloat4(&pixel.color[f], blended);
+                }
+                else
+                {
+                    pixel.mask[f] &= ~overlap;
+                    XMStoreFloat4(&pixel.color[pixel.fragmentCount], blended);
+                    pixel.mask[pixel.fragmentCount] = overlap;
+                    ++pixel.fragmentCount;
+                }
+            }
+        }
+        else
+        {
+            // ㏑Tv𑼂̃tOgOAȂȂtOgl߂
+            uint32_t kept = 0;
+            for (uint32_t f = 0; f < count; ++f)
+            {
+                const uint32_t remaining = pixel.mask[f] & ~mask;
+                if (remaining == 0) continue;
+
+                pixel.color[kept] = pixel.color[f];
+                pixel.mask[kept] = remaining;
+                ++kept;
+            }
+            XMStoreFloat4(&pixel.color[kept], color);
+            pixel.mask[kept] = mask;
+            pixel.fragmentCount = kept + 1;
+        }
+    };
+
+    // VU[`͂ݏo^ĆA`̒̃sNZhď
+    const bool partial = GetScissorCoverage(x0, y0, x1, y1) == ScissorCoverage::Partial;
+
+    const uint32_t tile = tileY * m_tilesX + tileX;
+    uint32_t fragments = 0;
+    for (uint32_t n = m_tileTriangleOffsets[tile]; n < m_tileTriangleOffsets[tile + 1]; ++n)
+    {
+        const TriangleSetup& triangle = m_triangles[m_tileTriangles[n]];
+        const uint32_t minX = std::max(triangle.minX, x0);
+        const uint32_t maxX = std::min(triangle.maxX, x1);
+        const uint32_t minY = std::max(triangle.minY, y0);
+        const uint32_t maxY = std::min(triangle.maxY, y1);
+        if (minX > maxX || minY > maxY) continue;
+
+        const XMFLOAT3 e0 = triangle.edges[0];
+        const XMFLOAT3 e1 = triangle.edges[1];
+        const XMFLOAT3 e2 = triangle.edges[2];
+        const XMFLOAT3 bias = triangle.coverageBias;
+        const XMFLOAT3 z = triangle.depthOverW;
+        const float minZ = std::min({ z.x, z.y, z.z });
+        const float maxZ = std::max({ z.x, z.y, z.z });
+
+        for (uint32_t y = minY; y <= maxY; ++y)
+        {
+            const float py = static_cast<float>(y) + 0.5f;
+            for (uint32_t x = minX; x <= maxX; ++x)
+            {
+                const float px = static_cast<float>(x) + 0.5f;
+                const float w0 = e0.x * px + e0.y * py + e0.z;
+                const float w1 = e1.x * px + e1.y * py + e1.z;
+                const float w2 = e2.x * px + e2.y * py + e2.z;
+                if (conservative && (w0 + bias.x < 0.0f || w1 + bias.y < 0.0f || w2 + bias.z < 0.0f)) continue;
+                if (partial && !IsInsideScissor(x, y)) continue;
+
+                CoveragePixel& pixel = m_coverageTile[(y - y0) * tileSize.width + (x - x0)];
+
+                // TvƂɃGbWƐ[x𔻒肵ă}XNɂ
+                uint32_t mask = 0;
+                float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f;
+                for (uint32_t s = 0; s < sampleCount; ++s)
+                {
+                    const float sw0 = w0 + e0.x * sampleX[s] + e0.y * sampleY[s];
+                    const float sw1 = w1 + e1.x * sampleX[s] + e1.y * sampleY[s];
+                    const float sw2 = w2 + e2.x * sampleX[s] + e2.y * sampleY[s];
+                    if (!conservative && (sw0 < 0.0f || sw1 < 0.0f || sw2 < 0.0f)) continue;
+
+                    if constexpr (c_State.depthTest)
+                    {
+                        float sampleDepth = sw0 * z.x + sw1 * z.y + sw2 * z.z;
+                        if (clampDepth)
+                        {
+                            sampleDepth = std::min(std::max(sampleDepth, minZ), maxZ);
+                        }
+                        if (depthUnormMax > 0.0f)
+                        {
+                            sampleDepth = std::round(std::min(std::max(sampleDepth, 0.0f), 1.0f) * depthUnormMax) / depthUnormMax;
+                        }
+                        if (reversedZ ? !(sampleDepth > pixel.depth[s]) : !(sampleDepth < pixel.depth[s])) continue;
+                        if constexpr (c_WriteDepth)
+                        {
+                            pixel.depth[s] = sampleDepth;
+                        }
+                    }
+
+                    mask |= 1u << s;
+                    sum0 += sw0;
+                    sum1 += sw1;
+                    sum2 += sw2;
+                }
+                if (mask == 0) continue;
+
+                // Tv̏dS1񂾂h (GPU ł̃ZgCh)
+                const float invCount = 1.0f / static_cast<float>(CountBits(mask));
+                addFragment(pixel, ShadeTriangle<Permutation>(triangle, sum0 * invCount, sum1 * invCount, sum2 * invCount), mask);
+                pixel.covered = true;
+                ++fragments;
+            }
+        }
+    }
+
+    // kTvƁAłÕTv̐[x (t@XgNA͎g킸SsNZ)
+    const uint32_t fragmentCapacity = static_cast<uint32_t>(m_coverageFragments.size() / 2);
+    const DepthFormat depthFormat = m_depthBufferDesc.format;
+    const uint32_t depthBytes = GetDepthBytesPerPixel(depthFormat);
+    uint32_t coveredPixels = 0;
+    size_t writtenPixels = 0;
+    float depthRow[c_TileSizes[c_TileSizeCount - 1].width];
+    for (uint32_t y = y0; y <= y1; ++y)
+    {
+        for (uint32_t x = x0; x <= x1; ++x)
+        {
+            // VU[`̊ÕsNZ͏Ȃ ([x1sNZ)
+            if (partial && !IsInsideScissor(x, y)) continue;
+            ++writtenPixels;
+
+            const CoveragePixel& pixel = m_coverageTile[(y - y0) * tileSize.width + (x - x0)];
+            coveredPixels += pixel.covered ? 1 : 0;
+
+            float closest = pixel.depth[0];
+            for (uint32_t s = 1; s < sampleCount; ++s)
+            {
+                closest = (reversedZ ? pixel.depth[s] > closest : pixel.depth[s] < closest) ? pixel.depth[s] : closest;
+            }
+            depthRow[x - x0] = closest;
+            if (partial)
+            {
+                StoreDepthRow(&m_depthStorage[(static_cast<size_t>(y) * m_width + x) * depthBytes], &closest, 1, depthFormat);
+            }
+
+            // GPU ł StoreCoverageSamples (c̃tOgӂꂽς݂̐FSTṽtOgɂ)
+            uint32_t* header = &m_coveragePixels[(static_cast<size_t>(y) * m_width + x) * 2];
+            const uint32_t extraCount = pixel.fragmentCount - 1;
+            const uint32_t extraOffset = m_coverageFragmentCount;
+            m_coverageFragmentCount += extraCount;
+            if (extraCount > 0 && extraOffset + extraCount > fragmentCapacity)
+            {
+                XMVECTOR resolved = XMVectorZero();
+                for (uint32_t f = 0; f < pixel.fragmentCount; ++f)
+                {
+                    resolved = XMVectorMultiplyAdd(XMLoadFloat4(&pixel.color[f]), XMVectorReplicate(static_cast<float>(CountBits(pixel.mask[f]))), resolved);
+                }
+                header[0] = PackColor(XMVectorScale(resolved, 1.0f / sampleCount));
+                header[1] = allSamples;
+                continue;
+            }
+
+            header[0] = PackColor(XMLoadFloat4(&pixel.color[0]));
+            header[1] = pixel.mask[0] | (extraCount << c_CoverageCountShift) | (extraOffset << c_CoverageOffsetShift);
+            for (uint32_t e = 0; e < extraCount; ++e)
+            {
+                m_coverageFragments[(static_cast<size_t>(extraOffset) + e) * 2] = PackColor(XMLoadFloat4(&pixel.color[e + 1]));
+                m_coverageFragments[(static_cast<size_t>(extraOffset) + e) * 2 + 1] = pixel.mask[e + 1];
+            }
+        }
+        if (!partial)
+        {
+            StoreDepthRow(&m_depthStorage[(static_cast<size_t>(y) * m_width + x0) * depthBytes], depthRow, x1 - x0 + 1, depthFormat);
+        }
+    }
+
+    stats.coveredPixels += coveredPixels;
+    stats.depthPassFragments += fragments;
+    stats.shadedFragments += fragments;
+    m_tileCleared[tile] = coveredPixels == 0 && (m_tileCleared[tile] != 0 || !partial) ? 1 : 0;
+    stats.writtenPixels += writtenPixels;
+}
+
+void SoftwareRasterizer::ResolveCoverage()
+{
+    // tOg̐F}XÑTvŏdݕtĕς (Tv̓}XN̍v)
+    const size_t pixelCount = static_cast<size_t>(m_width) * m_height;
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+    {
+        // VU[`̊O͓hĂȂ̂ŉȂ
+        if (m_scissorActive && !IsInsideScissor(static_cast<uint32_t>(pixel % m_width), static_cast<uint32_t>(pixel / m_width))) continue;
+
+        const uint32_t* header = &m_coveragePixels[pixel * 2];
+        uint32_t sampleCount = CountBits(header[1] & c_CoverageMaskBits);
+        XMVECTOR color = XMVectorScale(UnpackColor(header[0]), static_cast<float>(sampleCount));
+
+        const uint32_t extraCount = (header[1] >> c_CoverageCountShift) & 0x7;
+        const uint32_t extraOffset = header[1] >> c_CoverageOffsetShift;
+        for (uint32_t e = 0; e < extraCount; ++e)
+        {
+            const uint32_t* fragment = &m_coverageFragments[(static_cast<size_t>(extraOffset) + e) * 2];
+            const uint32_t fragmentSamples = CountBits(fragment[1]);
+            color = XMVectorMultiplyAdd(UnpackColor(fragment[0]), XMVectorReplicate(static_cast<float>(fragmentSamples)), color);
+            sampleCount += fragmentSamples;
+        }
+
+        m_color[pixel] = PackColor(XMVectorScale(color, 1.0f / std::max(sampleCount, 1u)));
+    }
+}
+
+void XM_CALLCONV SoftwareRasterizer::WriteGBuffer(uint32_t x, uint32_t y, uint32_t triangle, FXMVECTOR albedo)
+{
+    const size_t index = static_cast<size_t>(y) * m_width + x;
+    const GBufferFormat albedoFormat = m_gbufferDesc.formats[static_cast<uint32_t>(GBufferTarget::Albedo)];
+    const GBufferFormat normalFormat = m_gbufferDesc.formats[static_cast<uint32_t>(GBufferTarget::Normal)];
+    const GBufferFormat idFormat = m_gbufferDesc.formats[static_cast<uint32_t>(GBufferTarget::Id)];
+    const GBufferFormat motionFormat = m_gbufferDesc.formats[static_cast<uint32_t>(GBufferTarget::Motion)];
+    uint8_t* albedoTexel = m_gbuffer[static_cast<uint32_t>(GBufferTarget::Albedo)].data() + index * GetGBufferBytesPerPixel(albedoFormat);
+    uint8_t* normalTexel = m_gbuffer[static_cast<uint32_t>(GBufferTarget::Normal)].data() + index * GetGBufferBytesPerPixel(normalFormat);
+    uint8_t* idTexel = m_gbuffer[static_cast<uint32_t>(GBufferTarget::Id)].data() + index * GetGBufferBytesPerPixel(idFormat);
+    uint8_t* motionTexel = m_gbuffer[static_cast<uint32_t>(GBufferTarget::Motion)].data() + index * GetGBufferBytesPerPixel(motionFormat);
+
+    if (albedoFormat == GBufferFormat::Full)
+    {
+        XMFLOAT4 value;
+        XMStoreFloat4(&value, albedo);
+        StoreHalfTexel(albedoTexel, &value.x, 4);
+    }
+    else if (albedoFormat == GBufferFormat::Packed)
+    {
+        const uint32_t value = PackColor(albedo);
+        memcpy(albedoTexel, &value, sizeof(value));
+    }
+
+    if (triangle == c_GBufferNoTriangle)
+    {
+        // wi͖@Ɠ 0AID ͎Op`Ȃ
+        const uint32_t noTriangle[2] = { c_GBufferNoTriangle, c_GBufferNoTriangle };
+        if (normalFormat != GBufferFormat::Off) memset(normalTexel, 0, GetGBufferBytesPerPixel(normalFormat));
+        if (idFormat != GBufferFormat::Off) memcpy(idTexel, noTriangle, GetGBufferBytesPerPixel(idFormat));
+        if (motionFormat != GBufferFormat::Off) memset(motionTexel, 0, GetGBufferBytesPerPixel(motionFormat));
+        return;
+    }
+
+    // CPU ł̓}eAȂ̂ŁA}eA ID  0 (GPU ł MaterialCount = 0 Ɠ)
+    const TriangleSetup& setup = m_triangles[triangle];
+    if (idFormat == GBufferFormat::Full)
+    {
+        const uint32_t value[2] = { setup.index, 0 };
+        memcpy(idTexel, value, sizeof(value));
+    }
+    else if (idFormat == GBufferFormat::Packed)
+    {
+        const uint32_t value = setup.index & c_GBufferPackedTriangleMask;
+        memcpy(idTexel, &value, sizeof(value));
+    }
+    if (normalFormat == GBufferFormat::Off && motionFormat == GBufferFormat::Off) return;
+
+    // sNZS̃p[XyNeBu␳dSWŃ[JẄʒu߂
+    const float px = static_cast<float>(x) + 0.5f;
+    const float py = static_cast<float>(y) + 0.5f;
+    const float w0 = (setup.edges[0].x * px + setup.edges[0].y * py + setup.edges[0].z) * setup.invW.x;
+    const float w1 = (setup.edges[1].x * px + setup.edges[1].y * py + setup.edges[1].z) * setup.invW.y;
+    const float w2 = (setup.edges[2].x * px + setup.edges[2].y * py + setup.edges[2].z) * setup.invW.z;
+    const float invSum = 1.0f / (w0 + w1 + w2);
+    const XMVECTOR weights = XMVectorScale(XMVectorSet(w0, w1, w2, 0.0f), invSum);
+    XMVECTOR normal = XMVectorZero();
+    const XMVECTOR position = LoadSurface(setup, weights, normalFormat != GBufferFormat::Off ? &normal : nullptr);
+
+    if (normalFormat != GBufferFormat::Off)
+    {
+        XMFLOAT3 worldNormal;
+        XMStoreFloat3(&worldNormal, XMVector3Normalize(XMVector3TransformNormal(normal, XMLoadFloat4x4(&m_normalWorld))));
+
+        if (normalFormat == GBufferFormat::Full)
+        {
+            const float value[4] = { worldNormal.x, worldNormal.y, worldNormal.z, 0.0f };
+            StoreHalfTexel(normalTexel, value, 4);
+        }
+        else
+        {
+            // R16G16_UNORM ̔ʑ
+            const XMFLOAT2 encoded = EncodeNormalOctahedral(worldNormal);
+            const uint16_t value[2] = {
+                static_cast<uint16_t>((encoded.x * 0.5f + 0.5f) * 65535.0f + 0.5f),
+                static_cast<uint16_t>((encoded.y * 0.5f + 0.5f) * 65535.0f + 0.5f),
+            };
+            memcpy(normalTexel, value, sizeof(value));
+        }
+    }
+
+    if (motionFormat != GBufferFormat::Off)
+    {
+        // ʒuÕt[̍sŉʂ֎ʂÃsNZSƂ̍𓮂xNgɂ
+        const XMMATRIX previous = XMLoadFloat4x4(m_previousTransformValid ? &m_previousWorldViewProj : &m_worldViewProj);
+        XMFLOAT4 clip;
+        XMStoreFloat4(&clip, XMVector4Transform(XMVectorSetW(position, 1.0f), previous));
+        const float motion[2] = {
+            (clip.x / clip.w + 1.0f) * 0.5f * m_width - px,
+            (1.0f - clip.y / clip.w) * 0.5f * m_height - py,
+        };
+        if (motionFormat == GBufferFormat::Full)
+        {
+            memcpy(motionTexel, motion, sizeof(motion));
+        }
+        else
+        {
+            StoreHalfTexel(motionTexel, motion, 2);
+        }
+    }
+}
+
+void SoftwareRasterizer::SetScissorRects(const ScissorRect* rects, uint32_t count)
+{
+    if (count > c_MaxScissorRects)
+    {
+        DebugOutput("Failed to set scissor rects: too many rects\n");
+        throw std::runtime_error("Failed to set scissor rects: too many rects");
+    }
+    std::copy(rects, rects + count, m_scissorRects);
+    m_scissorRectCount = count;
+}
+
+SoftwareRasterizer::ScissorCoverage SoftwareRasterizer::GetScissorCoverage(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) const
+{
+    if (!m_scissorActive)
+    {
+        return ScissorCoverage::Inside;
+    }
+
+    // ^C͉ʓȂ̂ŁAʂ͂ݏo`؂l߂ɔׂ
+    bool overlaps = false;
+    for (uint32_t r = 0; r < m_scissorRectCount; ++r)
+    {
+        if (ScissorRectContains(m_scissorRects[r], x0, y0, x1 + 1, y1 + 1))
+        {
+            return ScissorCoverage::Inside;
+        }
+        overlaps = overlaps || ScissorRectOverlaps(m_scissorRects[r], x0, y0, x1 + 1, y1 + 1);
+    }
+    return overlaps ? ScissorCoverage::Partial : ScissorCoverage::Outside;
+}
+
+bool SoftwareRasterizer::IsInsideScissor(uint32_t x, uint32_t y) const
+{
+    if (!m_scissorActive)
+    {
+        return true;
+    }
+
+    for (uint32_t r = 0; r < m_scissorRectCount; ++r)
+    {
+        if (ScissorRectContains(m_scissorRects[r], x, y, x + 1, y + 1))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SoftwareRasterizer::Render(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    // eNX`ȂΔ|̂ƓȂ̂ŁAeNX`ǂ܂Ȃgݍ킹ŕ`
+    RasterState state = m_rasterState;
+    if (m_texture == nullptr)
+    {
+        state.textured = false;
+    }
+
+    SetupTriangles(vertices, indices, state.cullMode);
+    BinTriangles();
+
+    // G-buffer ͕sŐ[xeXĝƂ (A`GCAXł͏Ȃ)
+    const bool gbuffer = m_antiAliasMode == AntiAliasMode::Off && IsGBufferEnabled(m_gbufferDesc) && CanWriteGBuffer(state);
+    if (gbuffer != m_gbufferActive)
+    {
+        // G-buffer Ȃ Render ŃNAꂽ^ĆAG-buffer Â܂܂Ȃ̂ŏ
+        std::fill(m_tileCleared.begin(), m_tileCleared.end(), static_cast<uint8_t>(0));
+        m_gbufferActive = gbuffer;
+    }
+    // ^C̃CeBO͕sŐ[xeXĝƂ (A`GCAX G-buffer ł͎gȂB[x̃pXŐ[x͈̔͂߂)
+    m_lightingActive = m_antiAliasMode == AntiAliasMode::Off && !gbuffer && !m_lights.empty() && CanUseTiledLighting(state);
+    if (m_lightingActive)
+    {
+        // Cg̓[hWȂ̂ŁAWorld -> Clip ̍sŃ^C̎[hW֖߂
+        XMStoreFloat4x4(&m_lightViewProj, XMMatrixMultiply(XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_world)), XMLoadFloat4x4(&m_worldViewProj)));
+    }
+    if (gbuffer || m_lightingActive)
+    {
+        // [JW̃Jʒu Clip  (0, 0, 1, 0) ߂_ (w = 0 Ȃ畽se̐[x)
+        XMFLOAT4 origin;
+        XMStoreFloat4(&origin, XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_worldViewProj)).r[2]);
+        if (std::abs(origin.w) > 1e-6f)
+        {
+            m_viewOrigin = XMFLOAT4(origin.x / origin.w, origin.y / origin.w, origin.z / origin.w, 1.0f);
+        }
+        else
+        {
+            XMStoreFloat4(&m_viewOrigin, XMVector3Normalize(XMVectorSetW(XMLoadFloat4(&origin), 0.0f)));
+            m_viewOrigin.w = 0.0f;
+        }
+        m_vertices = &vertices;
+        m_indices = &indices;
+    }
+
+    // σ[gVF[fBO͕sŐ[xeXĝƂ (A`GCAXł͎gȂB[xvpX˂)
+    m_variableRateActive = m_antiAliasMode == AntiAliasMode::Off && m_shadingRateMode != ShadingRateMode::Off && CanUseVariableRateShading(state);
+    if (m_variableRateActive)
+    {
+        // Explicit  SetShadingRates ĂłȂ 1x1 (GPU ł̃obt@̏lƓ)
+        m_shadingRates.resize(GetShadingRateTileCount(m_width, m_height), ShadingRate::Rate1x1);
+        if (m_shadingRateMode == ShadingRateMode::Auto)
+        {
+            UpdateShadingRatesFromColor();
+        }
+    }
+
+    // [xvpXg (Auto ȂO Render ̏d˕`Ō߂BA`GCAXƉσ[gVF[fBOł͎gȂ)
+    // CeBO͐[x̃pXv̂ŁAσ[gVF[fBOłȂΕKg
+    m_depthPrepassActive = m_antiAliasMode == AntiAliasMode::Off && !m_variableRateActive
+        && (m_lightingActive || ShouldUseDepthPrepass(m_depthPrepassMode, state, GetOverdraw(), m_depthPrepassActive));
+
+    // kTv (GPU łƓ傫)
+    if (m_antiAliasMode != AntiAliasMode::Off)
+    {
+        m_coveragePixels.resize(static_cast<size_t>(m_width) * m_height * 2);
+        m_coverageFragments.resize(static_cast<size_t>(GetCoverageFragmentCapacity(m_width, m_height)) * 2);
+        m_coverageFragmentCount = 0;
+    }
+
+    m_scissorActive = m_scissorRectCount > 0;
+    m_writtenPixelCount = 0;
+    m_depthPassFragments = 0;
+    m_shadedFragments = 0;
+    m_coveredPixels = 0;
+    m_sharedShadedPixels = 0;
+    m_tileLights = 0;
+    m_overflowedLightTiles = 0;
+    m_gbufferWriting = gbuffer;
+    RasterizeTiles(state, m_antiAliasMode);
+    m_scissorActive = false;
+    m_gbufferWriting = false;
+    m_vertices = nullptr;
+    m_indices = nullptr;
+
+    //  Render ̓xNǵA Render ̕ϊÕt[ƂĎg
+    m_previousWorldViewProj = m_worldViewProj;
+    m_previousTransformValid = true;
+}
+
+void SoftwareRasterizer::SetShadingRates(const std::vector<ShadingRate>& rates)
+{
+    if (rates.size() != GetShadingRateTileCount(m_width, m_height))
+    {
+        DebugOutput("Failed to set shading rates: pass one rate per shading rate tile\n");
+        throw std::runtime_error("Failed to set shading rates: pass one rate per shading rate tile");
+    }
+    m_shadingRates = rates;
+}
+
+void SoftwareRasterizer::UpdateShadingRatesFromColor()
+{
+    // [g̃^CƂ̋Px (0 ~ 255 ̐BGPU łƓۂ) ̕U
+    const uint32_t rateTileCountX = (m_width + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize;
+    const uint32_t rateTileCountY = (m_height + c_ShadingRateTileSize - 1) / c_ShadingRateTileSize;
+    for (uint32_t ty = 0; ty < rateTileCountY; ++ty)
+    {
+        for (uint32_t tx = 0; tx < rateTileCountX; ++tx)
+        {
+            const uint32_t x0 = tx * c_ShadingRateTileSize;
+            const uint32_t y0 = ty * c_ShadingRateTileSize;
+            const uint32_t x1 = std::min(x0 + c_ShadingRateTileSize, m_width);
+            const uint32_t y1 = std::min(y0 + c_ShadingRateTileSize, m_height);
+
+            uint32_t lumaSum = 0;
+            uint32_t lumaSquareSum = 0;
+            for (uint32_t y = y0; y < y1; ++y)
+            {
+                for (uint32_t x = x0; x < x1; ++x)
+                {
+                    const uint32_t packed = m_color[static_cast<size_t>(y) * m_width + x];
+                    const float luma = (0.299f * (packed & 0xFF) + 0.587f * ((packed >> 8) & 0xFF) + 0.114f * ((packed >> 16) & 0xFF)) / 255.0f;
+                    const uint32_t value = static_cast<uint32_t>(luma * 255.0f + 0.5f);
+                    lumaSum += value;
+                    lumaSquareSum += value * value;
+                }
+            }
+
+            const float count = static_cast<float>((x1 - x0) * (y1 - y0));
+            const float mean = lumaSum / count;
+            m_shadingRates[ty * rateTileCountX + tx] = SelectShadingRate(lumaSquareSum / count - mean * mean);
+        }
+    }
+}
+
+void SoftwareRasterizer::RenderMultiView(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                         const XMMATRIX* worldViewProjs, uint32_t viewCount)
+{
+    if (viewCount == 0 || viewCount > c_MaxViews)
+    {
+        DebugOutput("Failed to render multi-view: view count is out of range\n");
+        throw std::runtime_error("Failed to render multi-view: view count is out of range");
+    }
+
+    RasterState state = m_rasterState;
+    if (m_texture == nullptr)
+    {
+        state.textured = false;
+    }
+
+    // Op`1xǂ݁Ar[ƂɕϊĂꂼ̃Xg֓
+    const uint32_t triangleCount = TriangleCount(vertices, indices);
+    m_views.resize(viewCount);
+    for (ViewTarget& view : m_views)
+    {
+        view.triangles.clear();
+        view.triangles.reserve(triangleCount);
+    }
+
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const Vertex* v[3];
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            v[k] = &vertices[TriangleVertexIndex(indices, t, k)];
+        }
+
+        for (uint32_t view = 0; view < viewCount; ++view)
+        {
+            TriangleSetup setup;
+            if (SetupTriangle(v, worldViewProjs[view], state.cullMode, setup))
+            {
+                setup.index = t;
+                m_views[view].triangles.push_back(setup);
+            }
+        }
+    }
+
+    // r[̎Op`Əo͐ւāARender Ɠ^C֐U蕪ēh
+    // (GPU ł CSMainMultiView Ɠ[xvpXƉσ[gVF[fBOAVU[`͎gȂBv͑Sr[̍v)
+    m_depthPrepassActive = false;
+    m_variableRateActive = false;
+    m_lightingActive = false;
+    m_scissorActive = false;
+    m_writtenPixelCount = 0;
+    m_depthPassFragments = 0;
+    m_shadedFragments = 0;
+    m_coveredPixels = 0;
+    m_sharedShadedPixels = 0;
+    m_tileLights = 0;
+    m_overflowedLightTiles = 0;
+    const size_t pixelCount = static_cast<size_t>(m_width) * m_height;
+    const size_t depthBytes = pixelCount * GetDepthBytesPerPixel(m_depthBufferDesc.format);
+    for (ViewTarget& view : m_views)
+    {
+        if (view.color.size() != pixelCount || view.depthStorage.size() != depthBytes)
+        {
+            view.color.assign(pixelCount, 0);
+            view.depthStorage.assign(depthBytes, 0);
+            view.tileCleared.clear();
+        }
+
+        std::swap(m_triangles, view.triangles);
+        std::swap(m_color, view.color);
+        std::swap(m_depthStorage, view.depthStorage);
+        std::swap(m_tileCleared, view.tileCleared);
+
+        BinTriangles();
+        RasterizeTiles(state, AntiAliasMode::Off);
+
+        std::swap(m_triangles, view.triangles);
+        std::swap(m_color, view.color);
+        std::swap(m_depthStorage, view.depthStorage);
+        std::swap(m_tileCleared, view.tileCleared);
+    }
+}
+
+void SoftwareRasterizer::RenderShadowMap(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, FXMMATRIX worldLightViewProj,
+                                         SoftwareShadowMap& shadowMap, CullMode cullMode, ConservativeMode conservative)
+{
+    const uint32_t shadowWidth = shadowMap.width;
+    const uint32_t shadowHeight = shadowMap.height;
+    const float width = static_cast<float>(shadowWidth);
+    const float height = static_cast<float>(shadowHeight);
+    const bool reversedZ = shadowMap.desc.reversedZ;
+    const float depthUnormMax = static_cast<float>(GetDepthUnormMax(shadowMap.desc.format));
+
+    m_shadowDepth.assign(static_cast<size_t>(shadowWidth) * shadowHeight, reversedZ ? 0.0f : 1.0f);
+
+    const uint32_t triangleCount = TriangleCount(vertices, indices);
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        XMFLOAT4 clip[3];
+        XMFLOAT2 screen[3];
+        bool behindCamera = false;
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            XMStoreFloat4(&clip[k], XMVector3Transform(XMLoadFloat3(&vertices[TriangleVertexIndex(indices, t, k)].pos), worldLightViewProj));
+            if (clip[k].w <= 1e-6f)
+            {
+                behindCamera = true;
+                break;
+            }
+            const float invW = 1.0f / clip[k].w;
+            screen[k] = XMFLOAT2((clip[k].x * invW + 1.0f) * 0.5f * width, (1.0f - clip[k].y * invW) * 0.5f * height);
+        }
+        if (behindCamera) continue;
+
+        const float area = (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y)
+                         - (screen[2].y - screen[0].y) * (screen[1].x - screen[0].x);
+        if (area == 0.0f) continue;
+        if (cullMode == CullMode::Back && area < 0.0f) continue;
+        if (cullMode == CullMode::Front && area > 0.0f) continue;
+
+        const float invArea = 1.0f / area;
+        const XMFLOAT3 edges[3] = {
+            EdgeCoefficients(screen[1], screen[2], invArea),
+            EdgeCoefficients(screen[2], screen[0], invArea),
+            EdgeCoefficients(screen[0], screen[1], invArea),
+        };
+        const XMFLOAT3& e0 = edges[0];
+        const XMFLOAT3& e1 = edges[1];
+        const XMFLOAT3& e2 = edges[2];
+        const XMFLOAT3 bias = ConservativeCoverageBias(edges, conservative);
+        const XMFLOAT3 z(clip[0].z / clip[0].w, clip[1].z / clip[1].w, clip[2].z / clip[2].w);
+        const float minZ = std::min({ z.x, z.y, z.z });
+        const float maxZ = std::max({ z.x, z.y, z.z });
+        const bool clampDepth = conservative == ConservativeMode::Overestimate;
+        const float margin = clampDepth ? 0.5f : 0.0f;
+
+        // sNZS (sNZL) Op` AABB ɓ͈ (s_̐ōL肷Ȃ悤 GPU ł AABB Ő؂)
+        const float minX = std::min({ screen[0].x, screen[1].x, screen[2].x }) - margin;
+        const float maxX = std::max({ screen[0].x, screen[1].x, screen[2].x }) + margin;
+        const float minY = std::min({ screen[0].y, screen[1].y, screen[2].y }) - margin;
+        const float maxY = std::max({ screen[0].y, screen[1].y, screen[2].y }) + margin;
+        if (maxX < 0.5f || maxY < 0.5f || minX > width - 0.5f || minY > height - 0.5f) continue;
+        const uint32_t x0 = static_cast<uint32_t>(std::max(0.0f, std::ceil(minX - 0.5f)));
+        const uint32_t y0 = static_cast<uint32_t>(std::max(0.0f, std::ceil(minY - 0.5f)));
+        const uint32_t x1 = static_cast<uint32_t>(std::min(width - 1.0f, std::floor(maxX - 0.5f)));
+        const uint32_t y1 = static_cast<uint32_t>(std::min(height - 1.0f, std::floor(maxY - 0.5f)));
+
+        for (uint32_t y = y0; y <= y1; ++y)
+        {
+            const float py = static_cast<float>(y) + 0.5f;
+            float* row = &m_shadowDepth[static_cast<size_t>(y) * shadowWidth];
+            for (uint32_t x = x0; x <= x1; ++x)
+            {
+                const float px = static_cast<float>(x) + 0.5f;
+                const float w0 = e0.x * px + e0.y * py + e0.z;
+                const float w1 = e1.x * px + e1.y * py + e1.z;
+                const float w2 = e2.x * px + e2.y * py + e2.z;
+                if (w0 + bias.x < 0.0f || w1 + bias.y < 0.0f || w2 + bias.z < 0.0f) continue;
+
+                float depth = w0 * z.x + w1 * z.y + w2 * z.z;
+                if (clampDepth)
+                {
+                    // Op`̊ÕsNZSł͊O}ɂȂ̂ŁA_̐[x͈̔͂Ɏ߂
+                    depth = std::min(std::max(depth, minZ), maxZ);
+                }
+                if (depthUnormMax > 0.0f)
+                {
+                    depth = std::round(std::min(std::max(depth, 0.0f), 1.0f) * depthUnormMax) / depthUnormMax;
+                }
+                if (reversedZ ? depth > row[x] : depth < row[x])
+                {
+                    row[x] = depth;
+                }
+            }
+        }
+    }
+
+    const uint32_t bytesPerPixel = GetDepthBytesPerPixel(shadowMap.desc.format);
+    for (uint32_t y = 0; y < shadowHeight; ++y)
+    {
+        StoreDepthRow(&shadowMap.storage[static_cast<size_t>(y) * shadowWidth * bytesPerPixel],
+                      &m_shadowDepth[static_cast<size_t>(y) * shadowWidth], shadowWidth, shadowMap.desc.format);
+    }
+}
+
+void SoftwareRasterizer::RasterizeTiles(const RasterState& state, AntiAliasMode antiAlias)
+{
+    static constexpr auto c_TileFunctions = MakeTileFunctions(std::make_index_sequence<c_TileSizeCount * c_RasterPermutationCount>());
+    static constexpr auto c_CoverageTileFunctions = MakeCoverageTileFunctions(std::make_index_sequence<c_RasterPermutationCount>());
+
+    const TileFunction rasterizeTile = antiAlias != AntiAliasMode::Off
+        ? c_CoverageTileFunctions[GetRasterPermutation(state)]
+        : c_TileFunctions[m_tileSizeIndex * c_RasterPermutationCount + GetRasterPermutation(state)];
+    // VU[`ƏdȂȂ^C͓hȂ (GPU ł̓^C̕тɓȂ)
+    const TileSize tileSize = c_TileSizes[m_tileSizeIndex];
+    std::vector<uint32_t> tiles;
+    tiles.reserve(static_cast<size_t>(m_tilesX) * m_tilesY);
+    for (uint32_t ty = 0; ty < m_tilesY; ++ty)
+    {
+        for (uint32_t tx = 0; tx < m_tilesX; ++tx)
+        {
+            const uint32_t x0 = tx * tileSize.width;
+            const uint32_t y0 = ty * tileSize.height;
+            if (GetScissorCoverage(x0, y0, std::min(x0 + tileSize.width, m_width) - 1, std::min(y0 + tileSize.height, m_height) - 1) == ScissorCoverage::Outside) continue;
+
+            tiles.push_back(ty * m_tilesX + tx);
+        }
+    }
+    m_rasterizedTileCount = tiles.size();
+
+    // ^C͏ޔ͈͂dȂȂ̂ŁAeXbh̃^Cɍsēh
+    // JobW}XÑJ[l (Ɨp̃^CƃtOg̒ǉ̏) ƈkeNX` (ubÑLbV) 1Xbh
+    uint32_t workerCount = m_threadCount != 0 ? m_threadCount : std::max(1u, std::thread::hardware_concurrency());
+    if (antiAlias != AntiAliasMode::Off || (state.textured && m_texture->GetFormat() != TextureFormat::R8G8B8A8))
+    {
+        workerCount = 1;
+    }
+    workerCount = std::max(1u, std::min(workerCount, static_cast<uint32_t>(tiles.size())));
+
+    std::vector<TileStats> workerStats(workerCount);
+    std::atomic<uint32_t> nextTile = 0;
+    auto worker = [&](uint32_t w)
+    {
+        for (uint32_t n = nextTile++; n < tiles.size(); n = nextTile++)
+        {
+            (this->*rasterizeTile)(tiles[n] % m_tilesX, tiles[n] / m_tilesX, workerStats[w]);
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    for (uint32_t w = 1; w < workerCount; ++w)
+    {
+        tasks.push_back(std::async(std::launch::async, worker, w));
+    }
+    worker(0);
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    for (const TileStats& stats : workerStats)
+    {
+        m_depthPassFragments += stats.depthPassFragments;
+        m_shadedFragments += stats.shadedFragments;
+        m_coveredPixels += stats.coveredPixels;
+        m_sharedShadedPixels += stats.sharedShadedPixels;
+        m_tileLights += stats.tileLights;
+        m_overflowedLightTiles += stats.overflowedLightTiles;
+        m_writtenPixelCount += stats.writtenPixels;
+    }
+
+    if (antiAlias != AntiAliasMode::Off)
+    {
+        ResolveCoverage();
+    }
+}
+
+void SoftwareRasterizer::SetupLines(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, float width)
+{
+    const XMMATRIX worldViewProj = XMLoadFloat4x4(&m_worldViewProj);
+    const float screenWidth = static_cast<float>(m_width);
+    const float screenHeight = static_cast<float>(m_height);
+    const uint32_t lineCount = static_cast<uint32_t>((indices.empty() ? vertices.size() : indices.size()) / 2);
+
+    m_lines.clear();
+    m_lines.reserve(lineCount);
+
+    for (uint32_t l = 0; l < lineCount; ++l)
+    {
+        XMVECTOR clip[2];
+        XMVECTOR color[2];
+        float w[2];
+        for (uint32_t k = 0; k < 2; ++k)
+        {
+            const Vertex& vertex = vertices[indices.empty() ? l * 2 + k : indices[l * 2 + k]];
+            clip[k] = XMVector3Transform(XMLoadFloat3(&vertex.pos), worldViewProj);
+            color[k] = XMLoadFloat4(&vertex.color);
+            w[k] = XMVectorGetW(clip[k]);
+        }
+
+        // Op`ƈႢAJʂ܂͎O؂ĕ` (؂_̐[x 0 ~ 1 ̊OȂ̂ŁÃsNZ͕`Ȃ)
+        constexpr float c_MinW = 1e-6f;
+        if (w[0] <= c_MinW && w[1] <= c_MinW) continue;
+        if (w[0] <= c_MinW || w[1] <= c_MinW)
+        {
+            const uint32_t behind = w[0] <= c_MinW ? 0 : 1;
+            const float t = (c_MinW - w[behind]) / (w[1 - behind] - w[behind]);
+            clip[behind] = XMVectorLerp(clip[behind], clip[1 - behind], t);
+            color[behind] = XMVectorLerp(color[behind], color[1 - behind], t);
+        }
+
+        LineSetup setup;
+        for (uint32_t k = 0; k < 2; ++k)
+        {
+            XMFLOAT4 c;
+            XMStoreFloat4(&c, clip[k]);
+            const float invW = 1.0f / c.w;
+            setup.screen[k] = XMFLOAT2((c.x * invW + 1.0f) * 0.5f * screenWidth, (1.0f - c.y * invW) * 0.5f * screenHeight);
+            setup.depth[k] = c.z * invW;
+            setup.invW[k] = invW;
+            XMStoreFloat4(&setup.colorOverW[k], XMVectorScale(color[k], invW));
+        }
+
+        // 厲 (u) ̊esNZSŕ (v) ̈ʒu߂B͕ɑ / cos ̕h
+        const float dx = setup.screen[1].x - setup.screen[0].x;
+        const float dy = setup.screen[1].y - setup.screen[0].y;
+        setup.xMajor = std::abs(dx) >= std::abs(dy);
+        const float du = setup.xMajor ? dx : dy;
+        const float dv = setup.xMajor ? dy : dx;
+        if (du == 0.0f) continue;
+        const float slope = dv / du;
+        setup.halfSpan = width > 1.0f ? 0.5f * width * std::sqrt(1.0f + slope * slope) : 0.0f;
+
+        // 厲̓sNZS [n_, I_) ɓ (Ȃ̋L[_2hȂ)A͓h镝܂߂͈
+        const float ua = setup.xMajor ? setup.screen[0].x : setup.screen[0].y;
+        const float va = setup.xMajor ? setup.screen[0].y : setup.screen[0].x;
+        const float uLimit = setup.xMajor ? screenWidth : screenHeight;
+        const float vLimit = setup.xMajor ? screenHeight : screenWidth;
+        const float uMin = std::max(std::ceil(std::min(ua, ua + du) - 0.5f), 0.0f);
+        const float uMax = std::min(std::ceil(std::max(ua, ua + du) - 0.5f) - 1.0f, uLimit - 1.0f);
+        const float vMin = std::max(std::floor(std::min(va, va + dv) - setup.halfSpan), 0.0f);
+        const float vMax = std::min(std::floor(std::max(va, va + dv) + setup.halfSpan), vLimit - 1.0f);
+        if (uMin > uMax || vMin > vMax) continue;
+
+        setup.minX = static_cast<uint32_t>(setup.xMajor ? uMin : vMin);
+        setup.maxX = static_cast<uint32_t>(setup.xMajor ? uMax : vMax);
+        setup.minY = static_cast<uint32_t>(setup.xMajor ? vMin : uMin);
+        setup.maxY = static_cast<uint32_t>(setup.xMajor ? vMax : uMax);
+        m_lines.push_back(setup);
+    }
+}
+
+void SoftwareRasterizer::BinLines()
+{
+    // ͒߂ Render ̃^C̕ (NAtO̕) ŕ`BInitialize ̌ł܂`ĂȂ΁A
+    // ̃^C̑傫ŁAg̓NAꂽ̂Ƃ݂Ȃ (̒ʂ^C𖄂߂)
+    if (m_tileCleared.empty())
+    {
+        m_binnedTileSizeIndex = m_tileSizeIndex;
+    }
+    const TileSize tileSize = c_TileSizes[m_binnedTileSizeIndex];
+    m_tilesX = (m_width + tileSize.width - 1) / tileSize.width;
+    m_tilesY = (m_height + tileSize.height - 1) / tileSize.height;
+    const uint32_t tileCount = m_tilesX * m_tilesY;
+    m_tileLineOffsets.assign(tileCount + 1, 0);
+    if (m_tileCleared.empty())
+    {
+        m_tileCleared.assign(tileCount, 1);
+    }
+
+    // ^C̍sƂɁA̍s y ͈̔ (h镝̕L) Őʂ x ͈̔͂̃^CԂ
+    const float maxX = static_cast<float>(m_width - 1);
+    auto forEachTile = [&](const LineSetup& line, auto&& func)
+    {
+        const XMFLOAT2& a = line.screen[0];
+        const XMFLOAT2& b = line.screen[1];
+        const float margin = line.halfSpan + 1.0f;
+        for (uint32_t ty = line.minY / tileSize.height; ty <= line.maxY / tileSize.height; ++ty)
+        {
+            uint32_t tx0 = line.minX / tileSize.width;
+            uint32_t tx1 = line.maxX / tileSize.width;
+            if (a.y != b.y)
+            {
+                const float t0 = (static_cast<float>(ty * tileSize.height) - margin - a.y) / (b.y - a.y);
+                const float t1 = (static_cast<float>((ty + 1) * tileSize.height) + margin - a.y) / (b.y - a.y);
+                const float xa = a.x + (b.x - a.x) * std::clamp(std::min(t0, t1), 0.0f, 1.0f);
+                const float xb = a.x + (b.x - a.x) * std::clamp(std::max(t0, t1), 0.0f, 1.0f);
+                tx0 = std::max(tx0, static_cast<uint32_t>(std::clamp(std::min(xa, xb) - margin, 0.0f, maxX)) / tileSize.width);
+                tx1 = std::min(tx1, static_cast<uint32_t>(std::clamp(std::max(xa, xb) + margin, 0.0f, maxX)) / tileSize.width);
+            }
+            for (uint32_t tx = tx0; tx <= tx1; ++tx)
+            {
+                func(ty * m_tilesX + tx);
+            }
+        }
+    };
+
+    for (const LineSetup& line : m_lines)
+    {
+        forEachTile(line, [&](uint32_t tile) { ++m_tileLineOffsets[tile + 1]; });
+    }
+    for (uint32_t tile = 0; tile < tileCount; ++tile)
+    {
+        m_tileLineOffsets[tile + 1] += m_tileLineOffsets[tile];
+    }
+
+    m_tileLines.resize(m_tileLineOffsets[tileCount]);
+    std::vector<uint32_t> cursors(m_tileLineOffsets.begin(), m_tileLineOffsets.end() - 1);
+    for (uint32_t l = 0; l < static_cast<uint32_t>(m_lines.size()); ++l)
+    {
+        forEachTile(m_lines[l], [&](uint32_t tile) { m_tileLines[cursors[tile]++] = l; });
+    }
+}
+
+void SoftwareRasterizer::RasterizeLineTile(uint32_t tileX, uint32_t tileY, const LineDesc& desc, uint64_t& fragments)
+{
+    const TileSize tileSize = c_TileSizes[m_binnedTileSizeIndex];
+    const uint32_t tile = tileY * m_tilesX + tileX;
+    const uint32_t x0 = tileX * tileSize.width;
+    const uint32_t y0 = tileY * tileSize.height;
+    const uint32_t x1 = std::min(x0 + tileSize.width, m_width) - 1;
+    const uint32_t y1 = std::min(y0 + tileSize.height, m_height) - 1;
+    const DepthFormat depthFormat = m_depthBufferDesc.format;
+    const uint32_t depthBytes = GetDepthBytesPerPixel(depthFormat);
+    const bool reversedZ = m_depthBufferDesc.reversedZ;
+
+    // t@XgNAŏȂ^C͒gÂ̂ŁAɃNAJ[Ɛ[xŖ߂
+    if (m_tileCleared[tile])
+    {
+        const uint32_t clearColor = PackColor(XMLoadFloat4(&m_clearColor));
+        const std::vector<float> clearDepth(x1 - x0 + 1, reversedZ ? 0.0f : 1.0f);
+        for (uint32_t y = y0; y <= y1; ++y)
+        {
+            const size_t row = static_cast<size_t>(y) * m_width;
+            std::fill(m_color.begin() + row + x0, m_color.begin() + row + x1 + 1, clearColor);
+            StoreDepthRow(&m_depthStorage[(row + x0) * depthBytes], clearDepth.data(), x1 - x0 + 1, depthFormat);
+        }
+        m_tileCleared[tile] = 0;
+    }
+
+    const XMVECTOR tint = XMLoadFloat4(&desc.color);
+    const float depthBias = reversedZ ? desc.depthBias : -desc.depthBias;
+    uint64_t written = 0;
+    for (uint32_t n = m_tileLineOffsets[tile]; n < m_tileLineOffsets[tile + 1]; ++n)
+    {
+        const LineSetup& line = m_lines[m_tileLines[n]];
+        const float ua = line.xMajor ? line.screen[0].x : line.screen[0].y;
+        const float va = line.xMajor ? line.screen[0].y : line.screen[0].x;
+        const float du = (line.xMajor ? line.screen[1].x : line.screen[1].y) - ua;
+        const float dv = (line.xMajor ? line.screen[1].y : line.screen[1].x) - va;
+        const float invDu = 1.0f / du;
+
+        // ^CƐ͈̔͂̏dȂ񂾂i߂
+        const uint32_t uFirst = std::max(line.xMajor ? x0 : y0, line.xMajor ? line.minX : line.minY);
+        const uint32_t uLast = std::min(line.xMajor ? x1 : y1, line.xMajor ? line.maxX : line.maxY);
+        const float vTileMin = static_cast<float>(line.xMajor ? y0 : x0);
+        const float vTileMax = static_cast<float>(line.xMajor ? y1 : x1);
+        const XMVECTOR colorOverW0 = XMLoadFloat4(&line.colorOverW[0]);
+        const XMVECTOR colorOverW1 = XMLoadFloat4(&line.colorOverW[1]);
+
+        for (uint32_t u = uFirst; u <= uLast; ++u)
+        {
+            const float t = (static_cast<float>(u) + 0.5f - ua) * invDu;
+            const float v = va + dv * t;
+            float vMin = line.halfSpan > 0.0f ? std::ceil(v - line.halfSpan - 0.5f) : std::floor(v);
+            float vMax = line.halfSpan > 0.0f ? std::ceil(v + line.halfSpan - 0.5f) - 1.0f : vMin;
+            vMin = std::max(vMin, vTileMin);
+            vMax = std::min(vMax, vTileMax);
+            if (vMin > vMax) continue;
+
+            // [x̓XN[Ő`AF 1 / W Ŋăp[XyNeBu␳
+            const float depth = line.depth[0] + (line.depth[1] - line.depth[0]) * t;
+            if (!(depth >= 0.0f && depth <= 1.0f)) continue;
+            const float invW = line.invW[0] + (line.invW[1] - line.invW[0]) * t;
+            const uint32_t color = PackColor(XMVectorMultiply(XMVectorScale(XMVectorLerp(colorOverW0, colorOverW1, t), 1.0f / invW), tint));
+
+            for (uint32_t w = static_cast<uint32_t>(vMin); w <= static_cast<uint32_t>(vMax); ++w)
+            {
+                const size_t index = line.xMajor ? static_cast<size_t>(w) * m_width + u : static_cast<size_t>(u) * m_width + w;
+                uint8_t* storedDepth = &m_depthStorage[index * depthBytes];
+                if (desc.depthTest)
+                {
+                    const float testDepth = depth + depthBias;
+                    const float currentDepth = LoadDepth(storedDepth, depthFormat);
+                    if (reversedZ ? !(testDepth >= currentDepth) : !(testDepth <= currentDepth)) continue;
+                }
+
+                m_color[index] = color;
+                if (desc.depthWrite)
+                {
+                    StoreDepthRow(storedDepth, &depth, 1, depthFormat);
+                }
+                ++written;
+            }
+        }
+    }
+    fragments += written;
+}
+
+void SoftwareRasterizer::RenderLines(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const LineDesc& desc)
+{
+    SetupLines(vertices, indices, desc.width);
+    BinLines();
+
+    std::vector<uint32_t> tiles;
+    for (uint32_t tile = 0; tile < m_tilesX * m_tilesY; ++tile)
+    {
+        if (m_tileLineOffsets[tile] != m_tileLineOffsets[tile + 1])
+        {
+            tiles.push_back(tile);
+        }
+    }
+
+    // RasterizeTiles ƓAeXbh̃^Cɍsĕ`
+    uint32_t workerCount = m_threadCount != 0 ? m_threadCount : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::max(1u, std::min(workerCount, static_cast<uint32_t>(tiles.size())));
+
+    std::vector<uint64_t> workerFragments(workerCount, 0);
+    std::atomic<uint32_t> nextTile = 0;
+    auto worker = [&](uint32_t w)
+    {
+        for (uint32_t n = nextTile++; n < tiles.size(); n = nextTile++)
+        {
+            RasterizeLineTile(tiles[n] % m_tilesX, tiles[n] / m_tilesX, desc, workerFragments[w]);
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    for (uint32_t w = 1; w < workerCount; ++w)
+    {
+        tasks.push_back(std::async(std::launch::async, worker, w));
+    }
+    worker(0);
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    m_lineFragments = std::accumulate(workerFragments.begin(), workerFragments.end(), uint64_t(0));
+}
+
+void SoftwareRasterizer::RenderWireframe(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const LineDesc& desc)
+{
+    RenderLines(vertices, BuildWireframeEdges(vertices, indices), desc);
+}
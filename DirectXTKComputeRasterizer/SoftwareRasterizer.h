@@ -0,0 +1,392 @@
+#pragma once
+#include "RasterizerTypes.h"
+#include "SoftwareTexture.h"
+#include <array>
+#include <utility>
+
+// ==================================================================================
+// CPU ł CSMain (TriangleRasterizer.hlsl ƓKœh)
+// ʂ c_TileSizes ̃^CɕAOp`^CƂ̃Xg֐U蕪ĂA
+// ^C̐[xƐF GPU ł bestDepth / bestColor Ɠ[JɎĎOp`̏ɓhB
+// [xvpXł́Aɐ[xŃ^C̑SOp`]ĂA[xvsNZhB
+// ^C̃J[l̓^C̑傫 RasterState ̑gݍ킹Ƃ̃ev[gŁAgȂ@\̏ƕ܂܂ȂB
+// Op`1`Ȃ^C̓NAtO𗧂āAONAĂΏ܂Ȃ (t@XgNA)B
+// JobW}XÑA`GCAXł́A^C̃sNZƂɃTv̐[xƃtOgʂ̃J[lœhA
+// GPU łƓт̈kTvĂJ[obt@։B
+// σ[gVF[fBOł́A[x̃pXŃsNZƂ̌Op`߂ĂA[g̃ubNƂ1񂾂hB
+// VU[`΋`ƏdȂ^ChA`͂ݏo^Cł͋`̊ÕsNZȂB
+// G-buffer ł́AFƐ[xƂɃsNZƂ̌Op`AxhA@AIDAxNg GPU łƓтŏB
+// _΁A[x̃pX̌Ƀ^C̐[x͈̔͂ƎŃCgIсA^C̃Xg̃CgŏƂ炷B
+// ^C݂͌ɓƗĂ̂ŁASetThreadCount ̃Xbh֓IɊUēh (ʂ̓XbhɂȂ)B
+//  (RenderLines) ^C֐U蕪A^CƂɎ厲 DDA ō̃J[obt@Ɛ[xobt@̏ɕ`B
+// wbhX̃eXgx`}[NAGPU ł̌ʂ̔rɎgB
+// ==================================================================================
+
+// ^C̑傫̎x`}[NɎgrp̃V[
+// NDC (W = 1) ɎU΂ triangleCount ̎Op` (͗AAt@ 0.5 ~ 1)Baspect ͉ʂ̕ / 
+std::vector<Vertex> CreateCalibrationScene(uint32_t triangleCount, float aspect);
+
+// PʃxNg̔ʑ̂ 2 ([-1, 1]BGPU ł EncodeOctahedral) ƁA߂PʃxNg
+DirectX::XMFLOAT2 EncodeNormalOctahedral(const DirectX::XMFLOAT3& normal);
+DirectX::XMFLOAT3 DecodeNormalOctahedral(const DirectX::XMFLOAT2& encoded);
+
+// CPU ł̃VhE}bv (GPU ł ShadowMap Ɠl)
+struct SoftwareShadowMap {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    DepthBufferDesc desc;
+    std::vector<uint8_t> storage;   // GetDepthBytesPerPixel oCg / sNZAsD
+
+    void Create(uint32_t shadowWidth, uint32_t shadowHeight, const DepthBufferDesc& depthDesc);
+    // (x, y) ̐[x float 
+    float GetDepth(uint32_t x, uint32_t y) const;
+};
+
+// ̕` (SoftwareRasterizer::RenderLines)
+struct LineDesc {
+    float width = 1.0f;                                     // sNZPʂ̑ (1 ȉȂ厲11sNZ)
+    DirectX::XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };   // _J[Ɋ|F
+    bool depthTest = true;                                  // ̐[xobt@OȂ` (reversed-Z Ȃ傫)
+    bool depthWrite = false;                                // `sNZ̐[x
+    float depthBias = 0.0f;                                 // [xeXg̑Oɐ̐[xJւ炷 (bVɏd˂郏C[t[ z-fighting h)
+};
+
+// Op`̕ӂdȂŐ̃CfbNX (21{) ɂ
+// ʒu̒_1ɂ܂Ƃ߂̂ŁACfbNX` UV ̌pڂŕꂽ_łALӂ1{ɂȂ
+std::vector<uint32_t> BuildWireframeEdges(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+class SoftwareRasterizer
+{
+public:
+    void Initialize(uint32_t width, uint32_t height);
+
+    // Local -> Clip s (GPU ł WorldViewProj ƓB]uȂ)
+    void SetTransform(DirectX::FXMMATRIX worldViewProj);
+    // ȍ~ Render ŎgeNX` (nullptr Ȃ甒)
+    void SetTexture(const SoftwareTexture* texture) { m_texture = texture; }
+    void SetRasterState(const RasterState& state) { m_rasterState = state; }
+    // ȍ~ Render ̃^C̑傫 (c_TileSizes ̔ԍBResolveColor ƃNAtO͎ Render ܂őO̕т̂܂)
+    void SetTileSize(uint32_t tileSizeIndex);
+    uint32_t GetTileSize() const { return m_tileSizeIndex; }
+    // Op``ȂsNZ̐F (ςƎ Render őS^C)
+    void SetClearColor(const DirectX::XMFLOAT4& color);
+    // false Ȃ疈S^C (rpBNAtO͍XV)
+    void SetFastClear(bool enable) { m_fastClear = enable; }
+    // ێIX^CY (GPU ł SetConservativeRaster ƓBȍ~ Render  RenderMultiView Ɏg)
+    void SetConservativeRaster(ConservativeMode mode) { m_conservativeMode = mode; }
+    // JobW}XÑA`GCAX (GPU ł SetAntiAliasing ƓBȍ~ Render ɎgARenderMultiView ł͎gȂ)
+    void SetAntiAliasing(AntiAliasMode mode) { m_antiAliasMode = mode; }
+    AntiAliasMode GetAntiAliasing() const { return m_antiAliasMode; }
+    // σ[gVF[fBO (GPU ł SetShadingRateMode ƓBȍ~ Render ɎgARenderMultiView ł͎gȂ)
+    void SetShadingRateMode(ShadingRateMode mode) { m_shadingRateMode = mode; }
+    ShadingRateMode GetShadingRateMode() const { return m_shadingRateMode; }
+    // Explicit ̃[g (GetShadingRateTileCount(, ) Bт GPU ł SetShadingRates Ɠ)
+    void SetShadingRates(const std::vector<ShadingRate>& rates);
+    // ߂ Render ̃[g (Auto Ȃ炻̃t[Ō߂)
+    const std::vector<ShadingRate>& GetShadingRates() const { return m_shadingRates; }
+    // ߂ Render ŉσ[gVF[fBOg
+    bool IsVariableRateShadingActive() const { return m_variableRateActive; }
+    // VU[` (GPU ł SetScissorRects ƓBő c_MaxScissorRects Acount = 0 ŖBȍ~ Render ɎgARenderMultiView ł͎gȂ)
+    void SetScissorRects(const ScissorRect* rects, uint32_t count);
+    uint32_t GetScissorRectCount() const { return m_scissorRectCount; }
+    // G-buffer (GPU ł SetGBuffer ƓBȍ~ Render ɎgAsŐ[xeXĝƂBA`GCAX RenderMultiView ł͏Ȃ)
+    void SetGBuffer(const GBufferDesc& desc);
+    const GBufferDesc& GetGBufferDesc() const { return m_gbufferDesc; }
+    // ߂ Render  G-buffer 
+    bool IsGBufferActive() const { return m_gbufferActive; }
+    // G-buffer ̖@Ɏg_Ƃ̖@ ([JWBRender  vertices ƓсBnullptr ȂJ֌ʂ̖@)
+    void SetVertexNormals(const std::vector<DirectX::XMFLOAT3>* normals) { m_vertexNormals = normals; }
+    // @ƃCgƂ炷ʒu Local -> World sɎg World (GPU ł SetTransform  worldB͒Pʍs)
+    void SetNormalTransform(DirectX::FXMMATRIX world);
+    //  Render ̓xNgɎgÕt[ Local -> Clip s (͒O Render  SetTransform)
+    void SetPreviousTransform(DirectX::FXMMATRIX worldViewProj);
+    // ^CPʂ̃CgJO (GPU ł SetLights ƓBcount = 0 ŖBȍ~ Render ɎgAsŐ[xeXĝƂƂ炷)
+    // [xvpX (σ[gVF[fBOȂ炻̐[x̃pX)AA`GCAXAG-bufferARenderMultiView ł͏Ƃ炳Ȃ
+    // @ SetVertexNormals (Ȃ΃J֌ʂ̖@)Aʒu SetNormalTransform  World Ń[hWɂ
+    void SetLights(const PointLight* lights, uint32_t count) { m_lights.assign(lights, lights + count); }
+    uint32_t GetLightCount() const { return static_cast<uint32_t>(m_lights.size()); }
+    // ǂ̃Cg͂Ȃʂ̖邳 (͍)
+    void SetAmbientLight(const DirectX::XMFLOAT3& color) { m_ambientLight = color; }
+    // ߂ Render Ń^CPʂ̃CgJOg
+    bool IsTiledLightingActive() const { return m_lightingActive; }
+    // ^ChXbh (0 Ȃn[hEFÃXbhB 1 = ĂяoXbh)
+    // A`GCAXƈkeNX` (fR[hς݃ubÑLbV) ł 1 Xbhœh
+    void SetThreadCount(uint32_t count) { m_threadCount = count; }
+    uint32_t GetThreadCount() const { return m_threadCount; }
+    // [xvpX (Off / On / AutoBAuto ͑O Render ̏d˕`Ō߂)
+    void SetDepthPrepass(DepthPrepassMode mode) { m_depthPrepassMode = mode; }
+    // ߂ Render Ő[xvpXg
+    bool IsDepthPrepassActive() const { return m_depthPrepassActive; }
+    // [xobt@̃tH[}bg reversed-Z ( Render őS^C)
+    void SetDepthBuffer(const DepthBufferDesc& desc);
+    const DepthBufferDesc& GetDepthBufferDesc() const { return m_depthBufferDesc; }
+
+    // e^C̑傫Ŋrp̃V[`ĎԂ𑪂Aő̂̂ȍ~ Render Ŏg
+    // ߂l͑I c_TileSizes ̔ԍ (ʂ̑傫 Initialize ̂)
+    uint32_t AutoTuneTileSize(int iterations = 3);
+
+    // indices Ȃ 3_ = 1Op`BʑŜNAJ[`
+    void Render(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    // worldViewProjs  viewCount  (c_MaxViews ܂) ̃r[֕`BOp`1xǂŃr[ƂɕϊA
+    // r[Ƃ̃^C̃Xg֐U蕪Bʂ GetViewColorBuffer (GetColorBuffer Ȃǂ̎r[͕ςȂ)
+    // GPU ł CSMainMultiView Ɠ[xvpX͎gȂBv͑Sr[̍v
+    void RenderMultiView(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                         const DirectX::XMMATRIX* worldViewProjs, uint32_t viewCount);
+
+    // GPU ł RenderShadowMap ƓAworldLightViewProj Ő[x shadowMap ֕`
+    // ȂOp`Op`Ƃ͈̔͂Œڑ (^C֐U蕪ȂBeNX` RasterState ͎gȂ)
+    void RenderShadowMap(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, DirectX::FXMMATRIX worldLightViewProj,
+                         SoftwareShadowMap& shadowMap, CullMode cullMode = CullMode::Back, ConservativeMode conservative = ConservativeMode::Off);
+
+    //  (indices Ȃ 2_ = 1{A 21{)  SetTransform ̍sŕϊÃJ[obt@Ɛ[xobt@̏ɕ` (NAȂ)
+    // Jʂ̎OŐ؂A^C֐U蕪 SetThreadCount ̃Xbhŕ` (^C͐̏Bʂ̓XbhɂȂ)
+    // RasterStateAeNX`AVU[`AG-bufferAA`GCAXACg͎gȂ
+    void RenderLines(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const LineDesc& desc);
+    // BuildWireframeEdges ̕ӂ RenderLines ŕ` (ӂ蒼̂ŁAbVJԂ`Ȃ BuildWireframeEdges ̌ʂ RenderLines ɓn)
+    void RenderWireframe(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const LineDesc& desc);
+
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+    // R8G8B8A8 (R ʃoCg)AsD
+    const std::vector<uint32_t>& GetColorBuffer() const { return m_color; }
+    // ߂ RenderMultiView  view Ԗڂ̃r[̐FƐ[x (т GetColorBuffer / GetDepthStorage Ɠ)
+    const std::vector<uint32_t>& GetViewColorBuffer(uint32_t view) const { return m_views[view].color; }
+    const std::vector<uint8_t>& GetViewDepthStorage(uint32_t view) const { return m_views[view].depthStorage; }
+    // [xobt@̒g (GetDepthBytesPerPixel oCg / sNZAsDBGPU ł DepthBuffer Ɠl)
+    const std::vector<uint8_t>& GetDepthStorage() const { return m_depthStorage; }
+    // (x, y) ̐[x float  (`Ȃ 1Areversed-Z Ȃ 0)
+    float GetDepth(uint32_t x, uint32_t y) const;
+    // G-buffer  target ̒g (GetGBufferBytesPerPixel oCg / sNZAsDBGPU ł̃eNX`ƓtH[}bgBOff Ȃ)
+    const std::vector<uint8_t>& GetGBufferStorage(GBufferTarget target) const { return m_gbuffer[static_cast<uint32_t>(target)]; }
+    // ߂ Render (A`GCAX) ̈kTv (GPU ł CoveragePixels / CoverageFragments ƓlBuint x 2 )
+    const std::vector<uint32_t>& GetCoveragePixels() const { return m_coveragePixels; }
+    const std::vector<uint32_t>& GetCoverageFragments() const { return m_coverageFragments; }
+    // c̃tOg̃obt@ɋl߂ (GPU ł RasterStats::coverageFragmentsBeʂ𒴂͂ӂꂽ)
+    uint32_t GetCoverageFragmentCount() const { return m_coverageFragmentCount; }
+    // kTṽobt@̃oCg (GPU ł GetCoverageBufferBytes Ɠ)
+    size_t GetCoverageBufferBytes() const { return (m_coveragePixels.size() + m_coverageFragments.size()) * sizeof(uint32_t); }
+
+    // ߂ Render Ń^C֐U蕪Op`̉א
+    size_t GetBinnedTriangleCount() const { return m_tileTriangles.size(); }
+    // ߂ Render ŃJ[obt@Ɛ[xobt@֏sNZ (t@XgNAŔ΂^C͐Ȃ)
+    // [x̏݃oCg͂ GetDepthBytesPerPixel |
+    size_t GetWrittenPixelCount() const { return m_writtenPixelCount; }
+    // ߂ Render œh^C (VU[`ƏdȂȂ^C͐ȂBGPU ł GetDispatchedTileCount)
+    size_t GetRasterizedTileCount() const { return m_rasterizedTileCount; }
+
+    // ߂ Render ̓v (GPU ł RasterStats ƓӖ)
+    uint64_t GetDepthPassFragments() const { return m_depthPassFragments; }
+    uint64_t GetShadedFragments() const { return m_shadedFragments; }
+    uint64_t GetCoveredPixels() const { return m_coveredPixels; }
+    uint64_t GetSharedShadedPixels() const { return m_sharedShadedPixels; }
+    uint64_t GetTileLights() const { return m_tileLights; }
+    uint64_t GetOverflowedLightTiles() const { return m_overflowedLightTiles; }
+    // ߂ RenderLines ̓v
+    size_t GetBinnedLineCount() const { return m_tileLines.size(); }    // ^C֐U蕪̉א
+    uint64_t GetLineFragments() const { return m_lineFragments; }       // [xeXgʂďsNZ
+
+    // h^C̃Xg̃Cg
+    float GetAverageTileLights() const { return m_rasterizedTileCount > 0 ? static_cast<float>(m_tileLights) / m_rasterizedTileCount : 0.0f; }
+    // hꂽsNẐAσ[gVF[fBOœh炸ɍς񂾊
+    float GetShadingRateSavings() const { return m_coveredPixels > 0 ? static_cast<float>(m_sharedShadedPixels) / m_coveredPixels : 0.0f; }
+    // d˕` (1pXœh / hꂽsNZ)
+    float GetOverdraw() const { return m_coveredPixels > 0 ? static_cast<float>(m_depthPassFragments) / m_coveredPixels : 0.0f; }
+
+    // ^C̃NAtO (true Ȃ炻̃^C̓NAJ[Ɛ[x 1 ̂܂)
+    uint32_t GetTileCountX() const { return m_tilesX; }
+    uint32_t GetTileCountY() const { return m_tilesY; }
+    bool IsTileCleared(uint32_t tileX, uint32_t tileY) const { return m_tileCleared[tileY * m_tilesX + tileX] != 0; }
+
+    // J[obt@ dest (rowPitch oCgƂ̍s) ֎ʂBNAꂽ^C͓ǂ܂ɃNAJ[Ŗ߂
+    void ResolveColor(uint32_t* dest, size_t rowPitch) const;
+
+private:
+    // XN[WɕϊOp` (Render ̍ŏ1񂾂)
+    struct TriangleSetup {
+        DirectX::XMFLOAT3 edges[3];     // ʐςŊGbW֐̌W (w_i = x * a + y * b + c dSW)
+        DirectX::XMFLOAT3 coverageBias; // w_i + coverageBias_i >= 0 Ȃ (ێIX^CYŕӂ炷ʁBʏ 0)
+        DirectX::XMFLOAT3 invW;         // 1 / W
+        DirectX::XMFLOAT3 depthOverW;   // clip.z / W
+        DirectX::XMFLOAT4 colorOverW[3];
+        DirectX::XMFLOAT2 uvOverW[3];
+        uint32_t minX, minY, maxX, maxY; // ʓɐ؂l߂sNZ͈̔
+        uint32_t index;                  // ̎Op`̔ԍ (G-buffer  ID)
+    };
+
+    // XN[Wɕϊ (RenderLines ̍ŏ1񂾂BJʂ̎OŐ؂Ă)
+    struct LineSetup {
+        DirectX::XMFLOAT2 screen[2];
+        float depth[2];                     // clip.z / W (XN[Ő`)
+        float invW[2];                      // 1 / W
+        DirectX::XMFLOAT4 colorOverW[2];
+        bool xMajor;                        // |dx| >= |dy| Ȃ x 1sNZi߂
+        float halfSpan;                     // 厲1œh镛̔̕ ( 1 ȉȂ 0)
+        uint32_t minX, minY, maxX, maxY;    // ʓɐ؂l߂sNZ͈̔ (܂)
+    };
+
+    // JobW}XÑA`GCAX̃sNZƂ̏ (GPU ł s_SampleDepth / s_Fragment*)
+    struct CoveragePixel {
+        float depth[c_MaxCoverageSamples];
+        DirectX::XMFLOAT4 color[c_MaxCoverageSamples];  // tOg̐F
+        uint32_t mask[c_MaxCoverageSamples];            // tOgĂTv
+        uint32_t fragmentCount;
+        bool covered;                                   // 1ȏ̃Tvhꂽ
+    };
+
+    // RenderMultiView ̃r[Ƃ̎Op`Əo͐ (`Ԃ m_triangles ȂǂƓւ)
+    struct ViewTarget {
+        std::vector<TriangleSetup> triangles;
+        std::vector<uint32_t> color;
+        std::vector<uint8_t> depthStorage;
+        std::vector<uint8_t> tileCleared;
+    };
+
+    // ^C̃J[l̓v (XbhƂɑĂARasterizeTiles  m_depthPassFragments Ȃǂւ܂Ƃ߂)
+    struct TileStats {
+        uint64_t depthPassFragments = 0;
+        uint64_t shadedFragments = 0;
+        uint64_t coveredPixels = 0;
+        uint64_t sharedShadedPixels = 0;
+        uint64_t tileLights = 0;
+        uint64_t overflowedLightTiles = 0;
+        size_t writtenPixels = 0;
+    };
+
+    // ^Cɓ͂Cg (GPU ł gs_TileLightsBcount  c_MaxTileLights 𒴂邱ƂA͓ĂȂ)
+    struct TileLightList {
+        uint32_t count;
+        uint32_t lights[c_MaxTileLights];
+    };
+
+    // v  worldViewProj ŕϊăXN[W̎Op` (JOꂽʊOȂ false)
+    bool SetupTriangle(const Vertex* const v[3], DirectX::FXMMATRIX worldViewProj, CullMode cullMode, TriangleSetup& setup) const;
+    void SetupTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, CullMode cullMode);
+    void BinTriangles();
+    void SetupLines(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, float width);
+    // ꂪʂ^C֐U蕪 (sƂɐʂ x ͈̔͂BBinTriangles Ɠ^C̏Ԃۂ)
+    void BinLines();
+    // 1^C̐̃J[l (ʂ̃^CƕsɌĂׂBNAꂽ܂܂̃^C͐ɃNAJ[Ɛ[xŖ߂)
+    void RasterizeLineTile(uint32_t tileX, uint32_t tileY, const LineDesc& desc, uint64_t& fragments);
+    // S^C state ̃J[lœh (BinTriangles ̌BantiAlias  Off łȂ΃JobW}XÑJ[lœhĉ)
+    void RasterizeTiles(const RasterState& state, AntiAliasMode antiAlias);
+
+    // Op`̏dSW (w0, w1, w2) ̈ʒu̐F (_J[ x eNX`BtileLights ΂̃CgŏƂ炷)
+    // footprint ͓h͈͂1ӂ̃sNZ (σ[gVF[fBÕubNBUV ̔Ɋ|ă~bvI)
+    template <uint32_t Permutation>
+    DirectX::XMVECTOR XM_CALLCONV ShadeTriangle(const TriangleSetup& triangle, float w0, float w1, float w2, float footprint = 1.0f,
+                                                const TileLightList* tileLights = nullptr) const;
+    // Op`̃p[XyNeBu␳dSW weights ̈ʒu ([JW)Bnormal ΂̈ʒu̖@ ([JWBKȂBGPU ł SurfaceNormal)
+    // _ m_vertices ǂݒ̂ŁA`ĂԂg
+    DirectX::XMVECTOR XM_CALLCONV LoadSurface(const TriangleSetup& triangle, DirectX::FXMVECTOR weights, DirectX::XMVECTOR* normal) const;
+    // ^C (x0, y0) - (x1, y1) ([܂) ̐[x͈̔ [depthMin, depthMax] ɓ͂CgW߂ (GPU ł CullTileLights)
+    void CullTileLights(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, float depthMin, float depthMax, TileLightList& tileLights) const;
+    // [JW position  normal  albedo  tileLights ̃CgŏƂ炷 (GPU ł ShadeTileLights)
+    DirectX::XMVECTOR XM_CALLCONV ShadeTileLights(DirectX::FXMVECTOR albedo, DirectX::FXMVECTOR position, DirectX::FXMVECTOR normal,
+                                                  const TileLightList& tileLights) const;
+    // ShadingRateMode::Auto ̃[gO Render ̃J[obt@猈߂ (GPU ł CSShadingRateFromColor)
+    void UpdateShadingRatesFromColor();
+
+    // 1^C̃J[l (TileSizeIndex = c_TileSizes ̔ԍ, Permutation = GetRasterPermutation ̔ԍ)
+    // ʂ̃^CƕsɌĂׂ (ނ̂̓^C̃sNZ stats )
+    template <uint32_t TileSizeIndex, uint32_t Permutation>
+    void RasterizeTile(uint32_t tileX, uint32_t tileY, TileStats& stats);
+    // JobW}XÑA`GCAX 1^C̃J[l (^C̑傫ƃTv͎sɌ߂)
+    // Ɨp m_coverageTile ƁA^C̏Ɋ蓖Ăc̃tOgĝŕsɂ͌ĂׂȂ
+    template <uint32_t Permutation>
+    void RasterizeTileCoverage(uint32_t tileX, uint32_t tileY, TileStats& stats);
+    // kTvJ[obt@։ (GPU ł CSResolveCoverage)
+    void ResolveCoverage();
+    // sNZ (x, y) ɌĂOp` triangle (m_triangles ̔ԍBc_GBufferNoTriangle Ȃwi)  G-buffer  (GPU ł WriteGBuffer)
+    void XM_CALLCONV WriteGBuffer(uint32_t x, uint32_t y, uint32_t triangle, DirectX::FXMVECTOR albedo);
+
+    // ^C (x0, y0) - (x1, y1) ([܂) ƃVU[`̊֌W (Inside 1̋`Ɏ܂B`ȂΏ Inside)
+    enum class ScissorCoverage { Outside, Partial, Inside };
+    ScissorCoverage GetScissorCoverage(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) const;
+    // (x, y) ꂩ̃VU[`̒ (GPU ł IsInsideScissor)
+    bool IsInsideScissor(uint32_t x, uint32_t y) const;
+
+    using TileFunction = void (SoftwareRasterizer::*)(uint32_t, uint32_t, TileStats&);
+
+    // [^C̑傫 * c_RasterPermutationCount + gݍ킹] ̃J[l̕\
+    template <size_t... Kernels>
+    static constexpr std::array<TileFunction, sizeof...(Kernels)> MakeTileFunctions(std::index_sequence<Kernels...>)
+    {
+        return { { &SoftwareRasterizer::RasterizeTile<Kernels / c_RasterPermutationCount, Kernels % c_RasterPermutationCount>... } };
+    }
+
+    // [gݍ킹] ̃JobW}XÑJ[l̕\
+    template <size_t... Kernels>
+    static constexpr std::array<TileFunction, sizeof...(Kernels)> MakeCoverageTileFunctions(std::index_sequence<Kernels...>)
+    {
+        return { { &SoftwareRasterizer::RasterizeTileCoverage<Kernels>... } };
+    }
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_tileSizeIndex = c_DefaultTileSize;
+    uint32_t m_binnedTileSizeIndex = c_DefaultTileSize;     // m_tilesX / m_tilesY / m_tileCleared ̕т̃^C̑傫 (߂̐U蕪)
+    uint32_t m_tilesX = 0;
+    uint32_t m_tilesY = 0;
+    DirectX::XMFLOAT4X4 m_worldViewProj = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    const SoftwareTexture* m_texture = nullptr;
+    RasterState m_rasterState;
+    DirectX::XMFLOAT4 m_clearColor = { 0.1f, 0.1f, 0.15f, 1.0f };
+    bool m_fastClear = true;
+    ConservativeMode m_conservativeMode = ConservativeMode::Off;
+    AntiAliasMode m_antiAliasMode = AntiAliasMode::Off;
+    DepthBufferDesc m_depthBufferDesc;
+    DepthPrepassMode m_depthPrepassMode = DepthPrepassMode::Off;
+    bool m_depthPrepassActive = false;
+    ShadingRateMode m_shadingRateMode = ShadingRateMode::Off;
+    bool m_variableRateActive = false;
+    std::vector<ShadingRate> m_shadingRates;   // [g̃^C (GetShadingRateTileCount)
+    ScissorRect m_scissorRects[c_MaxScissorRects] = {};
+    uint32_t m_scissorRectCount = 0;
+    bool m_scissorActive = false;               // `ĂԂ (RenderMultiView ł false)
+    GBufferDesc m_gbufferDesc;
+    bool m_gbufferActive = false;               // ߂ Render (ς G-buffer ̌Â^C)
+    bool m_gbufferWriting = false;              // `ĂԂ (RenderMultiView ł false)
+    std::vector<uint8_t> m_gbuffer[c_GBufferTargetCount];
+    const std::vector<DirectX::XMFLOAT3>* m_vertexNormals = nullptr;
+    DirectX::XMFLOAT4X4 m_world = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    DirectX::XMFLOAT4X4 m_normalWorld = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };   // World ̋t]u
+    DirectX::XMFLOAT4X4 m_previousWorldViewProj = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    bool m_previousTransformValid = false;      // false ȂÕt[̕ϊƂ݂Ȃ (Ȃ)
+    DirectX::XMFLOAT4 m_viewOrigin = {};        // [JWł̃Jʒu (w = 0 Ȃ畽se̎BGPU ł ViewOrigin)
+    const std::vector<Vertex>* m_vertices = nullptr;    // `ĂԂ (WriteGBuffer  LoadSurface Op`ǂݒ)
+    const std::vector<uint32_t>* m_indices = nullptr;
+    std::vector<PointLight> m_lights;
+    DirectX::XMFLOAT3 m_ambientLight = { 0.0f, 0.0f, 0.0f };
+    bool m_lightingActive = false;              // ߂ Render (RenderMultiView ł false)
+    DirectX::XMFLOAT4X4 m_lightViewProj = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };  // World -> Clip (World ̋ts x SetTransform)
+    uint32_t m_threadCount = 1;
+
+    std::vector<TriangleSetup> m_triangles;
+    std::vector<uint32_t> m_tileTriangleOffsets;    // ^CƂ̃Xg̐擪 (m_tilesX * m_tilesY + 1)
+    std::vector<uint32_t> m_tileTriangles;
+
+    std::vector<LineSetup> m_lines;
+    std::vector<uint32_t> m_tileLineOffsets;        // ^CƂ̐̃Xg̐擪 (m_tilesX * m_tilesY + 1)
+    std::vector<uint32_t> m_tileLines;
+    uint64_t m_lineFragments = 0;
+
+    std::vector<uint32_t> m_color;
+    std::vector<uint8_t> m_depthStorage;
+    std::vector<uint8_t> m_tileCleared;     // ^CƂ̃NAtO (m_binnedTileSizeIndex ̕сB Render Ń^C̑傫ςĂ 0 ɖ߂)
+    size_t m_writtenPixelCount = 0;
+    size_t m_rasterizedTileCount = 0;
+    uint64_t m_depthPassFragments = 0;
+    uint64_t m_shadedFragments = 0;
+    uint64_t m_coveredPixels = 0;
+    uint64_t m_sharedShadedPixels = 0;
+    uint64_t m_tileLights = 0;
+    uint64_t m_overflowedLightTiles = 0;
+
+    std::vector<CoveragePixel> m_coverageTile;  // RasterizeTileCoverage ̍Ɨp (^C̃sNZ)
+    std::vector<uint32_t> m_coveragePixels;
+    std::vector<uint32_t> m_coverageFragments;
+    uint32_t m_coverageFragmentCount = 0;
+
+    std::vector<ViewTarget> m_views;
+    std::vector<float> m_shadowDepth;   // RenderShadowMap ̍Ɨp (ۂ߂[x float )
+};
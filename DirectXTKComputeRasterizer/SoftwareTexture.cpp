@@ -0,0 +1,330 @@
+#include "SoftwareTexture.h"
+#include "DebugOutput.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using namespace DirectX;
+
+namespace
+{
+    // 16bit ̒l̃rbg1ɍL (2 Morton p)
+    uint32_t SpreadBits(uint32_t v)
+    {
+        v &= 0x0000FFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+
+    uint32_t CeilLog2(uint32_t v)
+    {
+        uint32_t bits = 0;
+        while ((1u << bits) < v)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+}
+
+SoftwareTexture::MipLevel SoftwareTexture::MakeLevel(TextureLayout layout, uint32_t width, uint32_t height, size_t offset, size_t& texelCount)
+{
+    MipLevel mip = { width, height, offset, 0, 0, false };
+    switch (layout)
+    {
+    case TextureLayout::Tiled:
+        // [̃^C 4 ̔{ɐ؂グĊmۂ
+        mip.tilesX = (width + 3) / 4;
+        texelCount = static_cast<size_t>(mip.tilesX) * ((height + 3) / 4) * 16;
+        break;
+
+    case TextureLayout::Morton:
+    {
+        const uint32_t bitsX = CeilLog2(width);
+        const uint32_t bitsY = CeilLog2(height);
+        mip.mortonBits = std::min(bitsX, bitsY);
+        mip.mortonWide = bitsX > bitsY;
+        texelCount = static_cast<size_t>(1) << (bitsX + bitsY);
+        break;
+    }
+
+    default:
+        texelCount = static_cast<size_t>(width) * height;
+        break;
+    }
+    return mip;
+}
+
+size_t SoftwareTexture::TexelOffset(const MipLevel& mip, uint32_t x, uint32_t y) const
+{
+    switch (m_layout)
+    {
+    case TextureLayout::Tiled:
+        return mip.offset + (static_cast<size_t>(y >> 2) * mip.tilesX + (x >> 2)) * 16 + (y & 3) * 4 + (x & 3);
+
+    case TextureLayout::Morton:
+    {
+        // Z̕ӂ܂ł x  y ݂ɁAc͒̍W̏ʃrbgׂ
+        const uint32_t mask = (1u << mip.mortonBits) - 1;
+        const uint32_t upper = (mip.mortonWide ? x : y) >> mip.mortonBits;
+        return mip.offset + ((static_cast<size_t>(upper) << (2 * mip.mortonBits)) |
+                             SpreadBits(x & mask) | (SpreadBits(y & mask) << 1));
+    }
+
+    default:
+        return mip.offset + static_cast<size_t>(y) * mip.width + x;
+    }
+}
+
+const void* SoftwareTexture::Fetch(uint32_t level, uint32_t x, uint32_t y, uint32_t& value) const
+{
+    const MipLevel& mip = m_levels[level];
+    if (m_format == TextureFormat::R8G8B8A8)
+    {
+        const uint32_t* texel = m_texels.data() + TexelOffset(mip, x, y);
+        value = *texel;
+        return texel;
+    }
+
+    // ^C̗אڃsNZ͓ubNǂނ̂ŁAfR[hʂg
+    const uint32_t blockX = x / c_BlockSize;
+    const uint32_t blockY = y / c_BlockSize;
+    const size_t block = mip.offset + static_cast<size_t>(blockY) * mip.tilesX + blockX;
+    const uint8_t* address = m_blocks.data() + block * GetBlockBytes(m_format);
+
+    DecodedBlock& entry = m_blockCache[((level & 1) << 8) | ((blockY & 15) << 4) | (blockX & 15)];
+    if (entry.block != block)
+    {
+        DecodeBlock(m_format, address, entry.texels);
+        entry.block = block;
+        ++m_blockDecodes;
+    }
+    value = entry.texels[(y % c_BlockSize) * c_BlockSize + x % c_BlockSize];
+    return address;
+}
+
+uint32_t SoftwareTexture::Load(uint32_t level, uint32_t x, uint32_t y) const
+{
+    uint32_t value;
+    Fetch(level, x, y, value);
+    return value;
+}
+
+void SoftwareTexture::Create(uint32_t width, uint32_t height, const uint32_t* rgba, size_t rowPitch, bool generateMips,
+                             TextureLayout layout)
+{
+    // ~bv`F[sDō (ex̕ƍ͐؂̂ĂŔAŏ 1)
+    std::vector<MipLevel> linearLevels;
+    size_t totalTexels = 0;
+    for (uint32_t w = width, h = height; ; w = std::max(1u, w / 2), h = std::max(1u, h / 2))
+    {
+        size_t texelCount = 0;
+        linearLevels.push_back(MakeLevel(TextureLayout::RowMajor, w, h, totalTexels, texelCount));
+        totalTexels += texelCount;
+        if (!generateMips || (w == 1 && h == 1))
+        {
+            break;
+        }
+    }
+    std::vector<uint32_t> linear(totalTexels);
+
+    // x 0
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        memcpy(linear.data() + static_cast<size_t>(y) * width,
+               reinterpret_cast<const uint8_t*>(rgba) + y * rowPitch, width * sizeof(uint32_t));
+    }
+
+    // 2x2 ̃{bNXtB^ŏk (TCY̒[͓eNZ2g)
+    for (size_t level = 1; level < linearLevels.size(); ++level)
+    {
+        const MipLevel& src = linearLevels[level - 1];
+        const MipLevel& dst = linearLevels[level];
+        const uint32_t* srcTexels = linear.data() + src.offset;
+        uint32_t* dstTexels = linear.data() + dst.offset;
+
+        for (uint32_t y = 0; y < dst.height; ++y)
+        {
+            const uint32_t y0 = std::min(y * 2, src.height - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+            for (uint32_t x = 0; x < dst.width; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, src.width - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+                const uint32_t quad[4] = {
+                    srcTexels[y0 * src.width + x0], srcTexels[y0 * src.width + x1],
+                    srcTexels[y1 * src.width + x0], srcTexels[y1 * src.width + x1],
+                };
+
+                uint32_t result = 0;
+                for (uint32_t shift = 0; shift < 32; shift += 8)
+                {
+                    uint32_t sum = 2; // ľܓ
+                    for (uint32_t texel : quad)
+                    {
+                        sum += (texel >> shift) & 0xFF;
+                    }
+                    result |= (sum / 4) << shift;
+                }
+                dstTexels[y * dst.width + x] = result;
+            }
+        }
+    }
+
+    m_format = TextureFormat::R8G8B8A8;
+    m_layout = layout;
+    m_blocks.clear();
+    m_blockCache.clear();
+    if (layout == TextureLayout::RowMajor)
+    {
+        m_levels = std::move(linearLevels);
+        m_texels = std::move(linear);
+        return;
+    }
+
+    // ǂݍݎ1񂾂בւ (pfBO 0)
+    m_levels.clear();
+    totalTexels = 0;
+    for (const MipLevel& src : linearLevels)
+    {
+        size_t texelCount = 0;
+        m_levels.push_back(MakeLevel(layout, src.width, src.height, totalTexels, texelCount));
+        totalTexels += texelCount;
+    }
+    m_texels.assign(totalTexels, 0);
+
+    for (size_t level = 0; level < m_levels.size(); ++level)
+    {
+        const MipLevel& src = linearLevels[level];
+        const MipLevel& dst = m_levels[level];
+        for (uint32_t y = 0; y < src.height; ++y)
+        {
+            const uint32_t* srcRow = linear.data() + src.offset + static_cast<size_t>(y) * src.width;
+            for (uint32_t x = 0; x < src.width; ++x)
+            {
+                m_texels[TexelOffset(dst, x, y)] = srcRow[x];
+            }
+        }
+    }
+}
+
+void SoftwareTexture::CreateCompressed(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipCount, const uint8_t* blocks)
+{
+    if (format == TextureFormat::R8G8B8A8)
+    {
+        DebugOutput("Failed to create compressed texture: format is not block-compressed\n");
+        throw std::runtime_error("Failed to create compressed texture: format is not block-compressed");
+    }
+
+    // 4x4 ̃ubN͂̂܂ Tiled ̃^CɂȂ
+    m_format = format;
+    m_layout = TextureLayout::Tiled;
+    m_levels.clear();
+    size_t totalBlocks = 0;
+    uint32_t w = width, h = height;
+    for (uint32_t level = 0; level < std::max(1u, mipCount); ++level)
+    {
+        size_t texelCount = 0;
+        m_levels.push_back(MakeLevel(TextureLayout::Tiled, w, h, totalBlocks, texelCount));
+        totalBlocks += texelCount / (c_BlockSize * c_BlockSize);
+        w = std::max(1u, w / 2);
+        h = std::max(1u, h / 2);
+    }
+
+    m_texels.clear();
+    m_blocks.assign(blocks, blocks + totalBlocks * GetBlockBytes(format));
+    m_blockCache.assign(c_BlockCacheSize, DecodedBlock{ SIZE_MAX, {} });
+    m_blockDecodes = 0;
+}
+
+float SoftwareTexture::CalculateLevelOfDetail(XMFLOAT2 ddx, XMFLOAT2 ddy) const
+{
+    const float width = static_cast<float>(m_levels[0].width);
+    const float height = static_cast<float>(m_levels[0].height);
+    const float dxu = ddx.x * width, dxv = ddx.y * height;
+    const float dyu = ddy.x * width, dyv = ddy.y * height;
+    const float rho2 = std::max(dxu * dxu + dxv * dxv, dyu * dyu + dyv * dyv);
+    return rho2 > 0.0f ? 0.5f * std::log2(rho2) : 0.0f;
+}
+
+void SoftwareTexture::AddBilinearTexels(uint32_t level, float u, float v, float weight, SampleFootprint& footprint) const
+{
+    const MipLevel& mip = m_levels[level];
+
+    // Wrap: eNZSɂȂ悤 0.5 炷
+    const float x = (u - std::floor(u)) * mip.width - 0.5f;
+    const float y = (v - std::floor(v)) * mip.height - 0.5f;
+    const float fx0 = std::floor(x);
+    const float fy0 = std::floor(y);
+    const float fx = x - fx0;
+    const float fy = y - fy0;
+
+    const uint32_t x0 = (static_cast<int32_t>(fx0) + mip.width) % mip.width;
+    const uint32_t y0 = (static_cast<int32_t>(fy0) + mip.height) % mip.height;
+    const uint32_t x1 = (x0 + 1) % mip.width;
+    const uint32_t y1 = (y0 + 1) % mip.height;
+
+    uint32_t n = footprint.count;
+    footprint.addresses[n + 0] = Fetch(level, x0, y0, footprint.values[n + 0]);
+    footprint.addresses[n + 1] = Fetch(level, x1, y0, footprint.values[n + 1]);
+    footprint.addresses[n + 2] = Fetch(level, x0, y1, footprint.values[n + 2]);
+    footprint.addresses[n + 3] = Fetch(level, x1, y1, footprint.values[n + 3]);
+    footprint.weights[n + 0] = weight * (1.0f - fx) * (1.0f - fy);
+    footprint.weights[n + 1] = weight * fx * (1.0f - fy);
+    footprint.weights[n + 2] = weight * (1.0f - fx) * fy;
+    footprint.weights[n + 3] = weight * fx * fy;
+    footprint.count = n + 4;
+}
+
+void SoftwareTexture::GetFootprint(XMFLOAT2 uv, float lod, SampleFootprint& footprint) const
+{
+    footprint.count = 0;
+
+    const float maxLod = static_cast<float>(m_levels.size() - 1);
+    lod = std::min(std::max(lod, 0.0f), maxLod);
+
+    const uint32_t level = static_cast<uint32_t>(lod);
+    const float blend = lod - level;
+    if (blend <= 0.0f || level + 1 >= m_levels.size())
+    {
+        AddBilinearTexels(level, uv.x, uv.y, 1.0f, footprint);
+    }
+    else
+    {
+        AddBilinearTexels(level, uv.x, uv.y, 1.0f - blend, footprint);
+        AddBilinearTexels(level + 1, uv.x, uv.y, blend, footprint);
+    }
+}
+
+XMFLOAT4 SoftwareTexture::Resolve(const SampleFootprint& footprint)
+{
+    float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+    for (uint32_t i = 0; i < footprint.count; ++i)
+    {
+        const uint32_t texel = footprint.values[i];
+        const float weight = footprint.weights[i];
+        r += weight * static_cast<float>(texel & 0xFF);
+        g += weight * static_cast<float>((texel >> 8) & 0xFF);
+        b += weight * static_cast<float>((texel >> 16) & 0xFF);
+        a += weight * static_cast<float>(texel >> 24);
+    }
+
+    const float scale = 1.0f / 255.0f;
+    return XMFLOAT4(r * scale, g * scale, b * scale, a * scale);
+}
+
+XMFLOAT4 SoftwareTexture::SampleLevel(XMFLOAT2 uv, float lod) const
+{
+    SampleFootprint footprint;
+    GetFootprint(uv, lod, footprint);
+    return Resolve(footprint);
+}
+
+XMFLOAT4 SoftwareTexture::SampleGrad(XMFLOAT2 uv, XMFLOAT2 ddx, XMFLOAT2 ddy) const
+{
+    return SampleLevel(uv, CalculateLevelOfDetail(ddx, ddy));
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#include "BlockCompression.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// ==================================================================================
+// CPU ł BaseTexture / BaseSampler (R8G8B8A8_UNORM, LinearWrap, ~bv}bv)
+// GPU ̃eNX`ƓA2ŋ߂eNZł߂Ȃ悤בւĎ (TextureLayout)B
+// BC1 / BC3 / BC7 ͈k܂܎ATvɃubNfR[hB
+// GPU ƓAUV ̉ʏ̔ LOD IсAאڂ2xgCjAŕԂB
+// ǂݍރeNZ̈ʒuƏd݂ SampleFootprint ƂĎôŁA
+// LbV⃁ш̃V~[VɂgB
+// ==================================================================================
+
+// eNZ̃̕ (Create ōsD̉摜ϊ)
+enum class TextureLayout {
+    RowMajor, // sD (c]ANZXŃLbVCg؂Ȃ)
+    Tiled,    // 4x4 eNZ (64byte = 1 LbVC) ̃^CsDɕׂ
+    Morton,   // eNZPʂ Z  (ƍ 2 ׂ̂ɐ؂グĊmۂ)
+};
+
+// 1̃TvœǂރeNZ (gCjAōő 2x x 4eNZ)
+struct SampleFootprint {
+    const void* addresses[8];   // ǂރ (keNX`ł̓ubN̐擪)
+    uint32_t values[8];
+    float weights[8];
+    uint32_t count;
+};
+
+class SoftwareTexture
+{
+public:
+    // rgba (width x height, s̊Ԋu rowPitch byte) ~bv`F[Alayout ̕тɕϊ
+    // generateMips  false Ȃ烌x 0 
+    void Create(uint32_t width, uint32_t height, const uint32_t* rgba, size_t rowPitch, bool generateMips = true,
+                TextureLayout layout = TextureLayout::Tiled);
+
+    // BC1 / BC3 / BC7 ̃ubN (DDS ƓAxƂɃubNsDŕׂ) ̂܂܎
+    // fR[hς݃ubÑLbV̂ŁAkeNX`̃Tv̓XbhƂɕʂ̃CX^Xōs
+    void CreateCompressed(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipCount, const uint8_t* blocks);
+
+    TextureFormat GetFormat() const { return m_format; }
+    TextureLayout GetLayout() const { return m_layout; }
+    uint32_t GetMipCount() const { return static_cast<uint32_t>(m_levels.size()); }
+    uint32_t GetWidth(uint32_t level = 0) const { return m_levels[level].width; }
+    uint32_t GetHeight(uint32_t level = 0) const { return m_levels[level].height; }
+    size_t GetSizeInBytes() const { return m_texels.size() * sizeof(uint32_t) + m_blocks.size(); }
+    uint64_t GetBlockDecodeCount() const { return m_blockDecodes; }
+
+    // (x, y) ̃eNZ (tB^Ȃ)
+    uint32_t Load(uint32_t level, uint32_t x, uint32_t y) const;
+
+    // D3D  CalculateLevelOfDetail Ɠ (x 0 ̃eNZPʂ̔̒ log2)
+    float CalculateLevelOfDetail(DirectX::XMFLOAT2 ddx, DirectX::XMFLOAT2 ddy) const;
+
+    DirectX::XMFLOAT4 SampleLevel(DirectX::XMFLOAT2 uv, float lod) const;
+    DirectX::XMFLOAT4 SampleGrad(DirectX::XMFLOAT2 uv, DirectX::XMFLOAT2 ddx, DirectX::XMFLOAT2 ddy) const;
+
+    // SampleLevel ǂރeNZƏd
+    void GetFootprint(DirectX::XMFLOAT2 uv, float lod, SampleFootprint& footprint) const;
+
+    static DirectX::XMFLOAT4 Resolve(const SampleFootprint& footprint);
+
+private:
+    struct MipLevel {
+        uint32_t width;
+        uint32_t height;
+        size_t offset;          // m_texels ̐擪 (keNX`ł m_blocks ̃ubNԍ)
+        uint32_t tilesX;        // Tiled: ̃^C (keNX`ł̓ubN)
+        uint32_t mortonBits;    // Morton: ƍ̃rbg̏ (͒̍W̃rbĝ܂ܕׂ)
+        bool mortonWide;        // Morton: ̕
+    };
+
+    static MipLevel MakeLevel(TextureLayout layout, uint32_t width, uint32_t height, size_t offset, size_t& texelCount);
+    size_t TexelOffset(const MipLevel& mip, uint32_t x, uint32_t y) const;
+    const void* Fetch(uint32_t level, uint32_t x, uint32_t y, uint32_t& value) const;
+
+    void AddBilinearTexels(uint32_t level, float u, float v, float weight, SampleFootprint& footprint) const;
+
+    // fR[hς݃ubÑLbV (ubNW̉ 4bit ƃx̋Ō܂_CNg}bv)
+    struct DecodedBlock {
+        size_t block;   // m_blocks ̃ubNԍ (SIZE_MAX ͋)
+        uint32_t texels[16];
+    };
+    static constexpr uint32_t c_BlockCacheSize = 512;
+
+    TextureFormat m_format = TextureFormat::R8G8B8A8;
+    TextureLayout m_layout = TextureLayout::RowMajor;
+    std::vector<MipLevel> m_levels;
+    std::vector<uint32_t> m_texels;
+    std::vector<uint8_t> m_blocks;
+    mutable std::vector<DecodedBlock> m_blockCache;
+    mutable uint64_t m_blockDecodes = 0;
+};
\ No newline at end of file
@@ -2,148 +2,1524 @@
 // TriangleRasterizer.hlsl
 // ==================================================================================
 
+#include "RasterizerCommon.hlsli"
+
+// --- pCvC̓ꉻ (C++  RasterStateBDirectXTKComputeRasterizer::GetRasterShader `ăRpC) ---
+
+#define RASTER_CULL_NONE  0 // CullMode ƈv邱
+#define RASTER_CULL_BACK  1
+#define RASTER_CULL_FRONT 2
+
+#ifndef RASTER_TEXTURED
+#define RASTER_TEXTURED 1       // 0 ȂeNX` (}eA) ǂ܂Ȃ
+#endif
+#ifndef RASTER_VERTEX_COLOR
+#define RASTER_VERTEX_COLOR 1   // 0 Ȃ璸_J[ԂȂ ()
+#endif
+#ifndef RASTER_DEPTH_TEST
+#define RASTER_DEPTH_TEST 1     // 0 Ȃ[xrA̎Op`ŏ㏑
+#endif
+#ifndef RASTER_CULL_MODE
+#define RASTER_CULL_MODE RASTER_CULL_BACK
+#endif
+#ifndef RASTER_BLEND
+#define RASTER_BLEND 0          // 1 Ȃ src.a ōA[x͏Ȃ
+#endif
+#ifndef RASTER_DEPTH_PREPASS
+#define RASTER_DEPTH_PREPASS 0  // 1 Ȃ[x̃pX̌A[xvOp`h
+#endif
+
+#if RASTER_DEPTH_PREPASS && (!RASTER_DEPTH_TEST || RASTER_BLEND)
+#error RASTER_DEPTH_PREPASS requires RASTER_DEPTH_TEST and opaque blending
+#endif
+
+// JobW}XÑA`GCAX̃Tv (1 ȂgȂBC++  AntiAliasMode)
+#ifndef RASTER_SAMPLES
+#define RASTER_SAMPLES 1
+#endif
+
+#if RASTER_SAMPLES != 1 && RASTER_SAMPLES != 4 && RASTER_SAMPLES != 8
+#error RASTER_SAMPLES must be 1, 4 or 8
+#endif
+#if RASTER_SAMPLES > 1 && RASTER_DEPTH_PREPASS
+#error RASTER_SAMPLES does not support RASTER_DEPTH_PREPASS
+#endif
+
+// σ[gVF[fBO (C++  ShadingRateMode)B1 Ȃ[x̃pXŌOp`߂ĂA
+// ShadingRates ̃[g̃ubNƂ1񂾂h ([xvpX˂)
+#ifndef RASTER_VRS
+#define RASTER_VRS 0
+#endif
+
+#if RASTER_VRS && (!RASTER_DEPTH_TEST || RASTER_BLEND || RASTER_DEPTH_PREPASS || RASTER_SAMPLES > 1)
+#error RASTER_VRS requires RASTER_DEPTH_TEST and opaque blending without RASTER_DEPTH_PREPASS or RASTER_SAMPLES
+#endif
+
+// G-buffer (C++  GBufferDesc)B1 Ȃ OutputTexture  DepthBuffer ɉāAĂOp`
+// AxhA@AIDAxNg GBuffer* ֏ (ǂƃtH[}bg GBufferConstants)
+#ifndef RASTER_GBUFFER
+#define RASTER_GBUFFER 0
+#endif
+
+#if RASTER_GBUFFER && (!RASTER_DEPTH_TEST || RASTER_BLEND || RASTER_SAMPLES > 1)
+#error RASTER_GBUFFER requires RASTER_DEPTH_TEST and opaque blending without RASTER_SAMPLES
+#endif
+
+// ^CPʂ̃CgJO (C++  SetLights)B1 Ȃ[x̃pX̌Ƀ^C̐[x͈̔͂Ǝ
+// Lights ͂̂IсAShadeTriangle ̓^C̃Xg̃CgŏƂ炷
+#ifndef RASTER_LIGHTING
+#define RASTER_LIGHTING 0
+#endif
+
+#if RASTER_LIGHTING && (!(RASTER_DEPTH_PREPASS || RASTER_VRS) || RASTER_GBUFFER)
+#error RASTER_LIGHTING requires RASTER_DEPTH_PREPASS or RASTER_VRS without RASTER_GBUFFER
+#endif
+
+#define RASTER_CONSERVATIVE_OFF   0 // ConservativeMode ƈv邱
+#define RASTER_CONSERVATIVE_OVER  1 // sNZɏłΓh
+#define RASTER_CONSERVATIVE_UNDER 2 // sNZŜ̂Ƃh
+
+#ifndef RASTER_CONSERVATIVE
+#define RASTER_CONSERVATIVE RASTER_CONSERVATIVE_OFF
+#endif
+
+// }`r[ (CSMainMultiView) ̃r[ (C++  c_MaxViews ܂)
+#define MAX_VIEWS 6
+#ifndef MULTI_VIEW_COUNT
+#define MULTI_VIEW_COUNT 1
+#endif
+
+// RasterizeTriangle ̃pX
+#define RASTER_PASS_FULL  0 // [xeXgʂh (1pX)
+#define RASTER_PASS_DEPTH 1 // [xXV (̕ԂƃeNX`ǂ܂Ȃ)
+#define RASTER_PASS_SHADE 2 // RASTER_PASS_DEPTH Ō߂[xƈvŏ̎Op`h
+
+// --- [xobt@ (C++  DepthBufferDesc) ---
+
+#define DEPTH_FORMAT_D32_FLOAT    0 // DepthFormat ƈv邱
+#define DEPTH_FORMAT_D24_UNORM_S8 1
+#define DEPTH_FORMAT_D16_UNORM    2
+
+#ifndef DEPTH_FORMAT
+#define DEPTH_FORMAT DEPTH_FORMAT_D32_FLOAT
+#endif
+#ifndef DEPTH_REVERSED
+#define DEPTH_REVERSED 0        // 1 ȂO = 1A = 0 (傫O)
+#endif
+
+#if DEPTH_REVERSED
+#define DEPTH_CLEAR 0.0f
+#define DEPTH_CLOSER(a, b) ((a) > (b))
+#else
+#define DEPTH_CLEAR 1.0f
+#define DEPTH_CLOSER(a, b) ((a) < (b))
+#endif
+
 // --- \[X` ---
 
 // o͐: obNobt@֓]邽߂̃eNX`
 RWTexture2D<float4> OutputTexture : register(u0);
 
-// : _f[^ (StructuredBuffer)
-struct Vertex {
-    float3 pos;   // [JW
-    float4 color; // _J[
-    float2 uv;    // UVW
+// ^CƂ̃NAtO (1 Ȃ炻̃^C OutputTexture ̓NAJ[̂܂܁BTileClearFlagIndex ň)
+RWStructuredBuffer<uint> TileClearFlags : register(u1);
+
+// `̓v (C++  RasterStats ƓсBDepthPrepassMode::Auto ̔fɎg)
+RWByteAddressBuffer RasterStats : register(u3);
+
+#define RASTER_STATS_DEPTH_PASS_FRAGMENTS 0 // [xeXgʂ (1pXœh)
+#define RASTER_STATS_SHADED_FRAGMENTS     4 // ۂɓh
+#define RASTER_STATS_COVERED_PIXELS       8 // 1ȏhꂽsNZ
+#define RASTER_STATS_COVERAGE_FRAGMENTS   12 // CoverageFragments ɋl߂tOg (RASTER_SAMPLES > 1 ̂ƂBc̐擪̊蓖ĂɎg)
+#define RASTER_STATS_SHARED_SHADES        16 // ubN̑̃sNZ̐Fg (h炸ɍς) sNZ (RASTER_VRS ̂Ƃ)
+#define RASTER_STATS_TILE_LIGHTS          20 // ^C̃Cg̃XgɓCg̉א (RASTER_LIGHTING ̂Ƃ)
+#define RASTER_STATS_OVERFLOWED_LIGHT_TILES 24 // Cg MAX_TILE_LIGHTS 𒴂^C (RASTER_LIGHTING ̂Ƃ)
+
+// o͐: [xobt@ (DEPTH_FORMAT ̃tH[}bg)
+#if DEPTH_FORMAT == DEPTH_FORMAT_D24_UNORM_S8
+#define DEPTH_STORAGE uint
+#elif DEPTH_FORMAT == DEPTH_FORMAT_D16_UNORM
+#define DEPTH_STORAGE unorm float
+#else
+#define DEPTH_STORAGE float
+#endif
+RWTexture2D<DEPTH_STORAGE> DepthBuffer : register(u2);
+
+#if RASTER_GBUFFER
+// G-buffer ̏o͐ (RASTER_GBUFFER ̂ƂB}`r[ƃA`GCAXƂ͕pȂ̂ u4 ~ u7 g)
+// tH[}bg GBuffer*Format (GBUFFER_FORMAT_*) ɍ킹 C++ ōBGBUFFER_FORMAT_OFF ̃^[Qbg͏Ȃ
+RWTexture2D<float4> GBufferAlbedo : register(u4); // FULL: R16G16B16A16_FLOAT, PACKED: R8G8B8A8_UNORM
+RWTexture2D<float4> GBufferNormal : register(u5); // FULL: R16G16B16A16_FLOAT (xyz), PACKED: R16G16_UNORM (ʑ)
+RWTexture2D<uint2> GBufferId : register(u6);      // FULL: R32G32_UINT (Op`, }eA), PACKED: R32_UINT
+RWTexture2D<float2> GBufferMotion : register(u7); // FULL: R32G32_FLOAT, PACKED: R16G16_FLOAT
+#else
+// }`r[̏o͐ (XCX = r[)
+RWTexture2DArray<float4> MultiViewOutput : register(u4);
+RWTexture2DArray<DEPTH_STORAGE> MultiViewDepth : register(u5);
+
+// JobW}XÑA`GCAẌkTv (RASTER_SAMPLES > 1 ̂ƂBCSResolveCoverage  OutputTexture ։)
+// CoveragePixels ̓sNZƂ (ŏ̃tOg̐F, }XN | c̃tOg << COVERAGE_COUNT_SHIFT | c̐擪 << COVERAGE_OFFSET_SHIFT)
+// CoverageFragments ͎c̃tOg (F, }XN)BF R8G8B8A8 (R ʃoCg)
+RWStructuredBuffer<uint2> CoveragePixels : register(u6);
+RWStructuredBuffer<uint2> CoverageFragments : register(u7);
+#endif
+
+#define COVERAGE_MASK_BITS    0xFF // C++  c_Coverage* ƈv邱
+#define COVERAGE_COUNT_SHIFT  8
+#define COVERAGE_OFFSET_SHIFT 11
+
+// σ[gVF[fBÕ[g (RASTER_VRS ̂ƂBSHADING_RATE_TILE_SIZE sNZl̃^CƂ ShadingRate)
+StructuredBuffer<uint> ShadingRates : register(t11);
+
+#define SHADING_RATE_TILE_SIZE 16 // C++  c_ShadingRateTileSize ƈv邱
+#define NO_TRIANGLE 0xFFFFFFFF // ĂOp`Ȃ (wiBC++  c_GBufferNoTriangle ƈv邱)
+
+// VU[` (ScissorRectCount > 0 ̂ƂBCSMain  CSResolveCoverage ͋`̊ÕsNZȂ)
+// CSMain ͋`ƏdȂ^C ScissorTiles ɕׂ Dispatch  (O[v (x, y)  y * ScissorDispatchWidth + x Ԗ)
+#define MAX_SCISSOR_RECTS 8 // C++  c_MaxScissorRects ƈv邱
+cbuffer ScissorConstants : register(b2)
+{
+    uint ScissorTileCount;
+    uint ScissorDispatchWidth;
+    uint2 ScissorPadding;
+    uint4 ScissorRects[MAX_SCISSOR_RECTS]; // (left, top, right, bottom)Bright / bottom ͊܂܂ȂBʓɐ؂lߍς
 };
+StructuredBuffer<uint> ScissorTiles : register(t12); // ^C (x | y << 16)
+
+// G-buffer ̒萔 (RASTER_GBUFFER ̂Ƃ)
+#define GBUFFER_FORMAT_OFF    0 // GBufferFormat ƈv邱
+#define GBUFFER_FORMAT_FULL   1
+#define GBUFFER_FORMAT_PACKED 2
+#define GBUFFER_PACKED_TRIANGLE_MASK   0xFFFFFF // C++  c_GBufferPacked* ƈv邱
+#define GBUFFER_PACKED_MATERIAL_SHIFT  24
+cbuffer GBufferConstants : register(b3)
+{
+    matrix PreviousWorldViewProj; // Õt[ Local -> Clip s (xNg)
+    matrix NormalWorld;           // Local -> World ̖@̕ϊ (World ̋t]u)
+    uint GBufferAlbedoFormat;     // GBUFFER_FORMAT_*
+    uint GBufferNormalFormat;
+    uint GBufferIdFormat;
+    uint GBufferMotionFormat;
+    uint InterpolatedNormals;     // 1 Ȃ VertexNormals Ԃ (0 Ȃʂ̖@)
+    uint3 GBufferPadding;
+};
+StructuredBuffer<float3> VertexNormals : register(t13); // _Ƃ̖@ ([JWBVertexBuffer Ɠ)
+
+// ^CPʂ̃CgJO̒萔ƃCg (RASTER_LIGHTING ̂ƂB@ VertexNormals L)
+#define MAX_TILE_LIGHTS 256 // 1^C̃Cg̃Xg̗e (C++  c_MaxTileLights ƈv邱)
+struct PointLight {
+    float3 position;    // [hW
+    float radius;       // ͂ (LightFalloff  0 ɂȂ)
+    float3 color;
+    float intensity;
+};
+cbuffer LightConstants : register(b4)
+{
+    matrix LightWorld;            // Local -> World s
+    matrix LightNormalWorld;      // Local -> World ̖@̕ϊ (World ̋t]u)
+    matrix LightViewProj;         // World -> Clip s (^C̎[hW֖߂)
+    float3 AmbientColor;          // ǂ̃Cg͂Ȃʂ̖邳
+    uint LightCount;
+    uint LightInterpolatedNormals; // 1 Ȃ VertexNormals Ԃ (0 Ȃʂ̖@)
+    uint3 LightPadding;
+};
+StructuredBuffer<PointLight> Lights : register(t14);
+
+// }`r[̃r[Ƃ Local -> Clip s
+cbuffer MultiViewConstants : register(b1)
+{
+    matrix ViewWorldViewProj[MAX_VIEWS];
+};
+
+// : _f[^ (StructuredBuffer)
 StructuredBuffer<Vertex> VertexBuffer : register(t0);
 
 // : eNX`ƃTv[
 Texture2D<float4> BaseTexture : register(t1);
 SamplerState BaseSampler : register(s0);
 
-// 萔obt@: sƉʏ
-cbuffer ConstantBuffer : register(b0)
+// : bVbgƁAMeshletCull.hlsl o͂bVbg̃Xg
+StructuredBuffer<Meshlet> Meshlets : register(t2);
+StructuredBuffer<uint> VisibleMeshlets : register(t3);
+ByteAddressBuffer CullCounters : register(t4);
+
+// : ÓIV[p BVH (BvhBuilder.cpp ō\z)
+StructuredBuffer<BvhNode> BvhNodes : register(t5);
+StructuredBuffer<uint> BvhTriangleIndices : register(t6);
+
+// : CfbNXobt@ (IndexedTriangles = 1 ̏ꍇ̂ݎgp)
+StructuredBuffer<uint> IndexBuffer : register(t7);
+
+// : }eA (MaterialCount > 0 ̏ꍇ̂ݎgpBMaterialTable.cpp ō\z)
+StructuredBuffer<uint> TriangleMaterials : register(t8);
+StructuredBuffer<Material> Materials : register(t9);
+Texture2DArray<float4> MaterialTextures : register(t10);
+SamplerState LinearClampSampler : register(s1);
+SamplerState PointWrapSampler : register(s2);
+SamplerState PointClampSampler : register(s3);
+
+// --- ^C (XbhO[v) Pʂ BVH  ---
+
+// ^C (= XbhO[v) ̑傫 (C++  c_TileSizesBGetRasterShader `ăRpC)
+#ifndef TILE_WIDTH
+#define TILE_WIDTH 16
+#endif
+#ifndef TILE_HEIGHT
+#define TILE_HEIGHT 16
+#endif
+#define TILE_THREAD_COUNT (TILE_WIDTH * TILE_HEIGHT)
+
+#define BVH_MAX_DEPTH 32                // BvhBuilder.h  c_BvhMaxDepth ƈv邱
+#define BVH_FRONTIER_SIZE 512           // 1Kwɕێłm[h
+#define BVH_TILE_TRIANGLE_CAPACITY 1024 // 1^CɎWłOp`
+
+groupshared uint gs_Frontier[2][BVH_FRONTIER_SIZE];
+groupshared uint gs_FrontierCount[2];
+groupshared uint gs_TileTriangles[BVH_TILE_TRIANGLE_CAPACITY];
+groupshared uint gs_TileTriangleCount;
+groupshared uint gs_TileOverflow;
+groupshared uint gs_TileCovered;
+groupshared uint gs_DepthPassFragments;
+groupshared uint gs_ShadedFragments;
+groupshared uint gs_CoveredPixels;
+groupshared uint gs_CoverageFragments;      // O[v̎c̃tOg
+groupshared uint gs_CoverageFragmentBase;   // O[v̎c̃tOg CoverageFragments ̐擪
+#if RASTER_VRS
+groupshared uint gs_VisibleTriangles[TILE_THREAD_COUNT]; // sNZƂ̌Op` (NO_TRIANGLE Ȃwi)
+groupshared uint gs_ShadeColors[TILE_THREAD_COUNT];      // ubNhsNZ̐F (R8G8B8A8BO[vL}邽ߋl߂)
+groupshared uint gs_SharedShades;
+#endif
+#if RASTER_LIGHTING
+groupshared uint gs_TileDepthMin;                   // Op`ĂsNZ̐[x͈̔ ( float  asuint)
+groupshared uint gs_TileDepthMax;
+groupshared float4 gs_TilePlanes[6];                // ^C̎̃[hW̕ ()
+groupshared uint gs_TileLights[MAX_TILE_LIGHTS];    // ^Cɓ͂Cg Lights ̔ԍ
+groupshared uint gs_TileLightCount;                 // MAX_TILE_LIGHTS 𒴂邱Ƃ (͓ĂȂ)
+#endif
+
+// XbhƂ̓v (CSMain ̍ŌɃO[vōv)
+static uint s_DepthPassFragments = 0;
+static uint s_ShadedFragments = 0;
+#if RASTER_VRS || RASTER_GBUFFER || RASTER_LIGHTING
+static uint s_VisibleTriangle = NO_TRIANGLE;    // Ōɐ[xeXgʂ (łO) Op`
+#endif
+#if RASTER_VRS
+static uint s_SharedShades = 0;
+#endif
+
+// --- [eBeB֐ ---
+
+// Op` i ̃}eAŃTv (}eAȂ BaseTexture)
+float4 SampleMaterial(uint i, float2 uv, float2 uvDdx, float2 uvDdy)
 {
-    matrix WorldViewProj; // Local -> Clip s
-    float2 ScreenSize;    // ʉ𑜓x (Width, Height)
-    uint TriangleCount;   // `悷Op`̖
-    float Padding;
+    if (MaterialCount == 0)
+    {
+        return BaseTexture.SampleGrad(BaseSampler, uv, uvDdx, uvDdy);
+    }
+
+    uint materialIndex = TriangleMaterialIDs ? TriangleMaterials[i] : DrawMaterial;
+    Material material = Materials[min(materialIndex, MaterialCount - 1)];
+    if (material.textureIndex == MATERIAL_NO_TEXTURE)
+    {
+        return material.tint;
+    }
+
+    bool clamp = (material.sampler & MATERIAL_SAMPLER_CLAMP) != 0;
+    if (material.atlas)
+    {
+        // AgX̋`ŃAhbVOAׂ̋`ǂ܂Ȃ悤Nvœǂ
+        uv = material.uvTransform.zw + (clamp ? saturate(uv) : frac(uv)) * material.uvTransform.xy;
+        uvDdx *= material.uvTransform.xy;
+        uvDdy *= material.uvTransform.xy;
+        clamp = true;
+    }
+
+    // cs_5_0 ł̓Tv[𓮓IɑIׂȂ̂ŕ򂷂
+    float3 location = float3(uv, material.textureIndex);
+    float4 color;
+    [branch] if (material.sampler & MATERIAL_SAMPLER_POINT)
+    {
+        if (clamp) color = MaterialTextures.SampleGrad(PointClampSampler, location, uvDdx, uvDdy);
+        else       color = MaterialTextures.SampleGrad(PointWrapSampler, location, uvDdx, uvDdy);
+    }
+    else
+    {
+        if (clamp) color = MaterialTextures.SampleGrad(LinearClampSampler, location, uvDdx, uvDdy);
+        else       color = MaterialTextures.SampleGrad(BaseSampler, location, uvDdx, uvDdy);
+    }
+    return color * material.tint;
 }
 
-// --- [eBeB֐ ---
+// [x DEPTH_FORMAT ̐xɊۂ߂ (rۂ߂lōs)
+float QuantizeDepth(float depth)
+{
+#if DEPTH_FORMAT == DEPTH_FORMAT_D16_UNORM
+    return round(saturate(depth) * 65535.0f) / 65535.0f;
+#elif DEPTH_FORMAT == DEPTH_FORMAT_D24_UNORM_S8
+    return round(saturate(depth) * 16777215.0f) / 16777215.0f;
+#else
+    return depth;
+#endif
+}
+
+// [xobt@ɏl (D24UnormS8 ͉ 24bit ɐ[xA 8bit ̃XeV 0)
+DEPTH_STORAGE EncodeDepth(float depth)
+{
+#if DEPTH_FORMAT == DEPTH_FORMAT_D24_UNORM_S8
+    return uint(round(saturate(depth) * 16777215.0f));
+#else
+    return depth;
+#endif
+}
 
-// GbW֐: xNg(a->b)ɑ΂ē_cE𔻒
-// ߂l: ȂAȂOiɂj
-float EdgeFunction(float2 a, float2 b, float2 c) {
-    return (c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x);
+// ێIX^CY̔ (w ͖ʐςŊÕGbW֐ (w0, w1, w2))
+// ӂsNZ̔̍L (ӂ̖@ւ 0.5 * (|dw/dx| + |dw/dy|)) O / ւ炵Ĕ肷
+bool IsPixelCoveredConservative(float2 s0, float2 s1, float2 s2, float area, float3 w, float2 p)
+{
+    float3 dwdx = float3(s2.y - s1.y, s0.y - s2.y, s1.y - s0.y) / area;
+    float3 dwdy = float3(s1.x - s2.x, s2.x - s0.x, s0.x - s1.x) / area;
+    float3 extent = 0.5f * (abs(dwdx) + abs(dwdy));
+#if RASTER_CONSERVATIVE == RASTER_CONSERVATIVE_UNDER
+    return all(w / area - extent >= 0);
+#else
+    // s_̐ōL肷Ȃ悤AsNZL AABB Ő؂
+    float2 boundsMin = min(s0, min(s1, s2)) - 0.5f;
+    float2 boundsMax = max(s0, max(s1, s2)) + 0.5f;
+    if (any(p < boundsMin) || any(p > boundsMax)) return false;
+    return all(w / area + extent >= 0);
+#endif
+}
+
+// Op` i ̒_CfbNX
+uint3 TriangleVertexIndices(uint i)
+{
+    uint idx = i * 3;
+    return IndexedTriangles
+        ? uint3(IndexBuffer[idx], IndexBuffer[idx + 1], IndexBuffer[idx + 2])
+        : uint3(idx, idx + 1, idx + 2);
+}
+
+// Op` i ̒_ǂ
+void FetchTriangle(uint i, out Vertex v0, out Vertex v1, out Vertex v2)
+{
+    uint3 vertexIndices = TriangleVertexIndices(i);
+    v0 = VertexBuffer[vertexIndices.x];
+    v1 = VertexBuffer[vertexIndices.y];
+    v2 = VertexBuffer[vertexIndices.z];
+}
+
+// Op` (v0_raw, v1_raw, v2_raw)  worldViewProj ŕϊANbvԂ ZA1/WAXN[W߂
+// NbvȂ̂ŁAJʂ܂ (W  c_MinClipW ȉ̒_) Op` false Ԃĕ`Ȃ (CPU ł SetupTriangle Ɠ)
+static const float c_MinClipW = 1e-6f;
+
+bool ProjectTriangle(Vertex v0_raw, Vertex v1_raw, Vertex v2_raw, float4x4 worldViewProj,
+                     out float3 clipZ, out float3 invW, out float2 s0, out float2 s1, out float2 s2)
+{
+    // 1. _ϊ (Local -> Clip Space)
+    float4 c0 = mul(float4(v0_raw.pos, 1.0f), worldViewProj);
+    float4 c1 = mul(float4(v1_raw.pos, 1.0f), worldViewProj);
+    float4 c2 = mul(float4(v2_raw.pos, 1.0f), worldViewProj);
+    clipZ = float3(c0.z, c1.z, c2.z);
+    invW = 0.0f;
+    s0 = 0.0f;
+    s1 = 0.0f;
+    s2 = 0.0f;
+    if (min(c0.w, min(c1.w, c2.w)) <= c_MinClipW)
+    {
+        return false;
+    }
+
+    // 2. p[XyNeBu␳̏ (1/W vZ)
+    // W̓J̐[x܂݂܂
+    invW = float3(1.0f / c0.w, 1.0f / c1.w, 1.0f / c2.w);
+
+    // 3. XN[Wւ̕ϊ (Viewport Transform)
+    // NDC (-1~1) -> Screen (0~w, 0~h)
+    s0.x = (c0.x * invW.x + 1.0f) * 0.5f * ScreenSize.x;
+    s0.y = (1.0f - c0.y * invW.x) * 0.5f * ScreenSize.y; // Y]
+
+    s1.x = (c1.x * invW.y + 1.0f) * 0.5f * ScreenSize.x;
+    s1.y = (1.0f - c1.y * invW.y) * 0.5f * ScreenSize.y;
+
+    s2.x = (c2.x * invW.z + 1.0f) * 0.5f * ScreenSize.x;
+    s2.y = (1.0f - c2.y * invW.z) * 0.5f * ScreenSize.y;
+    return true;
+}
+
+// Op` i (v0, v1, v2) ̃p[XyNeBu␳dSW perspectiveW ̈ʒu position ([JW) ̖@ ([JWBKȂ)
+// interpolated Ȃ VertexNormals ԂAłȂ΃J̑֌ʂ̖@ (ʂ`Ƃ̗ʂ)
+float3 SurfaceNormal(uint i, Vertex v0, Vertex v1, Vertex v2, float3 perspectiveW, float3 position, bool interpolated)
+{
+    if (interpolated)
+    {
+        uint3 vertexIndices = TriangleVertexIndices(i);
+        return perspectiveW.x * VertexNormals[vertexIndices.x] + perspectiveW.y * VertexNormals[vertexIndices.y] + perspectiveW.z * VertexNormals[vertexIndices.z];
+    }
+
+    float3 normal = cross(v1.pos - v0.pos, v2.pos - v0.pos);
+    float3 toViewer = ViewOrigin.w != 0.0f ? ViewOrigin.xyz - position : -ViewOrigin.xyz;
+    return dot(normal, toViewer) < 0.0f ? -normal : normal;
+}
+
+#if RASTER_LIGHTING
+// --- ^CPʂ̃CgJO ---
+
+// _̋ɂ錸 (C++  LightFalloff Ɠ)
+float LightFalloff(float distanceSquared, float radiusSquared)
+{
+    float falloff = saturate(1.0f - distanceSquared / radiusSquared);
+    return falloff * falloff;
+}
+
+// [x̃pX̌ɁA^C (groupID) ̎Op`Ă[x͈̔͂ɓ͂Cg gs_TileLights ɏW߂ (O[v̑SXbhŌĂ)
+// ^C̉ʂ͈̔͂Ɛ[x͈̔͂NbvW6ʂɂ LightViewProj Ń[hW֖߂ACg̋Ɣׂ
+void CullTileLights(uint2 groupID, uint groupIndex, bool insideScreen, float bestDepth)
+{
+    if (insideScreen && s_VisibleTriangle != NO_TRIANGLE)
+    {
+        InterlockedMin(gs_TileDepthMin, asuint(bestDepth));
+        InterlockedMax(gs_TileDepthMax, asuint(bestDepth));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Op`ĂȂ^C̓CgW߂Ȃ
+    bool empty = gs_TileDepthMin > gs_TileDepthMax;
+    if (!empty && groupIndex < 6)
+    {
+        float2 tileMin = float2(groupID * uint2(TILE_WIDTH, TILE_HEIGHT));
+        float2 tileMax = min(tileMin + float2(TILE_WIDTH, TILE_HEIGHT), ScreenSize);
+        float2 ndcMin = float2(tileMin.x / ScreenSize.x * 2.0f - 1.0f, 1.0f - tileMax.y / ScreenSize.y * 2.0f);
+        float2 ndcMax = float2(tileMax.x / ScreenSize.x * 2.0f - 1.0f, 1.0f - tileMin.y / ScreenSize.y * 2.0f);
+        float depthMin = asfloat(gs_TileDepthMin);
+        float depthMax = asfloat(gs_TileDepthMax);
+
+        // dot(clip, plane) >= 0  (x >= ndcMin.x * w Ȃ)
+        float4 planes[6] = {
+            float4(1.0f, 0.0f, 0.0f, -ndcMin.x), float4(-1.0f, 0.0f, 0.0f, ndcMax.x),
+            float4(0.0f, 1.0f, 0.0f, -ndcMin.y), float4(0.0f, -1.0f, 0.0f, ndcMax.y),
+            float4(0.0f, 0.0f, 1.0f, -depthMin), float4(0.0f, 0.0f, -1.0f, depthMax)
+        };
+        float4 plane = mul(LightViewProj, planes[groupIndex]);
+        gs_TilePlanes[groupIndex] = plane / length(plane.xyz);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (!empty)
+    {
+        for (uint l = groupIndex; l < LightCount; l += TILE_THREAD_COUNT)
+        {
+            PointLight light = Lights[l];
+            bool inside = true;
+            [unroll] for (uint k = 0; k < 6; ++k)
+            {
+                inside = inside && dot(gs_TilePlanes[k].xyz, light.position) + gs_TilePlanes[k].w >= -light.radius;
+            }
+            if (inside)
+            {
+                uint slot;
+                InterlockedAdd(gs_TileLightCount, 1, slot);
+                if (slot < MAX_TILE_LIGHTS)
+                {
+                    gs_TileLights[slot] = l;
+                }
+            }
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+// ʒu position Ɩ@ normal ([JW)  albedo A^C̃Xg̃CgŏƂ炷 (LambertBAt@͂̂܂)
+float4 ShadeTileLights(float4 albedo, float3 position, float3 normal)
+{
+    float3 worldPosition = mul(float4(position, 1.0f), LightWorld).xyz;
+    float3 n = normalize(mul(float4(normal, 0.0f), LightNormalWorld).xyz);
+
+    float3 irradiance = AmbientColor;
+    uint count = min(gs_TileLightCount, MAX_TILE_LIGHTS);
+    for (uint k = 0; k < count; ++k)
+    {
+        PointLight light = Lights[gs_TileLights[k]];
+        float3 toLight = light.position - worldPosition;
+        float distanceSquared = dot(toLight, toLight);
+        float nDotL = saturate(dot(n, toLight) * rsqrt(max(distanceSquared, 1e-12f)));
+        irradiance += light.color * (light.intensity * nDotL * LightFalloff(distanceSquared, light.radius * light.radius));
+    }
+    return float4(albedo.rgb * irradiance, albedo.a);
+}
+#endif
+
+// Op` i ̏dSW w (ʐςŊ) ̈ʒu̐F (_J[ x eNX`BRASTER_LIGHTING Ȃ^C̃CgŏƂ炷)
+float4 ShadeTriangle(uint i, Vertex v0_raw, Vertex v1_raw, Vertex v2_raw, float3 invW, float2 s0, float2 s1, float2 s2, float area, float3 w)
+{
+    // 1/W ͉ʏŐ`Ȃ̂ŏdSWŕԂA̕Ɏg
+    float interpolatedInvW = dot(w, invW);
+    float currentW = 1.0f / interpolatedInvW;
+
+    // 7. p[XyNeBuERNg (dv)
+    // UVColor͒ w0,w1,w2 ŕԂƘcނ߁A
+    // x (Value / W) ԂAŌ W |ĕB
+
+#if RASTER_TEXTURED
+    // UV̕
+    float2 uv0_p = v0_raw.uv * invW.x;
+    float2 uv1_p = v1_raw.uv * invW.y;
+    float2 uv2_p = v2_raw.uv * invW.z;
+
+    float2 finalUV = (w.x * uv0_p + w.y * uv1_p + w.z * uv2_p) * currentW;
+#endif
+
+#if RASTER_VERTEX_COLOR
+    // Color̕
+    float4 col0_p = v0_raw.color * invW.x;
+    float4 col1_p = v1_raw.color * invW.y;
+    float4 col2_p = v2_raw.color * invW.z;
+
+    float4 finalVertexColor = (w.x * col0_p + w.y * col1_p + w.z * col2_p) * currentW;
+#else
+    float4 finalVertexColor = float4(1.0f, 1.0f, 1.0f, 1.0f);
+#endif
+
+#if RASTER_TEXTURED
+    // UV ̉ʏ̔ (Rs[gVF[_[ł ddx/ddy gȂ̂ŎOp`͓Iɋ߂)
+    // dSW͉ʏŐ`Ȃ̂ŁAuv = N / D (N =  w_i * uv_i / W_i, D =  w_i / W_i) ̔ŋ߂
+    float3 dwdx = float3(s2.y - s1.y, s0.y - s2.y, s1.y - s0.y) / area;
+    float3 dwdy = float3(s1.x - s2.x, s2.x - s0.x, s0.x - s1.x) / area;
+
+    float2 uvDdx = (dwdx.x * uv0_p + dwdx.y * uv1_p + dwdx.z * uv2_p - finalUV * dot(dwdx, invW)) * currentW;
+    float2 uvDdy = (dwdy.x * uv0_p + dwdy.y * uv1_p + dwdy.z * uv2_p - finalUV * dot(dwdy, invW)) * currentW;
+
+    // eNX`TvO ( LOD IсA~bvԂgCjAŕԂ)
+    float4 texColor = SampleMaterial(i, finalUV, uvDdx, uvDdy);
+#else
+    float4 texColor = float4(1.0f, 1.0f, 1.0f, 1.0f);
+#endif
+
+    // ŏIJ[
+#if RASTER_LIGHTING
+    float3 perspectiveW = w * invW * currentW;
+    float3 position = perspectiveW.x * v0_raw.pos + perspectiveW.y * v1_raw.pos + perspectiveW.z * v2_raw.pos;
+    return ShadeTileLights(finalVertexColor * texColor, position, SurfaceNormal(i, v0_raw, v1_raw, v2_raw, perspectiveW, position, LightInterpolatedNormals != 0));
+#else
+    return finalVertexColor * texColor;
+#endif
+}
+
+// dst ̏ src  src.a ō
+float4 BlendColor(float4 dst, float4 src)
+{
+    return float4(lerp(dst.rgb, src.rgb, src.a), src.a + dst.a * (1.0f - src.a));
+}
+
+// ǂݍݍς݂̎Op` i (v0_raw, v1_raw, v2_raw)  worldViewProj ŕϊăsNZ p ɑ΂ĕ]A
+// Oł bestDepth / bestColor XV (XV covered = true)
+// pass  RASTER_PASS_* (萔ŌĂԂ̂ŁAgȂpX̏̓RpCɏ)
+void RasterizeTriangleView(uint pass, uint i, Vertex v0_raw, Vertex v1_raw, Vertex v2_raw, float4x4 worldViewProj, float2 p,
+                           inout float bestDepth, inout float4 bestColor, inout bool covered)
+{
+    float3 clipZ, invW;
+    float2 s0, s1, s2;
+    if (!ProjectTriangle(v0_raw, v1_raw, v2_raw, worldViewProj, clipZ, invW, s0, s1, s2)) return;
+
+    // 4. X^CY (GbW֐)
+    float area = EdgeFunction(s0, s1, s2);
+
+    // obNtFCXJO (v𐳂ƂꍇAȂ痠)
+#if RASTER_CULL_MODE == RASTER_CULL_BACK
+    if (area <= 0) return;
+#elif RASTER_CULL_MODE == RASTER_CULL_FRONT
+    if (area >= 0) return;
+#else
+    if (area == 0) return;
+#endif
+
+    float w0 = EdgeFunction(s1, s2, p);
+    float w1 = EdgeFunction(s2, s0, p);
+    float w2 = EdgeFunction(s0, s1, p); // vZ
+
+    // 5. Op`̓O
+#if RASTER_CONSERVATIVE
+    if (IsPixelCoveredConservative(s0, s1, s2, area, float3(w0, w1, w2), p)) {
+#elif RASTER_CULL_MODE == RASTER_CULL_BACK
+    if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
+#else
+    // ʂ`ꍇ́AGbW֐ʐςƓȂ (ʐςŊ̏dSWƔ͂̂܂܎g)
+    if (w0 * area >= 0 && w1 * area >= 0 && w2 * area >= 0) {
+#endif
+        // dSW̐K
+        float3 w = float3(w0, w1, w2) / area;
+
+#if RASTER_DEPTH_TEST
+        // 6. [xeXg (Zl̐`)
+        // NDC  Z (c.z / c.w) ʏŐ`Ȃ̂ŁAW |Ė߂ɂ̂܂ܕԂA[xobt@̐xɊۂ߂
+        // (NbvԂ Z r 0 ~ 1 Ɏ܂炸Areversed-Z  unorm ̃tH[}bgŐׂȂ)
+        float3 vertexDepth = clipZ * invW;
+        float currentDepth = dot(w, vertexDepth);
+#if RASTER_CONSERVATIVE == RASTER_CONSERVATIVE_OVER
+        // Op`̊ÕsNZSł͊O}ɂȂ̂ŁA_̐[x͈̔͂Ɏ߂
+        currentDepth = clamp(currentDepth, min(vertexDepth.x, min(vertexDepth.y, vertexDepth.z)), max(vertexDepth.x, max(vertexDepth.y, vertexDepth.z)));
+#endif
+        currentDepth = QuantizeDepth(currentDepth);
+
+        bool depthPassed;
+        if (pass == RASTER_PASS_SHADE)
+        {
+            // łO̐[xƈvŏ̎Op` (1pXōŌɐ[xeXgʂOp`Ɠ)
+            depthPassed = currentDepth == bestDepth && !covered;
+        }
+        else
+        {
+            depthPassed = DEPTH_CLOSER(currentDepth, bestDepth);
+            s_DepthPassFragments += depthPassed ? 1 : 0;
+        }
+
+        if (depthPassed) {
+#if !RASTER_BLEND
+            bestDepth = currentDepth;
+#endif
+#if RASTER_VRS || RASTER_GBUFFER || RASTER_LIGHTING
+            s_VisibleTriangle = i;
+#endif
+            if (pass == RASTER_PASS_DEPTH) return;
+#else
+        {
+#endif
+            float4 color = ShadeTriangle(i, v0_raw, v1_raw, v2_raw, invW, s0, s1, s2, area, w);
+#if RASTER_BLEND
+            bestColor = BlendColor(bestColor, color);
+#else
+            bestColor = color;
+#endif
+            covered = true;
+            ++s_ShadedFragments;
+        }
+    }
+}
+
+// --- JobW}XÑA`GCAX (RASTER_SAMPLES > 1) ---
+
+// R8G8B8A8 (R ʃoCg) ւ̕ϊ (C++  PackColor Ɠۂ)
+uint PackColor(float4 color)
+{
+    uint4 value = uint4(saturate(color) * 255.0f + 0.5f);
+    return value.x | (value.y << 8) | (value.z << 16) | (value.w << 24);
+}
+
+float4 UnpackColor(uint value)
+{
+    return float4(value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24) / 255.0f;
+}
+
+#if RASTER_SAMPLES > 1
+
+#define COVERAGE_ALL_SAMPLES ((1u << RASTER_SAMPLES) - 1)
+
+// Tvʒu (sNZŜBC++  c_SamplePositions4x / 8x)
+#if RASTER_SAMPLES == 8
+static const float2 c_SamplePositions[8] = {
+    float2(1, -3) / 16.0f, float2(-1, 3) / 16.0f, float2(5, 1) / 16.0f, float2(-3, -5) / 16.0f,
+    float2(-5, 5) / 16.0f, float2(-7, -1) / 16.0f, float2(3, 7) / 16.0f, float2(7, -7) / 16.0f,
+};
+#else
+static const float2 c_SamplePositions[4] = {
+    float2(-2, -6) / 16.0f, float2(6, -2) / 16.0f, float2(-6, 2) / 16.0f, float2(2, 6) / 16.0f,
+};
+#endif
+
+// Xbh (= sNZ) Ƃ̃Tv̐[xƃtOg (hFƁA̐FĂTṽ}XN)
+// tOg̃}XN̓sNZ̃Tv𕪂̂ŁAtOg̐̓Tv𒴂Ȃ
+static float s_SampleDepth[RASTER_SAMPLES];
+static float4 s_FragmentColor[RASTER_SAMPLES];
+static uint s_FragmentMask[RASTER_SAMPLES];
+static uint s_FragmentCount;
+
+// STvNAJ[1̃tOgɂ
+void BeginCoverageSamples()
+{
+    [unroll]
+    for (uint s = 0; s < RASTER_SAMPLES; ++s)
+    {
+        s_SampleDepth[s] = DEPTH_CLEAR;
+        s_FragmentColor[s] = ClearColor;
+        s_FragmentMask[s] = 0;
+    }
+    s_FragmentMask[0] = COVERAGE_ALL_SAMPLES;
+    s_FragmentCount = 1;
+}
+
+// mask ̃Tv color h
+void AddFragment(float4 color, uint mask)
+{
+    uint count = s_FragmentCount;
+#if RASTER_BLEND
+    // dȂtOgƂɍ (ꕔ̃TvdȂtOg2ɕ)
+    for (uint f = 0; f < count; ++f)
+    {
+        uint overlap = s_FragmentMask[f] & mask;
+        if (overlap == 0) continue;
+
+        float4 blended = BlendColor(s_FragmentColor[f], color);
+        if (overlap == s_FragmentMask[f])
+        {
+            s_FragmentColor[f] = blended;
+        }
+        else
+        {
+            s_FragmentMask[f] &= ~overlap;
+            s_FragmentColor[s_FragmentCount] = blended;
+            s_FragmentMask[s_FragmentCount] = overlap;
+            ++s_FragmentCount;
+        }
+    }
+#else
+    // ㏑Tv𑼂̃tOgOAȂȂtOgl߂
+    uint kept = 0;
+    for (uint f = 0; f < count; ++f)
+    {
+        uint remaining = s_FragmentMask[f] & ~mask;
+        if (remaining == 0) continue;
+
+        s_FragmentColor[kept] = s_FragmentColor[f];
+        s_FragmentMask[kept] = remaining;
+        ++kept;
+    }
+    s_FragmentColor[kept] = color;
+    s_FragmentMask[kept] = mask;
+    s_FragmentCount = kept + 1;
+#endif
+}
+
+// ǂݍݍς݂̎Op` i sNZ p ̃Tvɑ΂ĕ]
+// GbW֐Ɛ[xTvƂɔ肵ă}XNɂA[xeXgʂTv1񂾂h
+void RasterizeTriangleSamples(uint i, Vertex v0_raw, Vertex v1_raw, Vertex v2_raw, float2 p, inout bool covered)
+{
+    float3 clipZ, invW;
+    float2 s0, s1, s2;
+    if (!ProjectTriangle(v0_raw, v1_raw, v2_raw, WorldViewProj, clipZ, invW, s0, s1, s2)) return;
+
+    float area = EdgeFunction(s0, s1, s2);
+#if RASTER_CULL_MODE == RASTER_CULL_BACK
+    if (area <= 0) return;
+#elif RASTER_CULL_MODE == RASTER_CULL_FRONT
+    if (area >= 0) return;
+#else
+    if (area == 0) return;
+#endif
+
+    // sNZS̏dSWƁẢʏ̔ (Tvʒuւ炷̂Ɏg)
+    float3 w = float3(EdgeFunction(s1, s2, p), EdgeFunction(s2, s0, p), EdgeFunction(s0, s1, p)) / area;
+    float3 dwdx = float3(s2.y - s1.y, s0.y - s2.y, s1.y - s0.y) / area;
+    float3 dwdy = float3(s1.x - s2.x, s2.x - s0.x, s0.x - s1.x) / area;
+    float3 vertexDepth = clipZ * invW;
+
+#if RASTER_CONSERVATIVE
+    // D3D ƓAsNZ̔ʂΑSTv𕢂
+    if (!IsPixelCoveredConservative(s0, s1, s2, area, w * area, p)) return;
+#endif
+
+    uint mask = 0;
+    float3 coveredSum = 0;
+    [unroll]
+    for (uint s = 0; s < RASTER_SAMPLES; ++s)
+    {
+        float3 sampleW = w + dwdx * c_SamplePositions[s].x + dwdy * c_SamplePositions[s].y;
+#if !RASTER_CONSERVATIVE
+        // ʐςŊdSW͗łŐ
+        if (any(sampleW < 0)) continue;
+#endif
+
+#if RASTER_DEPTH_TEST
+        float sampleDepth = dot(sampleW, vertexDepth);
+#if RASTER_CONSERVATIVE == RASTER_CONSERVATIVE_OVER
+        sampleDepth = clamp(sampleDepth, min(vertexDepth.x, min(vertexDepth.y, vertexDepth.z)), max(vertexDepth.x, max(vertexDepth.y, vertexDepth.z)));
+#endif
+        sampleDepth = QuantizeDepth(sampleDepth);
+        if (!DEPTH_CLOSER(sampleDepth, s_SampleDepth[s])) continue;
+#if !RASTER_BLEND
+        s_SampleDepth[s] = sampleDepth;
+#endif
+#endif
+        mask |= 1u << s;
+        coveredSum += sampleW;
+    }
+    if (mask == 0) return;
+    ++s_DepthPassFragments;
+
+    // Tv̏dS1񂾂h (sNZS͎Op`̊ÔƂ̂ŁAMSAA ̃ZgChԂƓTv̓ŕԂ)
+    float3 shadeW = coveredSum / countbits(mask);
+    AddFragment(ShadeTriangle(i, v0_raw, v1_raw, v2_raw, invW, s0, s1, s2, area, shadeW), mask);
+    covered = true;
+    ++s_ShadedFragments;
+}
+
+// sNZ̃tOgkď (extraOffset  CoverageFragments Ɋ蓖Ăc̃tOg̐擪)
+// CoverageFragments ӂꂽAς݂̐FSTv𕢂1̃tOgƂď
+void StoreCoverageSamples(uint2 pixel, uint extraOffset)
+{
+    uint capacity, stride;
+    CoverageFragments.GetDimensions(capacity, stride);
+
+    uint pixelIndex = pixel.y * uint(ScreenSize.x) + pixel.x;
+    uint extraCount = s_FragmentCount - 1;
+    if (extraCount > 0 && extraOffset + extraCount > capacity)
+    {
+        float4 resolved = 0;
+        for (uint f = 0; f < s_FragmentCount; ++f)
+        {
+            resolved += s_FragmentColor[f] * countbits(s_FragmentMask[f]);
+        }
+        CoveragePixels[pixelIndex] = uint2(PackColor(resolved / RASTER_SAMPLES), COVERAGE_ALL_SAMPLES);
+        return;
+    }
+
+    CoveragePixels[pixelIndex] = uint2(PackColor(s_FragmentColor[0]),
+                                       s_FragmentMask[0] | (extraCount << COVERAGE_COUNT_SHIFT) | (extraOffset << COVERAGE_OFFSET_SHIFT));
+    for (uint e = 0; e < extraCount; ++e)
+    {
+        CoverageFragments[extraOffset + e] = uint2(PackColor(s_FragmentColor[e + 1]), s_FragmentMask[e + 1]);
+    }
+}
+
+// [xobt@ɏ[x (łÕTv)
+float ClosestSampleDepth()
+{
+    float depth = s_SampleDepth[0];
+    [unroll]
+    for (uint s = 1; s < RASTER_SAMPLES; ++s)
+    {
+        depth = DEPTH_CLOSER(s_SampleDepth[s], depth) ? s_SampleDepth[s] : depth;
+    }
+    return depth;
+}
+
+#endif
+
+// 1̎Op`sNZ p ɑ΂ĕ] (WorldViewProj ̃r[)
+// RASTER_SAMPLES > 1 ł̓Tv̐[xƐF s_SampleDepth / s_Fragment* Ɏ (bestDepth / bestColor ͎gȂ)
+void RasterizeTriangle(uint pass, uint i, float2 p, inout float bestDepth, inout float4 bestColor, inout bool covered)
+{
+    Vertex v0, v1, v2;
+    FetchTriangle(i, v0, v1, v2);
+#if RASTER_SAMPLES > 1
+    RasterizeTriangleSamples(i, v0, v1, v2, p, covered);
+#else
+    RasterizeTriangleView(pass, i, v0, v1, v2, WorldViewProj, p, bestDepth, bestColor, covered);
+#endif
+}
+
+// SOp`sNZ p ɑ΂ĕ]
+void RasterizeAllTriangles(uint pass, float2 p, inout float bestDepth, inout float4 bestColor, inout bool covered)
+{
+    for (uint i = 0; i < TriangleCount; ++i)
+    {
+        RasterizeTriangle(pass, i, p, bestDepth, bestColor, covered);
+    }
+}
+
+// AABB ([JW) ̃XN[e^C`ƏdȂ邩 (ێIȔ)
+bool BoundsOverlapTile(float3 boundsMin, float3 boundsMax, float2 tileMin, float2 tileMax)
+{
+    float2 screenMin = float2(1e30f, 1e30f);
+    float2 screenMax = float2(-1e30f, -1e30f);
+    uint nearCount = 0;
+    uint farCount = 0;
+
+    [unroll]
+    for (uint c = 0; c < 8; ++c)
+    {
+        float3 corner = float3((c & 1) ? boundsMax.x : boundsMin.x,
+                               (c & 2) ? boundsMax.y : boundsMin.y,
+                               (c & 4) ? boundsMax.z : boundsMin.z);
+        float4 clip = mul(float4(corner, 1.0f), WorldViewProj);
+
+        // Jʂ܂ꍇ͓ełȂ̂ŁAdȂĂƂ݂Ȃ
+        if (clip.w <= 1e-6f) return true;
+
+        nearCount += (clip.z < 0.0f) ? 1 : 0;
+        farCount += (clip.z > clip.w) ? 1 : 0;
+
+        float2 ndc = clip.xy / clip.w;
+        float2 s = float2((ndc.x + 1.0f) * 0.5f * ScreenSize.x, (1.0f - ndc.y) * 0.5f * ScreenSize.y);
+        screenMin = min(screenMin, s);
+        screenMax = max(screenMax, s);
+    }
+
+    // S_jAʂO / t@[ʂ艜
+    if (nearCount == 8 || farCount == 8) return false;
+
+    return all(screenMax >= tileMin) && all(screenMin <= tileMax);
+}
+
+// ^CƏdȂOp` BVH  groupshared ̃XgɏW߂
+// O[v̑SXbh1KwDɑ (O[v̑SXbhĂԂ)
+// ߂l: false Ȃ烊Xgӂꂽ̂ŁASOp`[vɃtH[obN
+bool CollectTileTriangles(uint groupIndex, float2 tileMin, float2 tileMax)
+{
+    if (groupIndex == 0)
+    {
+        gs_Frontier[0][0] = 0; // [g
+        gs_FrontierCount[0] = 1;
+        gs_FrontierCount[1] = 0;
+        gs_TileTriangleCount = 0;
+        gs_TileOverflow = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint current = 0;
+    for (uint level = 0; level < BVH_MAX_DEPTH; ++level)
+    {
+        uint next = 1 - current;
+        uint frontierCount = min(gs_FrontierCount[current], BVH_FRONTIER_SIZE);
+
+        for (uint f = groupIndex; f < frontierCount; f += TILE_THREAD_COUNT)
+        {
+            BvhNode node = BvhNodes[gs_Frontier[current][f]];
+            if (!BoundsOverlapTile(node.boundsMin, node.boundsMax, tileMin, tileMax)) continue;
+
+            uint slot;
+            if (node.triangleCount == 0)
+            {
+                // m[h: 2̎q̊Kw
+                InterlockedAdd(gs_FrontierCount[next], 2, slot);
+                if (slot + 2 <= BVH_FRONTIER_SIZE)
+                {
+                    gs_Frontier[next][slot] = node.leftFirst;
+                    gs_Frontier[next][slot + 1] = node.leftFirst + 1;
+                }
+                else
+                {
+                    gs_TileOverflow = 1;
+                }
+            }
+            else
+            {
+                // [t: Op`^C̃Xg
+                InterlockedAdd(gs_TileTriangleCount, node.triangleCount, slot);
+                if (slot + node.triangleCount <= BVH_TILE_TRIANGLE_CAPACITY)
+                {
+                    for (uint t = 0; t < node.triangleCount; ++t)
+                    {
+                        gs_TileTriangles[slot + t] = BvhTriangleIndices[node.leftFirst + t];
+                    }
+                }
+                else
+                {
+                    gs_TileOverflow = 1;
+                }
+            }
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        // ς݂̊KwɂāÅKw
+        if (groupIndex == 0)
+        {
+            gs_FrontierCount[current] = 0;
+        }
+        current = next;
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    return gs_TileOverflow == 0;
+}
+
+// V[̎Op`sNZ p ɑ΂1pX] (collected Ȃ CollectTileTriangles ŏW߂^C̎Op`)
+void RasterizeScene(uint pass, float2 p, bool collected, inout float bestDepth, inout float4 bestColor, inout bool covered)
+{
+    if (BvhNodeCount > 0)
+    {
+        // ----------------------------------------------------------------
+        // ÓIV[: BVH ŏW߂^CƏdȂOp`[v (ꂽꍇ͑SOp`)
+        // ----------------------------------------------------------------
+        if (collected)
+        {
+            uint tileTriangleCount = gs_TileTriangleCount;
+            for (uint t = 0; t < tileTriangleCount; ++t)
+            {
+                RasterizeTriangle(pass, gs_TileTriangles[t], p, bestDepth, bestColor, covered);
+            }
+        }
+        else
+        {
+            RasterizeAllTriangles(pass, p, bestDepth, bestColor, covered);
+        }
+    }
+    else if (MeshletCount > 0)
+    {
+        // ----------------------------------------------------------------
+        // bVbĝ݂[v (JOς݃NX^͎Op`̂ȗ)
+        // ----------------------------------------------------------------
+        uint visibleCount = CullCounters.Load(CULL_COUNTER_VISIBLE_MESHLETS);
+        for (uint m = 0; m < visibleCount; ++m)
+        {
+            Meshlet meshlet = Meshlets[VisibleMeshlets[m]];
+            for (uint t = 0; t < meshlet.triangleCount; ++t)
+            {
+                RasterizeTriangle(pass, meshlet.firstTriangle + t, p, bestDepth, bestColor, covered);
+            }
+        }
+    }
+    else
+    {
+        // ----------------------------------------------------------------
+        // SOp`[v (sNZ哱_O)
+        // ----------------------------------------------------------------
+        RasterizeAllTriangles(pass, p, bestDepth, bestColor, covered);
+    }
+}
+
+// ^C (groupID)  TileClearFlags ̈ʒu
+uint TileClearFlagIndex(uint2 groupID)
+{
+    uint tileCountX = (uint(ScreenSize.x) + TILE_WIDTH - 1) / TILE_WIDTH;
+    return groupID.y * tileCountX + groupID.x;
+}
+
+#if RASTER_VRS
+// --- σ[gVF[fBO ---
+
+// Op` i ubN (S centerA1 blockSize sNZ) 1񕪂Ƃēh
+float4 ShadeBlock(uint i, float2 center, uint blockSize)
+{
+    Vertex v0, v1, v2;
+    FetchTriangle(i, v0, v1, v2);
+
+    float3 clipZ, invW;
+    float2 s0, s1, s2;
+    ProjectTriangle(v0, v1, v2, WorldViewProj, clipZ, invW, s0, s1, s2);
+
+    float area = EdgeFunction(s0, s1, s2);
+    float3 w = float3(EdgeFunction(s1, s2, center), EdgeFunction(s2, s0, center), EdgeFunction(s0, s1, center)) / area;
+
+    // ʐς blockSize Ŋēn UV ̔ blockSize {ɂȂAubN̑傫ɍ~bvǂ
+    // (dSW͐Kς݂Ȃ̂ŁAʐς͔ɂgȂ)
+    return ShadeTriangle(i, v0, v1, v2, invW, s0, s1, s2, area / blockSize, w);
+}
+
+// [x̃pX̌ɁAsNZ pixel (O[v groupIndex) ̐F߂ (O[v̑SXbhŌĂ)
+// ubNsDŌāAOp`Ăŏ̃sNZubN̒SœhAc͂̐Fg
+// (ubN̑傫̓^C̕ӂ̖񐔂Ȃ̂ŁAubN̓O[v܂Ȃ)
+void ShadeVariableRate(uint2 pixel, uint2 groupID, uint groupIndex, bool insideScreen, inout float4 bestColor, inout bool covered)
+{
+    uint visible = insideScreen ? s_VisibleTriangle : NO_TRIANGLE;
+    gs_VisibleTriangles[groupIndex] = visible;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint rateTileCountX = (uint(ScreenSize.x) + SHADING_RATE_TILE_SIZE - 1) / SHADING_RATE_TILE_SIZE;
+    uint rate = insideScreen ? ShadingRates[(pixel.y / SHADING_RATE_TILE_SIZE) * rateTileCountX + pixel.x / SHADING_RATE_TILE_SIZE] : 0;
+    uint blockSize = 1u << rate;
+    uint2 blockOrigin = pixel & ~(blockSize - 1);
+    uint2 localOrigin = blockOrigin - groupID * uint2(TILE_WIDTH, TILE_HEIGHT);
+
+    uint owner = groupIndex;
+    if (visible != NO_TRIANGLE)
+    {
+        bool found = false;
+        for (uint by = 0; by < blockSize && !found; ++by)
+        {
+            for (uint bx = 0; bx < blockSize && !found; ++bx)
+            {
+                uint index = (localOrigin.y + by) * TILE_WIDTH + localOrigin.x + bx;
+                if (gs_VisibleTriangles[index] == visible)
+                {
+                    owner = index;
+                    found = true;
+                }
+            }
+        }
+
+        if (owner == groupIndex)
+        {
+            bestColor = ShadeBlock(visible, float2(blockOrigin) + blockSize * 0.5f, blockSize);
+            gs_ShadeColors[groupIndex] = PackColor(bestColor);
+            ++s_ShadedFragments;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (visible != NO_TRIANGLE && owner != groupIndex)
+    {
+        bestColor = UnpackColor(gs_ShadeColors[owner]);
+        ++s_SharedShades;
+    }
+    covered = visible != NO_TRIANGLE;
+}
+#endif
+
+#if RASTER_GBUFFER
+// --- G-buffer ---
+
+// PʃxNg𔪖ʑ̂ɓWJ [-1, 1] 2 (C++  PackNormalOctahedral Ɠ)
+float2 EncodeOctahedral(float3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    float2 folded = (1.0f - abs(n.yx)) * (n.xy >= 0.0f ? 1.0f : -1.0f);
+    return n.z >= 0.0f ? n.xy : folded;
+}
+
+// sNZ pixel (S p) ɌĂOp` i  G-buffer  (i = NO_TRIANGLE Ȃwi)
+// dSWƑ́AFƓOp`ǂݒăsNZSŋ߂ (1sNZ1񂾂)
+void WriteGBuffer(uint2 pixel, float2 p, uint i, float4 albedo)
+{
+    if (GBufferAlbedoFormat != GBUFFER_FORMAT_OFF)
+    {
+        GBufferAlbedo[pixel] = albedo;
+    }
+
+    if (i == NO_TRIANGLE)
+    {
+        if (GBufferNormalFormat != GBUFFER_FORMAT_OFF) GBufferNormal[pixel] = 0;
+        if (GBufferIdFormat != GBUFFER_FORMAT_OFF) GBufferId[pixel] = NO_TRIANGLE;
+        if (GBufferMotionFormat != GBUFFER_FORMAT_OFF) GBufferMotion[pixel] = 0;
+        return;
+    }
+
+    if (GBufferIdFormat != GBUFFER_FORMAT_OFF)
+    {
+        uint material = MaterialCount > 0 ? (TriangleMaterialIDs ? TriangleMaterials[i] : DrawMaterial) : 0;
+        GBufferId[pixel] = GBufferIdFormat == GBUFFER_FORMAT_PACKED
+            ? uint2((i & GBUFFER_PACKED_TRIANGLE_MASK) | (material << GBUFFER_PACKED_MATERIAL_SHIFT), 0)
+            : uint2(i, material);
+    }
+    if (GBufferNormalFormat == GBUFFER_FORMAT_OFF && GBufferMotionFormat == GBUFFER_FORMAT_OFF) return;
+
+    Vertex v0, v1, v2;
+    FetchTriangle(i, v0, v1, v2);
+    float3 clipZ, invW;
+    float2 s0, s1, s2;
+    ProjectTriangle(v0, v1, v2, WorldViewProj, clipZ, invW, s0, s1, s2);
+
+    // p[XyNeBu␳dSWŃ[JẄʒu߂
+    float3 w = float3(EdgeFunction(s1, s2, p), EdgeFunction(s2, s0, p), EdgeFunction(s0, s1, p)) / EdgeFunction(s0, s1, s2);
+    float3 perspectiveW = w * invW / dot(w, invW);
+    float3 position = perspectiveW.x * v0.pos + perspectiveW.y * v1.pos + perspectiveW.z * v2.pos;
+
+    if (GBufferNormalFormat != GBUFFER_FORMAT_OFF)
+    {
+        float3 normal = SurfaceNormal(i, v0, v1, v2, perspectiveW, position, InterpolatedNormals != 0);
+        normal = normalize(mul(float4(normal, 0.0f), NormalWorld).xyz);
+        GBufferNormal[pixel] = GBufferNormalFormat == GBUFFER_FORMAT_PACKED
+            ? float4(EncodeOctahedral(normal) * 0.5f + 0.5f, 0.0f, 0.0f)
+            : float4(normal, 0.0f);
+    }
+
+    if (GBufferMotionFormat != GBUFFER_FORMAT_OFF)
+    {
+        // ʒuÕt[̍sŉʂ֎ʂÃsNZSƂ̍𓮂xNgɂ
+        float4 previousClip = mul(float4(position, 1.0f), PreviousWorldViewProj);
+        float2 previousScreen = float2(previousClip.x / previousClip.w + 1.0f, 1.0f - previousClip.y / previousClip.w) * 0.5f * ScreenSize;
+        GBufferMotion[pixel] = previousScreen - p;
+    }
+}
+#endif
+
+// --- VU[` ---
+
+// sNZ pixel ꂩ̃VU[`̒ (`ȂΏ true)
+bool IsInsideScissor(uint2 pixel)
+{
+    if (ScissorRectCount == 0) return true;
+
+    for (uint r = 0; r < ScissorRectCount; ++r)
+    {
+        uint4 rect = ScissorRects[r];
+        if (all(pixel >= rect.xy) && all(pixel < rect.zw)) return true;
+    }
+    return false;
+}
+
+// ^C (groupID) ̉ʓ̕1̃VU[`Ɏ܂邩 (`ȂΏ true)
+// ܂Ȃ^C͋`̊ÕsNZȂ̂ŁAt@XgNÃtO𗧂ĂȂ
+bool IsTileInsideScissor(uint2 groupID)
+{
+    if (ScissorRectCount == 0) return true;
+
+    uint2 tileMin = groupID * uint2(TILE_WIDTH, TILE_HEIGHT);
+    uint2 tileMax = min(tileMin + uint2(TILE_WIDTH, TILE_HEIGHT), uint2(ScreenSize));
+    for (uint r = 0; r < ScissorRectCount; ++r)
+    {
+        uint4 rect = ScissorRects[r];
+        if (all(tileMin >= rect.xy) && all(tileMax <= rect.zw)) return true;
+    }
+    return false;
 }
 
 // --- C֐ ---
-[numthreads(16, 16, 1)]
-void CSMain(uint3 dispatchThreadID : SV_DispatchThreadID)
+[numthreads(TILE_WIDTH, TILE_HEIGHT, 1)]
+void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 dispatchGroupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
 {
+    // h^C (VU[`΁A`ƏdȂ^Cׂ ScissorTiles )
+    uint2 groupID = dispatchGroupID.xy;
+    if (ScissorRectCount > 0)
+    {
+        uint listIndex = dispatchGroupID.y * ScissorDispatchWidth + dispatchGroupID.x;
+        if (listIndex >= ScissorTileCount) return; // O[vŜœȂ̂œɉeȂ
+        uint packedTile = ScissorTiles[listIndex];
+        groupID = uint2(packedTile & 0xFFFF, packedTile >> 16);
+    }
+    uint2 pixel = groupID * uint2(TILE_WIDTH, TILE_HEIGHT) + groupThreadID.xy;
+
     // ݏ̃sNZW (S)
-    float2 p = float2(dispatchThreadID.x, dispatchThreadID.y) + 0.5f;
+    float2 p = float2(pixel) + 0.5f;
 
-    // ʊO`FbN
-    if (p.x >= ScreenSize.x || p.y >= ScreenSize.y) return;
+    // ʊO`FbN (O[vŜœ邽߁A茋ʂێĂBVU[`̊OʊOƂĈ)
+    bool insideScreen = p.x < ScreenSize.x && p.y < ScreenSize.y && IsInsideScissor(pixel);
 
-    // [xobt@̏l (1.0 = ł)
-    float bestDepth = 1.0f;
+    // [xobt@̏l (łBreversed-Z Ȃ 0)
+    float bestDepth = DEPTH_CLEAR;
     // wiF (NAJ[)
-    float4 bestColor = float4(0.1f, 0.1f, 0.15f, 1.0f);
+    float4 bestColor = ClearColor;
+    bool covered = false;
+#if RASTER_SAMPLES > 1
+    BeginCoverageSamples();
+#endif
+
+    if (groupIndex == 0)
+    {
+        gs_TileCovered = 0;
+        gs_DepthPassFragments = 0;
+        gs_ShadedFragments = 0;
+        gs_CoveredPixels = 0;
+        gs_CoverageFragments = 0;
+#if RASTER_VRS
+        gs_SharedShades = 0;
+#endif
+#if RASTER_LIGHTING
+        gs_TileDepthMin = 0xFFFFFFFF;
+        gs_TileDepthMax = 0;
+        gs_TileLightCount = 0;
+#endif
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // ÓIV[: BVH Ń^CƏdȂOp`W߂ (O[vŜœ)
+    bool collected = false;
+    if (BvhNodeCount > 0)
+    {
+        float2 tileMin = float2(groupID * uint2(TILE_WIDTH, TILE_HEIGHT));
+        float2 tileMax = tileMin + float2(TILE_WIDTH, TILE_HEIGHT);
+        collected = CollectTileTriangles(groupIndex, tileMin, tileMax);
+    }
+
+    if (insideScreen)
+    {
+#if RASTER_VRS || RASTER_DEPTH_PREPASS
+        RasterizeScene(RASTER_PASS_DEPTH, p, collected, bestDepth, bestColor, covered);
+#else
+        RasterizeScene(RASTER_PASS_FULL, p, collected, bestDepth, bestColor, covered);
+#endif
+    }
+#if RASTER_LIGHTING
+    // [x̃pXŌ܂^C̐[x͈̔͂ŁAhOɃ^Cɓ͂CgW߂ (O[vŜœ)
+    CullTileLights(groupID, groupIndex, insideScreen, bestDepth);
+#endif
+#if RASTER_DEPTH_PREPASS
+    if (insideScreen)
+    {
+        RasterizeScene(RASTER_PASS_SHADE, p, collected, bestDepth, bestColor, covered);
+    }
+#endif
+#if RASTER_VRS
+    ShadeVariableRate(pixel, groupID, groupIndex, insideScreen, bestColor, covered);
+#endif
+
+    // vO[vōv (̓̌ɃXbh 0  RasterStats ֑)
+    InterlockedAdd(gs_DepthPassFragments, s_DepthPassFragments);
+    InterlockedAdd(gs_ShadedFragments, s_ShadedFragments);
+    InterlockedAdd(gs_CoveredPixels, covered ? 1 : 0);
+#if RASTER_VRS
+    InterlockedAdd(gs_SharedShades, s_SharedShades);
+#endif
+#if RASTER_SAMPLES > 1
+    // c̃tOgO[vŕׁA̓̌ɃXbh 0 O[v̕܂Ƃ߂ CoverageFragments 犄蓖Ă
+    uint coverageOffset = 0;
+    InterlockedAdd(gs_CoverageFragments, insideScreen ? s_FragmentCount - 1 : 0, coverageOffset);
+#endif
 
     // ----------------------------------------------------------------
-    // SOp`[v (sNZ哱_O)
+    // t@XgNA: ǂ̃sNZɂOp``Ȃ^C̓NAtO𗧂āA
+    // Õt[łNAꂽ܂ (F̓NAJ[A[x DEPTH_CLEAR) Ȃ牽Ȃ
+    // VU[`͂ݏo^C͋`̊OȂ̂ŁAONAĂƂtOc
     // ----------------------------------------------------------------
-    for (uint i = 0; i < TriangleCount; ++i)
+    uint tileIndex = TileClearFlagIndex(groupID);
+    bool wasCleared = TileClearFlags[tileIndex] != 0;
+
+    if (covered)
     {
-        // _f[^̎擾
-        uint idx = i * 3;
-        Vertex v0_raw = VertexBuffer[idx];
-        Vertex v1_raw = VertexBuffer[idx + 1];
-        Vertex v2_raw = VertexBuffer[idx + 2];
-
-        // 1. _ϊ (Local -> Clip Space)
-        float4 c0 = mul(float4(v0_raw.pos, 1.0f), WorldViewProj);
-        float4 c1 = mul(float4(v1_raw.pos, 1.0f), WorldViewProj);
-        float4 c2 = mul(float4(v2_raw.pos, 1.0f), WorldViewProj);
-
-        // 2. p[XyNeBu␳̏ (1/W vZ)
-        // W̓J̐[x܂݂܂
-        float invW0 = 1.0f / c0.w;
-        float invW1 = 1.0f / c1.w;
-        float invW2 = 1.0f / c2.w;
-
-        // 3. XN[Wւ̕ϊ (Viewport Transform)
-        // NDC (-1~1) -> Screen (0~w, 0~h)
-        float2 s0, s1, s2;
-        s0.x = (c0.x * invW0 + 1.0f) * 0.5f * ScreenSize.x;
-        s0.y = (1.0f - c0.y * invW0) * 0.5f * ScreenSize.y; // Y]
-
-        s1.x = (c1.x * invW1 + 1.0f) * 0.5f * ScreenSize.x;
-        s1.y = (1.0f - c1.y * invW1) * 0.5f * ScreenSize.y;
-
-        s2.x = (c2.x * invW2 + 1.0f) * 0.5f * ScreenSize.x;
-        s2.y = (1.0f - c2.y * invW2) * 0.5f * ScreenSize.y;
-
-        // 4. X^CY (GbW֐)
-        float area = EdgeFunction(s0, s1, s2);
-
-        // obNtFCXJO (v𐳂ƂꍇAȂ痠)
-        if (area <= 0) continue;
-
-        float w0 = EdgeFunction(s1, s2, p);
-        float w1 = EdgeFunction(s2, s0, p);
-        float w2 = EdgeFunction(s0, s1, p); // vZ
-
-        // 5. Op`̓O
-        if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
-            // dSW̐K
-            w0 /= area;
-            w1 /= area;
-            w2 /= area;
-
-            // 6. [xeXg (Zl̐`)
-            // NDCZ (c.z / c.w) Ԃ̂ʓIłA
-            // ł͊ȈՓI W ̋tgĐ[x肵܂ (1/W傫=W=O)
-            float interpolatedInvW = w0 * invW0 + w1 * invW1 + w2 * invW2;
-            float currentW = 1.0f / interpolatedInvW;
-
-            // [xobt@XV`FbN (WO)
-            // NDC[x(0~1)gꍇ z < bestDepth
-            // ł͊ȈՓIZeXgƂĔr
-            float currentDepth = c0.z * invW0 * w0 + c1.z * invW1 * w1 + c2.z * invW2 * w2;
-            currentDepth *= currentW; // 
-
-            if (currentDepth < bestDepth) {
-                bestDepth = currentDepth;
-
-                // 7. p[XyNeBuERNg (dv)
-                // UVColor͒ w0,w1,w2 ŕԂƘcނ߁A
-                // x (Value / W) ԂAŌ W |ĕB
-
-                // UV̕
-                float2 uv0_p = v0_raw.uv * invW0;
-                float2 uv1_p = v1_raw.uv * invW1;
-                float2 uv2_p = v2_raw.uv * invW2;
-
-                float2 finalUV = (w0 * uv0_p + w1 * uv1_p + w2 * uv2_p) * currentW;
-
-                // Color̕
-                float4 col0_p = v0_raw.color * invW0;
-                float4 col1_p = v1_raw.color * invW1;
-                float4 col2_p = v2_raw.color * invW2;
-
-                float4 finalVertexColor = (w0 * col0_p + w1 * col1_p + w2 * col2_p) * currentW;
-
-                // eNX`TvO
-                float4 texColor = BaseTexture.SampleLevel(BaseSampler, finalUV, 0);
-
-                // ŏIJ[
-                bestColor = finalVertexColor * texColor;
-            }
+        gs_TileCovered = 1;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    bool tileCleared = gs_TileCovered == 0 && (wasCleared || IsTileInsideScissor(groupID));
+    if (groupIndex == 0)
+    {
+        if (tileCleared != wasCleared)
+        {
+            TileClearFlags[tileIndex] = tileCleared ? 1 : 0;
         }
+        RasterStats.InterlockedAdd(RASTER_STATS_DEPTH_PASS_FRAGMENTS, gs_DepthPassFragments);
+        RasterStats.InterlockedAdd(RASTER_STATS_SHADED_FRAGMENTS, gs_ShadedFragments);
+        RasterStats.InterlockedAdd(RASTER_STATS_COVERED_PIXELS, gs_CoveredPixels);
+#if RASTER_VRS
+        RasterStats.InterlockedAdd(RASTER_STATS_SHARED_SHADES, gs_SharedShades);
+#endif
+#if RASTER_LIGHTING
+        RasterStats.InterlockedAdd(RASTER_STATS_TILE_LIGHTS, min(gs_TileLightCount, MAX_TILE_LIGHTS));
+        RasterStats.InterlockedAdd(RASTER_STATS_OVERFLOWED_LIGHT_TILES, gs_TileLightCount > MAX_TILE_LIGHTS ? 1 : 0);
+#endif
+#if RASTER_SAMPLES > 1
+        RasterStats.InterlockedAdd(RASTER_STATS_COVERAGE_FRAGMENTS, gs_CoverageFragments, gs_CoverageFragmentBase);
+#endif
+    }
+
+#if RASTER_SAMPLES > 1
+    // kTv͖SsNZ (OutputTexture  CSResolveCoverage )
+    GroupMemoryBarrierWithGroupSync();
+    if (insideScreen)
+    {
+        StoreCoverageSamples(pixel, gs_CoverageFragmentBase + coverageOffset);
+        DepthBuffer[pixel] = EncodeDepth(ClosestSampleDepth());
     }
+#else
+    if (tileCleared && wasCleared) return;
 
     // ʏ
-    OutputTexture[dispatchThreadID.xy] = bestColor;
-}
\ No newline at end of file
+    if (insideScreen)
+    {
+        OutputTexture[pixel] = bestColor;
+        DepthBuffer[pixel] = EncodeDepth(bestDepth);
+#if RASTER_GBUFFER
+        WriteGBuffer(pixel, p, covered ? s_VisibleTriangle : NO_TRIANGLE, bestColor);
+#endif
+    }
+#endif
+}
+
+#if !RASTER_GBUFFER
+// --- JobW}XÑA`GCAX̉ ---
+// CSMain (RASTER_SAMPLES > 1) kTvAtOg̐F}XÑTvŏdݕtĕς OutputTexture ֏
+// Tv̓}XN̍v番̂ŁA}NɈ˂炸1̃VF[_[ 4x / 8x 
+[numthreads(8, 8, 1)]
+void CSResolveCoverage(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    if (dispatchThreadID.x >= uint(ScreenSize.x) || dispatchThreadID.y >= uint(ScreenSize.y)) return;
+    if (!IsInsideScissor(dispatchThreadID.xy)) return;
+
+    uint2 header = CoveragePixels[dispatchThreadID.y * uint(ScreenSize.x) + dispatchThreadID.x];
+    uint sampleCount = countbits(header.y & COVERAGE_MASK_BITS);
+    float4 color = UnpackColor(header.x) * sampleCount;
+
+    uint extraCount = (header.y >> COVERAGE_COUNT_SHIFT) & 0x7;
+    uint extraOffset = header.y >> COVERAGE_OFFSET_SHIFT;
+    for (uint e = 0; e < extraCount; ++e)
+    {
+        uint2 fragment = CoverageFragments[extraOffset + e];
+        uint fragmentSamples = countbits(fragment.y);
+        color += UnpackColor(fragment.x) * fragmentSamples;
+        sampleCount += fragmentSamples;
+    }
+
+    OutputTexture[dispatchThreadID.xy] = color / max(sampleCount, 1u);
+}
+
+// --- }`r[ ---
+// MULTI_VIEW_COUNT ̃r[1 Dispatch ŕ`BeXbh͑Sr[̓sNZ󂯎A
+// Op`1xǂŃr[Ƃɕϊ (BVHAbVbgJOA[xvpXAt@XgNA͎gȂ)
+[numthreads(TILE_WIDTH, TILE_HEIGHT, 1)]
+void CSMainMultiView(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    float2 p = float2(dispatchThreadID.x, dispatchThreadID.y) + 0.5f;
+    if (p.x >= ScreenSize.x || p.y >= ScreenSize.y) return;
+
+    float bestDepth[MULTI_VIEW_COUNT];
+    float4 bestColor[MULTI_VIEW_COUNT];
+    bool covered[MULTI_VIEW_COUNT];
+    [unroll] for (uint v = 0; v < MULTI_VIEW_COUNT; ++v)
+    {
+        bestDepth[v] = DEPTH_CLEAR;
+        bestColor[v] = ClearColor;
+        covered[v] = false;
+    }
+
+    for (uint i = 0; i < TriangleCount; ++i)
+    {
+        Vertex v0, v1, v2;
+        FetchTriangle(i, v0, v1, v2);
+
+        [unroll] for (uint v = 0; v < MULTI_VIEW_COUNT; ++v)
+        {
+            RasterizeTriangleView(RASTER_PASS_FULL, i, v0, v1, v2, ViewWorldViewProj[v], p, bestDepth[v], bestColor[v], covered[v]);
+        }
+    }
+
+    [unroll] for (uint v = 0; v < MULTI_VIEW_COUNT; ++v)
+    {
+        MultiViewOutput[uint3(dispatchThreadID.xy, v)] = bestColor[v];
+        MultiViewDepth[uint3(dispatchThreadID.xy, v)] = EncodeDepth(bestDepth[v]);
+    }
+}
+#endif
+
+// --- [x̕` (VhE}bv) ---
+// WorldViewProj ̓Cg̍sAScreenSize ̓VhE}bv̉𑜓xADepthBuffer ̓VhE}bvB
+// ̕ԂƃeNX`ǂ܂A[x] (BVHAbVbgAt@XgNA͎gȂ)
+
+// Op` i ̐[xsNZ p ɑ΂ĕ]AOł bestDepth XV
+void RasterizeTriangleDepth(uint i, float2 p, inout float bestDepth)
+{
+    Vertex v0, v1, v2;
+    FetchTriangle(i, v0, v1, v2);
+
+    float4 c0 = mul(float4(v0.pos, 1.0f), WorldViewProj);
+    float4 c1 = mul(float4(v1.pos, 1.0f), WorldViewProj);
+    float4 c2 = mul(float4(v2.pos, 1.0f), WorldViewProj);
+    if (min(c0.w, min(c1.w, c2.w)) <= c_MinClipW) return;
+
+    float3 invW = 1.0f / float3(c0.w, c1.w, c2.w);
+    float2 s0 = float2(c0.x * invW.x + 1.0f, 1.0f - c0.y * invW.x) * 0.5f * ScreenSize;
+    float2 s1 = float2(c1.x * invW.y + 1.0f, 1.0f - c1.y * invW.y) * 0.5f * ScreenSize;
+    float2 s2 = float2(c2.x * invW.z + 1.0f, 1.0f - c2.y * invW.z) * 0.5f * ScreenSize;
+
+    float area = EdgeFunction(s0, s1, s2);
+#if RASTER_CULL_MODE == RASTER_CULL_BACK
+    if (area <= 0) return;
+#elif RASTER_CULL_MODE == RASTER_CULL_FRONT
+    if (area >= 0) return;
+#else
+    if (area == 0) return;
+#endif
+
+    float3 edges = float3(EdgeFunction(s1, s2, p), EdgeFunction(s2, s0, p), EdgeFunction(s0, s1, p));
+#if RASTER_CONSERVATIVE
+    if (!IsPixelCoveredConservative(s0, s1, s2, area, edges, p)) return;
+#else
+    if (any(edges / area < 0)) return;
+#endif
+    float3 w = edges / area;
+
+    // NDC  Z (CSMain Ɠ W |Ȃ)
+    float3 z = float3(c0.z, c1.z, c2.z) * invW;
+    float depth = dot(w, z);
+#if RASTER_CONSERVATIVE == RASTER_CONSERVATIVE_OVER
+    // Op`̊ÕsNZSł͊O}ɂȂ̂ŁA_̐[x͈̔͂Ɏ߂
+    depth = clamp(depth, min(z.x, min(z.y, z.z)), max(z.x, max(z.y, z.z)));
+#endif
+    depth = QuantizeDepth(depth);
+
+    if (DEPTH_CLOSER(depth, bestDepth))
+    {
+        bestDepth = depth;
+    }
+}
+
+[numthreads(TILE_WIDTH, TILE_HEIGHT, 1)]
+void CSMainDepthOnly(uint3 dispatchThreadID : SV_DispatchThreadID)
+{
+    float2 p = float2(dispatchThreadID.x, dispatchThreadID.y) + 0.5f;
+    if (p.x >= ScreenSize.x || p.y >= ScreenSize.y) return;
+
+    float bestDepth = DEPTH_CLEAR;
+    for (uint i = 0; i < TriangleCount; ++i)
+    {
+        RasterizeTriangleDepth(i, p, bestDepth);
+    }
+
+    DepthBuffer[dispatchThreadID.xy] = EncodeDepth(bestDepth);
+}
@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "UploadRing.h"
+#include <algorithm>
+
+void UploadRing::Initialize(ID3D11Device* device, uint32_t capacity)
+{
+    // 1̊mۂ̓O 1/c_FramesInFlight ܂łȂ̂ŁAꂪ 0 byte ɂȂ傫ł͍XV𕪊łȂ
+    if (capacity < c_FramesInFlight)
+    {
+        OutputDebugStringA("Upload ring capacity is too small\n");
+        throw std::runtime_error("Upload ring capacity is too small");
+    }
+
+    // DYNAMIC obt@̓oChtOK{Ȃ̂ŁANO_OVERWRITE Ɏg钸_obt@Ƃč쐬
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = capacity;
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, pUploadBuffer.ReleaseAndGetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create upload ring buffer\n");
+        throw std::runtime_error("Failed to create upload ring buffer");
+    }
+
+    D3D11_QUERY_DESC queryDesc = {};
+    queryDesc.Query = D3D11_QUERY_EVENT;
+
+    for (auto& fence : pFrameFences)
+    {
+        hr = device->CreateQuery(&queryDesc, fence.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to create upload ring fence\n");
+            throw std::runtime_error("Failed to create upload ring fence");
+        }
+    }
+
+    m_allocator.Reset(capacity);
+    m_frameIndex = 1;
+    m_completedFrameIndex = 0;
+    m_reportedOverflow = false;
+    OutputDebugStringA("Upload ring created successfully\n");
+}
+
+void UploadRing::Upload(ID3D11DeviceContext* context, ID3D11Buffer* destination, uint32_t destinationOffset, const void* data, uint32_t size)
+{
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+
+    // 1̊mۂ̓O 1/c_FramesInFlight ܂ (傫ȍXV͕āÃt[͈̔͂Ƌ)
+    const uint32_t maxChunkSize = static_cast<uint32_t>(m_allocator.GetCapacity() / c_FramesInFlight);
+
+    while (size > 0)
+    {
+        const uint32_t chunkSize = std::min(size, maxChunkSize);
+
+        uint64_t offset = m_allocator.Allocate(chunkSize);
+        while (offset == RingAllocator::c_InvalidOffset && m_allocator.HasPendingFrames())
+        {
+            // O܂Ă: łÂt[̊҂ĉ
+            WaitForFrame(context, m_allocator.GetOldestPendingFrame());
+            offset = m_allocator.Allocate(chunkSize);
+        }
+
+        if (offset == RingAllocator::c_InvalidOffset)
+        {
+            // ̃t[ŃOg؂: hCooR UpdateSubresource ōXV
+            if (!m_reportedOverflow)
+            {
+                OutputDebugStringA("Upload ring overflow, falling back to UpdateSubresource\n");
+                m_reportedOverflow = true;
+            }
+
+            D3D11_BOX box = { destinationOffset, 0, 0, destinationOffset + chunkSize, 1, 1 };
+            context->UpdateSubresource(destination, 0, &box, source, 0, 0);
+        }
+        else
+        {
+            // 擪珑 (ŏ̊mۂA܂Ԃ) Ƃ DISCARD Ńobt@ւAȊO NO_OVERWRITE ŒǋL
+            // DISCARD ̑Oɐς񂾃Rs[͌Âobt@ǂނ̂ŁAGPU ͈̔͂㏑邱Ƃ͂Ȃ
+            const D3D11_MAP mapType = offset == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+
+            D3D11_MAPPED_SUBRESOURCE mapped;
+            HRESULT hr = context->Map(pUploadBuffer.Get(), 0, mapType, 0, &mapped);
+            if (FAILED(hr))
+            {
+                OutputDebugStringA("Failed to map upload ring buffer\n");
+                throw std::runtime_error("Failed to map upload ring buffer");
+            }
+            memcpy(static_cast<uint8_t*>(mapped.pData) + offset, source, chunkSize);
+            context->Unmap(pUploadBuffer.Get(), 0);
+
+            const UINT begin = static_cast<UINT>(offset);
+            D3D11_BOX box = { begin, 0, 0, begin + chunkSize, 1, 1 };
+            context->CopySubresourceRegion(destination, 0, destinationOffset, 0, 0, pUploadBuffer.Get(), 0, &box);
+        }
+
+        source += chunkSize;
+        destinationOffset += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+void UploadRing::EndFrame(ID3D11DeviceContext* context)
+{
+    // tFXg c_FramesInFlight t[O̊҂ (GPU  c_FramesInFlight t[ȏxꂽꍇ̂ݎ~܂)
+    if (m_frameIndex > c_FramesInFlight)
+    {
+        WaitForFrame(context, m_frameIndex - c_FramesInFlight);
+    }
+
+    context->End(pFrameFences[m_frameIndex % c_FramesInFlight].Get());
+    m_allocator.FinishFrame(m_frameIndex);
+    ++m_frameIndex;
+
+    RetireCompletedFrames(context);
+}
+
+void UploadRing::RetireCompletedFrames(ID3D11DeviceContext* context)
+{
+    // tFX͔sɊ̂ŁAĂȂ̂_őł؂
+    while (m_completedFrameIndex + 1 < m_frameIndex)
+    {
+        ID3D11Query* fence = pFrameFences[(m_completedFrameIndex + 1) % c_FramesInFlight].Get();
+        const HRESULT hr = context->GetData(fence, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH);
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to query upload ring fence\n");
+            throw std::runtime_error("Failed to query upload ring fence");
+        }
+        if (hr != S_OK)
+        {
+            break;
+        }
+        ++m_completedFrameIndex;
+    }
+
+    m_allocator.Retire(m_completedFrameIndex);
+}
+
+void UploadRing::WaitForFrame(ID3D11DeviceContext* context, uint64_t frameIndex)
+{
+    while (m_completedFrameIndex < frameIndex)
+    {
+        // ҂ꍇ̓R}htbVȂƊȂ
+        // foCX̍폜ȂǂŎsꍇ͊ƂɂA͈͂Ȃ
+        ID3D11Query* fence = pFrameFences[(m_completedFrameIndex + 1) % c_FramesInFlight].Get();
+        HRESULT hr;
+        while ((hr = context->GetData(fence, nullptr, 0, 0)) == S_FALSE)
+        {
+            SwitchToThread();
+        }
+        if (FAILED(hr))
+        {
+            OutputDebugStringA("Failed to query upload ring fence\n");
+            throw std::runtime_error("Failed to query upload ring fence");
+        }
+        ++m_completedFrameIndex;
+    }
+
+    m_allocator.Retire(m_completedFrameIndex);
+}
\ No newline at end of file
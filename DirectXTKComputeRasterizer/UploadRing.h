@@ -0,0 +1,39 @@
+#pragma once
+#include "RingAllocator.h"
+#include <wrl.h>
+
+// ==================================================================================
+// DEFAULT obt@̕XVÕAbv[hobt@oRōs
+// ݂ GPU ǂłȂ͈͂ɂ WRITE_NO_OVERWRITE ōs (O̐擪珑Ƃ WRITE_DISCARD)A
+// CopySubresourceRegion œ]B
+// ͈͂̍ėp̓t[Ƃ̃CxgNG (tFX) ĂŝŁA
+// CPU ͍ő c_FramesInFlight t[܂ GPU ҂ɐsłB
+// ==================================================================================
+class UploadRing
+{
+public:
+    static constexpr uint32_t c_FramesInFlight = 3;
+
+    void Initialize(ID3D11Device* device, uint32_t capacity = c_DefaultUploadRingSize);
+
+    // data (size byte)  destination  destinationOffset ֏
+    // Rs[̓ReLXg̏ǂɎŝŁAȍ~ Dispatch ͍XV̓e
+    void Upload(ID3D11DeviceContext* context, ID3D11Buffer* destination, uint32_t destinationOffset, const void* data, uint32_t size);
+
+    // t[̏I[ŃtFXłAGPU It[͈̔͂
+    void EndFrame(ID3D11DeviceContext* context);
+
+    uint64_t GetFrameIndex() const { return m_frameIndex; }
+    uint64_t GetCompletedFrameIndex() const { return m_completedFrameIndex; }
+
+private:
+    void RetireCompletedFrames(ID3D11DeviceContext* context);
+    void WaitForFrame(ID3D11DeviceContext* context, uint64_t frameIndex);
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> pUploadBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Query> pFrameFences[c_FramesInFlight];
+    RingAllocator m_allocator;
+    uint64_t m_frameIndex = 1;          // L^̃t[ (tFX m_frameIndex % c_FramesInFlight)
+    uint64_t m_completedFrameIndex = 0; // GPU IŌ̃t[
+    bool m_reportedOverflow = false;
+};
\ No newline at end of file
@@ -0,0 +1,450 @@
+// ==================================================================================
+// MeshConverter.cpp
+// Wavefront OBJ  .dxrmesh (MeshFile.h) ɁA_Q̃eLXg (.xyz)  .dxrpoints (PointCloudFile.h) 
+// ϊc[ƁA.dxrmesh ̓ǂݍݑx̌v
+//
+//   MeshConverter [-nooptimize] [-nomeshlets] [-morton] <input.obj> <output.dxrmesh>
+//   MeshConverter -points <input.xyz> <output.dxrpoints>
+//   MeshConverter -benchmark <input.dxrmesh> [iterations]
+// ==================================================================================
+
+#include "pch.h"
+#include "MeshFile.h"
+#include "MeshletBuilder.h"
+#include "BvhBuilder.h"
+#include "MeshOptimizer.h"
+#include "PointCloudFile.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+using namespace DirectX;
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    double ToMegabytes(uint64_t bytes)
+    {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    // s̋󔒂΂
+    const char* SkipSpaces(const char* p, const char* end)
+    {
+        while (p < end && (*p == ' ' || *p == '\t'))
+        {
+            ++p;
+        }
+        return p;
+    }
+
+    // OBJ ̖ʗvf "v", "v/vt", "v//vn", "v/vt/vn" ʒu UV ̃CfbNXo (0 n܂, UV Ȃ -1)
+    bool ParseFaceVertex(const char*& p, const char* end, size_t positionCount, size_t uvCount, int64_t& position, int64_t& uv)
+    {
+        p = SkipSpaces(p, end);
+        if (p >= end || *p == '\r' || *p == '\n')
+        {
+            return false;
+        }
+
+        char* next = nullptr;
+        long long v = strtoll(p, &next, 10);
+        p = next;
+        position = v < 0 ? static_cast<int64_t>(positionCount) + v : v - 1;
+        uv = -1;
+
+        if (p < end && *p == '/')
+        {
+            ++p;
+            if (p < end && *p != '/')
+            {
+                long long t = strtoll(p, &next, 10);
+                p = next;
+                uv = t < 0 ? static_cast<int64_t>(uvCount) + t : t - 1;
+            }
+            if (p < end && *p == '/')
+            {
+                ++p;
+                strtoll(p, &next, 10); // @͎gȂ (ʖ@̓VF[_[ŋ߂)
+                p = next;
+            }
+        }
+        return position >= 0 && position < static_cast<int64_t>(positionCount);
+    }
+
+    // OBJ ǂݍ݁Aʒu UV ̑gݍ킹Ƃɒ_ăCfbNXtOp`Xgɂ
+    // "v x y z r g b" `̒_J[ɂΉ (ȂΔ)
+    void LoadObj(const std::filesystem::path& fileName, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        std::ifstream stream(fileName, std::ios::binary);
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to open OBJ file");
+        }
+        std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        std::vector<XMFLOAT3> positions;
+        std::vector<XMFLOAT4> colors;
+        std::vector<XMFLOAT2> uvs;
+        std::unordered_map<uint64_t, uint32_t> vertexMap;
+        std::vector<uint32_t> polygon;
+
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end)
+        {
+            const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (lineEnd == nullptr)
+            {
+                lineEnd = end;
+            }
+
+            p = SkipSpaces(p, lineEnd);
+            char* next = nullptr;
+            if (lineEnd - p > 2 && p[0] == 'v' && p[1] == ' ')
+            {
+                XMFLOAT3 position;
+                position.x = strtof(p + 2, &next);
+                position.y = strtof(next, &next);
+                position.z = strtof(next, &next);
+                positions.push_back(position);
+
+                XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+                const char* rest = SkipSpaces(next, lineEnd);
+                if (rest < lineEnd && *rest != '\r')
+                {
+                    color.x = strtof(rest, &next);
+                    color.y = strtof(next, &next);
+                    color.z = strtof(next, &next);
+                }
+                colors.push_back(color);
+            }
+            else if (lineEnd - p > 3 && p[0] == 'v' && p[1] == 't' && p[2] == ' ')
+            {
+                XMFLOAT2 uv;
+                uv.x = strtof(p + 3, &next);
+                uv.y = 1.0f - strtof(next, &next); // OBJ ͍_, D3D ͍㌴_
+                uvs.push_back(uv);
+            }
+            else if (lineEnd - p > 2 && p[0] == 'f' && p[1] == ' ')
+            {
+                polygon.clear();
+                const char* f = p + 2;
+                int64_t position, uv;
+                while (ParseFaceVertex(f, lineEnd, positions.size(), uvs.size(), position, uv))
+                {
+                    uint64_t key = (static_cast<uint64_t>(position) << 32) | static_cast<uint32_t>(uv);
+                    auto [it, inserted] = vertexMap.try_emplace(key, static_cast<uint32_t>(vertices.size()));
+                    if (inserted)
+                    {
+                        Vertex vertex = {};
+                        vertex.pos = positions[position];
+                        vertex.color = colors[position];
+                        vertex.uv = (uv >= 0 && uv < static_cast<int64_t>(uvs.size())) ? uvs[uv] : XMFLOAT2(0.0f, 0.0f);
+                        vertices.push_back(vertex);
+                    }
+                    polygon.push_back(it->second);
+                }
+
+                // p`͐`ɎOp`
+                for (size_t i = 2; i < polygon.size(); ++i)
+                {
+                    indices.push_back(polygon[0]);
+                    indices.push_back(polygon[i - 1]);
+                    indices.push_back(polygon[i]);
+                }
+            }
+
+            p = lineEnd + 1;
+        }
+    }
+
+    struct ConvertOptions
+    {
+        bool optimize = true;  // _LbV / _tFb`̍œK
+        bool meshlets = true;  // bVbg̍\z
+        bool morton = false;   // bVbgȂꍇɁAOp`IuWFNgԂ Morton ɕׂ
+    };
+
+    void PrintMeshStats(const wchar_t* label, const MeshData& mesh)
+    {
+        const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        VertexCacheStats cache = AnalyzeVertexCache(mesh.indices, vertexCount);
+        VertexFetchStats fetch = AnalyzeVertexFetch(mesh.indices, vertexCount);
+        wprintf(L"  %-7ls ACMR %.3f, ATVR %.3f, fetch miss rate %.1f%%, overfetch %.2fx\n",
+                label, cache.acmr, cache.atvr, fetch.missRate * 100.0f, fetch.overfetch);
+    }
+
+    int Convert(const wchar_t* inputName, const wchar_t* outputName, const ConvertOptions& options)
+    {
+        auto start = Clock::now();
+
+        MeshData mesh;
+        LoadObj(inputName, mesh.vertices, mesh.indices);
+        if (mesh.indices.empty())
+        {
+            wprintf(L"No triangles in %ls\n", inputName);
+            return 1;
+        }
+        double parseSeconds = SecondsSince(start);
+
+        // Op`̕בւׂ͂ BVH ̍\zOɍς܂ (BVH ͎Op`ԍQƂ)
+        auto buildStart = Clock::now();
+        MeshData input;
+        input.vertices = mesh.vertices;
+        input.indices = mesh.indices;
+
+        // LbVœK͔͈͓ŕ̂ŁAbVbg (܂ Morton ̃ubN) Ƃɍs
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;
+        const uint32_t triangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+        if (options.meshlets)
+        {
+            mesh.meshlets = BuildMeshlets(mesh.vertices, mesh.indices);
+            for (const auto& meshlet : mesh.meshlets)
+            {
+                ranges.emplace_back(meshlet.firstTriangle, meshlet.triangleCount);
+            }
+        }
+        else if (options.morton)
+        {
+            SortTrianglesMorton(mesh.vertices, mesh.indices);
+            for (uint32_t first = 0; first < triangleCount; first += c_MortonBlockTriangles)
+            {
+                ranges.emplace_back(first, std::min(c_MortonBlockTriangles, triangleCount - first));
+            }
+        }
+        else
+        {
+            ranges.emplace_back(0u, triangleCount);
+        }
+
+        // bVbg / Morton ̕בւ̌ALbVœK̑Ȍ (œǨʂׂ)
+        MeshData clustered;
+        clustered.vertices = mesh.vertices;
+        clustered.indices = mesh.indices;
+
+        if (options.optimize)
+        {
+            for (const auto& [first, count] : ranges)
+            {
+                OptimizeVertexCache(mesh.indices, static_cast<uint32_t>(mesh.vertices.size()), first, count);
+            }
+            OptimizeVertexFetch(mesh.vertices, mesh.indices);
+        }
+
+        mesh.bvh = BuildBvh(mesh.vertices, mesh.indices);
+        double buildSeconds = SecondsSince(buildStart);
+
+        WriteMeshFile(outputName, mesh);
+
+        wprintf(L"%ls -> %ls\n", inputName, outputName);
+        wprintf(L"  %zu vertices, %zu triangles, %zu meshlets, %zu BVH nodes\n",
+                mesh.vertices.size(), mesh.indices.size() / 3, mesh.meshlets.size(), mesh.bvh.nodes.size());
+        wprintf(L"  parse %.1f ms, build %.1f ms, %.1f MB written\n",
+                parseSeconds * 1000.0, buildSeconds * 1000.0, ToMegabytes(std::filesystem::file_size(outputName)));
+
+        PrintMeshStats(L"input", input);
+        if (options.meshlets || options.morton)
+        {
+            PrintMeshStats(options.meshlets ? L"meshlet" : L"morton", clustered);
+        }
+        if (options.optimize)
+        {
+            PrintMeshStats(L"output", mesh);
+        }
+        return 0;
+    }
+
+    // "x y z [r g b]" ̍sׂ_Q (F 0 ~ 255AȂΔ) ǂݍ
+    // l 3̍s (Rg .pts ̓_̍s) ͔΂
+    void LoadPoints(const std::filesystem::path& fileName, std::vector<PointVertex>& points)
+    {
+        std::ifstream stream(fileName, std::ios::binary);
+        if (!stream)
+        {
+            throw std::runtime_error("Failed to open point cloud file");
+        }
+        std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end)
+        {
+            const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (lineEnd == nullptr)
+            {
+                lineEnd = end;
+            }
+
+            // szēǂ܂Ȃ悤A1sɎ܂鐔𐔂
+            float values[6];
+            uint32_t valueCount = 0;
+            const char* q = SkipSpaces(p, lineEnd);
+            while (valueCount < 6 && q < lineEnd && *q != '\r' && *q != '#')
+            {
+                char* next = nullptr;
+                values[valueCount] = strtof(q, &next);
+                if (next == q || next > lineEnd)
+                {
+                    break;
+                }
+                ++valueCount;
+                q = SkipSpaces(next, lineEnd);
+            }
+
+            if (valueCount >= 3)
+            {
+                PointVertex point;
+                point.pos = XMFLOAT3(values[0], values[1], values[2]);
+                point.color = 0xFFFFFFFF;
+                if (valueCount == 6)
+                {
+                    const auto channel = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 255.0f) + 0.5f); };
+                    point.color = 0xFF000000 | (channel(values[5]) << 16) | (channel(values[4]) << 8) | channel(values[3]);
+                }
+                points.push_back(point);
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+    int ConvertPoints(const wchar_t* inputName, const wchar_t* outputName)
+    {
+        auto start = Clock::now();
+        std::vector<PointVertex> points;
+        LoadPoints(inputName, points);
+        if (points.empty())
+        {
+            wprintf(L"No points in %ls\n", inputName);
+            return 1;
+        }
+        double parseSeconds = SecondsSince(start);
+
+        auto buildStart = Clock::now();
+        std::vector<PointChunk> chunks;
+        BuildPointChunks(points, chunks);
+        double buildSeconds = SecondsSince(buildStart);
+
+        WritePointCloudFile(outputName, points, chunks);
+
+        wprintf(L"%ls -> %ls\n", inputName, outputName);
+        wprintf(L"  %zu points, %zu chunks\n", points.size(), chunks.size());
+        wprintf(L"  parse %.1f ms, build %.1f ms, %.1f MB written\n",
+                parseSeconds * 1000.0, buildSeconds * 1000.0, ToMegabytes(std::filesystem::file_size(outputName)));
+        return 0;
+    }
+
+    // t@C̃}bv (+ y[W̓ǂݍ)  GPU obt@ւ̓]ɂ鎞Ԃv
+    int Benchmark(const wchar_t* fileName, int iterations)
+    {
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+        HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, 0, nullptr, 0, D3D11_SDK_VERSION,
+                                       &device, nullptr, &context);
+        if (FAILED(hr))
+        {
+            wprintf(L"Failed to create D3D11 device\n");
+            return 1;
+        }
+
+        D3D11_QUERY_DESC queryDesc = { D3D11_QUERY_EVENT, 0 };
+        Microsoft::WRL::ComPtr<ID3D11Query> query;
+        DX::ThrowIfFailed(device->CreateQuery(&queryDesc, &query));
+
+        double bestMap = 1e30, bestUpload = 1e30, totalMap = 0.0, totalUpload = 0.0;
+        uint64_t fileSize = 0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            // 1. }bvASy[WɐGēǂݍ܂ (2ڈȍ~ OS ̃t@CLbVɍڂĂ)
+            auto start = Clock::now();
+            MeshFile file;
+            file.Open(fileName);
+            fileSize = file.GetFileSize();
+            const volatile uint8_t* view = reinterpret_cast<const uint8_t*>(&file.GetHeader());
+            uint32_t checksum = 0;
+            for (uint64_t offset = 0; offset < fileSize; offset += 4096)
+            {
+                checksum += view[offset];
+            }
+            double mapSeconds = SecondsSince(start);
+
+            // 2. GPU obt@ւ̓] (GPU ̃Rs[܂ő҂)
+            start = Clock::now();
+            MeshBuffers buffers;
+            CreateMeshBuffers(device.Get(), context.Get(), file, buffers);
+            context->End(query.Get());
+            context->Flush();
+            while (context->GetData(query.Get(), nullptr, 0, 0) == S_FALSE)
+            {
+                SwitchToThread();
+            }
+            double uploadSeconds = SecondsSince(start);
+
+            wprintf(L"  [%d] map %.2f ms (%.1f MB/s), upload %.2f ms (%.1f MB/s) checksum %08x\n", i,
+                    mapSeconds * 1000.0, ToMegabytes(fileSize) / mapSeconds,
+                    uploadSeconds * 1000.0, ToMegabytes(fileSize) / uploadSeconds, checksum);
+
+            bestMap = std::min(bestMap, mapSeconds);
+            bestUpload = std::min(bestUpload, uploadSeconds);
+            totalMap += mapSeconds;
+            totalUpload += uploadSeconds;
+        }
+
+        wprintf(L"%ls: %.1f MB, %d iterations\n", fileName, ToMegabytes(fileSize), iterations);
+        wprintf(L"  map + page-in : best %.1f MB/s, average %.1f MB/s\n",
+                ToMegabytes(fileSize) / bestMap, ToMegabytes(fileSize) * iterations / totalMap);
+        wprintf(L"  GPU upload    : best %.1f MB/s, average %.1f MB/s\n",
+                ToMegabytes(fileSize) / bestUpload, ToMegabytes(fileSize) * iterations / totalUpload);
+        return 0;
+    }
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+    try
+    {
+        if (argc >= 3 && wcscmp(argv[1], L"-benchmark") == 0)
+        {
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return Benchmark(argv[2], iterations);
+        }
+
+        if (argc == 4 && wcscmp(argv[1], L"-points") == 0)
+        {
+            return ConvertPoints(argv[2], argv[3]);
+        }
+
+        ConvertOptions options;
+        int arg = 1;
+        for (; arg < argc && argv[arg][0] == L'-'; ++arg)
+        {
+            if (wcscmp(argv[arg], L"-nooptimize") == 0) options.optimize = false;
+            else if (wcscmp(argv[arg], L"-nomeshlets") == 0) options.meshlets = false;
+            else if (wcscmp(argv[arg], L"-morton") == 0) options.morton = true;
+            else break;
+        }
+        if (argc - arg == 2)
+        {
+            return Convert(argv[arg], argv[arg + 1], options);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printf("Error: %s\n", e.what());
+        return 1;
+    }
+
+    wprintf(L"Usage:\n");
+    wprintf(L"  MeshConverter [-nooptimize] [-nomeshlets] [-morton] <input.obj> <output.dxrmesh>\n");
+    wprintf(L"  MeshConverter -points <input.xyz> <output.dxrpoints>\n");
+    wprintf(L"  MeshConverter -benchmark <input.dxrmesh> [iterations]\n");
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,2713 @@
+// ==================================================================================
+// RasterizerBenchmark.cpp
+// X^CŮeXe[WP̂Ōvc[
+//
+//   RasterizerBenchmark -skinning [characters] [iterations]
+//   RasterizerBenchmark -mips [iterations]
+//   RasterizerBenchmark -swizzle [iterations]
+//   RasterizerBenchmark -bc [iterations]
+//   RasterizerBenchmark -permutations [triangles] [iterations]
+//   RasterizerBenchmark -tiles [triangles] [iterations]
+//   RasterizerBenchmark -clear [iterations]
+//   RasterizerBenchmark -depth [iterations]
+//   RasterizerBenchmark -prepass [triangles] [iterations]
+//   RasterizerBenchmark -multiview [triangles] [iterations]
+//   RasterizerBenchmark -shadow [triangles] [iterations]
+//   RasterizerBenchmark -conservative [triangles] [iterations]
+//   RasterizerBenchmark -msaa [triangles] [iterations]
+//   RasterizerBenchmark -vrs [triangles] [iterations]
+//   RasterizerBenchmark -scissor [triangles] [iterations]
+//   RasterizerBenchmark -gbuffer [triangles] [iterations]
+//   RasterizerBenchmark -lights [triangles] [iterations]
+//   RasterizerBenchmark -points [points] [iterations]
+//   RasterizerBenchmark -lines [lines] [iterations]
+//   RasterizerBenchmark -dynamic [cells] [frames]
+//   RasterizerBenchmark -gpu [triangles] [iterations]
+// ==================================================================================
+
+#include "pch.h"
+#include "BvhBuilder.h"
+#include "PointCloudFile.h"
+#include "Skinning.h"
+#include "SoftwareDynamicGeometry.h"
+#include "SoftwareRasterizer.h"
+#include "SoftwareTexture.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace DirectX;
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    // VF[_[̓vWFNg̃fBNg (VS ̃fobOs̃Jg) QƂ
+    const std::wstring c_ShaderDirectory = L"..\\..\\DirectXTKComputeRasterizer\\";
+
+    double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    bool CreateDevice(Microsoft::WRL::ComPtr<ID3D11Device>& device, Microsoft::WRL::ComPtr<ID3D11DeviceContext>& context)
+    {
+        HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, 0, nullptr, 0, D3D11_SDK_VERSION,
+                                       &device, nullptr, &context);
+        if (FAILED(hr))
+        {
+            // GPU ̂Ȃ (VM  CI) ł WARP œBGPU Ԃ CPU ŎsԂɂȂ
+            hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0, nullptr, 0, D3D11_SDK_VERSION,
+                                   &device, nullptr, &context);
+            if (FAILED(hr))
+            {
+                wprintf(L"Failed to create D3D11 device\n");
+                return false;
+            }
+            wprintf(L"No hardware D3D11 device, using WARP (GPU times are software rasterizer times)\n");
+        }
+        return true;
+    }
+
+    // GPU ̃^CX^vŋԂ̎Ԃ𑪂
+    class GpuTimer
+    {
+    public:
+        explicit GpuTimer(ID3D11Device* device)
+        {
+            D3D11_QUERY_DESC disjointDesc = { D3D11_QUERY_TIMESTAMP_DISJOINT, 0 };
+            D3D11_QUERY_DESC timestampDesc = { D3D11_QUERY_TIMESTAMP, 0 };
+            DX::ThrowIfFailed(device->CreateQuery(&disjointDesc, &m_disjoint));
+            DX::ThrowIfFailed(device->CreateQuery(&timestampDesc, &m_begin));
+            DX::ThrowIfFailed(device->CreateQuery(&timestampDesc, &m_end));
+        }
+
+        void Begin(ID3D11DeviceContext* context)
+        {
+            context->Begin(m_disjoint.Get());
+            context->End(m_begin.Get());
+        }
+
+        void End(ID3D11DeviceContext* context)
+        {
+            context->End(m_end.Get());
+            context->End(m_disjoint.Get());
+        }
+
+        // vłȂ (NbNς) ꍇ͕̒l
+        double GetSeconds(ID3D11DeviceContext* context)
+        {
+            D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+            while (context->GetData(m_disjoint.Get(), &disjoint, sizeof(disjoint), 0) == S_FALSE)
+            {
+                SwitchToThread();
+            }
+
+            UINT64 begin = 0, end = 0;
+            while (context->GetData(m_begin.Get(), &begin, sizeof(begin), 0) == S_FALSE) SwitchToThread();
+            while (context->GetData(m_end.Get(), &end, sizeof(end), 0) == S_FALSE) SwitchToThread();
+
+            if (disjoint.Disjoint)
+            {
+                return -1.0;
+            }
+            return static_cast<double>(end - begin) / static_cast<double>(disjoint.Frequency);
+        }
+
+    private:
+        Microsoft::WRL::ComPtr<ID3D11Query> m_disjoint;
+        Microsoft::WRL::ComPtr<ID3D11Query> m_begin;
+        Microsoft::WRL::ComPtr<ID3D11Query> m_end;
+    };
+
+    // ------------------------------------------------------------------------------
+    // XLjO
+    // ------------------------------------------------------------------------------
+
+    constexpr uint32_t c_CharacterBones = 64;
+    constexpr uint32_t c_CharacterRings = 128;
+    constexpr uint32_t c_CharacterSegments = 64;
+
+    // Ƀ{[񂾉~ (e_͗אڂ4{[ 3 B XvC̏d݂ŏ)
+    std::vector<SkinnedVertex> CreateCharacterMesh()
+    {
+        std::vector<SkinnedVertex> vertices;
+        vertices.reserve(c_CharacterRings * c_CharacterSegments);
+
+        for (uint32_t ring = 0; ring < c_CharacterRings; ++ring)
+        {
+            const float height = static_cast<float>(ring) / (c_CharacterRings - 1);
+            const float bonePosition = height * (c_CharacterBones - 1);
+            const int bone = std::min(static_cast<int>(bonePosition), static_cast<int>(c_CharacterBones) - 2);
+            const float t = bonePosition - bone;
+
+            uint32_t indices[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                indices[k] = static_cast<uint32_t>(std::clamp(bone - 1 + k, 0, static_cast<int>(c_CharacterBones) - 1));
+            }
+
+            for (uint32_t segment = 0; segment < c_CharacterSegments; ++segment)
+            {
+                const float angle = XM_2PI * segment / c_CharacterSegments;
+
+                SkinnedVertex vertex;
+                vertex.pos = XMFLOAT3(0.2f * cosf(angle), height, 0.2f * sinf(angle));
+                vertex.color = XMFLOAT4(height, 1.0f - height, 0.5f, 1.0f);
+                vertex.uv = XMFLOAT2(static_cast<float>(segment) / c_CharacterSegments, height);
+                vertex.boneIndices = PackBoneIndices(indices[0], indices[1], indices[2], indices[3]);
+                vertex.boneWeights = XMFLOAT4((1.0f - t) * (1.0f - t) * (1.0f - t) / 6.0f,
+                                              (3.0f * t * t * t - 6.0f * t * t + 4.0f) / 6.0f,
+                                              (-3.0f * t * t * t + 3.0f * t * t + 3.0f * t + 1.0f) / 6.0f,
+                                              t * t * t / 6.0f);
+                vertices.push_back(vertex);
+            }
+        }
+        return vertices;
+    }
+
+    // LN^[ƂɈقȂ|[Ỹpbg
+    void AnimatePalettes(uint32_t characters, float time, std::vector<XMFLOAT3X4>& palette)
+    {
+        palette.resize(characters * c_CharacterBones);
+        for (uint32_t c = 0; c < characters; ++c)
+        {
+            const XMMATRIX placement = XMMatrixTranslation(static_cast<float>(c % 16), 0.0f, static_cast<float>(c / 16));
+            for (uint32_t b = 0; b < c_CharacterBones; ++b)
+            {
+                const float height = static_cast<float>(b) / (c_CharacterBones - 1);
+                const float bend = 0.5f * height * sinf(time + 0.37f * c);
+
+                // {[Ԃւ̋toChs -> Ȃ -> ̍ -> zu
+                XMMATRIX bone = XMMatrixTranslation(0.0f, -height, 0.0f)
+                              * XMMatrixRotationZ(bend)
+                              * XMMatrixTranslation(0.0f, height, 0.0f)
+                              * placement;
+                XMStoreFloat3x4(&palette[c * c_CharacterBones + b], bone);
+            }
+        }
+    }
+
+    int BenchmarkSkinning(uint32_t characters, int iterations)
+    {
+        const std::vector<SkinnedVertex> mesh = CreateCharacterMesh();
+        const uint32_t meshVertexCount = static_cast<uint32_t>(mesh.size());
+        const uint64_t totalVertices = static_cast<uint64_t>(meshVertexCount) * characters;
+
+        // SLN^[bVLApbgƏo͐悾قȂ
+        std::vector<SkinningDraw> draws(characters);
+        for (uint32_t c = 0; c < characters; ++c)
+        {
+            draws[c] = { 0, meshVertexCount, c * meshVertexCount, c * c_CharacterBones };
+        }
+
+        std::vector<XMFLOAT3X4> palette;
+        AnimatePalettes(characters, 0.0f, palette);
+
+        wprintf(L"Skinning: %u characters x %u vertices = %llu vertices, %u bones each, %d iterations\n",
+                characters, meshVertexCount, totalVertices, c_CharacterBones, iterations);
+
+        // 1. CPU (1XbhƑSRA)
+        std::vector<Vertex> cpuOutput;
+        const uint32_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t workerCount : { 1u, coreCount })
+        {
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                SkinVerticesParallel(mesh, palette, draws, cpuOutput, workerCount);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            const double verticesPerSecond = totalVertices / best;
+            wprintf(L"  CPU %2u thread(s): %8.3f ms, %8.1f Mverts/s, %7.1f Mverts/s per core\n",
+                    workerCount, best * 1000.0, verticesPerSecond / 1e6, verticesPerSecond / workerCount / 1e6);
+
+            if (workerCount == coreCount)
+            {
+                break;
+            }
+        }
+
+        // 2. GPU
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+        if (!CreateDevice(device, context))
+        {
+            return 1;
+        }
+
+        SkinningPass skinning;
+        skinning.Initialize(device.Get(), (c_ShaderDirectory + L"Skinning.hlsl").c_str());
+
+        UploadRing uploadRing;
+        uploadRing.Initialize(device.Get());
+
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> inputSRV;
+        Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> outputUAV;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> outputSRV;
+        skinning.CreateInputBuffer(device.Get(), mesh, inputSRV);
+        skinning.CreateOutputBuffer(device.Get(), static_cast<uint32_t>(totalVertices), outputUAV, outputSRV);
+
+        GpuTimer timer(device.Get());
+        double best = 1e30;
+        for (int i = 0; i < iterations; ++i)
+        {
+            // Dispatch ̑Oɐς܂pbgƃh[̓]vɊ܂܂ (LN^[ 3KB)
+            timer.Begin(context.Get());
+            skinning.Dispatch(context.Get(), uploadRing, inputSRV.Get(), outputUAV.Get(), draws, palette);
+            timer.End(context.Get());
+            uploadRing.EndFrame(context.Get());
+
+            const double seconds = timer.GetSeconds(context.Get());
+            if (seconds > 0.0)
+            {
+                best = std::min(best, seconds);
+            }
+        }
+
+        if (best < 1e30)
+        {
+            wprintf(L"  GPU             : %8.3f ms, %8.1f Mverts/s\n", best * 1000.0, totalVertices / best / 1e6);
+        }
+
+        // 3. GPU  CPU ̌ʂ̍
+        Microsoft::WRL::ComPtr<ID3D11Resource> output;
+        outputSRV->GetResource(&output);
+
+        D3D11_BUFFER_DESC stagingDesc = {};
+        stagingDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * totalVertices);
+        stagingDesc.Usage = D3D11_USAGE_STAGING;
+        stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> staging;
+        DX::ThrowIfFailed(device->CreateBuffer(&stagingDesc, nullptr, &staging));
+        context->CopyResource(staging.Get(), output.Get());
+
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        DX::ThrowIfFailed(context->Map(staging.Get(), 0, D3D11_MAP_READ, 0, &mapped));
+        const Vertex* gpuOutput = static_cast<const Vertex*>(mapped.pData);
+        float maxError = 0.0f;
+        for (uint64_t v = 0; v < totalVertices; ++v)
+        {
+            maxError = std::max(maxError, fabsf(gpuOutput[v].pos.x - cpuOutput[v].pos.x));
+            maxError = std::max(maxError, fabsf(gpuOutput[v].pos.y - cpuOutput[v].pos.y));
+            maxError = std::max(maxError, fabsf(gpuOutput[v].pos.z - cpuOutput[v].pos.z));
+        }
+        context->Unmap(staging.Get(), 0);
+
+        wprintf(L"  max |GPU - CPU| : %g\n", maxError);
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ~bv}bv
+    // ------------------------------------------------------------------------------
+
+    constexpr uint32_t c_TextureSize = 2048;
+    constexpr uint32_t c_ViewSize = 512;
+
+    // L1 ̃LbV (LRU ̃ZbgA\VAeBu)
+    class CacheSimulator
+    {
+    public:
+        CacheSimulator(uint32_t sizeInBytes, uint32_t lineSize, uint32_t ways)
+            : m_lineSize(lineSize), m_ways(ways), m_setCount(sizeInBytes / (lineSize * ways)),
+              m_tags(static_cast<size_t>(m_setCount) * ways, UINT64_MAX)
+        {
+        }
+
+        void Access(const void* address)
+        {
+            const uint64_t line = reinterpret_cast<uintptr_t>(address) / m_lineSize;
+            uint64_t* set = m_tags.data() + static_cast<size_t>(line % m_setCount) * m_ways;
+
+            // set[0] łV
+            uint32_t way = 0;
+            while (way < m_ways && set[way] != line)
+            {
+                ++way;
+            }
+
+            if (way == m_ways)
+            {
+                ++misses;
+                way = m_ways - 1;
+            }
+            else
+            {
+                ++hits;
+            }
+
+            for (; way > 0; --way)
+            {
+                set[way] = set[way - 1];
+            }
+            set[0] = line;
+        }
+
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+    private:
+        uint32_t m_lineSize;
+        uint32_t m_ways;
+        uint32_t m_setCount;
+        std::vector<uint64_t> m_tags;
+    };
+
+    // g܂ރeXg摜 (~bvȂŏkƃGCAXڗ)
+    std::vector<uint32_t> CreateTestImage(uint32_t size)
+    {
+        std::vector<uint32_t> image(static_cast<size_t>(size) * size);
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t hash = x * 0x9E3779B1u ^ y * 0x85EBCA77u;
+                hash ^= hash >> 15;
+                hash *= 0x2C1B3C6Du;
+                hash ^= hash >> 12;
+                const uint32_t checker = ((x / 8) ^ (y / 8)) & 1 ? 0xFF : 0x40;
+                image[static_cast<size_t>(y) * size + x] = 0xFF000000u | (checker << 16) | (hash & 0xFFFF);
+            }
+        }
+        return image;
+    }
+
+    int BenchmarkMips(int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        wprintf(L"Mips: %u x %u RGBA8 texture (%u levels, %.1f MB), %u x %u samples, %d iterations\n",
+                c_TextureSize, c_TextureSize, texture.GetMipCount(), texture.GetSizeInBytes() / (1024.0 * 1024.0),
+                c_ViewSize, c_ViewSize, iterations);
+        wprintf(L"  minify | mode   |    lod | ns/sample | L1 miss | DRAM MB/frame\n");
+
+        // 30 x]ʂAʂ1sNZ minification eNZɂȂkڂŌ
+        const float angle = XMConvertToRadians(30.0f);
+        for (float minification : { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f })
+        {
+            const float scale = minification / c_TextureSize;
+            const XMFLOAT2 ddx(scale * cosf(angle), scale * sinf(angle));
+            const XMFLOAT2 ddy(-scale * sinf(angle), scale * cosf(angle));
+
+            for (bool useMips : { false, true })
+            {
+                // ݂ CSMain (SampleLevel(..., 0)) ƁA LOD I SampleGrad ̔r
+                const float lod = useMips ? texture.CalculateLevelOfDetail(ddx, ddy) : 0.0f;
+
+                auto sampleAll = [&](auto&& visit)
+                {
+                    for (uint32_t y = 0; y < c_ViewSize; ++y)
+                    {
+                        for (uint32_t x = 0; x < c_ViewSize; ++x)
+                        {
+                            const XMFLOAT2 uv(0.25f + x * ddx.x + y * ddy.x, 0.25f + x * ddx.y + y * ddy.y);
+                            visit(uv);
+                        }
+                    }
+                };
+
+                double best = 1e30;
+                float checksum = 0.0f;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    sampleAll([&](const XMFLOAT2& uv)
+                    {
+                        checksum += useMips ? texture.SampleGrad(uv, ddx, ddy).x : texture.SampleLevel(uv, 0.0f).x;
+                    });
+                    best = std::min(best, SecondsSince(start));
+                }
+
+                // 32KB, 64byte C, 8-way  L1 ŁAǂ񂾃eNZ̃qbgƃǂޗʂς
+                CacheSimulator cache(32 * 1024, 64, 8);
+                sampleAll([&](const XMFLOAT2& uv)
+                {
+                    SampleFootprint footprint;
+                    texture.GetFootprint(uv, lod, footprint);
+                    for (uint32_t t = 0; t < footprint.count; ++t)
+                    {
+                        cache.Access(footprint.addresses[t]);
+                    }
+                });
+
+                const double sampleCount = static_cast<double>(c_ViewSize) * c_ViewSize;
+                wprintf(L"  %5.0fx | %-6ls | %6.2f | %9.2f | %6.1f%% | %8.2f   (checksum %g)\n",
+                        minification, useMips ? L"mips" : L"level0", lod, best * 1e9 / sampleCount,
+                        100.0 * cache.misses / (cache.hits + cache.misses), cache.misses * 64.0 / (1024.0 * 1024.0),
+                        checksum);
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // eNX`̃CAEg
+    // ------------------------------------------------------------------------------
+
+    // CSMain Ɠʂ 16x16 ̃^CPʂő (^C͍s)
+    constexpr uint32_t c_ScreenTileSize = 16;
+
+    template <typename Visit>
+    void SampleScreenTiles(XMFLOAT2 ddx, XMFLOAT2 ddy, Visit&& visit)
+    {
+        for (uint32_t tileY = 0; tileY < c_ViewSize; tileY += c_ScreenTileSize)
+        {
+            for (uint32_t tileX = 0; tileX < c_ViewSize; tileX += c_ScreenTileSize)
+            {
+                for (uint32_t y = tileY; y < tileY + c_ScreenTileSize; ++y)
+                {
+                    for (uint32_t x = tileX; x < tileX + c_ScreenTileSize; ++x)
+                    {
+                        visit(XMFLOAT2(0.25f + x * ddx.x + y * ddy.x, 0.25f + x * ddx.y + y * ddy.y));
+                    }
+                }
+            }
+        }
+    }
+
+    int BenchmarkSwizzle(int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+
+        struct LayoutCase {
+            TextureLayout layout;
+            const wchar_t* name;
+        };
+        const LayoutCase layouts[] = {
+            { TextureLayout::RowMajor, L"linear" },
+            { TextureLayout::Tiled, L"tiled" },
+            { TextureLayout::Morton, L"morton" },
+        };
+
+        wprintf(L"Swizzle: %u x %u RGBA8 texture, %u x %u samples (SampleGrad), %d iterations\n",
+                c_TextureSize, c_TextureSize, c_ViewSize, c_ViewSize, iterations);
+
+        SoftwareTexture textures[3];
+        for (size_t i = 0; i < 3; ++i)
+        {
+            auto start = Clock::now();
+            textures[i].Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t), true,
+                               layouts[i].layout);
+            wprintf(L"  %-6ls: %.1f MB, create %.1f ms\n", layouts[i].name,
+                    textures[i].GetSizeInBytes() / (1024.0 * 1024.0), SecondsSince(start) * 1000.0);
+        }
+
+        wprintf(L"  rotate | minify | layout | ns/sample | L1 miss | DRAM MB/frame\n");
+
+        for (float degrees : { 0.0f, 45.0f, 90.0f })
+        {
+            const float angle = XMConvertToRadians(degrees);
+            for (float minification : { 1.0f, 2.0f, 4.0f, 8.0f })
+            {
+                const float scale = minification / c_TextureSize;
+                const XMFLOAT2 ddx(scale * cosf(angle), scale * sinf(angle));
+                const XMFLOAT2 ddy(-scale * sinf(angle), scale * cosf(angle));
+
+                auto sampleAll = [&](auto&& visit) { SampleScreenTiles(ddx, ddy, visit); };
+
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    const SoftwareTexture& texture = textures[i];
+
+                    double best = 1e30;
+                    float checksum = 0.0f;
+                    for (int n = 0; n < iterations; ++n)
+                    {
+                        auto start = Clock::now();
+                        sampleAll([&](const XMFLOAT2& uv)
+                        {
+                            checksum += texture.SampleGrad(uv, ddx, ddy).x;
+                        });
+                        best = std::min(best, SecondsSince(start));
+                    }
+
+                    CacheSimulator cache(32 * 1024, 64, 8);
+                    const float lod = texture.CalculateLevelOfDetail(ddx, ddy);
+                    sampleAll([&](const XMFLOAT2& uv)
+                    {
+                        SampleFootprint footprint;
+                        texture.GetFootprint(uv, lod, footprint);
+                        for (uint32_t t = 0; t < footprint.count; ++t)
+                        {
+                            cache.Access(footprint.addresses[t]);
+                        }
+                    });
+
+                    // CAEgĂTvʂ͓Ȃ̂ŁA]Ək checksum ͈v
+                    const double sampleCount = static_cast<double>(c_ViewSize) * c_ViewSize;
+                    wprintf(L"  %5.0f  | %5.0fx | %-6ls | %9.2f | %6.1f%% | %8.2f   (checksum %g)\n",
+                            degrees, minification, layouts[i].name, best * 1e9 / sampleCount,
+                            100.0 * cache.misses / (cache.hits + cache.misses), cache.misses * 64.0 / (1024.0 * 1024.0),
+                            checksum);
+                }
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ubNk
+    // ------------------------------------------------------------------------------
+
+    // source ̊ex 4x4 ubNƂɃGR[h ([̃ubN͒[̃eNZJԂ)
+    std::vector<uint8_t> CompressTexture(const SoftwareTexture& source, TextureFormat format)
+    {
+        std::vector<uint8_t> blocks;
+        for (uint32_t level = 0; level < source.GetMipCount(); ++level)
+        {
+            const uint32_t width = source.GetWidth(level);
+            const uint32_t height = source.GetHeight(level);
+            for (uint32_t blockY = 0; blockY < height; blockY += c_BlockSize)
+            {
+                for (uint32_t blockX = 0; blockX < width; blockX += c_BlockSize)
+                {
+                    uint32_t texels[16];
+                    for (uint32_t i = 0; i < 16; ++i)
+                    {
+                        texels[i] = source.Load(level, std::min(blockX + i % 4, width - 1), std::min(blockY + i / 4, height - 1));
+                    }
+
+                    const size_t offset = blocks.size();
+                    blocks.resize(offset + GetBlockBytes(format));
+                    EncodeBlock(format, texels, blocks.data() + offset);
+                }
+            }
+        }
+        return blocks;
+    }
+
+    int BenchmarkBlockCompression(int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+
+        struct FormatCase {
+            TextureFormat format;
+            const wchar_t* name;
+        };
+        const FormatCase formats[] = {
+            { TextureFormat::R8G8B8A8, L"rgba8" },
+            { TextureFormat::BC1, L"bc1" },
+            { TextureFormat::BC3, L"bc3" },
+            { TextureFormat::BC7, L"bc7" },
+        };
+
+        wprintf(L"Block compression: %u x %u texture, %u x %u samples (SampleGrad), %d iterations\n",
+                c_TextureSize, c_TextureSize, c_ViewSize, c_ViewSize, iterations);
+        wprintf(L"  format |   MB  | saved | decode Mtexel/s\n");
+
+        SoftwareTexture textures[4];
+        textures[0].Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+        for (size_t i = 0; i < 4; ++i)
+        {
+            SoftwareTexture& texture = textures[i];
+            double decodeRate = 0.0;
+            uint32_t checksum = 0;
+            if (formats[i].format != TextureFormat::R8G8B8A8)
+            {
+                const std::vector<uint8_t> blocks = CompressTexture(textures[0], formats[i].format);
+                texture.CreateCompressed(formats[i].format, c_TextureSize, c_TextureSize, textures[0].GetMipCount(), blocks.data());
+
+                // LbVʂɃx 0 ̑SubNfR[h
+                const uint32_t blockCount = (c_TextureSize / c_BlockSize) * (c_TextureSize / c_BlockSize);
+                const uint32_t blockBytes = GetBlockBytes(formats[i].format);
+                double best = 1e30;
+                for (int n = 0; n < iterations; ++n)
+                {
+                    auto start = Clock::now();
+                    for (uint32_t b = 0; b < blockCount; ++b)
+                    {
+                        uint32_t texels[16];
+                        DecodeBlock(formats[i].format, blocks.data() + static_cast<size_t>(b) * blockBytes, texels);
+                        checksum += texels[b & 15];
+                    }
+                    best = std::min(best, SecondsSince(start));
+                }
+                decodeRate = blockCount * 16.0 / best / 1e6;
+            }
+
+            wprintf(L"  %-6ls | %5.1f | %4.0f%% | %8.1f   (checksum %u)\n", formats[i].name,
+                    texture.GetSizeInBytes() / (1024.0 * 1024.0),
+                    100.0 * (1.0 - static_cast<double>(texture.GetSizeInBytes()) / textures[0].GetSizeInBytes()), decodeRate,
+                    checksum);
+        }
+
+        wprintf(L"  rotate | minify | format | ns/sample | decodes/sample | DRAM MB/frame | mean |err|\n");
+        for (float degrees : { 0.0f, 45.0f })
+        {
+            const float angle = XMConvertToRadians(degrees);
+            for (float minification : { 1.0f, 4.0f })
+            {
+                const float scale = minification / c_TextureSize;
+                const XMFLOAT2 ddx(scale * cosf(angle), scale * sinf(angle));
+                const XMFLOAT2 ddy(-scale * sinf(angle), scale * cosf(angle));
+                const double sampleCount = static_cast<double>(c_ViewSize) * c_ViewSize;
+
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    const SoftwareTexture& texture = textures[i];
+
+                    double best = 1e30;
+                    float checksum = 0.0f;
+                    const uint64_t decodesBefore = texture.GetBlockDecodeCount();
+                    for (int n = 0; n < iterations; ++n)
+                    {
+                        auto start = Clock::now();
+                        SampleScreenTiles(ddx, ddy, [&](const XMFLOAT2& uv)
+                        {
+                            checksum += texture.SampleGrad(uv, ddx, ddy).x;
+                        });
+                        best = std::min(best, SecondsSince(start));
+                    }
+                    const double decodesPerSample = (texture.GetBlockDecodeCount() - decodesBefore) / (sampleCount * iterations);
+
+                    // ǂ񂾃 (keNX`ł̓ubN) ƁA񈳏kƂ̍
+                    CacheSimulator cache(32 * 1024, 64, 8);
+                    const float lod = texture.CalculateLevelOfDetail(ddx, ddy);
+                    double error = 0.0;
+                    SampleScreenTiles(ddx, ddy, [&](const XMFLOAT2& uv)
+                    {
+                        SampleFootprint footprint;
+                        texture.GetFootprint(uv, lod, footprint);
+                        for (uint32_t t = 0; t < footprint.count; ++t)
+                        {
+                            cache.Access(footprint.addresses[t]);
+                        }
+                        error += fabsf(SoftwareTexture::Resolve(footprint).x - textures[0].SampleLevel(uv, lod).x);
+                    });
+
+                    wprintf(L"  %5.0f  | %5.0fx | %-6ls | %9.2f | %14.3f | %13.2f | %10.2f   (checksum %g)\n",
+                            degrees, minification, formats[i].name, best * 1e9 / sampleCount, decodesPerSample,
+                            cache.misses * 64.0 / (1024.0 * 1024.0), error * 255.0 / sampleCount, checksum);
+                }
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // pCvC̓ꉻ
+    // ------------------------------------------------------------------------------
+
+    constexpr uint32_t c_FrameWidth = 1280;
+    constexpr uint32_t c_FrameHeight = 720;
+
+    int BenchmarkPermutations(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        const std::vector<Vertex> vertices = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> indices;
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTexture(&texture);
+
+        wprintf(L"Permutations: %u triangles, %u x %u, %d iterations\n", triangleCount, c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  permutation          | tex | vcol | depth | cull  | blend  | ms/frame | Mpixel/s\n");
+
+        struct Permutation {
+            const wchar_t* name;
+            RasterState state;
+        };
+        auto makeState = [](bool textured, bool vertexColor, bool depthTest, CullMode cullMode, BlendMode blendMode)
+        {
+            RasterState state;
+            state.textured = textured;
+            state.vertexColor = vertexColor;
+            state.depthTest = depthTest;
+            state.cullMode = cullMode;
+            state.blendMode = blendMode;
+            return state;
+        };
+        const Permutation permutations[] = {
+            { L"full (CSMain)",      makeState(true,  true,  true,  CullMode::Back,  BlendMode::Opaque) },
+            { L"textured only",      makeState(true,  false, true,  CullMode::Back,  BlendMode::Opaque) },
+            { L"vertex color only",  makeState(false, true,  true,  CullMode::Back,  BlendMode::Opaque) },
+            { L"flat (depth only)",  makeState(false, false, true,  CullMode::Back,  BlendMode::Opaque) },
+            { L"no depth test",      makeState(true,  true,  false, CullMode::Back,  BlendMode::Opaque) },
+            { L"two sided",          makeState(true,  true,  true,  CullMode::None,  BlendMode::Opaque) },
+            { L"alpha blend",        makeState(true,  true,  true,  CullMode::Back,  BlendMode::Alpha) },
+            { L"flat two sided 2D",  makeState(false, true,  false, CullMode::None,  BlendMode::Alpha) },
+        };
+
+        const wchar_t* cullNames[] = { L"none", L"back", L"front" };
+        for (const Permutation& permutation : permutations)
+        {
+            rasterizer.SetRasterState(permutation.state);
+
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                rasterizer.Render(vertices, indices);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            uint64_t checksum = 0;
+            for (uint32_t color : rasterizer.GetColorBuffer())
+            {
+                checksum += color;
+            }
+
+            const RasterState& state = permutation.state;
+            wprintf(L"  %-20ls | %-3ls | %-4ls | %-5ls | %-5ls | %-6ls | %8.2f | %8.1f   (checksum %llu)\n",
+                    permutation.name, state.textured ? L"on" : L"off", state.vertexColor ? L"on" : L"off",
+                    state.depthTest ? L"on" : L"off", cullNames[static_cast<uint32_t>(state.cullMode)],
+                    state.blendMode == BlendMode::Alpha ? L"alpha" : L"opaque", best * 1e3,
+                    static_cast<double>(c_FrameWidth) * c_FrameHeight / best * 1e-6, checksum);
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ^C̑傫
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkTileSizes(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        const std::vector<Vertex> vertices = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> indices;
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTexture(&texture);
+
+        wprintf(L"Tile sizes: %u triangles, %u x %u, %d iterations\n", triangleCount, c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  tile  | binned refs | full ms | flat ms\n");
+
+        for (uint32_t tileSize = 0; tileSize < c_TileSizeCount; ++tileSize)
+        {
+            rasterizer.SetTileSize(tileSize);
+
+            double seconds[2] = { 1e30, 1e30 };
+            uint64_t checksum = 0;
+            for (uint32_t flat = 0; flat < 2; ++flat)
+            {
+                RasterState state;
+                state.textured = flat == 0;
+                state.vertexColor = flat == 0;
+                rasterizer.SetRasterState(state);
+
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.Render(vertices, indices);
+                    seconds[flat] = std::min(seconds[flat], SecondsSince(start));
+                }
+                for (uint32_t color : rasterizer.GetColorBuffer())
+                {
+                    checksum += color;
+                }
+            }
+
+            // ^CقǁA1̎Op`U蕪^C
+            const TileSize& size = c_TileSizes[tileSize];
+            const uint64_t binnedReferences = rasterizer.GetBinnedTriangleCount();
+
+            wprintf(L"  %2ux%-2u | %11llu | %7.2f | %7.2f   (checksum %llu)\n",
+                    size.width, size.height, binnedReferences, seconds[0] * 1e3, seconds[1] * 1e3, checksum);
+        }
+
+        const uint32_t tuned = rasterizer.AutoTuneTileSize(iterations);
+        wprintf(L"  auto-tuned: %ux%u\n", c_TileSizes[tuned].width, c_TileSizes[tuned].height);
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // t@XgNA
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkFastClear(int iterations)
+    {
+        // ʂ𕢂̈ႤV[ (rp̃V[̎Op`ς)
+        const uint32_t triangleCounts[] = { 0, 16, 128, 1024, 8192 };
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        RasterState state;
+        state.textured = false;
+        rasterizer.SetRasterState(state);
+
+        // i (񎦂ǂݖ߂) ̑ ResolveColor Ŏʂ
+        std::vector<uint32_t> frame(static_cast<size_t>(c_FrameWidth) * c_FrameHeight);
+        const size_t framePitch = c_FrameWidth * sizeof(uint32_t);
+
+        wprintf(L"Fast clear: %u x %u, %d iterations (render + resolve)\n", c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  triangles | cleared tiles | off ms | on ms | off MB | on MB\n");
+
+        for (uint32_t triangleCount : triangleCounts)
+        {
+            const std::vector<Vertex> vertices = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+            const std::vector<uint32_t> indices;
+
+            double seconds[2] = { 1e30, 1e30 };
+            double megabytes[2] = {};
+            uint64_t checksum = 0;
+            for (uint32_t fastClear = 0; fastClear < 2; ++fastClear)
+            {
+                rasterizer.SetFastClear(fastClear != 0);
+
+                // 1ڂ̓NAtOĂȂ̂őS^C (Ȃ)
+                rasterizer.Render(vertices, indices);
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.Render(vertices, indices);
+                    rasterizer.ResolveColor(frame.data(), framePitch);
+                    seconds[fastClear] = std::min(seconds[fastClear], SecondsSince(start));
+                }
+
+                // J[ (4byte) Ɛ[x (4byte)
+                megabytes[fastClear] = static_cast<double>(rasterizer.GetWrittenPixelCount()) * 8.0 / (1024.0 * 1024.0);
+                for (uint32_t color : frame)
+                {
+                    checksum += color;
+                }
+            }
+
+            uint32_t clearedTiles = 0;
+            for (uint32_t ty = 0; ty < rasterizer.GetTileCountY(); ++ty)
+            {
+                for (uint32_t tx = 0; tx < rasterizer.GetTileCountX(); ++tx)
+                {
+                    clearedTiles += rasterizer.IsTileCleared(tx, ty) ? 1 : 0;
+                }
+            }
+
+            wprintf(L"  %9u | %5u / %-5u | %6.2f | %5.2f | %6.2f | %5.2f   (checksum %llu)\n",
+                    triangleCount, clearedTiles, rasterizer.GetTileCountX() * rasterizer.GetTileCountY(),
+                    seconds[0] * 1e3, seconds[1] * 1e3, megabytes[0], megabytes[1], checksum);
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // [xtH[}bg reversed-Z
+    // ------------------------------------------------------------------------------
+
+    // [x͈͂̍LV[ (near = 0.1, far = 10000) ̋̑
+    const float c_DepthBandDistances[] = { 1.0f, 10.0f, 100.0f, 1000.0f, 5000.0f };
+    constexpr uint32_t c_DepthBandCount = static_cast<uint32_t>(sizeof(c_DepthBandDistances) / sizeof(c_DepthBandDistances[0]));
+    constexpr float c_DepthNear = 0.1f;
+    constexpr float c_DepthFar = 10000.0f;
+    constexpr float c_DepthFovY = XM_PI / 3.0f;
+
+    // ʂ̑тɕA k ɋ c_DepthBandDistances[k] ̎΂߂̖ʂ2 (ԁAO) u
+    // ̖ʂ͎O̖ʂ_ (1 + separation) {̂ŁAʏł͊SɏdȂB
+    // ɕ`̂ŁAO̐[xOƔłȂsNZ͐Ԃ̂܂܎c (Z t@CeBO)
+    std::vector<Vertex> CreateDepthRangeScene(float separation, float aspect)
+    {
+        const float tanY = tanf(c_DepthFovY * 0.5f);
+        const float tanX = tanY * aspect;
+
+        std::vector<Vertex> vertices;
+        for (uint32_t layer = 0; layer < 2; ++layer)
+        {
+            const float scale = layer == 0 ? 1.0f + separation : 1.0f;
+            const XMFLOAT4 color = layer == 0 ? XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f) : XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
+
+            for (uint32_t band = 0; band < c_DepthBandCount; ++band)
+            {
+                const float top = 1.0f - 2.0f * band / c_DepthBandCount;
+                const float bottom = 1.0f - 2.0f * (band + 1) / c_DepthBandCount;
+
+                //  Z = d + 0.5 * X / tanX (ʂ̍ d / 1.5AE d / 0.5)  NDC (x, y) ̓_
+                auto corner = [&](float ndcX, float ndcY) {
+                    const float z = c_DepthBandDistances[band] / (1.0f - 0.5f * ndcX) * scale;
+                    Vertex vertex;
+                    vertex.pos = XMFLOAT3(ndcX * z * tanX, ndcY * z * tanY, z);
+                    vertex.color = color;
+                    vertex.uv = XMFLOAT2(0.0f, 0.0f);
+                    return vertex;
+                };
+                const Vertex v00 = corner(-1.01f, top), v10 = corner(1.01f, top);
+                const Vertex v01 = corner(-1.01f, bottom), v11 = corner(1.01f, bottom);
+                vertices.insert(vertices.end(), { v00, v10, v01, v10, v11, v01 });
+            }
+        }
+        return vertices;
+    }
+
+    int BenchmarkDepthFormats(int iterations)
+    {
+        const float aspect = static_cast<float>(c_FrameWidth) / c_FrameHeight;
+        const float separations[] = { 1e-3f, 1e-4f };
+        const wchar_t* formatNames[] = { L"D32F", L"D24S8", L"D16" };
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        RasterState state;
+        state.textured = false;
+        state.cullMode = CullMode::None;
+        rasterizer.SetRasterState(state);
+        rasterizer.SetFastClear(false);
+
+        wprintf(L"Depth formats: %u x %u, near %.1f, far %.0f, %d iterations\n", c_FrameWidth, c_FrameHeight, c_DepthNear, c_DepthFar, iterations);
+        wprintf(L"  Z-fighting = pixels where the nearer plane lost, per distance band\n");
+
+        for (float separation : separations)
+        {
+            const std::vector<Vertex> vertices = CreateDepthRangeScene(separation, aspect);
+            const std::vector<uint32_t> indices;
+
+            wprintf(L"  separation %.2f%%\n", separation * 100.0f);
+            wprintf(L"  format | reversed |   ms  | depth MB |");
+            for (float distance : c_DepthBandDistances)
+            {
+                wprintf(L" %6.0f", distance);
+            }
+            wprintf(L"\n");
+
+            for (uint32_t mode = 0; mode < c_DepthModeCount; ++mode)
+            {
+                DepthBufferDesc desc;
+                desc.format = static_cast<DepthFormat>(mode / 2);
+                desc.reversedZ = (mode & 1) != 0;
+                rasterizer.SetDepthBuffer(desc);
+
+                // reversed-Z  near  far ւˉes
+                rasterizer.SetTransform(desc.reversedZ
+                    ? XMMatrixPerspectiveFovLH(c_DepthFovY, aspect, c_DepthFar, c_DepthNear)
+                    : XMMatrixPerspectiveFovLH(c_DepthFovY, aspect, c_DepthNear, c_DepthFar));
+
+                double best = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.Render(vertices, indices);
+                    best = std::min(best, SecondsSince(start));
+                }
+                const double depthMegabytes = static_cast<double>(rasterizer.GetWrittenPixelCount()) * GetDepthBytesPerPixel(desc.format) / (1024.0 * 1024.0);
+
+                wprintf(L"  %-6ls | %-8ls | %5.2f | %8.2f |", formatNames[mode / 2], desc.reversedZ ? L"on" : L"off", best * 1e3, depthMegabytes);
+
+                // т̋E̍sāA (̖) csNZ̊
+                const std::vector<uint32_t>& colors = rasterizer.GetColorBuffer();
+                for (uint32_t band = 0; band < c_DepthBandCount; ++band)
+                {
+                    const uint32_t rowBegin = band * c_FrameHeight / c_DepthBandCount + 2;
+                    const uint32_t rowEnd = (band + 1) * c_FrameHeight / c_DepthBandCount - 2;
+                    uint64_t fighting = 0;
+                    for (uint32_t y = rowBegin; y < rowEnd; ++y)
+                    {
+                        for (uint32_t x = 0; x < c_FrameWidth; ++x)
+                        {
+                            fighting += (colors[static_cast<size_t>(y) * c_FrameWidth + x] & 0xFF) > 0x80 ? 1 : 0;
+                        }
+                    }
+                    wprintf(L" %5.1f%%", 100.0 * fighting / (static_cast<double>(rowEnd - rowBegin) * c_FrameWidth));
+                }
+                wprintf(L"\n");
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // [xvpX
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkDepthPrepass(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        // rp̃V[̎Op`[xŕבւāAO /  / ̂܂܂̏ŕ`
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        std::vector<uint32_t> order(triangleCount);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            order[t] = t;
+        }
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return scene[a * 3].pos.z < scene[b * 3].pos.z; });
+
+        std::vector<uint32_t> frontToBack, backToFront, unsorted;
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                frontToBack.push_back(order[t] * 3 + k);
+                backToFront.push_back(order[triangleCount - 1 - t] * 3 + k);
+                unsorted.push_back(t * 3 + k);
+            }
+        }
+
+        struct Scene {
+            const wchar_t* name;
+            const std::vector<uint32_t>* indices;
+        };
+        const Scene scenes[] = {
+            { L"front-to-back", &frontToBack },
+            { L"unsorted", &unsorted },
+            { L"back-to-front", &backToFront },
+        };
+        const wchar_t* modeNames[] = { L"off", L"on", L"auto" };
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTexture(&texture);
+
+        wprintf(L"Depth prepass: %u textured triangles, %u x %u, %d iterations\n", triangleCount, c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  order         | prepass   | overdraw | shaded frags |   ms    (checksum)\n");
+
+        for (const Scene& sceneOrder : scenes)
+        {
+            for (uint32_t mode = 0; mode < 3; ++mode)
+            {
+                rasterizer.SetDepthPrepass(static_cast<DepthPrepassMode>(mode));
+
+                // Auto ͑Ȍd˕`Ō߂̂ŁA1`Ă瑪
+                rasterizer.Render(scene, *sceneOrder.indices);
+
+                double best = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.Render(scene, *sceneOrder.indices);
+                    best = std::min(best, SecondsSince(start));
+                }
+
+                uint64_t checksum = 0;
+                for (uint32_t color : rasterizer.GetColorBuffer())
+                {
+                    checksum += color;
+                }
+
+                // Auto ͎ۂɑI񂾕ʂŎ
+                const std::wstring modeName = mode == 2 ? std::wstring(modeNames[mode]) + (rasterizer.IsDepthPrepassActive() ? L"(on)" : L"(off)") : modeNames[mode];
+                wprintf(L"  %-13ls | %-9ls | %8.2f | %12llu | %7.2f  (%llu)\n",
+                        sceneOrder.name, modeName.c_str(), rasterizer.GetOverdraw(), rasterizer.GetShadedFragments(), best * 1e3, checksum);
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // }`r[
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkMultiView(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        // rp̃V[ (NDC) r[Ƃɏ񂵂Ă炷 (W = 1 ̂܂)
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+        XMMATRIX views[c_MaxViews];
+        for (uint32_t v = 0; v < c_MaxViews; ++v)
+        {
+            views[v] = XMMatrixMultiply(XMMatrixRotationZ(0.05f * v), XMMatrixTranslation(0.04f * v, -0.02f * v, 0.0f));
+        }
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTexture(&texture);
+
+        wprintf(L"Multi-view: %u textured triangles, %u x %u, %d iterations\n", triangleCount, c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  views | separate ms | multi-view ms | saved  | checksum\n");
+
+        for (uint32_t viewCount = 2; viewCount <= c_MaxViews; viewCount += 2)
+        {
+            // r[Ƃ SetTransform  Render Ă (Op`r[̐ǂ)
+            double separate = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                for (uint32_t v = 0; v < viewCount; ++v)
+                {
+                    rasterizer.SetTransform(views[v]);
+                    rasterizer.Render(scene, noIndices);
+                }
+                separate = std::min(separate, SecondsSince(start));
+            }
+
+            uint64_t separateChecksum = 0;
+            for (uint32_t v = 0; v < viewCount; ++v)
+            {
+                rasterizer.SetTransform(views[v]);
+                rasterizer.Render(scene, noIndices);
+                for (uint32_t color : rasterizer.GetColorBuffer())
+                {
+                    separateChecksum += color;
+                }
+            }
+
+            // 1 RenderMultiView
+            double multi = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                rasterizer.RenderMultiView(scene, noIndices, views, viewCount);
+                multi = std::min(multi, SecondsSince(start));
+            }
+
+            uint64_t multiChecksum = 0;
+            for (uint32_t v = 0; v < viewCount; ++v)
+            {
+                for (uint32_t color : rasterizer.GetViewColorBuffer(v))
+                {
+                    multiChecksum += color;
+                }
+            }
+
+            wprintf(L"  %5u | %11.2f | %13.2f | %5.1f%% | %llu %ls\n", viewCount, separate * 1e3, multi * 1e3,
+                    (1.0 - multi / separate) * 100.0, multiChecksum, multiChecksum == separateChecksum ? L"(match)" : L"(MISMATCH)");
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // VhE}bv ([x̕`)
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkShadowMap(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        // rp̃V[ (NDC) ̂܂܃Cg猩̂Ƃĕ`
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTexture(&texture);
+
+        wprintf(L"Shadow map: %u triangles, %d iterations\n", triangleCount, iterations);
+        wprintf(L"  path                   | resolution  | covered px |   ms\n");
+
+        // r: 𑜓xŐFh Render (eNX`ƒ_J[)
+        double best = 1e30;
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto start = Clock::now();
+            rasterizer.Render(scene, noIndices);
+            best = std::min(best, SecondsSince(start));
+        }
+        wprintf(L"  Render (color + depth) | %4u x %4u | %10llu | %7.2f\n", c_FrameWidth, c_FrameHeight, rasterizer.GetCoveredPixels(), best * 1e3);
+
+        struct Resolution {
+            uint32_t width;
+            uint32_t height;
+        };
+        const Resolution resolutions[] = { { c_FrameWidth, c_FrameHeight }, { 2048, 2048 } };
+        for (const Resolution& resolution : resolutions)
+        {
+            for (ConservativeMode conservative : { ConservativeMode::Off, ConservativeMode::Overestimate })
+            {
+                SoftwareShadowMap shadowMap;
+                shadowMap.Create(resolution.width, resolution.height, DepthBufferDesc());
+
+                best = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.RenderShadowMap(scene, noIndices, XMMatrixIdentity(), shadowMap, CullMode::Back, conservative);
+                    best = std::min(best, SecondsSince(start));
+                }
+
+                uint64_t covered = 0;
+                for (uint32_t y = 0; y < shadowMap.height; ++y)
+                {
+                    for (uint32_t x = 0; x < shadowMap.width; ++x)
+                    {
+                        covered += shadowMap.GetDepth(x, y) < 1.0f ? 1 : 0;
+                    }
+                }
+                wprintf(L"  depth only%-12ls | %4u x %4u | %10llu | %7.2f\n", conservative != ConservativeMode::Off ? L" (conserv.)" : L"",
+                        resolution.width, resolution.height, covered, best * 1e3);
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ێIX^CY
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkConservative(uint32_t triangleCount, int iterations)
+    {
+        // IN[Wobt@̂悤Ȓ𑜓x̕`ɁAFg킸[xŕ`
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+        RasterState state;
+        state.textured = false;
+        state.vertexColor = false;
+
+        struct Resolution {
+            uint32_t width;
+            uint32_t height;
+        };
+        const Resolution resolutions[] = { { 160, 90 }, { 320, 180 }, { c_FrameWidth, c_FrameHeight } };
+        const wchar_t* modeNames[] = { L"off", L"overestimate", L"underestimate" };
+
+        wprintf(L"Conservative rasterization: %u triangles, untextured, %d iterations\n", triangleCount, iterations);
+        wprintf(L"  resolution  | mode          | covered px | fragments |   ms\n");
+
+        for (const Resolution& resolution : resolutions)
+        {
+            SoftwareRasterizer rasterizer;
+            rasterizer.Initialize(resolution.width, resolution.height);
+            rasterizer.SetRasterState(state);
+
+            for (uint32_t mode = 0; mode < c_ConservativeModeCount; ++mode)
+            {
+                rasterizer.SetConservativeRaster(static_cast<ConservativeMode>(mode));
+
+                double best = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.Render(scene, noIndices);
+                    best = std::min(best, SecondsSince(start));
+                }
+                wprintf(L"  %4u x %4u | %-13ls | %10llu | %9llu | %7.3f\n", resolution.width, resolution.height, modeNames[mode],
+                        rasterizer.GetCoveredPixels(), rasterizer.GetDepthPassFragments(), best * 1e3);
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // JobW}XÑA`GCAX
+    // ------------------------------------------------------------------------------
+
+    // source (width * scaleX, height * scaleY)  scaleX x scaleY ̃{bNXtB^[ŏk߂
+    std::vector<uint32_t> DownsampleColor(const std::vector<uint32_t>& source, uint32_t width, uint32_t height, uint32_t scaleX, uint32_t scaleY)
+    {
+        std::vector<uint32_t> result(static_cast<size_t>(width) * height);
+        const uint32_t sourceWidth = width * scaleX;
+        const uint32_t samples = scaleX * scaleY;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                uint32_t sum[4] = {};
+                for (uint32_t sy = 0; sy < scaleY; ++sy)
+                {
+                    for (uint32_t sx = 0; sx < scaleX; ++sx)
+                    {
+                        const uint32_t texel = source[static_cast<size_t>(y * scaleY + sy) * sourceWidth + x * scaleX + sx];
+                        for (uint32_t c = 0; c < 4; ++c)
+                        {
+                            sum[c] += (texel >> (c * 8)) & 0xFF;
+                        }
+                    }
+                }
+                uint32_t packed = 0;
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    packed |= ((sum[c] + samples / 2) / samples) << (c * 8);
+                }
+                result[static_cast<size_t>(y) * width + x] = packed;
+            }
+        }
+        return result;
+    }
+
+    // RGB ̕ϐΌ덷 (0 ~ 255)
+    double ColorError(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                const int diff = static_cast<int>((a[i] >> (c * 8)) & 0xFF) - static_cast<int>((b[i] >> (c * 8)) & 0xFF);
+                sum += static_cast<uint64_t>(std::abs(diff));
+            }
+        }
+        return static_cast<double>(sum) / (a.size() * 3);
+    }
+
+    int BenchmarkAntiAliasing(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+        RasterState state;
+        state.textured = false;
+        const uint32_t depthBytes = GetDepthBytesPerPixel(DepthFormat::D32Float);
+
+        //  16x ̃X[p[TvO (4x4 ̊iq)
+        std::vector<uint32_t> reference;
+        {
+            SoftwareRasterizer rasterizer;
+            rasterizer.Initialize(c_FrameWidth * 4, c_FrameHeight * 4);
+            rasterizer.SetRasterState(state);
+            rasterizer.Render(scene, noIndices);
+            reference = DownsampleColor(rasterizer.GetColorBuffer(), c_FrameWidth, c_FrameHeight, 4, 4);
+        }
+
+        wprintf(L"Anti-aliasing: %u triangles at %u x %u, untextured, %d iterations (error vs 16x supersampling)\n",
+                triangleCount, c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  mode          |    ms    | memory (MB) | extra fragments | error\n");
+
+        // JobW}XN (ς݂̐FƁAkTv + [x̃oCg)
+        const wchar_t* coverageNames[] = { L"off", L"coverage 4x", L"coverage 8x" };
+        for (uint32_t mode = 0; mode < c_AntiAliasModeCount; ++mode)
+        {
+            SoftwareRasterizer rasterizer;
+            rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+            rasterizer.SetRasterState(state);
+            rasterizer.SetAntiAliasing(static_cast<AntiAliasMode>(mode));
+
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                rasterizer.Render(scene, noIndices);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            const size_t pixels = static_cast<size_t>(c_FrameWidth) * c_FrameHeight;
+            const size_t bytes = pixels * (sizeof(uint32_t) + depthBytes) + rasterizer.GetCoverageBufferBytes();
+            wprintf(L"  %-13ls | %8.3f | %11.2f | %15u | %.3f\n", coverageNames[mode], best * 1e3, bytes / (1024.0 * 1024.0),
+                    rasterizer.GetCoverageFragmentCount(), ColorError(rasterizer.GetColorBuffer(), reference));
+        }
+
+        // TṽX[p[TvO (TvƂɐFƐ[xASTvh)
+        struct Supersampling {
+            const wchar_t* name;
+            uint32_t scaleX;
+            uint32_t scaleY;
+        };
+        const Supersampling supersamplings[] = { { L"SSAA 4x", 2, 2 }, { L"SSAA 8x", 4, 2 } };
+        for (const Supersampling& ssaa : supersamplings)
+        {
+            SoftwareRasterizer rasterizer;
+            rasterizer.Initialize(c_FrameWidth * ssaa.scaleX, c_FrameHeight * ssaa.scaleY);
+            rasterizer.SetRasterState(state);
+
+            double best = 1e30;
+            std::vector<uint32_t> resolved;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                rasterizer.Render(scene, noIndices);
+                resolved = DownsampleColor(rasterizer.GetColorBuffer(), c_FrameWidth, c_FrameHeight, ssaa.scaleX, ssaa.scaleY);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            const size_t samples = static_cast<size_t>(c_FrameWidth) * c_FrameHeight * ssaa.scaleX * ssaa.scaleY;
+            const size_t bytes = samples * (sizeof(uint32_t) + depthBytes) + static_cast<size_t>(c_FrameWidth) * c_FrameHeight * sizeof(uint32_t);
+            wprintf(L"  %-13ls | %8.3f | %11.2f | %15ls | %.3f\n", ssaa.name, best * 1e3, bytes / (1024.0 * 1024.0), L"-",
+                    ColorError(resolved, reference));
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // σ[gVF[fBO
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkVariableRateShading(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<uint32_t> image = CreateTestImage(c_TextureSize);
+        SoftwareTexture texture;
+        texture.Create(c_TextureSize, c_TextureSize, image.data(), c_TextureSize * sizeof(uint32_t));
+
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+        const uint32_t rateTileCount = GetShadingRateTileCount(c_FrameWidth, c_FrameHeight);
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTexture(&texture);
+
+        // 덷̊͉σ[gVF[fBOȂ
+        rasterizer.Render(scene, noIndices);
+        const std::vector<uint32_t> reference = rasterizer.GetColorBuffer();
+
+        wprintf(L"Variable-rate shading: %u triangles at %u x %u, textured, %d iterations (%u rate tiles of %u x %u)\n",
+                triangleCount, c_FrameWidth, c_FrameHeight, iterations, rateTileCount, c_ShadingRateTileSize, c_ShadingRateTileSize);
+        wprintf(L"  mode          |    ms    |   shaded  |   shared  | savings | tiles 1x1 / 2x2 / 4x4 | error\n");
+
+        struct Mode {
+            const wchar_t* name;
+            ShadingRateMode mode;
+            ShadingRate rate;   // Explicit ̑S^C̃[g
+        };
+        const Mode modes[] = {
+            { L"off",           ShadingRateMode::Off,      ShadingRate::Rate1x1 },
+            { L"explicit 1x1",  ShadingRateMode::Explicit, ShadingRate::Rate1x1 },
+            { L"explicit 2x2",  ShadingRateMode::Explicit, ShadingRate::Rate2x2 },
+            { L"explicit 4x4",  ShadingRateMode::Explicit, ShadingRate::Rate4x4 },
+            { L"auto",          ShadingRateMode::Auto,     ShadingRate::Rate1x1 },
+        };
+        for (const Mode& mode : modes)
+        {
+            rasterizer.SetShadingRateMode(mode.mode);
+            if (mode.mode == ShadingRateMode::Explicit)
+            {
+                rasterizer.SetShadingRates(std::vector<ShadingRate>(rateTileCount, mode.rate));
+            }
+
+            // Auto ͑Õt[̐FŌ߂̂ŁAŏ̃t[͑Ȃ
+            rasterizer.Render(scene, noIndices);
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                rasterizer.Render(scene, noIndices);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            uint32_t rateCounts[c_ShadingRateCount] = {};
+            if (rasterizer.IsVariableRateShadingActive())
+            {
+                for (ShadingRate rate : rasterizer.GetShadingRates())
+                {
+                    ++rateCounts[static_cast<uint32_t>(rate)];
+                }
+            }
+            wprintf(L"  %-13ls | %8.3f | %9llu | %9llu | %6.1f%% | %6u / %4u / %4u   | %.3f\n", mode.name, best * 1e3,
+                    rasterizer.GetShadedFragments(), rasterizer.GetSharedShadedPixels(), rasterizer.GetShadingRateSavings() * 100.0f,
+                    rateCounts[0], rateCounts[1], rateCounts[2], ColorError(rasterizer.GetColorBuffer(), reference));
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // VU[`
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkScissor(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+        // Õt[ (S) ƁAVU[`̒`̃t[ (Op`炷)
+        const XMMATRIX previousFrame = XMMatrixIdentity();
+        const XMMATRIX nextFrame = XMMatrixTranslation(0.05f, -0.03f, 0.0f);
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetTransform(nextFrame);
+        rasterizer.Render(scene, noIndices);
+        const std::vector<uint32_t> nextReference = rasterizer.GetColorBuffer();
+
+        wprintf(L"Scissor rects: %u triangles at %u x %u, %d iterations (tile %u x %u, %u tiles)\n", triangleCount, c_FrameWidth, c_FrameHeight, iterations,
+                c_TileSizes[rasterizer.GetTileSize()].width, c_TileSizes[rasterizer.GetTileSize()].height, rasterizer.GetTileCountX() * rasterizer.GetTileCountY());
+        wprintf(L"  rects            |    ms    | tiles | written px | outside changed | inside mismatches\n");
+
+        // UI ̃plA~j}bvƃXe[^XAʂ͂ݏo` (^C̋EɑȂ)
+        const ScissorRect panel[] = { { 965, 37, 1243, 361 } };
+        const ScissorRect hud[] = { { 20, 20, 277, 149 }, { 1003, 515, 1260, 700 }, { 400, 650, 880, 703 } };
+        const ScissorRect offscreen[] = { { 1150, 610, 1500, 900 } };
+        struct Case {
+            const wchar_t* name;
+            const ScissorRect* rects;
+            uint32_t count;
+        };
+        const Case cases[] = {
+            { L"full frame",  nullptr,   0 },
+            { L"ui panel",    panel,     1 },
+            { L"hud (3)",     hud,       3 },
+            { L"offscreen",   offscreen, 1 },
+        };
+        for (const Case& c : cases)
+        {
+            // Õt[Ŝɕ`ĂÃt[VU[`̒֕`
+            rasterizer.SetScissorRects(nullptr, 0);
+            rasterizer.SetTransform(previousFrame);
+            rasterizer.Render(scene, noIndices);
+            const std::vector<uint32_t> previous = rasterizer.GetColorBuffer();
+
+            rasterizer.SetScissorRects(c.rects, c.count);
+            rasterizer.SetTransform(nextFrame);
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = Clock::now();
+                rasterizer.Render(scene, noIndices);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            // `̊O͑Õt[̂܂܁Ã͎t[Ŝɕ`̂ƈv͂
+            const std::vector<uint32_t>& color = rasterizer.GetColorBuffer();
+            uint32_t outsideChanged = 0;
+            uint32_t insideMismatches = 0;
+            for (uint32_t y = 0; y < c_FrameHeight; ++y)
+            {
+                for (uint32_t x = 0; x < c_FrameWidth; ++x)
+                {
+                    bool inside = c.count == 0;
+                    for (uint32_t r = 0; r < c.count; ++r)
+                    {
+                        inside = inside || ScissorRectContains(c.rects[r], x, y, x + 1, y + 1);
+                    }
+                    const size_t pixel = static_cast<size_t>(y) * c_FrameWidth + x;
+                    if (inside)
+                    {
+                        insideMismatches += color[pixel] != nextReference[pixel] ? 1 : 0;
+                    }
+                    else
+                    {
+                        outsideChanged += color[pixel] != previous[pixel] ? 1 : 0;
+                    }
+                }
+            }
+            wprintf(L"  %-16ls | %8.3f | %5zu | %10zu | %15u | %17u\n", c.name, best * 1e3,
+                    rasterizer.GetRasterizedTileCount(), rasterizer.GetWrittenPixelCount(), outsideChanged, insideMismatches);
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // G-buffer
+    // ------------------------------------------------------------------------------
+
+    // G-buffer ̖@ format PʃxNgœǂ
+    XMFLOAT3 LoadGBufferNormal(const uint8_t* texel, GBufferFormat format)
+    {
+        if (format == GBufferFormat::Packed)
+        {
+            uint16_t value[2];
+            memcpy(value, texel, sizeof(value));
+            return DecodeNormalOctahedral(XMFLOAT2(value[0] / 65535.0f * 2.0f - 1.0f, value[1] / 65535.0f * 2.0f - 1.0f));
+        }
+        PackedVector::HALF value[3];
+        memcpy(value, texel, sizeof(value));
+        return XMFLOAT3(PackedVector::XMConvertHalfToFloat(value[0]), PackedVector::XMConvertHalfToFloat(value[1]), PackedVector::XMConvertHalfToFloat(value[2]));
+    }
+
+    // G-buffer ̓xNg format ǂ
+    XMFLOAT2 LoadGBufferMotion(const uint8_t* texel, GBufferFormat format)
+    {
+        if (format == GBufferFormat::Packed)
+        {
+            PackedVector::HALF value[2];
+            memcpy(value, texel, sizeof(value));
+            return XMFLOAT2(PackedVector::XMConvertHalfToFloat(value[0]), PackedVector::XMConvertHalfToFloat(value[1]));
+        }
+        XMFLOAT2 value;
+        memcpy(&value, texel, sizeof(value));
+        return value;
+    }
+
+    int BenchmarkGBuffer(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+
+        // ʑŜɎU΂_Ƃ̖@ (ʑ̂̉̐܂Ԃʂ)
+        std::vector<XMFLOAT3> normals(scene.size());
+        for (size_t v = 0; v < normals.size(); ++v)
+        {
+            const float f = static_cast<float>(v);
+            XMStoreFloat3(&normals[v], XMVector3Normalize(XMVectorSet(sinf(f * 0.37f), cosf(f * 0.11f), sinf(f * 0.23f + 1.0f), 0.0f)));
+        }
+
+        // Õt[ʏœ̃t[ (xNg̊Ғl͑SsNZœ)
+        const float moveX = 0.05f, moveY = -0.03f;
+        const XMMATRIX previousFrame = XMMatrixIdentity();
+        const XMMATRIX nextFrame = XMMatrixTranslation(moveX, moveY, 0.0f);
+        const XMFLOAT2 expectedMotion(-moveX * 0.5f * c_FrameWidth, moveY * 0.5f * c_FrameHeight);
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetVertexNormals(&normals);
+        rasterizer.SetTransform(nextFrame);
+        const uint32_t depthBytes = GetDepthBytesPerPixel(rasterizer.GetDepthBufferDesc().format);
+
+        wprintf(L"G-buffer: %u triangles at %u x %u, %d iterations (color 4 + depth %u bytes/pixel)\n",
+                triangleCount, c_FrameWidth, c_FrameHeight, iterations, depthBytes);
+        wprintf(L"  targets      |    ms    | bytes/px | MB written | normal error (deg) | motion error (px)\n");
+
+        constexpr GBufferFormat Off = GBufferFormat::Off;
+        constexpr GBufferFormat Full = GBufferFormat::Full;
+        constexpr GBufferFormat Packed = GBufferFormat::Packed;
+        struct Config {
+            const wchar_t* name;
+            GBufferDesc desc;   // Albedo, Normal, Id, Motion
+        };
+        const Config configs[] = {
+            { L"color only",  { { Off, Off, Off, Off } } },
+            { L"all full",    { { Full, Full, Full, Full } } },
+            { L"all packed",  { { Packed, Packed, Packed, Packed } } },
+            { L"mixed",       { { Packed, Packed, Full, Off } } },
+            { L"albedo only", { { Packed, Off, Off, Off } } },
+        };
+
+        // @̌덷̊ Full (R16G16B16A16_FLOAT) ̖@
+        std::vector<XMFLOAT3> referenceNormals;
+        for (const Config& config : configs)
+        {
+            rasterizer.SetGBuffer(config.desc);
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                rasterizer.SetPreviousTransform(previousFrame);
+                auto start = Clock::now();
+                rasterizer.Render(scene, noIndices);
+                best = std::min(best, SecondsSince(start));
+            }
+
+            const uint32_t gbufferBytes = GetGBufferBytesPerPixel(config.desc);
+            const uint32_t pixelBytes = 4 + depthBytes + gbufferBytes;
+            const double writtenMB = static_cast<double>(rasterizer.GetWrittenPixelCount()) * pixelBytes / (1024.0 * 1024.0);
+
+            // Op`ĂsNZ̖@ƓxNg𒲂ׂ
+            const GBufferFormat normalFormat = config.desc.formats[static_cast<uint32_t>(GBufferTarget::Normal)];
+            const GBufferFormat motionFormat = config.desc.formats[static_cast<uint32_t>(GBufferTarget::Motion)];
+            const std::vector<uint8_t>& normalStorage = rasterizer.GetGBufferStorage(GBufferTarget::Normal);
+            const std::vector<uint8_t>& motionStorage = rasterizer.GetGBufferStorage(GBufferTarget::Motion);
+            const size_t pixelCount = static_cast<size_t>(c_FrameWidth) * c_FrameHeight;
+            if (normalFormat == Full && referenceNormals.empty())
+            {
+                referenceNormals.resize(pixelCount);
+                for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+                {
+                    referenceNormals[pixel] = LoadGBufferNormal(&normalStorage[pixel * GetGBufferBytesPerPixel(normalFormat)], normalFormat);
+                }
+            }
+
+            float normalError = 0.0f;
+            float motionError = 0.0f;
+            for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+            {
+                const float depth = rasterizer.GetDepth(static_cast<uint32_t>(pixel % c_FrameWidth), static_cast<uint32_t>(pixel / c_FrameWidth));
+                if (depth >= 1.0f) continue;
+
+                if (normalFormat != Off && !referenceNormals.empty())
+                {
+                    const XMFLOAT3 normal = LoadGBufferNormal(&normalStorage[pixel * GetGBufferBytesPerPixel(normalFormat)], normalFormat);
+                    // ȊpxłxȂ悤AOς̒Ɠςpx߂
+                    const XMVECTOR n0 = XMLoadFloat3(&normal);
+                    const XMVECTOR n1 = XMLoadFloat3(&referenceNormals[pixel]);
+                    const float angle = atan2f(XMVectorGetX(XMVector3Length(XMVector3Cross(n0, n1))), XMVectorGetX(XMVector3Dot(n0, n1)));
+                    normalError = std::max(normalError, XMConvertToDegrees(angle));
+                }
+                if (motionFormat != Off)
+                {
+                    const XMFLOAT2 motion = LoadGBufferMotion(&motionStorage[pixel * GetGBufferBytesPerPixel(motionFormat)], motionFormat);
+                    motionError = std::max({ motionError, std::abs(motion.x - expectedMotion.x), std::abs(motion.y - expectedMotion.y) });
+                }
+            }
+
+            wprintf(L"  %-12ls | %8.3f | %8u | %10.2f | ", config.name, best * 1e3, pixelBytes, writtenMB);
+            if (normalFormat != Off) wprintf(L"%18.4f | ", normalError); else wprintf(L"%18ls | ", L"-");
+            if (motionFormat != Off) wprintf(L"%.4f\n", motionError); else wprintf(L"-\n");
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ^C̃CgJO
+    // ------------------------------------------------------------------------------
+
+    int BenchmarkLights(uint32_t triangleCount, int iterations)
+    {
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        const std::vector<uint32_t> noIndices;
+        const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Op` (NDC  z = 0.1 ~ 0.9) ̎OɎU΂Cg (World = PʍsȂ̂Ń[hW = NDC)
+        std::mt19937 random(54321);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<PointLight> lights(4096);
+        for (PointLight& light : lights)
+        {
+            light.position = XMFLOAT3(unit(random) * 2.2f - 1.1f, unit(random) * 2.2f - 1.1f, unit(random) * 0.9f - 0.2f);
+            light.radius = 0.1f + 0.2f * unit(random);
+            light.color = XMFLOAT3(unit(random), unit(random), unit(random));
+            light.intensity = 0.5f;
+        }
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetAmbientLight(XMFLOAT3(0.1f, 0.1f, 0.1f));
+
+        wprintf(L"Tiled lighting: %u triangles at %u x %u, %d iterations (%u hardware threads, at most %u lights per tile)\n",
+                triangleCount, c_FrameWidth, c_FrameHeight, iterations, hardwareThreads, c_MaxTileLights);
+        wprintf(L"  lights | threads |    ms    | speedup | lights/tile | overflowed tiles | error\n");
+
+        const uint32_t lightCounts[] = { 0, 64, 256, 1024, 4096 };
+        std::vector<uint32_t> threadCounts = { 1 };
+        if (hardwareThreads > 1)
+        {
+            threadCounts.push_back(hardwareThreads);
+        }
+        for (uint32_t lightCount : lightCounts)
+        {
+            rasterizer.SetLights(lights.data(), lightCount);
+
+            // 덷̊1Xbh (^C͏dȂȂ̂ŁAXbhɂ炸FɂȂ)
+            double singleThread = 0.0;
+            std::vector<uint32_t> reference;
+            for (uint32_t threads : threadCounts)
+            {
+                rasterizer.SetThreadCount(threads);
+                double best = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    auto start = Clock::now();
+                    rasterizer.Render(scene, noIndices);
+                    best = std::min(best, SecondsSince(start));
+                }
+                if (reference.empty())
+                {
+                    singleThread = best;
+                    reference = rasterizer.GetColorBuffer();
+                }
+
+                wprintf(L"  %6u | %7u | %8.3f | %6.2fx | %11.1f | %16llu | %.3f\n", lightCount, threads, best * 1e3, singleThread / best,
+                        rasterizer.GetAverageTileLights(), rasterizer.GetOverflowedLightTiles(), ColorError(rasterizer.GetColorBuffer(), reference));
+            }
+        }
+        return 0;
+    }
+    // ------------------------------------------------------------------------------
+    // _Q̃Xvbg
+    // ------------------------------------------------------------------------------
+
+    // LiDAR ŊX𑪂悤ȓ_Q (N̂ 200m l̒nʂƁA8 x 8 ̌̕)
+    std::vector<PointVertex> CreateLidarCloud(uint32_t pointCount)
+    {
+        std::mt19937 random(2468);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<PointVertex> points(pointCount);
+        for (uint32_t i = 0; i < pointCount; ++i)
+        {
+            PointVertex& point = points[i];
+            if (i % 4 != 0)
+            {
+                const float x = unit(random) * 200.0f - 100.0f;
+                const float z = unit(random) * 200.0f - 100.0f;
+                point.pos = XMFLOAT3(x, 0.5f * sinf(x * 0.3f) * cosf(z * 0.2f), z);
+                const uint32_t gray = 80 + static_cast<uint32_t>(unit(random) * 48.0f);
+                point.color = 0xFF000000 | (gray << 16) | (gray << 8) | gray;
+            }
+            else
+            {
+                // 4_1_͌̕ (ƂɍƐFႤ)
+                const uint32_t building = static_cast<uint32_t>(random() % 64);
+                const float centerX = -87.5f + (building % 8) * 25.0f;
+                const float centerZ = -87.5f + (building / 8) * 25.0f;
+                const float height = 5.0f + static_cast<float>((building * 7) % 20);
+                const float along = unit(random) * 10.0f - 5.0f;
+                const uint32_t face = static_cast<uint32_t>(random() % 4);
+                const float x = face < 2 ? along : (face == 2 ? -5.0f : 5.0f);
+                const float z = face < 2 ? (face == 0 ? -5.0f : 5.0f) : along;
+                point.pos = XMFLOAT3(centerX + x, unit(random) * height, centerZ + z);
+                point.color = 0xFF000000 | ((building * 37 % 256) << 16) | ((building * 91 % 256) << 8) | (building * 53 % 256);
+            }
+        }
+        return points;
+    }
+
+    int BenchmarkPoints(uint32_t pointCount, int iterations)
+    {
+        const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        // 1. _Qă`NɕA.dxrpoints ɏoă}bvŊJ
+        std::vector<PointVertex> points = CreateLidarCloud(pointCount);
+        std::vector<PointChunk> chunks;
+        auto start = Clock::now();
+        BuildPointChunks(points, chunks);
+        const double buildSeconds = SecondsSince(start);
+
+        const std::wstring fileName = (std::filesystem::temp_directory_path() / L"RasterizerBenchmark.dxrpoints").wstring();
+        WritePointCloudFile(fileName.c_str(), points, chunks);
+        points.clear();
+        points.shrink_to_fit();
+        chunks.clear();
+
+        PointCloudFile file;
+        start = Clock::now();
+        file.Open(fileName.c_str());
+        const double openSeconds = SecondsSince(start);
+
+        wprintf(L"Point splatting: %u points in %u chunks at %u x %u, %d iterations (%u hardware threads)\n",
+                file.GetPointCount(), file.GetChunkCount(), c_FrameWidth, c_FrameHeight, iterations, hardwareThreads);
+        wprintf(L"  chunk build %.1f ms, file %.1f MB mapped in %.3f ms\n",
+                buildSeconds * 1e3, file.GetFileSize() / (1024.0 * 1024.0), openSeconds * 1e3);
+
+        // X΂ߏォ猩낷 (̃`NقǉʏŏALOD ŊԈ)
+        const XMMATRIX worldViewProj = XMMatrixLookAtLH(XMVectorSet(0.0f, 30.0f, -120.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f))
+                                     * XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<float>(c_FrameWidth) / c_FrameHeight, 1.0f, 400.0f);
+
+        // 2. CPU (_̓}bvr[璼ړǂ)
+        SoftwarePointSplatter splatter;
+        splatter.Initialize(c_FrameWidth, c_FrameHeight);
+
+        wprintf(L"  density | threads | splat ms | speedup | resolve ms | drawn points | Mpts/s (input) | covered px | filled px | error\n");
+
+        const float densities[] = { 0.0f, 4.0f, 1.0f, 0.25f };
+        std::vector<uint32_t> threadCounts = { 1 };
+        if (hardwareThreads > 1)
+        {
+            threadCounts.push_back(hardwareThreads);
+        }
+        std::vector<uint32_t> reference;
+        std::vector<std::vector<uint32_t>> cpuImages;
+        for (float density : densities)
+        {
+            PointSplatDesc desc;
+            desc.density = density;
+            splatter.SetDesc(desc);
+
+            // 덷̊͊Ԉɕ`摜 (64bit ̍ŏlŌ܂̂ŁAXbhɂ炸FɂȂ)
+            double singleThread = 0.0;
+            for (uint32_t threads : threadCounts)
+            {
+                splatter.SetThreadCount(threads);
+                double best = 1e30;
+                double bestResolve = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    start = Clock::now();
+                    splatter.Clear();
+                    splatter.Splat(file.GetPoints(), file.GetChunks(), file.GetChunkCount(), worldViewProj);
+                    best = std::min(best, SecondsSince(start));
+
+                    start = Clock::now();
+                    splatter.Resolve();
+                    bestResolve = std::min(bestResolve, SecondsSince(start));
+                }
+                if (singleThread == 0.0)
+                {
+                    singleThread = best;
+                    cpuImages.push_back(splatter.GetColorBuffer());
+                }
+                if (reference.empty())
+                {
+                    reference = splatter.GetColorBuffer();
+                }
+
+                wprintf(L"  %7.2f | %7u | %8.3f | %6.2fx | %10.3f | %12llu | %14.1f | %10zu | %9zu | %.3f\n", density, threads, best * 1e3, singleThread / best,
+                        bestResolve * 1e3, splatter.GetSplattedPoints(), file.GetPointCount() / best / 1e6, splatter.GetCoveredPixels(), splatter.GetFilledPixels(),
+                        ColorError(splatter.GetColorBuffer(), reference));
+            }
+        }
+
+        // 3. GPU (]̓`NPʁBCPU Ɠxŕ`ACPU ̉摜Ƃ̍o)
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+        if (!CreateDevice(device, context))
+        {
+            return 1;
+        }
+
+        PointCloudBuffers buffers;
+        CreatePointCloudBuffers(device.Get(), context.Get(), file, buffers);
+
+        PointSplatPass pass;
+        pass.Initialize(device.Get(), (c_ShaderDirectory + L"PointSplat.hlsl").c_str());
+        pass.CreateTargets(device.Get(), c_FrameWidth, c_FrameHeight);
+
+        D3D11_TEXTURE2D_DESC textureDesc = {};
+        textureDesc.Width = c_FrameWidth;
+        textureDesc.Height = c_FrameHeight;
+        textureDesc.MipLevels = 1;
+        textureDesc.ArraySize = 1;
+        textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        textureDesc.SampleDesc.Count = 1;
+        textureDesc.Usage = D3D11_USAGE_DEFAULT;
+        textureDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> output;
+        Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> outputUAV;
+        DX::ThrowIfFailed(device->CreateTexture2D(&textureDesc, nullptr, &output));
+        DX::ThrowIfFailed(device->CreateUnorderedAccessView(output.Get(), nullptr, &outputUAV));
+
+        textureDesc.Usage = D3D11_USAGE_STAGING;
+        textureDesc.BindFlags = 0;
+        textureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> staging;
+        DX::ThrowIfFailed(device->CreateTexture2D(&textureDesc, nullptr, &staging));
+
+        GpuTimer timer(device.Get());
+        std::vector<uint32_t> gpuImage(static_cast<size_t>(c_FrameWidth) * c_FrameHeight);
+        for (size_t d = 0; d < std::size(densities); ++d)
+        {
+            PointSplatDesc desc;
+            desc.density = densities[d];
+
+            double best = 1e30;
+            for (int i = 0; i < iterations; ++i)
+            {
+                timer.Begin(context.Get());
+                pass.Clear(context.Get());
+                pass.Splat(context.Get(), buffers.pointSRV.Get(), buffers.chunkSRV.Get(), buffers.chunkCount, worldViewProj, desc);
+                pass.Resolve(context.Get(), outputUAV.Get(), desc);
+                timer.End(context.Get());
+
+                const double seconds = timer.GetSeconds(context.Get());
+                if (seconds > 0.0)
+                {
+                    best = std::min(best, seconds);
+                }
+            }
+
+            context->CopyResource(staging.Get(), output.Get());
+            D3D11_MAPPED_SUBRESOURCE mapped;
+            DX::ThrowIfFailed(context->Map(staging.Get(), 0, D3D11_MAP_READ, 0, &mapped));
+            for (uint32_t y = 0; y < c_FrameHeight; ++y)
+            {
+                memcpy(&gpuImage[static_cast<size_t>(y) * c_FrameWidth], static_cast<const uint8_t*>(mapped.pData) + static_cast<size_t>(y) * mapped.RowPitch,
+                       c_FrameWidth * sizeof(uint32_t));
+            }
+            context->Unmap(staging.Get(), 0);
+
+            if (best < 1e30)
+            {
+                wprintf(L"  GPU density %5.2f: %8.3f ms, %8.1f Mpts/s (input), |GPU - CPU| %.3f\n",
+                        densities[d], best * 1e3, buffers.pointCount / best / 1e6, ColorError(gpuImage, cpuImages[d]));
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // ƃC[t[
+    // ------------------------------------------------------------------------------
+
+    // NDC  [-1, 1] x [-1, 1] 𕢂 cells x cells ̊iq̋N̂n (CfbNX`AWorld = Pʍs)
+    void CreateHeightfieldGrid(uint32_t cells, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+    {
+        vertices.clear();
+        indices.clear();
+        for (uint32_t y = 0; y <= cells; ++y)
+        {
+            for (uint32_t x = 0; x <= cells; ++x)
+            {
+                const float u = static_cast<float>(x) / cells;
+                const float v = static_cast<float>(y) / cells;
+                Vertex vertex = {};
+                vertex.pos = XMFLOAT3(u * 2.0f - 1.0f, v * 2.0f - 1.0f, 0.5f + 0.1f * sinf(u * 12.0f) * cosf(v * 9.0f));
+                vertex.color = XMFLOAT4(u, v, 0.5f, 1.0f);
+                vertex.uv = XMFLOAT2(u, v);
+                vertices.push_back(vertex);
+            }
+        }
+        for (uint32_t y = 0; y < cells; ++y)
+        {
+            for (uint32_t x = 0; x < cells; ++x)
+            {
+                const uint32_t i = y * (cells + 1) + x;
+                const uint32_t quad[6] = { i, i + cells + 1, i + 1, i + 1, i + cells + 1, i + cells + 2 };
+                indices.insert(indices.end(), quad, quad + 6);
+            }
+        }
+    }
+
+    int BenchmarkLines(uint32_t lineCount, int iterations)
+    {
+        const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        const std::vector<uint32_t> noIndices;
+
+        // 1. NDC ɎU΂Z ( 0.01 ~ 0.11Az = 0 ~ 1BCfbNX` 2_ = 1{)
+        std::mt19937 random(97531);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<Vertex> lines(static_cast<size_t>(lineCount) * 2);
+        for (uint32_t l = 0; l < lineCount; ++l)
+        {
+            const float x = unit(random) * 2.2f - 1.1f;
+            const float y = unit(random) * 2.2f - 1.1f;
+            const float angle = unit(random) * XM_2PI;
+            const float length = 0.01f + 0.1f * unit(random);
+            const float z = unit(random);
+            const XMFLOAT4 color(unit(random), unit(random), unit(random), 1.0f);
+            lines[l * 2] = { XMFLOAT3(x, y, z), color, XMFLOAT2(0.0f, 0.0f) };
+            lines[l * 2 + 1] = { XMFLOAT3(x + length * cosf(angle), y + length * sinf(angle), z), color, XMFLOAT2(1.0f, 0.0f) };
+        }
+
+        const std::vector<Vertex> scene = CreateCalibrationScene(1024, static_cast<float>(c_FrameWidth) / c_FrameHeight);
+        RasterState state;
+        state.textured = false;
+
+        SoftwareRasterizer rasterizer;
+        rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+        rasterizer.SetRasterState(state);
+
+        wprintf(L"Lines: %u lines at %u x %u, %d iterations (%u hardware threads)\n",
+                lineCount, c_FrameWidth, c_FrameHeight, iterations, hardwareThreads);
+        wprintf(L"  width | depth test | threads |    ms    | speedup | Mlines/s | Mpixels/s | binned | error\n");
+
+        std::vector<uint32_t> threadCounts = { 1 };
+        if (hardwareThreads > 1)
+        {
+            threadCounts.push_back(hardwareThreads);
+        }
+        const float widths[] = { 1.0f, 3.0f };
+        for (uint32_t depthTest = 0; depthTest < 2; ++depthTest)
+        {
+            for (float width : widths)
+            {
+                LineDesc desc;
+                desc.width = width;
+                desc.depthTest = depthTest != 0;
+
+                // 덷̊1Xbh (^C̐͏Ԃɕ`̂ŁAXbhɂ炸FɂȂ)
+                double singleThread = 0.0;
+                std::vector<uint32_t> reference;
+                for (uint32_t threads : threadCounts)
+                {
+                    rasterizer.SetThreadCount(threads);
+                    double best = 1e30;
+                    for (int i = 0; i < iterations; ++i)
+                    {
+                        // [xeXgȂOp`̏ɕ` (Op`͌vȂ)
+                        rasterizer.Render(desc.depthTest ? scene : std::vector<Vertex>(), noIndices);
+                        auto start = Clock::now();
+                        rasterizer.RenderLines(lines, noIndices, desc);
+                        best = std::min(best, SecondsSince(start));
+                    }
+                    if (reference.empty())
+                    {
+                        singleThread = best;
+                        reference = rasterizer.GetColorBuffer();
+                    }
+
+                    wprintf(L"  %5.1f | %10ls | %7u | %8.3f | %6.2fx | %8.2f | %9.1f | %6zu | %.3f\n", width, desc.depthTest ? L"on" : L"off", threads,
+                            best * 1e3, singleThread / best, lineCount / best / 1e6, rasterizer.GetLineFragments() / best / 1e6,
+                            rasterizer.GetBinnedLineCount(), ColorError(rasterizer.GetColorBuffer(), reference));
+                }
+            }
+        }
+
+        // 2. C[t[: Op`Ƃ3 (Lӂ2`) ƁAd
+        std::vector<Vertex> grid;
+        std::vector<uint32_t> gridIndices;
+        CreateHeightfieldGrid(256, grid, gridIndices);
+        const uint32_t triangleCount = TriangleCount(grid, gridIndices);
+
+        std::vector<uint32_t> naiveEdges;
+        naiveEdges.reserve(static_cast<size_t>(triangleCount) * 6);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                naiveEdges.push_back(TriangleVertexIndex(gridIndices, t, k));
+                naiveEdges.push_back(TriangleVertexIndex(gridIndices, t, (k + 1) % 3));
+            }
+        }
+
+        double buildSeconds = 1e30;
+        std::vector<uint32_t> uniqueEdges;
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto start = Clock::now();
+            uniqueEdges = BuildWireframeEdges(grid, gridIndices);
+            buildSeconds = std::min(buildSeconds, SecondsSince(start));
+        }
+
+        wprintf(L"Wireframe: %u triangles, %zu edges per triangle -> %zu unique edges (built in %.3f ms)\n",
+                triangleCount, naiveEdges.size() / 2, uniqueEdges.size() / 2, buildSeconds * 1e3);
+        wprintf(L"  edges          | overlay |    ms    | Mlines/s | pixels\n");
+
+        // B: ʂ`ɁAʂ菭Oւ炵[xŐd˂
+        rasterizer.SetThreadCount(0);
+        struct EdgeSet {
+            const wchar_t* name;
+            const std::vector<uint32_t>* edges;
+        };
+        const EdgeSet edgeSets[] = { { L"per triangle", &naiveEdges }, { L"unique", &uniqueEdges } };
+        for (uint32_t overlay = 0; overlay < 2; ++overlay)
+        {
+            for (const EdgeSet& edgeSet : edgeSets)
+            {
+                LineDesc desc;
+                desc.color = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+                desc.depthTest = overlay != 0;
+                desc.depthBias = 1e-3f;
+
+                double best = 1e30;
+                for (int i = 0; i < iterations; ++i)
+                {
+                    rasterizer.Render(overlay != 0 ? grid : std::vector<Vertex>(), overlay != 0 ? gridIndices : noIndices);
+                    auto start = Clock::now();
+                    rasterizer.RenderLines(grid, *edgeSet.edges, desc);
+                    best = std::min(best, SecondsSince(start));
+                }
+
+                const size_t edgeCount = edgeSet.edges->size() / 2;
+                wprintf(L"  %-14ls | %7ls | %8.3f | %8.2f | %llu\n", edgeSet.name, overlay != 0 ? L"on" : L"off", best * 1e3,
+                        edgeCount / best / 1e6, rasterizer.GetLineFragments());
+            }
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // IWIg
+    // ------------------------------------------------------------------------------
+
+    // frame Ԗڂ̃t[̍ row sڂ̒_ (CreateHeightfieldGrid ̍Ԃŗh炵)
+    void AnimateHeightfieldRow(uint32_t cells, uint32_t row, uint32_t frame, Vertex* vertices)
+    {
+        const float v = static_cast<float>(row) / cells;
+        const float phase = frame * 0.3f;
+        for (uint32_t x = 0; x <= cells; ++x)
+        {
+            const float u = static_cast<float>(x) / cells;
+            vertices[x].pos = XMFLOAT3(u * 2.0f - 1.0f, v * 2.0f - 1.0f, 0.5f + 0.1f * sinf(u * 12.0f + phase) * cosf(v * 9.0f));
+            vertices[x].color = XMFLOAT4(u, v, 0.5f + 0.5f * sinf(phase), 1.0f);
+            vertices[x].uv = XMFLOAT2(u, v);
+        }
+    }
+
+    int BenchmarkDynamicGeometry(uint32_t cells, uint32_t frameCount)
+    {
+        std::vector<Vertex> grid;
+        std::vector<uint32_t> gridIndices;
+        CreateHeightfieldGrid(cells, grid, gridIndices);
+        const uint32_t rowSize = cells + 1;
+        const uint32_t triangleCount = TriangleCount(grid, gridIndices);
+
+        // t[ 1/8 ̍sAOp`̐ 1/2 ~ S̊Ԃŕς
+        const uint32_t bandRows = std::max(1u, rowSize / 8);
+
+        // CreateHeightfieldGrid ̎Op` NDC Ŏvł͂Ȃ̂ŁAʂ`
+        RasterState state;
+        state.textured = false;
+        state.cullMode = CullMode::None;
+
+        wprintf(L"Dynamic geometry: %u x %u grid (%u triangles), %u rows (%.2f MB) updated per frame, %u frames\n", cells, cells,
+                triangleCount, bandRows, bandRows * rowSize * sizeof(Vertex) / (1024.0 * 1024.0), frameCount);
+        wprintf(L"  mode      | upload MB/frame |  ms/frame | checksum\n");
+
+        // XV: frame Ԗڂ̃t[ō (mesh) ̑тāAтŜςŒ߂
+        auto produce = [&](SoftwareDynamicGeometry& geometry, std::vector<Vertex>& mesh, uint32_t frame, bool fullUpload)
+        {
+            const uint32_t firstRow = (frame * bandRows) % rowSize;
+            const uint32_t rowCount = std::min(bandRows, rowSize - firstRow);
+            for (uint32_t r = firstRow; r < firstRow + rowCount; ++r)
+            {
+                AnimateHeightfieldRow(cells, r, frame, &mesh[r * rowSize]);
+            }
+
+            if (fullUpload)
+            {
+                geometry.UpdateVertices(0, mesh.data(), static_cast<uint32_t>(mesh.size()));
+            }
+            else
+            {
+                geometry.UpdateVertices(firstRow * rowSize, &mesh[firstRow * rowSize], rowCount * rowSize);
+            }
+            geometry.SetTriangleCount(triangleCount / 2 + (frame * 977) % (triangleCount / 2 + 1));
+            geometry.EndFrame();
+        };
+
+        struct Mode {
+            const wchar_t* name;
+            bool fullUpload;
+            bool pipelined;
+        };
+        const Mode modes[] = {
+            { L"full", true, false },
+            { L"partial", false, false },
+            { L"pipelined", false, true },
+        };
+
+        uint64_t reference = 0;
+        for (const Mode& mode : modes)
+        {
+            SoftwareDynamicGeometry geometry;
+            geometry.Initialize(static_cast<uint32_t>(grid.size()), static_cast<uint32_t>(gridIndices.size()));
+            geometry.UpdateVertices(0, grid.data(), static_cast<uint32_t>(grid.size()));
+            geometry.UpdateIndices(0, gridIndices.data(), static_cast<uint32_t>(gridIndices.size()));
+
+            SoftwareRasterizer rasterizer;
+            rasterizer.Initialize(c_FrameWidth, c_FrameHeight);
+            rasterizer.SetRasterState(state);
+
+            // St[̐F𑫂 (XV̔fxꂽ蔲肷ƕς)
+            uint64_t checksum = 0;
+            auto consume = [&]()
+            {
+                rasterizer.Render(geometry.GetVertices(), geometry.GetIndices());
+                geometry.ReleaseFrame();
+                for (uint32_t color : rasterizer.GetColorBuffer())
+                {
+                    checksum += color;
+                }
+            };
+
+            std::vector<Vertex> mesh = grid;
+            auto start = Clock::now();
+            if (mode.pipelined)
+            {
+                // XVʃXbhŐs
+                auto producer = std::async(std::launch::async, [&]()
+                {
+                    for (uint32_t f = 0; f < frameCount; ++f)
+                    {
+                        produce(geometry, mesh, f, false);
+                    }
+                });
+
+                for (uint32_t f = 0; f < frameCount; )
+                {
+                    if (geometry.AcquireFrame())
+                    {
+                        consume();
+                        ++f;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                producer.get();
+            }
+            else
+            {
+                for (uint32_t f = 0; f < frameCount; ++f)
+                {
+                    produce(geometry, mesh, f, mode.fullUpload);
+                    geometry.AcquireFrame();
+                    consume();
+                }
+            }
+            const double seconds = SecondsSince(start);
+
+            // ǂ̃[ht[̗`̂ŁAŜ̓]ƓFɂȂ
+            if (reference == 0)
+            {
+                reference = checksum;
+            }
+            const uint32_t uploadRows = mode.fullUpload ? rowSize : bandRows;
+            wprintf(L"  %-9ls | %15.2f | %9.3f | %llu %ls\n", mode.name, uploadRows * rowSize * sizeof(Vertex) / (1024.0 * 1024.0),
+                    seconds / frameCount * 1e3, checksum, checksum == reference ? L"(match)" : L"(MISMATCH)");
+        }
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------------
+    // GPU ̃X^CU
+    // ------------------------------------------------------------------------------
+
+    // vertices (3_ = 1Op`) ̍\obt@ SRV
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> CreateVertexSRV(ID3D11Device* device, const std::vector<Vertex>& vertices)
+    {
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * vertices.size());
+        bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+        bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = sizeof(Vertex);
+
+        D3D11_SUBRESOURCE_DATA initData = {};
+        initData.pSysMem = vertices.data();
+
+        Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+        DX::ThrowIfFailed(device->CreateBuffer(&bufferDesc, &initData, &buffer));
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.NumElements = static_cast<UINT>(vertices.size());
+
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        DX::ThrowIfFailed(device->CreateShaderResourceView(buffer.Get(), &srvDesc, &srv));
+        return srv;
+    }
+
+    // CPU ł̊ex`}[N̋@\ DirectXTKComputeRasterizer::Rasterize  GPU  (^CX^v) Ŕׂ
+    int BenchmarkGpuRasterizer(uint32_t triangleCount, int iterations)
+    {
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+        if (!CreateDevice(device, context))
+        {
+            return 1;
+        }
+
+        // X^CU̓VF[_[JgfBNgǂ
+        std::filesystem::current_path(c_ShaderDirectory);
+
+        const float aspect = static_cast<float>(c_FrameWidth) / c_FrameHeight;
+        const std::vector<Vertex> scene = CreateCalibrationScene(triangleCount, aspect);
+        const std::vector<Vertex> sparseScene = CreateCalibrationScene(64, aspect);
+        const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> sceneSRV = CreateVertexSRV(device.Get(), scene);
+        const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> sparseSRV = CreateVertexSRV(device.Get(), sparseScene);
+        const uint32_t sceneTriangles = static_cast<uint32_t>(scene.size() / 3);
+        const uint32_t sparseTriangles = static_cast<uint32_t>(sparseScene.size() / 3);
+
+        // rp̃V[ NDC Ȃ̂ŁAϊ͒Pʍs
+        DirectXTKComputeRasterizer rasterizer;
+        rasterizer.Initialize(device.Get(), context.Get(), c_FrameWidth, c_FrameHeight, DXGI_FORMAT_R8G8B8A8_UNORM);
+        rasterizer.SetTransform(XMMatrixIdentity(), XMMatrixIdentity(), XMMatrixIdentity());
+
+        auto rasterize = [&](ID3D11ShaderResourceView* vertexSRV, uint32_t count)
+        {
+            rasterizer.Rasterize(device.Get(), context.Get(), vertexSRV, nullptr, count, c_FrameWidth, c_FrameHeight);
+        };
+        auto rasterizeScene = [&]() { rasterize(sceneSRV.Get(), sceneTriangles); };
+
+        // draw ̍ŒZ GPU  (1ڂ̓VF[_[̃RpC܂ނ̂őȂBbefore ͖ draw ̑Oɑ炸Ɏs)
+        GpuTimer timer(device.Get());
+        auto measure = [&](const std::function<void()>& draw, const std::function<void()>& before = nullptr)
+        {
+            double best = 1e30;
+            for (int i = -1; i < iterations; ++i)
+            {
+                if (before)
+                {
+                    before();
+                }
+                timer.Begin(context.Get());
+                draw();
+                timer.End(context.Get());
+                rasterizer.GetUploadRing().EndFrame(context.Get());
+
+                const double seconds = timer.GetSeconds(context.Get());
+                if (i >= 0 && seconds > 0.0)
+                {
+                    best = std::min(best, seconds);
+                }
+            }
+            return best;
+        };
+
+        wprintf(L"GPU rasterizer: %u triangles at %u x %u, %d iterations (GPU time of Rasterize)\n",
+                sceneTriangles, c_FrameWidth, c_FrameHeight, iterations);
+        wprintf(L"  feature       | setting                |    ms    | vs base\n");
+
+        double baseline = 0.0;
+        auto report = [&](const wchar_t* feature, const wchar_t* setting, double seconds)
+        {
+            // e@\̍ŏ̍s (@\Ȃ) ɂ
+            if (feature[0] != L'\0')
+            {
+                baseline = seconds;
+            }
+            wprintf(L"  %-13ls | %-22ls | %8.3f | %+6.1f%%\n", feature, setting, seconds * 1e3, (seconds / baseline - 1.0) * 100.0);
+        };
+
+        // 1. ^C (XbhO[v) ̑傫BAutoTuneTileSize Iԑ傫ƔׁAȍ~͂̑傫ő (Game Ɠ)
+        for (uint32_t tileSize = 0; tileSize < c_TileSizeCount; ++tileSize)
+        {
+            wchar_t setting[32];
+            swprintf_s(setting, L"%ux%u", c_TileSizes[tileSize].width, c_TileSizes[tileSize].height);
+            rasterizer.SetTileSize(tileSize);
+            report(tileSize == 0 ? L"tile size" : L"", setting, measure(rasterizeScene));
+        }
+
+        const uint32_t tunedTileSize = rasterizer.AutoTuneTileSize(device.Get(), context.Get(), c_FrameWidth, c_FrameHeight, iterations);
+        wchar_t tunedSetting[32];
+        swprintf_s(tunedSetting, L"auto-tuned %ux%u", c_TileSizes[tunedTileSize].width, c_TileSizes[tunedTileSize].height);
+        report(L"", tunedSetting, measure(rasterizeScene));
+
+        // 2. t@XgNA: ȂOp`̃t[AŜ` (S^C) Ɠt[̌ (̃^C΂) ŕ`
+        auto rasterizeSparse = [&]() { rasterize(sparseSRV.Get(), sparseTriangles); };
+        report(L"fast clear", L"after full frame", measure(rasterizeSparse, rasterizeScene));
+        report(L"", L"after same frame", measure(rasterizeSparse, rasterizeSparse));
+
+        // 3. [xvpX
+        rasterizer.SetDepthPrepass(DepthPrepassMode::Off);
+        report(L"depth prepass", L"off", measure(rasterizeScene));
+        rasterizer.SetDepthPrepass(DepthPrepassMode::On);
+        report(L"", L"on", measure(rasterizeScene));
+        rasterizer.SetDepthPrepass(DepthPrepassMode::Off);
+
+        // 4. }`r[: r[Ƃ Rasterize ƁA1 Dispatch (CPU ł -multiview Ɠr[)
+        XMMATRIX views[c_MaxViews];
+        for (uint32_t v = 0; v < c_MaxViews; ++v)
+        {
+            views[v] = XMMatrixMultiply(XMMatrixRotationZ(0.05f * v), XMMatrixTranslation(0.04f * v, -0.02f * v, 0.0f));
+        }
+        for (uint32_t viewCount = 2; viewCount <= c_MaxViews; viewCount += 2)
+        {
+            const double separate = measure([&]()
+            {
+                for (uint32_t v = 0; v < viewCount; ++v)
+                {
+                    rasterizer.SetTransform(XMMatrixIdentity(), XMMatrixIdentity(), views[v]);
+                    rasterizeScene();
+                }
+            });
+
+            // ̓r[ƂɁAr[Ƃ Rasterize
+            wchar_t setting[32];
+            swprintf_s(setting, L"%u separate", viewCount);
+            baseline = separate;
+            report(viewCount == 2 ? L"multi-view" : L"", setting, separate);
+
+            rasterizer.SetMultiView(device.Get(), XMMatrixIdentity(), views, viewCount);
+            swprintf_s(setting, L"%u single pass", viewCount);
+            const double multi = measure(rasterizeScene);
+            rasterizer.SetMultiView(device.Get(), XMMatrixIdentity(), nullptr, 0);
+            rasterizer.SetTransform(XMMatrixIdentity(), XMMatrixIdentity(), XMMatrixIdentity());
+            report(L"", setting, multi);
+        }
+
+        // 5. BVH ɂ^CPʂ̎Op`W
+        const Bvh bvh = BuildBvh(scene);
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> nodeSRV, triangleIndexSRV;
+        rasterizer.CreateBvhBuffers(device.Get(), bvh, nodeSRV, triangleIndexSRV);
+        report(L"BVH", L"off", measure(rasterizeScene));
+        rasterizer.SetBvh(nodeSRV.Get(), triangleIndexSRV.Get(), static_cast<uint32_t>(bvh.nodes.size()));
+        report(L"", L"on", measure(rasterizeScene));
+        rasterizer.SetBvh(nullptr, nullptr, 0);
+
+        // 6. ێIX^CYƃJobW}XÑA`GCAX
+        const wchar_t* conservativeNames[] = { L"off", L"overestimate", L"underestimate" };
+        for (uint32_t mode = 0; mode < c_ConservativeModeCount; ++mode)
+        {
+            rasterizer.SetConservativeRaster(static_cast<ConservativeMode>(mode));
+            report(mode == 0 ? L"conservative" : L"", conservativeNames[mode], measure(rasterizeScene));
+        }
+        rasterizer.SetConservativeRaster(ConservativeMode::Off);
+
+        const wchar_t* antiAliasNames[] = { L"off", L"coverage 4x", L"coverage 8x" };
+        for (uint32_t mode = 0; mode < c_AntiAliasModeCount; ++mode)
+        {
+            rasterizer.SetAntiAliasing(device.Get(), static_cast<AntiAliasMode>(mode));
+            report(mode == 0 ? L"anti-aliasing" : L"", antiAliasNames[mode], measure(rasterizeScene));
+        }
+        rasterizer.SetAntiAliasing(device.Get(), AntiAliasMode::Off);
+
+        // 7. σ[gVF[fBO (Explicit ͑S^C 2x2AAuto ͑Õt[̐FŌ߂)
+        rasterizer.SetShadingRates(context.Get(), std::vector<ShadingRate>(GetShadingRateTileCount(c_FrameWidth, c_FrameHeight), ShadingRate::Rate2x2));
+        const wchar_t* shadingRateNames[] = { L"off", L"explicit 2x2", L"auto" };
+        for (uint32_t mode = 0; mode < 3; ++mode)
+        {
+            rasterizer.SetShadingRateMode(device.Get(), static_cast<ShadingRateMode>(mode));
+            report(mode == 0 ? L"shading rate" : L"", shadingRateNames[mode], measure(rasterizeScene));
+        }
+        rasterizer.SetShadingRateMode(device.Get(), ShadingRateMode::Off);
+
+        // 8. VU[` (CPU ł -scissor  UI ̃pl)
+        const ScissorRect panel = { 965, 37, 1243, 361 };
+        report(L"scissor", L"off", measure(rasterizeScene));
+        rasterizer.SetScissorRects(&panel, 1);
+        report(L"", L"panel", measure(rasterizeScene));
+        rasterizer.SetScissorRects(nullptr, 0);
+
+        // 9. G-buffer (S^[Qbg Full / Packed ŏ)
+        report(L"G-buffer", L"off", measure(rasterizeScene));
+        const GBufferFormat gbufferFormats[] = { GBufferFormat::Full, GBufferFormat::Packed };
+        for (GBufferFormat format : gbufferFormats)
+        {
+            GBufferDesc desc;
+            std::fill(std::begin(desc.formats), std::end(desc.formats), format);
+            rasterizer.SetGBuffer(device.Get(), desc);
+            report(L"", format == GBufferFormat::Full ? L"all full" : L"all packed", measure(rasterizeScene));
+        }
+        rasterizer.SetGBuffer(device.Get(), GBufferDesc());
+
+        // 10. ^CPʂ̃CgJO (CPU ł -lights ƓCg)
+        std::mt19937 random(54321);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<PointLight> lights(1024);
+        for (PointLight& light : lights)
+        {
+            light.position = XMFLOAT3(unit(random) * 2.2f - 1.1f, unit(random) * 2.2f - 1.1f, unit(random) * 0.9f - 0.2f);
+            light.radius = 0.1f + 0.2f * unit(random);
+            light.color = XMFLOAT3(unit(random), unit(random), unit(random));
+            light.intensity = 0.5f;
+        }
+        const uint32_t lightCounts[] = { 0, 64, 256, 1024 };
+        for (uint32_t lightCount : lightCounts)
+        {
+            wchar_t setting[32];
+            swprintf_s(setting, L"%u lights", lightCount);
+            rasterizer.SetLights(device.Get(), context.Get(), lights.data(), lightCount);
+            report(lightCount == 0 ? L"lighting" : L"", setting, measure(rasterizeScene));
+        }
+        rasterizer.SetLights(device.Get(), context.Get(), nullptr, 0);
+        return 0;
+    }
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+    try
+    {
+        if (argc >= 2 && wcscmp(argv[1], L"-skinning") == 0)
+        {
+            uint32_t characters = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 256;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 10;
+            return BenchmarkSkinning(characters, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-mips") == 0)
+        {
+            int iterations = argc >= 3 ? std::max(1, _wtoi(argv[2])) : 5;
+            return BenchmarkMips(iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-swizzle") == 0)
+        {
+            int iterations = argc >= 3 ? std::max(1, _wtoi(argv[2])) : 5;
+            return BenchmarkSwizzle(iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-bc") == 0)
+        {
+            int iterations = argc >= 3 ? std::max(1, _wtoi(argv[2])) : 5;
+            return BenchmarkBlockCompression(iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-permutations") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4096;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkPermutations(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-tiles") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4096;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkTileSizes(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-clear") == 0)
+        {
+            int iterations = argc >= 3 ? std::max(1, _wtoi(argv[2])) : 5;
+            return BenchmarkFastClear(iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-depth") == 0)
+        {
+            int iterations = argc >= 3 ? std::max(1, _wtoi(argv[2])) : 5;
+            return BenchmarkDepthFormats(iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-prepass") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4096;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkDepthPrepass(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-multiview") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4096;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkMultiView(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-shadow") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4096;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkShadowMap(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-conservative") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkConservative(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-msaa") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkAntiAliasing(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-vrs") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkVariableRateShading(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-scissor") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkScissor(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-gbuffer") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkGBuffer(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-lights") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkLights(triangles, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-points") == 0)
+        {
+            uint32_t points = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4 * 1024 * 1024;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkPoints(points, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-lines") == 0)
+        {
+            uint32_t lines = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 100000;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 5;
+            return BenchmarkLines(lines, iterations);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-dynamic") == 0)
+        {
+            uint32_t cells = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 256;
+            uint32_t frames = argc >= 4 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[3]))) : 120;
+            return BenchmarkDynamicGeometry(cells, frames);
+        }
+
+        if (argc >= 2 && wcscmp(argv[1], L"-gpu") == 0)
+        {
+            uint32_t triangles = argc >= 3 ? static_cast<uint32_t>(std::max(1, _wtoi(argv[2]))) : 4096;
+            int iterations = argc >= 4 ? std::max(1, _wtoi(argv[3])) : 10;
+            return BenchmarkGpuRasterizer(triangles, iterations);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printf("Error: %s\n", e.what());
+        return 1;
+    }
+
+    wprintf(L"Usage:\n");
+    wprintf(L"  RasterizerBenchmark -skinning [characters] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -mips [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -swizzle [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -bc [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -permutations [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -tiles [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -clear [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -depth [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -prepass [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -multiview [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -shadow [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -conservative [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -msaa [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -vrs [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -scissor [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -gbuffer [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -lights [triangles] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -points [points] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -lines [lines] [iterations]\n");
+    wprintf(L"  RasterizerBenchmark -dynamic [cells] [frames]\n");
+    wprintf(L"  RasterizerBenchmark -gpu [triangles] [iterations]\n");
+    return 1;
+}
\ No newline at end of file